@@ -44,6 +44,17 @@ extern std::shared_ptr<CacheBase> NewLRUCache(size_t capacity, int num_shard_bit
                                           double high_pri_pool_ratio = 0.0,
                                           const CacheAllocatorPtr& allocator = CacheAllocatorPtr());
 
+// Create a new scan-resistant cache with W-TinyLFU admission policy. New
+// entries are kept in an LRU window of window_ratio of capacity, and only
+// admitted to the segmented main region when they are estimated to be
+// accessed more frequently than the entry they would evict. protected_ratio
+// of main region is reserved for entries hit again after admitted.
+// estimated_entry_charge is used to size the frequency sketch.
+extern std::shared_ptr<CacheBase> NewTinyLFUCache(size_t capacity, int num_shard_bits = 6,
+                                              bool strict_capacity_limit = false, double window_ratio = 0.01,
+                                              double protected_ratio = 0.8, size_t estimated_entry_charge = 4096,
+                                              const CacheAllocatorPtr& allocator = CacheAllocatorPtr());
+
 class CacheBase
 {
 public:
@@ -0,0 +1,607 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "autil/cache/tiny_lfu_cache.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "autil/Autovector.h"
+#include "autil/Lock.h"
+#include "autil/cache/cache.h"
+#include "autil/cache/cache_allocator.h"
+#include "autil/cache/sharded_cache.h"
+#ifndef AIOS_OPEN_SOURCE
+#include "lockless_allocator/MallocPoolScope.h"
+#endif
+
+namespace autil {
+
+static const uint64_t SKETCH_SEEDS[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+                                        0xcbf29ce484222325ULL};
+static const uint64_t SKETCH_RESET_MASK = 0x7777777777777777ULL;
+static const uint64_t SKETCH_ONE_MASK = 0x1111111111111111ULL;
+
+FrequencySketch::FrequencySketch() : table_mask_(0), sample_size_(0), size_(0) { EnsureCapacity(1); }
+
+FrequencySketch::~FrequencySketch() {}
+
+void FrequencySketch::EnsureCapacity(size_t maximum_size)
+{
+    size_t width = 16;
+    while (width < maximum_size && width < (1UL << 30)) {
+        width <<= 1;
+    }
+    if (width == table_.size()) {
+        return;
+    }
+    table_.assign(width, 0);
+    table_mask_ = width - 1;
+    // counters are aged after about 10 accesses per entry
+    sample_size_ = 10 * std::max(maximum_size, (size_t)1);
+    size_ = 0;
+}
+
+size_t FrequencySketch::IndexOf(uint32_t hash, int row) const
+{
+    uint64_t h = (hash + SKETCH_SEEDS[row]) * SKETCH_SEEDS[row];
+    h += (h >> 32);
+    return h & table_mask_;
+}
+
+bool FrequencySketch::IncrementAt(size_t index, int row, uint32_t hash)
+{
+    // each row uses a different counter of the 16 in word, selected by low bits of hash
+    int offset = (((hash & 3) << 2) + row) << 2;
+    uint64_t mask = 0xfULL << offset;
+    if ((table_[index] & mask) != mask) {
+        table_[index] += 1ULL << offset;
+        return true;
+    }
+    return false;
+}
+
+void FrequencySketch::Increment(uint32_t hash)
+{
+    bool added = false;
+    for (int row = 0; row < 4; ++row) {
+        added |= IncrementAt(IndexOf(hash, row), row, hash);
+    }
+    if (added && ++size_ >= sample_size_) {
+        Reset();
+    }
+}
+
+uint32_t FrequencySketch::Frequency(uint32_t hash) const
+{
+    uint32_t frequency = 15;
+    for (int row = 0; row < 4; ++row) {
+        int offset = (((hash & 3) << 2) + row) << 2;
+        uint32_t count = (table_[IndexOf(hash, row)] >> offset) & 0xf;
+        frequency = std::min(frequency, count);
+    }
+    return frequency;
+}
+
+void FrequencySketch::Reset()
+{
+    size_t odd_count = 0;
+    for (auto& word : table_) {
+        odd_count += __builtin_popcountll(word & SKETCH_ONE_MASK);
+        word = (word >> 1) & SKETCH_RESET_MASK;
+    }
+    size_ = (size_ - (odd_count >> 2)) >> 1;
+}
+
+TinyLFUCacheShard::TinyLFUCacheShard()
+    : capacity_(0)
+    , window_capacity_(0)
+    , protected_capacity_(0)
+    , window_ratio_(0.01)
+    , protected_ratio_(0.8)
+    , estimated_entry_charge_(4096)
+    , usage_(0)
+    , lru_usage_(0)
+    , strict_capacity_limit_(false)
+{
+    // Make empty circular linked lists
+    for (int i = 0; i < 3; ++i) {
+        lists_[i].next = &lists_[i];
+        lists_[i].prev = &lists_[i];
+        region_usage_[i] = 0;
+    }
+}
+
+TinyLFUCacheShard::~TinyLFUCacheShard() {}
+
+bool TinyLFUCacheShard::Unref(LRUHandle* e)
+{
+    assert(e->refs > 0);
+    e->refs--;
+    return e->refs == 0;
+}
+
+void TinyLFUCacheShard::List_Remove(LRUHandle* e)
+{
+    assert(e->next != nullptr);
+    assert(e->prev != nullptr);
+    e->next->prev = e->prev;
+    e->prev->next = e->next;
+    e->prev = e->next = nullptr;
+    lru_usage_ -= e->charge;
+}
+
+void TinyLFUCacheShard::List_Insert(LRUHandle* e)
+{
+    assert(e->next == nullptr);
+    assert(e->prev == nullptr);
+    LRUHandle* head = &lists_[GetRegion(e)];
+    e->next = head;
+    e->prev = head->prev;
+    e->prev->next = e;
+    e->next->prev = e;
+    lru_usage_ += e->charge;
+}
+
+void TinyLFUCacheShard::ChangeRegion(LRUHandle* e, Region region)
+{
+    region_usage_[GetRegion(e)] -= e->charge;
+    SetRegion(e, region);
+    region_usage_[region] += e->charge;
+}
+
+void TinyLFUCacheShard::UpdateCapacity()
+{
+    window_capacity_ = capacity_ * window_ratio_;
+    protected_capacity_ = (capacity_ - window_capacity_) * protected_ratio_;
+    sketch_.EnsureCapacity(capacity_ / std::max(estimated_entry_charge_, (size_t)1));
+    MaintainProtectedSize();
+}
+
+void TinyLFUCacheShard::MaintainProtectedSize()
+{
+    while (region_usage_[PROTECTED] > protected_capacity_) {
+        LRUHandle* e = Eldest(PROTECTED);
+        if (e == nullptr) {
+            break;
+        }
+        List_Remove(e);
+        ChangeRegion(e, PROBATION);
+        List_Insert(e);
+    }
+}
+
+void TinyLFUCacheShard::EvictEntry(LRUHandle* e, autovector<LRUHandle*>* deleted)
+{
+    assert(e->InCache());
+    assert(e->refs == 1); // lists contain elements which may be evicted
+    table_.Remove(e->key(), e->hash);
+    e->SetInCache(false);
+    region_usage_[GetRegion(e)] -= e->charge;
+    Unref(e);
+    usage_ -= e->charge;
+    deleted->push_back(e);
+}
+
+void TinyLFUCacheShard::Evict(size_t charge, autovector<LRUHandle*>* deleted)
+{
+    while (usage_ + charge > capacity_ || region_usage_[WINDOW] > window_capacity_) {
+        LRUHandle* candidate = region_usage_[WINDOW] > window_capacity_ ? Eldest(WINDOW) : nullptr;
+        if (candidate != nullptr) {
+            List_Remove(candidate);
+            ChangeRegion(candidate, PROBATION);
+            if (usage_ + charge <= capacity_) {
+                // main region still has room
+                List_Insert(candidate);
+                stat_.admit_count++;
+                continue;
+            }
+            LRUHandle* victim = Eldest(PROBATION);
+            if (victim == nullptr) {
+                victim = Eldest(PROTECTED);
+            }
+            if (victim != nullptr && sketch_.Frequency(candidate->hash) > sketch_.Frequency(victim->hash)) {
+                List_Insert(candidate);
+                List_Remove(victim);
+                EvictEntry(victim, deleted);
+                stat_.admit_count++;
+            } else {
+                EvictEntry(candidate, deleted);
+                stat_.reject_count++;
+            }
+            continue;
+        }
+        if (usage_ + charge <= capacity_) {
+            break;
+        }
+        LRUHandle* e = Eldest(PROBATION);
+        if (e == nullptr) {
+            e = Eldest(PROTECTED);
+        }
+        if (e == nullptr) {
+            e = Eldest(WINDOW);
+        }
+        if (e == nullptr) {
+            break;
+        }
+        List_Remove(e);
+        EvictEntry(e, deleted);
+    }
+}
+
+void TinyLFUCacheShard::EraseUnRefEntries()
+{
+    autovector<LRUHandle*> last_reference_list;
+    {
+        ScopedLock l(mutex_);
+        for (int i = 0; i < 3; ++i) {
+            LRUHandle* e = nullptr;
+            while ((e = Eldest(static_cast<Region>(i))) != nullptr) {
+                List_Remove(e);
+                EvictEntry(e, &last_reference_list);
+            }
+        }
+    }
+
+    for (auto entry : last_reference_list) {
+        entry->Free(allocator_);
+    }
+}
+
+void TinyLFUCacheShard::ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe)
+{
+    if (thread_safe) {
+        int ret = mutex_.lock();
+        assert(ret == 0);
+        (void)ret;
+    }
+    table_.ApplyToAllCacheEntries([callback](LRUHandle* h) { callback(h->value, h->charge); });
+    if (thread_safe) {
+        int ret = mutex_.unlock();
+        assert(ret == 0);
+        (void)ret;
+    }
+}
+
+void TinyLFUCacheShard::SetCapacity(size_t capacity)
+{
+    autovector<LRUHandle*> last_reference_list;
+    {
+        ScopedLock l(mutex_);
+        capacity_ = capacity;
+        UpdateCapacity();
+        Evict(0, &last_reference_list);
+    }
+    // we free the entries here outside of mutex for
+    // performance reasons
+    for (auto entry : last_reference_list) {
+        entry->Free(allocator_);
+    }
+}
+
+void TinyLFUCacheShard::SetStrictCapacityLimit(bool strict_capacity_limit)
+{
+    ScopedLock l(mutex_);
+    strict_capacity_limit_ = strict_capacity_limit;
+}
+
+void TinyLFUCacheShard::SetRegionRatio(double window_ratio, double protected_ratio)
+{
+    ScopedLock l(mutex_);
+    window_ratio_ = window_ratio;
+    protected_ratio_ = protected_ratio;
+    UpdateCapacity();
+}
+
+void TinyLFUCacheShard::SetEstimatedEntryCharge(size_t estimated_entry_charge)
+{
+    ScopedLock l(mutex_);
+    estimated_entry_charge_ = estimated_entry_charge;
+    UpdateCapacity();
+}
+
+void TinyLFUCacheShard::SetAllocator(const CacheAllocatorPtr& allocator)
+{
+    ScopedLock l(mutex_);
+    allocator_ = allocator;
+    table_.SetAllocator(allocator);
+}
+
+CacheBase::Handle* TinyLFUCacheShard::Lookup(const StringView& key, uint32_t hash)
+{
+    ScopedLock l(mutex_);
+    sketch_.Increment(hash);
+    LRUHandle* e = table_.Lookup(key, hash);
+    if (e == nullptr) {
+        stat_.miss_count++;
+        return nullptr;
+    }
+    assert(e->InCache());
+    if (e->refs == 1) {
+        List_Remove(e);
+    }
+    e->refs++;
+    switch (GetRegion(e)) {
+    case WINDOW:
+        stat_.window_hit_count++;
+        break;
+    case PROBATION:
+        // promoted, put on protected list when released
+        stat_.probation_hit_count++;
+        ChangeRegion(e, PROTECTED);
+        MaintainProtectedSize();
+        break;
+    case PROTECTED:
+        stat_.protected_hit_count++;
+        break;
+    }
+    return reinterpret_cast<CacheBase::Handle*>(e);
+}
+
+bool TinyLFUCacheShard::Ref(CacheBase::Handle* h)
+{
+    LRUHandle* handle = reinterpret_cast<LRUHandle*>(h);
+    ScopedLock l(mutex_);
+    if (handle->InCache()) {
+        if (handle->refs == 1) {
+            List_Remove(handle);
+        }
+        handle->refs++;
+        return true;
+    }
+    return false;
+}
+
+void TinyLFUCacheShard::Release(CacheBase::Handle* handle)
+{
+    if (handle == nullptr) {
+        return;
+    }
+    LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
+    bool last_reference = false;
+    {
+        ScopedLock l(mutex_);
+        last_reference = Unref(e);
+        if (last_reference) {
+            usage_ -= e->charge;
+        }
+        if (e->refs == 1 && e->InCache()) {
+            // The item is still in cache, and nobody else holds a reference to it
+            if (usage_ > capacity_) {
+                // the cache is full, all lists are empty, take this opportunity
+                // and remove the item
+                table_.Remove(e->key(), e->hash);
+                e->SetInCache(false);
+                region_usage_[GetRegion(e)] -= e->charge;
+                Unref(e);
+                usage_ -= e->charge;
+                last_reference = true;
+            } else {
+                // put the item on the list to be potentially freed
+                List_Insert(e);
+            }
+        }
+    }
+
+    // free outside of mutex
+    if (last_reference) {
+        e->Free(allocator_);
+    }
+}
+
+bool TinyLFUCacheShard::Insert(const StringView& key, uint32_t hash, void* value, size_t charge,
+                               void (*deleter)(const StringView& key, void* value, const CacheAllocatorPtr& allocator),
+                               CacheBase::Handle** handle, CacheBase::Priority priority)
+{
+#ifndef AIOS_OPEN_SOURCE
+    DisablePoolScope disableScope;
+#endif
+    // Allocate the memory here outside of the mutex
+    // If the cache is full, we'll have to release it
+    // It shouldn't happen very often though.
+    int handle_size = sizeof(LRUHandle) - 1 + key.size();
+    LRUHandle* e = reinterpret_cast<LRUHandle*>(new char[handle_size]);
+    autovector<LRUHandle*> last_reference_list;
+
+    bool s = true;
+
+    e->value = value;
+    e->deleter = deleter;
+    e->charge = charge + handle_size;
+    e->key_length = key.size();
+    e->hash = hash;
+    e->refs = (handle == nullptr ? 1 : 2); // One from cache, one for the returned handle
+    e->next = e->prev = nullptr;
+    e->flags = 0;
+    e->SetInCache(true);
+    e->SetPriority(priority);
+    SetRegion(e, WINDOW);
+    memcpy(e->key_data, key.data(), key.size());
+
+    {
+        ScopedLock l(mutex_);
+        // frequency is only counted on Lookup, an insert after a miss would
+        // count the same access twice
+
+        // Free the space following W-TinyLFU policy until enough space
+        // is freed or all lists are empty
+        Evict(e->charge, &last_reference_list);
+
+        if (usage_ - lru_usage_ + e->charge > capacity_ && (strict_capacity_limit_ || handle == nullptr)) {
+            if (handle == nullptr) {
+                // Don't insert the entry but still return ok, as if the entry inserted
+                // into cache and get evicted immediately.
+                last_reference_list.push_back(e);
+            } else {
+                delete[] reinterpret_cast<char*>(e);
+                *handle = nullptr;
+                s = false;
+            }
+        } else {
+            // insert into the cache
+            // note that the cache might get larger than its capacity if not enough
+            // space was freed
+            LRUHandle* old = table_.Insert(e);
+            usage_ += e->charge;
+            region_usage_[WINDOW] += e->charge;
+            if (old != nullptr) {
+                old->SetInCache(false);
+                region_usage_[GetRegion(old)] -= old->charge;
+                if (Unref(old)) {
+                    usage_ -= old->charge;
+                    // old is on list because it's in cache and its reference count
+                    // was just 1 (Unref returned 0)
+                    List_Remove(old);
+                    last_reference_list.push_back(old);
+                }
+            }
+            if (handle == nullptr) {
+                List_Insert(e);
+            } else {
+                *handle = reinterpret_cast<CacheBase::Handle*>(e);
+            }
+            s = true;
+        }
+    }
+
+    // we free the entries here outside of mutex for
+    // performance reasons
+    for (auto entry : last_reference_list) {
+        entry->Free(allocator_);
+    }
+
+    return s;
+}
+
+void TinyLFUCacheShard::Erase(const StringView& key, uint32_t hash)
+{
+    LRUHandle* e;
+    bool last_reference = false;
+    {
+        ScopedLock l(mutex_);
+        e = table_.Remove(key, hash);
+        if (e != nullptr) {
+            last_reference = Unref(e);
+            if (last_reference) {
+                usage_ -= e->charge;
+            }
+            if (last_reference && e->InCache()) {
+                List_Remove(e);
+            }
+            if (e->InCache()) {
+                region_usage_[GetRegion(e)] -= e->charge;
+            }
+            e->SetInCache(false);
+        }
+    }
+
+    // mutex not held here
+    // last_reference will only be true if e != nullptr
+    if (last_reference) {
+        e->Free(allocator_);
+    }
+}
+
+size_t TinyLFUCacheShard::GetUsage() const
+{
+    ScopedLock l(mutex_);
+    return usage_;
+}
+
+size_t TinyLFUCacheShard::GetPinnedUsage() const
+{
+    ScopedLock l(mutex_);
+    assert(usage_ >= lru_usage_);
+    return usage_ - lru_usage_;
+}
+
+TinyLFUCacheShard::Statistics TinyLFUCacheShard::GetStatistics() const
+{
+    ScopedLock l(mutex_);
+    return stat_;
+}
+
+std::string TinyLFUCacheShard::GetPrintableOptions() const
+{
+    const int kBufferSize = 200;
+    char buffer[kBufferSize];
+    {
+        ScopedLock l(mutex_);
+        snprintf(buffer, kBufferSize, "    window_ratio: %.3lf\n    protected_ratio: %.3lf\n    sketch_width: %lu\n",
+                 window_ratio_, protected_ratio_, sketch_.GetWidth());
+    }
+    return std::string(buffer);
+}
+
+TinyLFUCache::TinyLFUCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit, double window_ratio,
+                           double protected_ratio, size_t estimated_entry_charge, const CacheAllocatorPtr& allocator)
+    : ShardedCache(capacity, num_shard_bits, strict_capacity_limit)
+    , num_shards_(1 << num_shard_bits)
+{
+    shards_ = new TinyLFUCacheShard[num_shards_];
+    for (int i = 0; i < num_shards_; i++) {
+        shards_[i].SetRegionRatio(window_ratio, protected_ratio);
+        shards_[i].SetEstimatedEntryCharge(estimated_entry_charge);
+        shards_[i].SetAllocator(allocator);
+    }
+    SetCapacity(capacity);
+    SetStrictCapacityLimit(strict_capacity_limit);
+}
+
+TinyLFUCache::~TinyLFUCache() { delete[] shards_; }
+
+CacheShard* TinyLFUCache::GetShard(int shard) { return reinterpret_cast<CacheShard*>(&shards_[shard]); }
+
+const CacheShard* TinyLFUCache::GetShard(int shard) const { return reinterpret_cast<CacheShard*>(&shards_[shard]); }
+
+void* TinyLFUCache::Value(Handle* handle) { return reinterpret_cast<const LRUHandle*>(handle)->value; }
+
+size_t TinyLFUCache::GetCharge(Handle* handle) const { return reinterpret_cast<const LRUHandle*>(handle)->charge; }
+
+uint32_t TinyLFUCache::GetHash(Handle* handle) const { return reinterpret_cast<const LRUHandle*>(handle)->hash; }
+
+void TinyLFUCache::DisownData() { shards_ = nullptr; }
+
+TinyLFUCacheShard::Statistics TinyLFUCache::GetStatistics() const
+{
+    TinyLFUCacheShard::Statistics stat;
+    if (shards_ == nullptr) {
+        return stat;
+    }
+    for (int i = 0; i < num_shards_; i++) {
+        stat.Merge(shards_[i].GetStatistics());
+    }
+    return stat;
+}
+
+std::shared_ptr<CacheBase> NewTinyLFUCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit,
+                                           double window_ratio, double protected_ratio, size_t estimated_entry_charge,
+                                           const CacheAllocatorPtr& allocator)
+{
+    if (num_shard_bits >= 20) {
+        return nullptr; // the cache cannot be sharded into too many fine pieces
+    }
+    if (window_ratio < 0.0 || window_ratio > 1.0 || protected_ratio < 0.0 || protected_ratio > 1.0) {
+        return nullptr;
+    }
+    return std::make_shared<TinyLFUCache>(capacity, num_shard_bits, strict_capacity_limit, window_ratio,
+                                          protected_ratio, estimated_entry_charge, allocator);
+}
+
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "autil/Autovector.h"
+#include "autil/Lock.h"
+#include "autil/cache/cache.h"
+#include "autil/cache/cache_allocator.h"
+#include "autil/cache/lru_cache.h"
+#include "autil/cache/sharded_cache.h"
+
+namespace autil {
+
+// W-TinyLFU cache implementation
+//
+// Each shard is split into three LRU lists:
+// 1. window: small admission window, every new entry goes here first.
+// 2. probation: main region entries which are not hit since admitted.
+// 3. protected: main region entries hit at least once in probation.
+//
+// When the window overflows, its eldest entry becomes a candidate for the
+// main region. If the main region is full, the candidate is only admitted
+// when its estimated access frequency is larger than the eldest probation
+// entry (the victim), otherwise the candidate itself is evicted. Frequencies
+// are estimated by a count-min sketch with 4-bit counters, which are halved
+// periodically so that stale popularity fades away. So a one-pass scan only
+// churns the window and never flushes the hot working set.
+//
+// Entries referenced externally are not on any list (same as LRUCacheShard),
+// they are put back to the list of their region when released.
+
+// Frequency sketch with 4 rows of 4-bit counters, 16 counters per word.
+class FrequencySketch
+{
+public:
+    FrequencySketch();
+    ~FrequencySketch();
+
+public:
+    // sketch is sized to hold about maximum_size distinct keys
+    void EnsureCapacity(size_t maximum_size);
+    void Increment(uint32_t hash);
+    uint32_t Frequency(uint32_t hash) const;
+    size_t GetWidth() const { return table_.size(); }
+
+private:
+    size_t IndexOf(uint32_t hash, int row) const;
+    bool IncrementAt(size_t index, int row, uint32_t hash);
+    void Reset();
+
+private:
+    std::vector<uint64_t> table_;
+    size_t table_mask_;
+    size_t sample_size_;
+    size_t size_;
+};
+
+// A single shard of sharded W-TinyLFU cache.
+class TinyLFUCacheShard : public CacheShard
+{
+public:
+    enum Region { WINDOW = 0, PROBATION = 1, PROTECTED = 2 };
+
+    struct Statistics {
+        uint64_t window_hit_count = 0;
+        uint64_t probation_hit_count = 0;
+        uint64_t protected_hit_count = 0;
+        uint64_t miss_count = 0;
+        uint64_t admit_count = 0;
+        uint64_t reject_count = 0;
+
+        void Merge(const Statistics& other)
+        {
+            window_hit_count += other.window_hit_count;
+            probation_hit_count += other.probation_hit_count;
+            protected_hit_count += other.protected_hit_count;
+            miss_count += other.miss_count;
+            admit_count += other.admit_count;
+            reject_count += other.reject_count;
+        }
+    };
+
+public:
+    TinyLFUCacheShard();
+    virtual ~TinyLFUCacheShard();
+
+    virtual void SetCapacity(size_t capacity) override;
+    virtual void SetStrictCapacityLimit(bool strict_capacity_limit) override;
+
+    // Set percentage of capacity used as admission window, and percentage of
+    // main region reserved for protected entries.
+    void SetRegionRatio(double window_ratio, double protected_ratio);
+    // Expected charge of one entry, used to size the frequency sketch.
+    void SetEstimatedEntryCharge(size_t estimated_entry_charge);
+    void SetAllocator(const CacheAllocatorPtr& allocator);
+
+    virtual bool Insert(const autil::StringView& key, uint32_t hash, void* value, size_t charge,
+                        void (*deleter)(const autil::StringView& key, void* value,
+                                const CacheAllocatorPtr& allocator),
+                        CacheBase::Handle** handle, CacheBase::Priority priority) override;
+    virtual CacheBase::Handle* Lookup(const autil::StringView& key, uint32_t hash) override;
+    virtual bool Ref(CacheBase::Handle* handle) override;
+    virtual void Release(CacheBase::Handle* handle) override;
+    virtual void Erase(const autil::StringView& key, uint32_t hash) override;
+
+    virtual size_t GetUsage() const override;
+    virtual size_t GetPinnedUsage() const override;
+
+    virtual void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override;
+
+    virtual void EraseUnRefEntries() override;
+
+    virtual std::string GetPrintableOptions() const override;
+
+    Statistics GetStatistics() const;
+
+private:
+    static Region GetRegion(const LRUHandle* e) { return static_cast<Region>((e->flags >> 3) & 3); }
+    static void SetRegion(LRUHandle* e, Region region)
+    {
+        e->flags = static_cast<char>((e->flags & ~(3 << 3)) | (region << 3));
+    }
+
+    void List_Remove(LRUHandle* e);
+    // insert "e" to MRU end of list of its region
+    void List_Insert(LRUHandle* e);
+    void ChangeRegion(LRUHandle* e, Region region);
+    void UpdateCapacity();
+
+    // Demote eldest protected entries to probation until protected region
+    // fits in its capacity.
+    void MaintainProtectedSize();
+
+    // Move overflowed window entries to main region, evict candidates or
+    // victims by frequency, until enough space to hold (usage_ + charge)
+    // is freed or all lists are empty.
+    // This function is not thread safe - it needs to be executed while
+    // holding the mutex_
+    void Evict(size_t charge, autovector<LRUHandle*>* deleted);
+    void EvictEntry(LRUHandle* e, autovector<LRUHandle*>* deleted);
+    LRUHandle* Eldest(Region region)
+    {
+        LRUHandle* head = &lists_[region];
+        return head->next == head ? nullptr : head->next;
+    }
+
+    bool Unref(LRUHandle* e);
+
+    size_t capacity_;
+    size_t window_capacity_;
+    size_t protected_capacity_;
+    double window_ratio_;
+    double protected_ratio_;
+    size_t estimated_entry_charge_;
+
+    // Memory size for entries residing in the cache
+    size_t usage_;
+    // Memory size for entries residing on lists
+    size_t lru_usage_;
+    // Memory size for entries of each region, both on list and pinned
+    size_t region_usage_[3];
+
+    bool strict_capacity_limit_;
+
+    mutable autil::ThreadMutex mutex_;
+
+    // Dummy heads of lists, head.prev is newest entry, head.next is eldest.
+    LRUHandle lists_[3];
+
+    LRUHandleTable table_;
+    FrequencySketch sketch_;
+    Statistics stat_;
+
+    CacheAllocatorPtr allocator_;
+};
+
+class TinyLFUCache : public ShardedCache
+{
+public:
+    TinyLFUCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit, double window_ratio,
+                 double protected_ratio, size_t estimated_entry_charge, const CacheAllocatorPtr& allocator);
+    virtual ~TinyLFUCache();
+    virtual const char* Name() const override { return "TinyLFUCache"; }
+    virtual CacheShard* GetShard(int shard) override;
+    virtual const CacheShard* GetShard(int shard) const override;
+    virtual void* Value(Handle* handle) override;
+    virtual size_t GetCharge(Handle* handle) const override;
+    virtual uint32_t GetHash(Handle* handle) const override;
+    virtual void DisownData() override;
+
+    TinyLFUCacheShard::Statistics GetStatistics() const;
+
+private:
+    int num_shards_;
+    TinyLFUCacheShard* shards_;
+};
+
+}
@@ -20,7 +20,10 @@
 #include "expression/framework/AttributeExpressionTyped.h"
 #include "expression/framework/TypeInfo.h"
 #include "expression/framework/TypeTraits.h"
+#include "expression/framework/VectorizedBinaryOperator.h"
 #include "autil/MultiValueType.h"
+#include <algorithm>
+#include <type_traits>
 
 namespace expression {
 
@@ -113,6 +116,8 @@ class BinaryAttributeExpression : public AttributeExpressionTyped<ResultType>
 public:
     typedef AttributeExpressionTyped<LeftArgType> LeftAttrExpr;
     typedef AttributeExpressionTyped<RightArgType> RightAttrExpr;
+    typedef VectorizedBinaryOperator<BinaryOperatorType, LeftArgType,
+                                     RightArgType, ResultType> VectorizedOperator;
 public:
     BinaryAttributeExpression(
             const std::string &exprStr,
@@ -139,9 +144,8 @@ public:
     }
 
     /* override */ void batchEvaluate(matchdoc::MatchDoc *matchDocs, uint32_t docCount) {
-        for (uint32_t i = 0; i < docCount; i++) {
-            innerEvaluate(matchDocs[i]);
-        }
+        doBatchEvaluate(matchDocs, docCount,
+                        std::integral_constant<bool, VectorizedOperator::supported>());
     }
 
     /* override */ matchdoc::ReferenceBase* getReferenceBase() const {
@@ -155,6 +159,36 @@ private:
         this->storeValue(matchDoc, result);
     }
 
+    void doBatchEvaluate(matchdoc::MatchDoc *matchDocs, uint32_t docCount,
+                         std::false_type)
+    {
+        for (uint32_t i = 0; i < docCount; i++) {
+            innerEvaluate(matchDocs[i]);
+        }
+    }
+
+    // gather operands into contiguous buffers, evaluate chunk at a time
+    // with vectorized operator, then scatter results back to match docs
+    void doBatchEvaluate(matchdoc::MatchDoc *matchDocs, uint32_t docCount,
+                         std::true_type)
+    {
+        LeftArgType leftValues[vectorized::BATCH_SIZE];
+        RightArgType rightValues[vectorized::BATCH_SIZE];
+        ResultType results[vectorized::BATCH_SIZE];
+        for (uint32_t begin = 0; begin < docCount; begin += vectorized::BATCH_SIZE) {
+            const matchdoc::MatchDoc *docs = matchDocs + begin;
+            uint32_t count = std::min(vectorized::BATCH_SIZE, docCount - begin);
+            for (uint32_t i = 0; i < count; i++) {
+                leftValues[i] = _leftExpr->getValue(docs[i]);
+                rightValues[i] = _rightExpr->getValue(docs[i]);
+            }
+            VectorizedOperator::apply(leftValues, rightValues, results, count);
+            for (uint32_t i = 0; i < count; i++) {
+                this->storeValue(docs[i], results[i]);
+            }
+        }
+    }
+
 private:
     LeftAttrExpr *_leftExpr;
     RightAttrExpr *_rightExpr;
@@ -0,0 +1,222 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "expression/framework/VectorizedBinaryOperator.h"
+#include <string.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace expression {
+namespace vectorized {
+
+static_assert(sizeof(bool) == 1, "vectorized logical kernels require one byte bool");
+
+#define SCALAR_LOOP(begin, SCALAR_EXPR)                                 \
+    for (uint32_t i = begin; i < count; i++) {                          \
+        result[i] = SCALAR_EXPR;                                        \
+    }
+
+// scalar form of kernels, also used for tail elements of AVX2 kernels
+#define ADD_EXPR (lhs[i] + rhs[i])
+#define SUB_EXPR (lhs[i] - rhs[i])
+#define MUL_EXPR (lhs[i] * rhs[i])
+#define DIV_EXPR (rhs[i] == 0 ? 0 : lhs[i] / rhs[i])
+#define LESS_EXPR (lhs[i] < rhs[i])
+#define GREATER_EXPR (lhs[i] > rhs[i])
+#define EQUAL_EXPR (lhs[i] == rhs[i])
+#define AND_EXPR (lhs[i] && rhs[i])
+#define OR_EXPR (lhs[i] || rhs[i])
+
+#if defined(__x86_64__)
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+bool supportAvx2() {
+    static const bool avx2 = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return avx2;
+}
+
+// expand compare mask bits to 0/1 bytes, entry i holds 8 bools of mask i
+struct MaskTable {
+    MaskTable() {
+        for (uint32_t mask = 0; mask < 256; mask++) {
+            for (uint32_t bit = 0; bit < 8; bit++) {
+                bools[mask][bit] = (mask >> bit) & 1;
+            }
+        }
+    }
+    uint8_t bools[256][8];
+};
+static const MaskTable maskTable;
+
+static inline void storeMask(bool *result, uint32_t mask, uint32_t width) {
+    memcpy(result, maskTable.bools[mask], width);
+}
+
+AVX2_TARGET static inline __m256i loadInt(const void *p) {
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+AVX2_TARGET static inline void storeInt(void *p, __m256i v) {
+    _mm256_storeu_si256((__m256i *)p, v);
+}
+AVX2_TARGET static inline uint32_t maskInt32(__m256i v) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(v));
+}
+AVX2_TARGET static inline uint32_t maskInt64(__m256i v) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(v));
+}
+AVX2_TARGET static inline __m256 divFloat(__m256 l, __m256 r) {
+    __m256 zero = _mm256_cmp_ps(r, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    return _mm256_andnot_ps(zero, _mm256_div_ps(l, r));
+}
+AVX2_TARGET static inline __m256d divDouble(__m256d l, __m256d r) {
+    __m256d zero = _mm256_cmp_pd(r, _mm256_setzero_pd(), _CMP_EQ_OQ);
+    return _mm256_andnot_pd(zero, _mm256_div_pd(l, r));
+}
+
+// l and r are the loaded lanes in VECTOR_EXPR, lhs[i] and rhs[i] the tail
+// elements in SCALAR_EXPR
+#define AVX2_ARITHMETIC_KERNEL(name, T, WIDTH, LOAD, STORE, VECTOR_EXPR, SCALAR_EXPR) \
+    AVX2_TARGET static void name(const T *lhs, const T *rhs, T *result, uint32_t count) { \
+        uint32_t begin = 0;                                             \
+        for (; begin + WIDTH <= count; begin += WIDTH) {                \
+            auto l = LOAD(lhs + begin);                                 \
+            auto r = LOAD(rhs + begin);                                 \
+            STORE(result + begin, VECTOR_EXPR);                         \
+        }                                                               \
+        SCALAR_LOOP(begin, SCALAR_EXPR);                                \
+    }
+
+#define AVX2_COMPARE_KERNEL(name, T, WIDTH, LOAD, MASK_EXPR, SCALAR_EXPR) \
+    AVX2_TARGET static void name(const T *lhs, const T *rhs, bool *result, uint32_t count) { \
+        uint32_t begin = 0;                                             \
+        for (; begin + WIDTH <= count; begin += WIDTH) {                \
+            auto l = LOAD(lhs + begin);                                 \
+            auto r = LOAD(rhs + begin);                                 \
+            storeMask(result + begin, MASK_EXPR, WIDTH);                \
+        }                                                               \
+        SCALAR_LOOP(begin, SCALAR_EXPR);                                \
+    }
+
+AVX2_ARITHMETIC_KERNEL(addAvx2, int32_t, 8, loadInt, storeInt, _mm256_add_epi32(l, r), ADD_EXPR)
+AVX2_ARITHMETIC_KERNEL(addAvx2, int64_t, 4, loadInt, storeInt, _mm256_add_epi64(l, r), ADD_EXPR)
+AVX2_ARITHMETIC_KERNEL(addAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps(l, r), ADD_EXPR)
+AVX2_ARITHMETIC_KERNEL(addAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd(l, r), ADD_EXPR)
+AVX2_ARITHMETIC_KERNEL(subAvx2, int32_t, 8, loadInt, storeInt, _mm256_sub_epi32(l, r), SUB_EXPR)
+AVX2_ARITHMETIC_KERNEL(subAvx2, int64_t, 4, loadInt, storeInt, _mm256_sub_epi64(l, r), SUB_EXPR)
+AVX2_ARITHMETIC_KERNEL(subAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_sub_ps(l, r), SUB_EXPR)
+AVX2_ARITHMETIC_KERNEL(subAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_sub_pd(l, r), SUB_EXPR)
+AVX2_ARITHMETIC_KERNEL(mulAvx2, int32_t, 8, loadInt, storeInt, _mm256_mullo_epi32(l, r), MUL_EXPR)
+AVX2_ARITHMETIC_KERNEL(mulAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_mul_ps(l, r), MUL_EXPR)
+AVX2_ARITHMETIC_KERNEL(mulAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd(l, r), MUL_EXPR)
+AVX2_ARITHMETIC_KERNEL(divAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, divFloat(l, r), DIV_EXPR)
+AVX2_ARITHMETIC_KERNEL(divAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, divDouble(l, r), DIV_EXPR)
+
+AVX2_COMPARE_KERNEL(lessAvx2, int32_t, 8, loadInt, maskInt32(_mm256_cmpgt_epi32(r, l)), LESS_EXPR)
+AVX2_COMPARE_KERNEL(lessAvx2, int64_t, 4, loadInt, maskInt64(_mm256_cmpgt_epi64(r, l)), LESS_EXPR)
+AVX2_COMPARE_KERNEL(lessAvx2, float, 8, _mm256_loadu_ps,
+                    _mm256_movemask_ps(_mm256_cmp_ps(l, r, _CMP_LT_OQ)), LESS_EXPR)
+AVX2_COMPARE_KERNEL(lessAvx2, double, 4, _mm256_loadu_pd,
+                    _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_LT_OQ)), LESS_EXPR)
+AVX2_COMPARE_KERNEL(greaterAvx2, int32_t, 8, loadInt, maskInt32(_mm256_cmpgt_epi32(l, r)), GREATER_EXPR)
+AVX2_COMPARE_KERNEL(greaterAvx2, int64_t, 4, loadInt, maskInt64(_mm256_cmpgt_epi64(l, r)), GREATER_EXPR)
+AVX2_COMPARE_KERNEL(greaterAvx2, float, 8, _mm256_loadu_ps,
+                    _mm256_movemask_ps(_mm256_cmp_ps(l, r, _CMP_GT_OQ)), GREATER_EXPR)
+AVX2_COMPARE_KERNEL(greaterAvx2, double, 4, _mm256_loadu_pd,
+                    _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_GT_OQ)), GREATER_EXPR)
+AVX2_COMPARE_KERNEL(equalAvx2, int32_t, 8, loadInt, maskInt32(_mm256_cmpeq_epi32(l, r)), EQUAL_EXPR)
+AVX2_COMPARE_KERNEL(equalAvx2, int64_t, 4, loadInt, maskInt64(_mm256_cmpeq_epi64(l, r)), EQUAL_EXPR)
+AVX2_COMPARE_KERNEL(equalAvx2, float, 8, _mm256_loadu_ps,
+                    _mm256_movemask_ps(_mm256_cmp_ps(l, r, _CMP_EQ_OQ)), EQUAL_EXPR)
+AVX2_COMPARE_KERNEL(equalAvx2, double, 4, _mm256_loadu_pd,
+                    _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_EQ_OQ)), EQUAL_EXPR)
+
+// bool is stored as 0/1 byte, so bitwise and/or of bytes is logical and/or
+AVX2_ARITHMETIC_KERNEL(logicalAndAvx2, bool, 32, loadInt, storeInt, _mm256_and_si256(l, r), AND_EXPR)
+AVX2_ARITHMETIC_KERNEL(logicalOrAvx2, bool, 32, loadInt, storeInt, _mm256_or_si256(l, r), OR_EXPR)
+
+#undef AVX2_ARITHMETIC_KERNEL
+#undef AVX2_COMPARE_KERNEL
+
+#define DEFINE_VECTORIZED_KERNEL(name, T, R, SCALAR_EXPR)               \
+    void name(const T *lhs, const T *rhs, R *result, uint32_t count) {  \
+        if (supportAvx2()) {                                            \
+            name##Avx2(lhs, rhs, result, count);                        \
+            return;                                                     \
+        }                                                               \
+        SCALAR_LOOP(0, SCALAR_EXPR);                                    \
+    }
+
+#undef AVX2_TARGET
+
+#else
+
+bool supportAvx2() {
+    return false;
+}
+
+#define DEFINE_VECTORIZED_KERNEL(name, T, R, SCALAR_EXPR)               \
+    void name(const T *lhs, const T *rhs, R *result, uint32_t count) {  \
+        SCALAR_LOOP(0, SCALAR_EXPR);                                    \
+    }
+
+#endif
+
+DEFINE_VECTORIZED_KERNEL(add, int32_t, int32_t, ADD_EXPR)
+DEFINE_VECTORIZED_KERNEL(add, int64_t, int64_t, ADD_EXPR)
+DEFINE_VECTORIZED_KERNEL(add, float, float, ADD_EXPR)
+DEFINE_VECTORIZED_KERNEL(add, double, double, ADD_EXPR)
+DEFINE_VECTORIZED_KERNEL(sub, int32_t, int32_t, SUB_EXPR)
+DEFINE_VECTORIZED_KERNEL(sub, int64_t, int64_t, SUB_EXPR)
+DEFINE_VECTORIZED_KERNEL(sub, float, float, SUB_EXPR)
+DEFINE_VECTORIZED_KERNEL(sub, double, double, SUB_EXPR)
+DEFINE_VECTORIZED_KERNEL(mul, int32_t, int32_t, MUL_EXPR)
+DEFINE_VECTORIZED_KERNEL(mul, float, float, MUL_EXPR)
+DEFINE_VECTORIZED_KERNEL(mul, double, double, MUL_EXPR)
+DEFINE_VECTORIZED_KERNEL(div, float, float, DIV_EXPR)
+DEFINE_VECTORIZED_KERNEL(div, double, double, DIV_EXPR)
+DEFINE_VECTORIZED_KERNEL(less, int32_t, bool, LESS_EXPR)
+DEFINE_VECTORIZED_KERNEL(less, int64_t, bool, LESS_EXPR)
+DEFINE_VECTORIZED_KERNEL(less, float, bool, LESS_EXPR)
+DEFINE_VECTORIZED_KERNEL(less, double, bool, LESS_EXPR)
+DEFINE_VECTORIZED_KERNEL(greater, int32_t, bool, GREATER_EXPR)
+DEFINE_VECTORIZED_KERNEL(greater, int64_t, bool, GREATER_EXPR)
+DEFINE_VECTORIZED_KERNEL(greater, float, bool, GREATER_EXPR)
+DEFINE_VECTORIZED_KERNEL(greater, double, bool, GREATER_EXPR)
+DEFINE_VECTORIZED_KERNEL(equal, int32_t, bool, EQUAL_EXPR)
+DEFINE_VECTORIZED_KERNEL(equal, int64_t, bool, EQUAL_EXPR)
+DEFINE_VECTORIZED_KERNEL(equal, float, bool, EQUAL_EXPR)
+DEFINE_VECTORIZED_KERNEL(equal, double, bool, EQUAL_EXPR)
+DEFINE_VECTORIZED_KERNEL(logicalAnd, bool, bool, AND_EXPR)
+DEFINE_VECTORIZED_KERNEL(logicalOr, bool, bool, OR_EXPR)
+
+#undef DEFINE_VECTORIZED_KERNEL
+#undef SCALAR_LOOP
+#undef ADD_EXPR
+#undef SUB_EXPR
+#undef MUL_EXPR
+#undef DIV_EXPR
+#undef LESS_EXPR
+#undef GREATER_EXPR
+#undef EQUAL_EXPR
+#undef AND_EXPR
+#undef OR_EXPR
+
+}
+}
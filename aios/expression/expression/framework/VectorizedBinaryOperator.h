@@ -0,0 +1,133 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ISEARCH_EXPRESSION_VECTORIZEDBINARYOPERATOR_H
+#define ISEARCH_EXPRESSION_VECTORIZEDBINARYOPERATOR_H
+
+#include <stdint.h>
+#include <functional>
+#include <type_traits>
+
+namespace expression {
+
+template<typename T>
+struct divides;
+
+// column-at-a-time kernels over contiguous operand buffers, use AVX2 when
+// cpu supports it and fall back to scalar loop otherwise
+namespace vectorized {
+
+// operands of BinaryAttributeExpression::batchEvaluate are gathered in
+// chunks of BATCH_SIZE docs
+static const uint32_t BATCH_SIZE = 256;
+
+bool supportAvx2();
+
+#define DECLARE_VECTORIZED_KERNEL(name, T, R)                           \
+    void name(const T *lhs, const T *rhs, R *result, uint32_t count)
+
+DECLARE_VECTORIZED_KERNEL(add, int32_t, int32_t);
+DECLARE_VECTORIZED_KERNEL(add, int64_t, int64_t);
+DECLARE_VECTORIZED_KERNEL(add, float, float);
+DECLARE_VECTORIZED_KERNEL(add, double, double);
+DECLARE_VECTORIZED_KERNEL(sub, int32_t, int32_t);
+DECLARE_VECTORIZED_KERNEL(sub, int64_t, int64_t);
+DECLARE_VECTORIZED_KERNEL(sub, float, float);
+DECLARE_VECTORIZED_KERNEL(sub, double, double);
+DECLARE_VECTORIZED_KERNEL(mul, int32_t, int32_t);
+DECLARE_VECTORIZED_KERNEL(mul, float, float);
+DECLARE_VECTORIZED_KERNEL(mul, double, double);
+DECLARE_VECTORIZED_KERNEL(div, float, float);
+DECLARE_VECTORIZED_KERNEL(div, double, double);
+DECLARE_VECTORIZED_KERNEL(less, int32_t, bool);
+DECLARE_VECTORIZED_KERNEL(less, int64_t, bool);
+DECLARE_VECTORIZED_KERNEL(less, float, bool);
+DECLARE_VECTORIZED_KERNEL(less, double, bool);
+DECLARE_VECTORIZED_KERNEL(greater, int32_t, bool);
+DECLARE_VECTORIZED_KERNEL(greater, int64_t, bool);
+DECLARE_VECTORIZED_KERNEL(greater, float, bool);
+DECLARE_VECTORIZED_KERNEL(greater, double, bool);
+DECLARE_VECTORIZED_KERNEL(equal, int32_t, bool);
+DECLARE_VECTORIZED_KERNEL(equal, int64_t, bool);
+DECLARE_VECTORIZED_KERNEL(equal, float, bool);
+DECLARE_VECTORIZED_KERNEL(equal, double, bool);
+DECLARE_VECTORIZED_KERNEL(logicalAnd, bool, bool);
+DECLARE_VECTORIZED_KERNEL(logicalOr, bool, bool);
+
+#undef DECLARE_VECTORIZED_KERNEL
+
+}
+
+// batch form of BinaryOperatorType, plain loop for single value arithmetic
+// types and not supported for others (strings, multi values)
+template<template<class T> class BinaryOperatorType,
+         typename LeftArgType, typename RightArgType, typename ResultType>
+struct VectorizedBinaryOperator {
+    static const bool supported = std::is_arithmetic<LeftArgType>::value
+                                  && std::is_same<LeftArgType, RightArgType>::value
+                                  && std::is_arithmetic<ResultType>::value;
+
+    static void apply(const LeftArgType *lhs, const RightArgType *rhs,
+                      ResultType *result, uint32_t count)
+    {
+        BinaryOperatorType<LeftArgType> binaryOperator;
+        for (uint32_t i = 0; i < count; i++) {
+            result[i] = binaryOperator(lhs[i], rhs[i]);
+        }
+    }
+};
+
+#define VECTORIZED_BINARY_OPERATOR(op, T, R, kernel)                    \
+    template<>                                                          \
+    struct VectorizedBinaryOperator<op, T, T, R> {                      \
+        static const bool supported = true;                             \
+        static void apply(const T *lhs, const T *rhs, R *result, uint32_t count) { \
+            vectorized::kernel(lhs, rhs, result, count);                \
+        }                                                               \
+    }
+
+VECTORIZED_BINARY_OPERATOR(std::plus, int32_t, int32_t, add);
+VECTORIZED_BINARY_OPERATOR(std::plus, int64_t, int64_t, add);
+VECTORIZED_BINARY_OPERATOR(std::plus, float, float, add);
+VECTORIZED_BINARY_OPERATOR(std::plus, double, double, add);
+VECTORIZED_BINARY_OPERATOR(std::minus, int32_t, int32_t, sub);
+VECTORIZED_BINARY_OPERATOR(std::minus, int64_t, int64_t, sub);
+VECTORIZED_BINARY_OPERATOR(std::minus, float, float, sub);
+VECTORIZED_BINARY_OPERATOR(std::minus, double, double, sub);
+VECTORIZED_BINARY_OPERATOR(std::multiplies, int32_t, int32_t, mul);
+VECTORIZED_BINARY_OPERATOR(std::multiplies, float, float, mul);
+VECTORIZED_BINARY_OPERATOR(std::multiplies, double, double, mul);
+VECTORIZED_BINARY_OPERATOR(divides, float, float, div);
+VECTORIZED_BINARY_OPERATOR(divides, double, double, div);
+VECTORIZED_BINARY_OPERATOR(std::less, int32_t, bool, less);
+VECTORIZED_BINARY_OPERATOR(std::less, int64_t, bool, less);
+VECTORIZED_BINARY_OPERATOR(std::less, float, bool, less);
+VECTORIZED_BINARY_OPERATOR(std::less, double, bool, less);
+VECTORIZED_BINARY_OPERATOR(std::greater, int32_t, bool, greater);
+VECTORIZED_BINARY_OPERATOR(std::greater, int64_t, bool, greater);
+VECTORIZED_BINARY_OPERATOR(std::greater, float, bool, greater);
+VECTORIZED_BINARY_OPERATOR(std::greater, double, bool, greater);
+VECTORIZED_BINARY_OPERATOR(std::equal_to, int32_t, bool, equal);
+VECTORIZED_BINARY_OPERATOR(std::equal_to, int64_t, bool, equal);
+VECTORIZED_BINARY_OPERATOR(std::equal_to, float, bool, equal);
+VECTORIZED_BINARY_OPERATOR(std::equal_to, double, bool, equal);
+VECTORIZED_BINARY_OPERATOR(std::logical_and, bool, bool, logicalAnd);
+VECTORIZED_BINARY_OPERATOR(std::logical_or, bool, bool, logicalOr);
+
+#undef VECTORIZED_BINARY_OPERATOR
+
+}
+
+#endif //ISEARCH_EXPRESSION_VECTORIZEDBINARYOPERATOR_H
@@ -18,7 +18,11 @@
 #include "fslib/fs/local/LocalFile.h"
 #include "fslib/fs/local/LocalFileSystem.h"
 #include "fslib/util/LongIntervalLog.h"
-#include <aio.h>
+#include "fslib/util/EnvUtil.h"
+#if (__cplusplus >= 201703L)
+#include "future_lite/Executor.h"
+#include "future_lite/IOExecutor.h"
+#endif
 #include <fcntl.h>
 
 #include <iostream>
@@ -29,6 +33,12 @@ using namespace std;
 FSLIB_BEGIN_NAMESPACE(fs);
 AUTIL_DECLARE_AND_SETUP_LOGGER(fs, LocalFile);
 
+// buffered local file reads synchronously in coroutine by default, set it to submit
+// reads to io executor (e.g. io_uring) of caller's executor
+bool LocalFile::_asyncCoroRead = []() -> bool {
+    return util::EnvUtil::GetEnv<int>("FSLIB_LOCAL_FILE_ASYNC_CORO_READ", 0);
+}();
+
 LocalFile::LocalFile(const string& fileName, FILE* file, ErrorCode ec)
     : File(fileName, ec)
     ,_file(file)
@@ -149,62 +159,47 @@ ssize_t LocalFile::pread(void* buffer, size_t length, off_t offset) {
     return off;
 }
 
-namespace
-{
-
 #if (__cplusplus >= 201703L)
-struct AioSigval
+void LocalFile::pread(IOController* controller, void* buffer, size_t length, off_t offset,
+                      std::function<void()> callback)
 {
-    aiocb aioCb;
-    IOController* controller;
-    std::function<void()> callback;
-
-    AioSigval(IOController *IOController)
-        : controller(IOController)
-    {
-        bzero((char*)&aioCb, sizeof(aioCb));
+    if (!_asyncCoroRead || NULL == _file || !controller->getExecutor() ||
+        !controller->getExecutor()->getIOExecutor()) {
+        return File::pread(controller, buffer, length, offset, std::move(callback));
     }
-};
-#endif
+    controller->getExecutor()->getIOExecutor()->submitIO(
+        fileno(_file), future_lite::IOCB_CMD_PREAD, buffer, length, offset,
+        [controller, callback = std::move(callback)](int32_t res) mutable {
+            if ((signed long)(res) < 0) {
+                controller->setErrorCode(LocalFileSystem::convertErrno(-(signed long)(res)));
+            } else {
+                controller->setIoSize(res);
+                controller->setErrorCode(EC_OK);
+            }
+            callback();
+        });
 }
 
-// void LocalFile::pread(IOController* controller, void* buffer, size_t length, off_t offset,
-//                       std::function<void()> callback)
-// {
-//     File::pread(controller, buffer, length, offset, callback);
-//     FIXME: use kernel native AIO
-//     auto aioSigval = new AioSigval(controller);
-//     aioSigval->callback = callback;
-//     aioSigval->aioCb.aio_buf = buffer;
-//     aioSigval->aioCb.aio_fildes = fileno(_file);
-//     aioSigval->aioCb.aio_nbytes = length;
-//     aioSigval->aioCb.aio_offset = offset;
-//     aioSigval->aioCb.aio_sigevent.sigev_notify = SIGEV_THREAD;
-
-//     aioSigval->aioCb.aio_sigevent.sigev_notify_function = [](sigval_t sigval) {
-//         auto aioSigval = static_cast<AioSigval*>(sigval.sival_ptr);
-//         if (aio_error(&(aioSigval->aioCb)) == 0) {
-//             auto ret = aio_return(&(aioSigval->aioCb));
-//             if (ret < 0) {
-//                 aioSigval->controller->setErrorCode(LocalFileSystem::convertErrno(errno));
-//             } else {
-//                 aioSigval->controller->setErrorCode(EC_OK);
-//                 aioSigval->controller->setIoSize(ret);
-//             }
-//         } else {
-//             aioSigval->controller->setErrorCode(LocalFileSystem::convertErrno(errno));
-//         }
-//         aioSigval->callback();
-//         delete aioSigval;
-//     };
-
-//     aioSigval->aioCb.aio_sigevent.sigev_notify_attributes = nullptr;
-//     aioSigval->aioCb.aio_sigevent.sigev_value.sival_ptr = aioSigval;
-//     if (aio_read(&(aioSigval->aioCb)) < 0) {
-//         controller->setErrorCode(LocalFileSystem::convertErrno(errno));
-//         callback();
-//     }
-// }
+void LocalFile::preadv(IOController* controller, const iovec* iov, int iovcnt, off_t offset,
+                       std::function<void()> callback)
+{
+    if (!_asyncCoroRead || NULL == _file || !controller->getExecutor() ||
+        !controller->getExecutor()->getIOExecutor()) {
+        return File::preadv(controller, iov, iovcnt, offset, std::move(callback));
+    }
+    controller->getExecutor()->getIOExecutor()->submitIOV(
+        fileno(_file), future_lite::IOCB_CMD_PREADV, iov, iovcnt, offset,
+        [controller, callback = std::move(callback)](int32_t res) mutable {
+            if ((signed long)(res) < 0) {
+                controller->setErrorCode(LocalFileSystem::convertErrno(-(signed long)(res)));
+            } else {
+                controller->setIoSize(res);
+                controller->setErrorCode(EC_OK);
+            }
+            callback();
+        });
+}
+#endif
 
 ssize_t LocalFile::preadv(const iovec* iov, int iovcnt, off_t offset) {
     if (NULL == _file) {
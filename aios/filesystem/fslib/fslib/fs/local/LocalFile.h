@@ -26,6 +26,10 @@ FSLIB_BEGIN_NAMESPACE(fs);
 
 class LocalFile : public File
 {
+public:
+    using File::pread;
+    using File::preadv;
+
 public:
     LocalFile(const std::string& fileName, FILE* file, ErrorCode ec = EC_OK);
     ~LocalFile();
@@ -38,6 +42,13 @@ public:
 
     ssize_t preadv(const iovec* iov, int iovcnt, off_t offset) override;
 
+#if (__cplusplus >= 201703L)
+    void pread(IOController* controller, void* buffer, size_t length, off_t offset,
+               std::function<void()> callback) override;
+    void preadv(IOController* controller, const iovec* iov, int iovcnt, off_t offset,
+                std::function<void()> callback) override;
+#endif
+
     ssize_t pwrite(const void* buffer, size_t length, off_t offset) override;
 
     ErrorCode flush() override;
@@ -56,6 +67,7 @@ public:
 
 private:
     FILE* _file;
+    static bool _asyncCoroRead;
 };
 
 FSLIB_TYPEDEF_AUTO_PTR(LocalFile);
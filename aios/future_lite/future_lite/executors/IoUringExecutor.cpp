@@ -0,0 +1,57 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "future_lite/executors/IoUringIOExecutor.h"
+#include "future_lite/executors/SimpleExecutor.h"
+
+namespace future_lite {
+
+namespace executors {
+
+// SimpleExecutor whose io is served by io_uring, use posix aio of SimpleExecutor
+// if io_uring is not supported by kernel
+class IoUringExecutor : public SimpleExecutor {
+public:
+    IoUringExecutor(size_t threadNum, uint32_t entries) : SimpleExecutor(threadNum) {
+        _ioUringInited = _ioUringExecutor.init(entries);
+    }
+    ~IoUringExecutor() {
+        _ioUringExecutor.destroy();
+    }
+
+public:
+    IOExecutor* getIOExecutor() override {
+        if (_ioUringInited) {
+            return &_ioUringExecutor;
+        }
+        return SimpleExecutor::getIOExecutor();
+    }
+
+private:
+    IoUringIOExecutor _ioUringExecutor;
+    bool _ioUringInited = false;
+};
+
+} // namespace executors
+
+} // namespace future_lite
+
+REGISTER_FUTURE_LITE_EXECUTOR(async_io_uring) {
+    auto threadNum = params.GetThreadNum();
+    auto entries = params.Get<uint32_t>("max_aio");
+    return std::make_unique<future_lite::executors::IoUringExecutor>(
+        threadNum.value_or(/*defaultValue*/ 1),
+        entries.value_or(future_lite::executors::IoUringIOExecutor::kDefaultEntries));
+}
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "future_lite/executors/IoUringIOExecutor.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace future_lite {
+
+namespace executors {
+
+namespace {
+
+int ioUringSetup(uint32_t entries, io_uring_params* params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+int ioUringEnter(int ringFd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+    return (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+}
+
+} // namespace
+
+IoUringIOExecutor::IoUringIOExecutor()
+    : _ringFd(-1)
+    , _sqEntries(0)
+    , _cqEntries(0)
+    , _sqHead(nullptr)
+    , _sqTail(nullptr)
+    , _sqMask(nullptr)
+    , _sqArray(nullptr)
+    , _sqes(nullptr)
+    , _cqHead(nullptr)
+    , _cqTail(nullptr)
+    , _cqMask(nullptr)
+    , _cqes(nullptr)
+    , _sqRing(MAP_FAILED)
+    , _sqRingSize(0)
+    , _cqRing(MAP_FAILED)
+    , _cqRingSize(0)
+    , _sqesSize(0)
+    , _unsubmitted(0)
+    , _submitting(false)
+    , _inflight(0)
+    , _shutdown(false)
+{
+}
+
+IoUringIOExecutor::~IoUringIOExecutor() {
+    destroy();
+}
+
+bool IoUringIOExecutor::init(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _ringFd = ioUringSetup(entries, &params);
+    if (_ringFd < 0) {
+        fprintf(stderr, "io_uring_setup failed, entries [%u], error [%s]\n", entries, strerror(errno));
+        return false;
+    }
+    _sqEntries = params.sq_entries;
+    _cqEntries = params.cq_entries;
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   _ringFd, IORING_OFF_SQ_RING);
+    _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   _ringFd, IORING_OFF_CQ_RING);
+    void* sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      _ringFd, IORING_OFF_SQES);
+    if (_sqRing == MAP_FAILED || _cqRing == MAP_FAILED || sqes == MAP_FAILED) {
+        fprintf(stderr, "mmap io_uring rings failed, error [%s]\n", strerror(errno));
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, _sqesSize);
+        }
+        unmapRings();
+        return false;
+    }
+    char* sqRing = (char*)_sqRing;
+    _sqHead = (unsigned*)(sqRing + params.sq_off.head);
+    _sqTail = (unsigned*)(sqRing + params.sq_off.tail);
+    _sqMask = (unsigned*)(sqRing + params.sq_off.ring_mask);
+    _sqArray = (unsigned*)(sqRing + params.sq_off.array);
+    _sqes = (io_uring_sqe*)sqes;
+    char* cqRing = (char*)_cqRing;
+    _cqHead = (unsigned*)(cqRing + params.cq_off.head);
+    _cqTail = (unsigned*)(cqRing + params.cq_off.tail);
+    _cqMask = (unsigned*)(cqRing + params.cq_off.ring_mask);
+    _cqes = (io_uring_cqe*)(cqRing + params.cq_off.cqes);
+
+    _loopThread = std::thread([this]() mutable { this->loop(); });
+    return true;
+}
+
+void IoUringIOExecutor::destroy() {
+    if (_ringFd < 0) {
+        return;
+    }
+    _shutdown = true;
+    if (_loopThread.joinable()) {
+        // wake up polling thread by a nop request
+        bool pushed = false;
+        {
+            autil::ScopedLock lock(_mutex);
+            pushed = pushSqe(IORING_OP_NOP, -1, nullptr, 0, 0, nullptr);
+        }
+        if (pushed) {
+            submitPending();
+        }
+        _loopThread.join();
+    }
+    failOverflow(ECANCELED);
+    unmapRings();
+}
+
+void IoUringIOExecutor::unmapRings() {
+    if (_sqes) {
+        munmap(_sqes, _sqesSize);
+        _sqes = nullptr;
+    }
+    if (_sqRing != MAP_FAILED) {
+        munmap(_sqRing, _sqRingSize);
+        _sqRing = MAP_FAILED;
+    }
+    if (_cqRing != MAP_FAILED) {
+        munmap(_cqRing, _cqRingSize);
+        _cqRing = MAP_FAILED;
+    }
+    if (_ringFd >= 0) {
+        close(_ringFd);
+        _ringFd = -1;
+    }
+}
+
+void IoUringIOExecutor::submitIO(int fd, iocb_cmd cmd, void* buffer, size_t length, off_t offset,
+                                 AIOCallback cbfn) {
+    if (cmd == IOCB_CMD_PREAD) {
+        cmd = IOCB_CMD_PREADV;
+    } else if (cmd == IOCB_CMD_PWRITE) {
+        cmd = IOCB_CMD_PWRITEV;
+    } else {
+        cbfn(-EINVAL);
+        return;
+    }
+    // iovec must live until request completes, keep it in request
+    auto request = new Request{std::move(cbfn), {buffer, length}};
+    doSubmit(fd, cmd, &request->iov, 1, offset, request);
+}
+
+void IoUringIOExecutor::submitIOV(int fd, iocb_cmd cmd, const iovec* iov, size_t count, off_t offset,
+                                  AIOCallback cbfn) {
+    if (cmd != IOCB_CMD_PREADV && cmd != IOCB_CMD_PWRITEV) {
+        cbfn(-EINVAL);
+        return;
+    }
+    doSubmit(fd, cmd, iov, count, offset, new Request{std::move(cbfn)});
+}
+
+void IoUringIOExecutor::doSubmit(int fd, iocb_cmd cmd, const iovec* iov, size_t count, off_t offset,
+                                 Request* request) {
+    if (_shutdown) {
+        request->cbfn(-ECANCELED);
+        delete request;
+        return;
+    }
+    request->fd = fd;
+    request->opcode = (cmd == IOCB_CMD_PREADV) ? IORING_OP_READV : IORING_OP_WRITEV;
+    request->iovs = iov;
+    request->iovCount = count;
+    request->offset = offset;
+    {
+        autil::ScopedLock lock(_mutex);
+        // keep submit order, queued requests go first
+        if (!_overflow.empty() || !pushRequest(request)) {
+            _overflow.push_back(request);
+            return;
+        }
+    }
+    submitPending();
+}
+
+bool IoUringIOExecutor::pushRequest(Request* request) {
+    // completions of requests in flight must fit in completion ring
+    if (_inflight.load() >= _cqEntries) {
+        return false;
+    }
+    if (!pushSqe(request->opcode, request->fd, request->iovs, request->iovCount, request->offset, request)) {
+        return false;
+    }
+    _inflight.fetch_add(1);
+    return true;
+}
+
+void IoUringIOExecutor::drainOverflow() {
+    bool pushed = false;
+    {
+        autil::ScopedLock lock(_mutex);
+        while (!_overflow.empty() && pushRequest(_overflow.front())) {
+            _overflow.pop_front();
+            pushed = true;
+        }
+    }
+    if (pushed) {
+        submitPending();
+    }
+}
+
+bool IoUringIOExecutor::pushSqe(uint8_t opcode, int fd, const iovec* iov, uint32_t count, off_t offset,
+                                Request* request) {
+    unsigned tail = *_sqTail;
+    unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    if (tail - head >= _sqEntries) {
+        return false;
+    }
+    unsigned index = tail & *_sqMask;
+    io_uring_sqe* sqe = &_sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = (uint64_t)iov;
+    sqe->len = count;
+    sqe->user_data = (uint64_t)request;
+    _sqArray[index] = index;
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+    // counted under lock, so that failUnsubmitted can reset it together with ring tail
+    _unsubmitted.fetch_add(1);
+    return true;
+}
+
+void IoUringIOExecutor::submitPending() {
+    // only one thread enters kernel at a time, sqes pushed meanwhile are taken by it
+    while (!_submitting.exchange(true)) {
+        uint32_t toSubmit = _unsubmitted.exchange(0);
+        while (toSubmit > 0) {
+            int ret = ioUringEnter(_ringFd, toSubmit, 0, 0);
+            if (ret < 0) {
+                int err = errno;
+                if (err == EINTR || err == EAGAIN || err == EBUSY) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                fprintf(stderr, "io_uring_enter submit failed, error [%s]\n", strerror(err));
+                failUnsubmitted(err);
+                break;
+            }
+            toSubmit -= std::min((uint32_t)ret, toSubmit);
+        }
+        _submitting.store(false);
+        if (_unsubmitted.load() == 0) {
+            break;
+        }
+    }
+}
+
+void IoUringIOExecutor::failUnsubmitted(int err) {
+    // sqes not consumed by kernel are taken back, only submitting thread enters kernel with them
+    std::vector<Request*> failed;
+    {
+        autil::ScopedLock lock(_mutex);
+        unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        unsigned tail = *_sqTail;
+        for (unsigned i = head; i != tail; ++i) {
+            auto request = (Request*)_sqes[_sqArray[i & *_sqMask]].user_data;
+            if (request) {
+                failed.push_back(request);
+            }
+        }
+        __atomic_store_n(_sqTail, head, __ATOMIC_RELEASE);
+        _unsubmitted.store(0);
+        _inflight.fetch_sub(failed.size());
+    }
+    for (auto request : failed) {
+        request->cbfn(-err);
+        delete request;
+    }
+    // nothing may be in flight to trigger draining any more
+    drainOverflow();
+}
+
+void IoUringIOExecutor::failOverflow(int err) {
+    std::deque<Request*> failed;
+    {
+        autil::ScopedLock lock(_mutex);
+        failed.swap(_overflow);
+    }
+    for (auto request : failed) {
+        request->cbfn(-err);
+        delete request;
+    }
+}
+
+void IoUringIOExecutor::loop() {
+    while (true) {
+        reapCompletions();
+        drainOverflow();
+        if (_shutdown && _inflight.load() == 0) {
+            break;
+        }
+        int ret = ioUringEnter(_ringFd, 0, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            fprintf(stderr, "io_uring_enter wait failed, error [%s]\n", strerror(errno));
+            usleep(1000);
+        }
+    }
+}
+
+void IoUringIOExecutor::reapCompletions() {
+    unsigned head = *_cqHead;
+    unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        io_uring_cqe* cqe = &_cqes[head & *_cqMask];
+        auto request = (Request*)cqe->user_data;
+        int32_t res = cqe->res;
+        // release slot before callback, callback may submit new io
+        __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+        if (!request) {
+            continue;
+        }
+        _inflight.fetch_sub(1);
+        request->cbfn(res);
+        delete request;
+    }
+}
+
+} // namespace executors
+
+} // namespace future_lite
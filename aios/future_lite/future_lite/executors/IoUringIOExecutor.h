@@ -0,0 +1,117 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FUTURE_IO_URING_IO_EXECUTOR_H
+#define FUTURE_IO_URING_IO_EXECUTOR_H
+
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <linux/io_uring.h>
+#include "future_lite/IOExecutor.h"
+#include "autil/Lock.h"
+
+namespace future_lite {
+
+namespace executors {
+
+// IOExecutor on linux io_uring (raw syscalls, no liburing). Requests are put into
+// submission ring under lock and submitted in batch by one io_uring_enter: whoever
+// submits drains sqes pushed by other threads in the meantime. A polling thread waits
+// for completions and runs callbacks. Requests beyond ring capacity wait in an overflow
+// queue and are pushed when completions free slots.
+class IoUringIOExecutor : public IOExecutor {
+public:
+    static constexpr uint32_t kDefaultEntries = 256;
+
+public:
+    IoUringIOExecutor();
+    ~IoUringIOExecutor();
+
+    IoUringIOExecutor(const IoUringIOExecutor &) = delete;
+    IoUringIOExecutor& operator = (const IoUringIOExecutor &) = delete;
+
+public:
+    // return false if kernel not support io_uring
+    bool init(uint32_t entries = kDefaultEntries);
+    void destroy();
+
+public:
+    void submitIO(int fd, iocb_cmd cmd, void* buffer, size_t length, off_t offset,
+                  AIOCallback cbfn) override;
+    void submitIOV(int fd, iocb_cmd cmd, const iovec* iov, size_t count, off_t offset,
+                   AIOCallback cbfn) override;
+
+private:
+    struct Request {
+        AIOCallback cbfn;
+        iovec iov{nullptr, 0};
+        // sqe fields, kept for requests waiting in overflow queue
+        int fd = -1;
+        uint8_t opcode = 0;
+        const iovec* iovs = nullptr;
+        uint32_t iovCount = 0;
+        off_t offset = 0;
+    };
+
+private:
+    void doSubmit(int fd, iocb_cmd cmd, const iovec* iov, size_t count, off_t offset,
+                  Request* request);
+    bool pushSqe(uint8_t opcode, int fd, const iovec* iov, uint32_t count, off_t offset,
+                 Request* request);
+    // caller holds _mutex
+    bool pushRequest(Request* request);
+    void drainOverflow();
+    void submitPending();
+    void failUnsubmitted(int err);
+    void failOverflow(int err);
+    void loop();
+    void reapCompletions();
+    void unmapRings();
+
+private:
+    int _ringFd;
+    uint32_t _sqEntries;
+    uint32_t _cqEntries;
+    unsigned* _sqHead;
+    unsigned* _sqTail;
+    unsigned* _sqMask;
+    unsigned* _sqArray;
+    io_uring_sqe* _sqes;
+    unsigned* _cqHead;
+    unsigned* _cqTail;
+    unsigned* _cqMask;
+    io_uring_cqe* _cqes;
+    void* _sqRing;
+    size_t _sqRingSize;
+    void* _cqRing;
+    size_t _cqRingSize;
+    size_t _sqesSize;
+
+    autil::ThreadMutex _mutex;
+    std::deque<Request*> _overflow;
+    std::atomic<uint32_t> _unsubmitted;
+    std::atomic<bool> _submitting;
+    // requests in submission ring or kernel, never exceed completion ring size
+    std::atomic<uint32_t> _inflight;
+    volatile bool _shutdown;
+    std::thread _loopThread;
+};
+
+} // namespace executors
+
+} // namespace future_lite
+
+#endif // FUTURE_IO_URING_IO_EXECUTOR_H
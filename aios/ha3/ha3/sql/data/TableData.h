@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 
+#include "autil/CompressionUtil.h"
 #include "ha3/sql/data/TableType.h"
 #include "navi/engine/Data.h"
 #include "table/Table.h"
@@ -29,7 +30,9 @@ class TableData : public navi::Data {
 public:
     TableData(table::TablePtr table)
         : navi::Data(TableType::TYPE_ID, nullptr)
-        , _table(std::move(table)) {}
+        , _table(std::move(table))
+        , _columnarSerialize(false)
+        , _compressType(autil::CompressType::NO_COMPRESS) {}
 
     ~TableData() {}
 
@@ -41,9 +44,22 @@ public:
     table::TablePtr &getTable() {
         return _table;
     }
+    // only set by senders whose receiver decodes columnar format
+    void setColumnarSerialize(autil::CompressType compressType) {
+        _columnarSerialize = true;
+        _compressType = compressType;
+    }
+    bool isColumnarSerialize() const {
+        return _columnarSerialize;
+    }
+    autil::CompressType getSerializeCompressType() const {
+        return _compressType;
+    }
 
 private:
     table::TablePtr _table;
+    bool _columnarSerialize;
+    autil::CompressType _compressType;
 };
 
 typedef std::shared_ptr<TableData> TableDataPtr;
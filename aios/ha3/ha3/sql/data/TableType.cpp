@@ -49,7 +49,11 @@ navi::TypeErrorCode TableType::serialize(navi::TypeContext &ctx, const navi::Dat
     }
     auto table = tableData->getTable();
     assert(table != nullptr);
-    table->serialize(ctx.getDataBuffer());
+    if (tableData->isColumnarSerialize()) {
+        table->serializeColumnar(ctx.getDataBuffer(), tableData->getSerializeCompressType());
+    } else {
+        table->serialize(ctx.getDataBuffer());
+    }
     return navi::TEC_NONE;
 }
 
@@ -21,6 +21,7 @@
 namespace isearch {
 namespace sql {
 
+AUTIL_LOG_SETUP(sql, BatchAggFunc);
 AUTIL_LOG_SETUP(sql, AggFunc);
 
 bool AggFunc::initMergeInput(const table::TablePtr &inputTable) {
@@ -40,5 +41,30 @@ bool AggFunc::outputResult(Accumulator *acc, table::Row outputRow) const {
     return false;
 }
 
+bool AggFunc::batchAggregate(const table::Row *inputRows, Accumulator *const *accs, size_t count) {
+    assert(_inited);
+    for (size_t i = 0; i < count; ++i) {
+        if (!aggregate(inputRows[i], accs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchAggFunc::batchCollect(const table::Row *inputRows,
+                                const uint32_t *groups,
+                                Accumulator *const *groupAccs,
+                                size_t count) {
+    SQL_LOG(ERROR, "func [%s] not implemented", __FUNCTION__);
+    return false;
+}
+bool BatchAggFunc::batchMerge(const table::Row *inputRows,
+                              const uint32_t *groups,
+                              Accumulator *const *groupAccs,
+                              size_t count) {
+    SQL_LOG(ERROR, "func [%s] not implemented", __FUNCTION__);
+    return false;
+}
+
 } // namespace sql
 } // namespace isearch
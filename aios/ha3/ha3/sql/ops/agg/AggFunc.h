@@ -19,11 +19,13 @@
 #include <assert.h>
 #include <memory>
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
 #include "autil/Log.h"
 #include "ha3/sql/ops/agg/AggFuncMode.h"
+#include "table/ColumnData.h"
 #include "table/Row.h"
 #include "table/Table.h"
 
@@ -41,6 +43,41 @@ class Accumulator;
 namespace isearch {
 namespace sql {
 
+// Optional batch form of collect and merge, groups[i] is group of inputRows[i]
+// and groupAccs is indexed by group. Builtin functions read their typed input
+// columns for the whole batch, then update their typed accumulators in one
+// loop. It is not a part of AggFunc, so functions built against older headers
+// keep their vtable layout.
+class BatchAggFunc {
+public:
+    virtual ~BatchAggFunc() {}
+
+public:
+    virtual bool batchCollect(const table::Row *inputRows,
+                              const uint32_t *groups,
+                              Accumulator *const *groupAccs,
+                              size_t count);
+    virtual bool batchMerge(const table::Row *inputRows,
+                            const uint32_t *groups,
+                            Accumulator *const *groupAccs,
+                            size_t count);
+
+protected:
+    template <typename T>
+    static void readColumn(const table::ColumnData<T> *column,
+                           const table::Row *inputRows,
+                           size_t count,
+                           std::vector<T> &values) {
+        values.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = column->get(inputRows[i]);
+        }
+    }
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
 class AggFunc {
 public:
     AggFunc(const std::vector<std::string> &inputs,
@@ -72,6 +109,9 @@ public:
     void setName(const std::string &name) {
         _name = name;
     }
+    AggFuncMode getFuncMode() const {
+        return _funcMode;
+    }
     virtual bool initHint(const std::string &funcHint) {
         return true;
     }
@@ -124,6 +164,9 @@ public:
             return collect(inputRow, acc);
         }
     }
+    // accs[i] is accumulator of inputRows[i], aggregate row by row, used for
+    // functions not implementing BatchAggFunc
+    bool batchAggregate(const table::Row *inputRows, Accumulator *const *accs, size_t count);
     bool setResult(Accumulator *acc, table::Row outputRow) {
         assert(_inited);
         if (_funcMode == AggFuncMode::AGG_FUNC_MODE_LOCAL) {
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ha3/sql/ops/agg/AggGroupHashTable.h"
+
+#include <utility>
+
+namespace isearch {
+namespace sql {
+
+AggGroupHashTable::AggGroupHashTable()
+    : _mask(0)
+    , _shift(0)
+    , _size(0) {
+    rehash(MIN_CAPACITY);
+}
+
+AggGroupHashTable::~AggGroupHashTable() {}
+
+void AggGroupHashTable::rehash(size_t capacity) {
+    std::vector<size_t> oldKeys(capacity);
+    std::vector<uint32_t> oldGroups(capacity, INVALID_GROUP);
+    _keys.swap(oldKeys);
+    _groups.swap(oldGroups);
+    _mask = capacity - 1;
+    _shift = 64 - __builtin_ctzll(capacity);
+    for (size_t i = 0; i < oldGroups.size(); ++i) {
+        if (oldGroups[i] == INVALID_GROUP) {
+            continue;
+        }
+        size_t pos = position(oldKeys[i]);
+        while (_groups[pos] != INVALID_GROUP) {
+            pos = (pos + 1) & _mask;
+        }
+        _keys[pos] = oldKeys[i];
+        _groups[pos] = oldGroups[i];
+    }
+}
+
+} // namespace sql
+} // namespace isearch
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits>
+#include <vector>
+
+namespace isearch {
+namespace sql {
+
+// Open-addressing (linear probing) table from group key hash to group index.
+// Group indexes are assigned in insertion order starting from 0, so they can
+// address accumulator arrays directly.
+class AggGroupHashTable {
+public:
+    static constexpr uint32_t INVALID_GROUP = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MIN_CAPACITY = 1024;
+
+public:
+    AggGroupHashTable();
+    ~AggGroupHashTable();
+    AggGroupHashTable(const AggGroupHashTable &) = delete;
+    AggGroupHashTable &operator=(const AggGroupHashTable &) = delete;
+
+public:
+    // return group index of key, a new group is added if key not exists and
+    // group count is less than groupLimit, otherwise INVALID_GROUP
+    inline uint32_t findOrInsert(size_t key, size_t groupLimit);
+    inline uint32_t find(size_t key) const;
+    inline void prefetch(size_t key) const;
+    size_t size() const {
+        return _size;
+    }
+    size_t capacity() const {
+        return _groups.size();
+    }
+
+private:
+    size_t position(size_t key) const {
+        // keys may be plain column values, mix them before taking bits
+        return (key * 0x9E3779B97F4A7C15ULL) >> _shift;
+    }
+    void rehash(size_t capacity);
+
+private:
+    std::vector<size_t> _keys;
+    std::vector<uint32_t> _groups;
+    size_t _mask;
+    size_t _shift;
+    size_t _size;
+};
+
+inline uint32_t AggGroupHashTable::findOrInsert(size_t key, size_t groupLimit) {
+    size_t pos = position(key);
+    while (_groups[pos] != INVALID_GROUP) {
+        if (_keys[pos] == key) {
+            return _groups[pos];
+        }
+        pos = (pos + 1) & _mask;
+    }
+    if (_size >= groupLimit || _size >= INVALID_GROUP) {
+        return INVALID_GROUP;
+    }
+    _keys[pos] = key;
+    _groups[pos] = _size++;
+    uint32_t group = _groups[pos];
+    // keep load factor <= 0.5
+    if (_size * 2 > _groups.size()) {
+        rehash(_groups.size() * 2);
+    }
+    return group;
+}
+
+inline uint32_t AggGroupHashTable::find(size_t key) const {
+    size_t pos = position(key);
+    while (_groups[pos] != INVALID_GROUP) {
+        if (_keys[pos] == key) {
+            return _groups[pos];
+        }
+        pos = (pos + 1) & _mask;
+    }
+    return INVALID_GROUP;
+}
+
+inline void AggGroupHashTable::prefetch(size_t key) const {
+    size_t pos = position(key);
+    __builtin_prefetch(_groups.data() + pos, 0, 1);
+    __builtin_prefetch(_keys.data() + pos, 0, 1);
+}
+
+} // namespace sql
+} // namespace isearch
@@ -48,7 +48,8 @@ namespace isearch {
 namespace sql {
 AUTIL_LOG_SETUP(sql, Aggregator);
 
-static constexpr size_t kCheckIntervalMask = (1 << 7) - 1;
+static constexpr size_t kAggBatchSize = 1024;
+static constexpr size_t kGroupPrefetchDistance = 16;
 #define UPDATE_AND_CHECK_AGG_POOL()                                                                \
     _aggPoolSize = _aggregatorPoolPtr->getAllocatedSize();                                         \
     if (unlikely(_aggPoolSize > _aggHints.memoryLimit)) {                                          \
@@ -67,7 +68,6 @@ Aggregator::Aggregator(AggFuncMode mode,
     , _aggregateTime(0)
     , _getTableTime(0)
     , _aggPoolSize(0)
-    , _aggregateCnt(0)
     , _mode(mode)
     , _aggregatorPoolPtr(_memoryPoolResource->getPool()) {}
 
@@ -169,6 +169,7 @@ bool Aggregator::createAggFunc(const AggFuncManager *aggFuncManager,
         return false;
     }
     _aggFuncVec.emplace_back(func);
+    _batchAggFuncVec.emplace_back(dynamic_cast<BatchAggFunc *>(func));
     _accumulatorVec.emplace_back(_aggregatorPoolPtr.get());
     if (filterArg >= 0 && _mode != AggFuncMode::AGG_FUNC_MODE_GLOBAL) {
         _aggFilterArgs.emplace_back(filterArg);
@@ -201,11 +202,22 @@ bool Aggregator::aggregate(const TablePtr &table, const vector<size_t> &groupKey
             aggFilterColumn[i] = column;
         }
     }
+    // resolve group of a batch of rows first, then update accumulators
+    // function by function
     size_t rowCount = table->getRowCount();
-    for (size_t i = 0; i < rowCount; i++) {
-        if (!doAggregate(table->getRow(i), groupKeys[i], aggFilterColumn)) {
+    vector<Row> rows;
+    vector<uint32_t> groups;
+    rows.reserve(kAggBatchSize);
+    groups.reserve(kAggBatchSize);
+    for (size_t begin = 0; begin < rowCount; begin += kAggBatchSize) {
+        size_t end = std::min(rowCount, begin + kAggBatchSize);
+        if (!resolveGroups(table, groupKeys, begin, end, rows, groups)) {
             return false;
         }
+        if (!batchAggregate(rows, groups, aggFilterColumn)) {
+            return false;
+        }
+        UPDATE_AND_CHECK_AGG_POOL();
     }
     UPDATE_AND_CHECK_AGG_POOL();
 
@@ -213,48 +225,93 @@ bool Aggregator::aggregate(const TablePtr &table, const vector<size_t> &groupKey
     return true;
 }
 
-bool Aggregator::doAggregate(const Row &row, size_t groupKey,
-                             const std::vector<table::ColumnData<bool> *> &aggFilterColumn)
-{
-    size_t accIdx;
-    auto it = _accumulatorIdxMap.find(groupKey);
-    if (it == _accumulatorIdxMap.end()) {
-        accIdx = _accumulatorIdxMap.size();
-        if (accIdx >= _aggHints.groupKeyLimit) {
+bool Aggregator::resolveGroups(const TablePtr &table,
+                               const vector<size_t> &groupKeys,
+                               size_t begin,
+                               size_t end,
+                               vector<Row> &rows,
+                               vector<uint32_t> &groups) {
+    rows.clear();
+    groups.clear();
+    for (size_t i = begin; i < end; i++) {
+        if (i + kGroupPrefetchDistance < end) {
+            _groupTable.prefetch(groupKeys[i + kGroupPrefetchDistance]);
+        }
+        size_t groupCount = _groupTable.size();
+        uint32_t group = _groupTable.findOrInsert(groupKeys[i], _aggHints.groupKeyLimit);
+        if (group == AggGroupHashTable::INVALID_GROUP) {
             if (_aggHints.stopExceedLimit) {
                 SQL_LOG(ERROR, "group key size large than limit[%lu]", _aggHints.groupKeyLimit);
                 return false;
-            } else {
-                return true;
             }
+            continue;
         }
-        for (size_t i = 0; i < _aggFuncVec.size(); i++) {
-            // IMPORTANT: use independent pool for each thread
-            auto acc = _aggFuncVec[i]->createAccumulator(_aggregatorPoolPtr.get());
-            if (acc == nullptr) {
-                SQL_LOG(ERROR, "create accumulator failed");
-                return false;
-            }
-            assert(i < _accumulatorVec.size());
-            assert(_accumulatorVec[i].size() == accIdx);
-            _accumulatorVec[i].push_back(acc);
+        if (_groupTable.size() > groupCount && !createAccumulators(group)) {
+            return false;
         }
-        _accumulatorIdxMap.insert({groupKey, accIdx});
-    } else {
-        accIdx = it->second;
+        rows.emplace_back(table->getRow(i));
+        groups.emplace_back(group);
     }
+    return true;
+}
+
+bool Aggregator::createAccumulators(uint32_t group) {
     for (size_t i = 0; i < _aggFuncVec.size(); i++) {
-        if (aggFilterColumn[i] != nullptr && aggFilterColumn[i]->get(row) == false) {
-            continue;
+        // IMPORTANT: use independent pool for each thread
+        auto acc = _aggFuncVec[i]->createAccumulator(_aggregatorPoolPtr.get());
+        if (acc == nullptr) {
+            SQL_LOG(ERROR, "create accumulator failed");
+            return false;
         }
         assert(i < _accumulatorVec.size());
-        if (!_aggFuncVec[i]->aggregate(row, _accumulatorVec[i][accIdx])) {
+        assert(_accumulatorVec[i].size() == group);
+        _accumulatorVec[i].push_back(acc);
+    }
+    return true;
+}
+
+bool Aggregator::batchAggregate(const vector<Row> &rows,
+                                const vector<uint32_t> &groups,
+                                const std::vector<table::ColumnData<bool> *> &aggFilterColumn)
+{
+    for (size_t i = 0; i < _aggFuncVec.size(); i++) {
+        assert(i < _accumulatorVec.size());
+        const auto &accumulators = _accumulatorVec[i];
+        const Row *inputRows = rows.data();
+        const uint32_t *inputGroups = groups.data();
+        size_t count = rows.size();
+        if (aggFilterColumn[i] != nullptr) {
+            _batchRows.clear();
+            _batchGroups.clear();
+            for (size_t j = 0; j < rows.size(); j++) {
+                if (aggFilterColumn[i]->get(rows[j]) == false) {
+                    continue;
+                }
+                _batchRows.push_back(rows[j]);
+                _batchGroups.push_back(groups[j]);
+            }
+            inputRows = _batchRows.data();
+            inputGroups = _batchGroups.data();
+            count = _batchRows.size();
+        }
+        auto *batchFunc = _batchAggFuncVec[i];
+        if (batchFunc != nullptr) {
+            bool ret = _aggFuncVec[i]->getFuncMode() == AggFuncMode::AGG_FUNC_MODE_GLOBAL
+                           ? batchFunc->batchMerge(inputRows, inputGroups, accumulators.data(), count)
+                           : batchFunc->batchCollect(inputRows, inputGroups, accumulators.data(), count);
+            if (!ret) {
+                return false;
+            }
+            continue;
+        }
+        _batchAccs.clear();
+        for (size_t j = 0; j < count; j++) {
+            _batchAccs.push_back(accumulators[inputGroups[j]]);
+        }
+        if (!_aggFuncVec[i]->batchAggregate(inputRows, _batchAccs.data(), count)) {
             return false;
         }
     }
-    if ((++_aggregateCnt & kCheckIntervalMask) == 0) {
-        UPDATE_AND_CHECK_AGG_POOL();
-    }
     return true;
 }
 
@@ -264,11 +321,10 @@ TablePtr Aggregator::getTable() {
     }
     
     autil::ScopedTime2 getTableTimer;
-    _table->batchAllocateRow(_accumulatorIdxMap.size());
-    size_t rowIndex = 0;
-    for (auto &pair : _accumulatorIdxMap) {
-        Row row = _table->getRow(rowIndex++);
-        size_t accIdx = pair.second;
+    size_t groupCount = _groupTable.size();
+    _table->batchAllocateRow(groupCount);
+    for (size_t accIdx = 0; accIdx < groupCount; accIdx++) {
+        Row row = _table->getRow(accIdx);
         for (size_t i = 0; i < _aggFuncVec.size(); i++) {
             auto *acc = _accumulatorVec[i][accIdx];
             if (!_aggFuncVec[i]->setResult(acc, row)) {
@@ -19,13 +19,13 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "autil/Log.h"
 #include "autil/mem_pool/PoolVector.h"
 #include "ha3/sql/common/common.h"
 #include "ha3/sql/ops/agg/AggFuncMode.h"
+#include "ha3/sql/ops/agg/AggGroupHashTable.h"
 #include "table/Row.h"
 #include "table/Table.h"
 
@@ -44,6 +44,7 @@ namespace sql {
 class Accumulator;
 class AggFunc;
 class AggFuncDesc;
+class BatchAggFunc;
 class AggFuncManager;
 } // namespace sql
 } // namespace isearch
@@ -93,8 +94,16 @@ private:
                        const std::vector<std::string> &inputs,
                        const std::vector<std::string> &outputs,
                        const int32_t filterArg = -1);
-    bool doAggregate(const table::Row &row, size_t groupKey,
-                     const std::vector<table::ColumnData<bool> *> &aggFilterColumn);
+    bool resolveGroups(const table::TablePtr &table,
+                       const std::vector<size_t> &groupKeys,
+                       size_t begin,
+                       size_t end,
+                       std::vector<table::Row> &rows,
+                       std::vector<uint32_t> &groups);
+    bool createAccumulators(uint32_t group);
+    bool batchAggregate(const std::vector<table::Row> &rows,
+                        const std::vector<uint32_t> &groups,
+                        const std::vector<table::ColumnData<bool> *> &aggFilterColumn);
     bool needDependInputTablePools() const;
 
 private:
@@ -104,14 +113,18 @@ private:
     uint64_t _aggregateTime;
     uint64_t _getTableTime;
     uint64_t _aggPoolSize;
-    size_t _aggregateCnt;
     AggFuncMode _mode;
 
     std::vector<AggFunc *> _aggFuncVec;
+    // resolved once per function, nullptr if function has no batch form
+    std::vector<BatchAggFunc *> _batchAggFuncVec;
     std::vector<int32_t> _aggFilterArgs;
     std::shared_ptr<autil::mem_pool::Pool> _aggregatorPoolPtr;
     std::vector<autil::mem_pool::PoolVector<Accumulator *>> _accumulatorVec;
-    std::unordered_map<size_t, size_t> _accumulatorIdxMap;
+    AggGroupHashTable _groupTable;
+    std::vector<table::Row> _batchRows;
+    std::vector<uint32_t> _batchGroups;
+    std::vector<Accumulator *> _batchAccs;
 
 private:
     AUTIL_LOG_DECLARE();
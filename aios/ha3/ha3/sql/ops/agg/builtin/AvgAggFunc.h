@@ -52,7 +52,7 @@ public:
 };
 
 template <typename InputType, typename AccumulatorType>
-class AvgAggFunc : public AggFunc {
+class AvgAggFunc : public AggFunc, public BatchAggFunc {
 public:
     AvgAggFunc(const std::vector<std::string> &inputs,
                const std::vector<std::string> &outputs,
@@ -78,17 +78,28 @@ private:
     bool initAccumulatorOutput(const table::TablePtr &outputTable) override;
     bool collect(table::Row inputRow, Accumulator *acc) override;
     bool outputAccumulator(Accumulator *acc, table::Row outputRow) const override;
+    bool batchCollect(const table::Row *inputRows,
+                      const uint32_t *groups,
+                      Accumulator *const *groupAccs,
+                      size_t count) override;
     // global
     bool initMergeInput(const table::TablePtr &inputTable) override;
     bool initResultOutput(const table::TablePtr &outputTable) override;
     bool merge(table::Row inputRow, Accumulator *acc) override;
     bool outputResult(Accumulator *acc, table::Row outputRow) const override;
+    bool batchMerge(const table::Row *inputRows,
+                    const uint32_t *groups,
+                    Accumulator *const *groupAccs,
+                    size_t count) override;
 
 private:
     table::ColumnData<InputType> *_inputColumn;
     table::ColumnData<uint64_t> *_countColumn;
     table::ColumnData<AccumulatorType> *_sumColumn;
     table::ColumnData<double> *_avgColumn;
+    std::vector<InputType> _batchValues;
+    std::vector<uint64_t> _batchCounts;
+    std::vector<AccumulatorType> _batchSums;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -138,6 +149,20 @@ bool AvgAggFunc<InputType, AccumulatorType>::collect(table::Row inputRow, Accumu
     return true;
 }
 
+template <typename InputType, typename AccumulatorType>
+bool AvgAggFunc<InputType, AccumulatorType>::batchCollect(const table::Row *inputRows,
+                                                          const uint32_t *groups,
+                                                          Accumulator *const *groupAccs,
+                                                          size_t count) {
+    readColumn(_inputColumn, inputRows, count, _batchValues);
+    for (size_t i = 0; i < count; ++i) {
+        auto *avgAcc = static_cast<AvgAccumulator<AccumulatorType> *>(groupAccs[groups[i]]);
+        avgAcc->count++;
+        avgAcc->sum += _batchValues[i];
+    }
+    return true;
+}
+
 template <typename InputType, typename AccumulatorType>
 bool AvgAggFunc<InputType, AccumulatorType>::outputAccumulator(Accumulator *acc,
                                                                table::Row outputRow) const {
@@ -181,6 +206,21 @@ bool AvgAggFunc<InputType, AccumulatorType>::merge(table::Row inputRow, Accumula
     return true;
 }
 
+template <typename InputType, typename AccumulatorType>
+bool AvgAggFunc<InputType, AccumulatorType>::batchMerge(const table::Row *inputRows,
+                                                        const uint32_t *groups,
+                                                        Accumulator *const *groupAccs,
+                                                        size_t count) {
+    readColumn(_countColumn, inputRows, count, _batchCounts);
+    readColumn(_sumColumn, inputRows, count, _batchSums);
+    for (size_t i = 0; i < count; ++i) {
+        auto *avgAcc = static_cast<AvgAccumulator<AccumulatorType> *>(groupAccs[groups[i]]);
+        avgAcc->count += _batchCounts[i];
+        avgAcc->sum += _batchSums[i];
+    }
+    return true;
+}
+
 template <typename InputType, typename AccumulatorType>
 bool AvgAggFunc<InputType, AccumulatorType>::outputResult(Accumulator *acc,
                                                           table::Row outputRow) const {
@@ -59,6 +59,16 @@ bool CountAggFunc::collect(Row inputRow, Accumulator *acc) {
     return true;
 }
 
+bool CountAggFunc::batchCollect(const Row *inputRows,
+                                const uint32_t *groups,
+                                Accumulator *const *groupAccs,
+                                size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        ++static_cast<CountAccumulator *>(groupAccs[groups[i]])->value;
+    }
+    return true;
+}
+
 bool CountAggFunc::outputAccumulator(Accumulator *acc, Row outputRow) const {
     CountAccumulator *countAcc = static_cast<CountAccumulator *>(acc);
     _countColumn->set(outputRow, countAcc->value);
@@ -84,6 +94,17 @@ bool CountAggFunc::merge(Row inputRow, Accumulator *acc) {
     return true;
 }
 
+bool CountAggFunc::batchMerge(const Row *inputRows,
+                              const uint32_t *groups,
+                              Accumulator *const *groupAccs,
+                              size_t count) {
+    readColumn(_inputColumn, inputRows, count, _batchValues);
+    for (size_t i = 0; i < count; ++i) {
+        static_cast<CountAccumulator *>(groupAccs[groups[i]])->value += _batchValues[i];
+    }
+    return true;
+}
+
 bool CountAggFunc::outputResult(Accumulator *acc, Row outputRow) const {
     return outputAccumulator(acc, outputRow);
 }
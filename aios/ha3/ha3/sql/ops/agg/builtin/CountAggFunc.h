@@ -49,7 +49,7 @@ public:
     int64_t value;
 };
 
-class CountAggFunc : public AggFunc {
+class CountAggFunc : public AggFunc, public BatchAggFunc {
 public:
     CountAggFunc(const std::vector<std::string> &inputs,
                  const std::vector<std::string> &outputs,
@@ -75,15 +75,24 @@ private:
     bool initAccumulatorOutput(const table::TablePtr &outputTable) override;
     bool collect(table::Row inputRow, Accumulator *acc) override;
     bool outputAccumulator(Accumulator *acc, table::Row outputRow) const override;
+    bool batchCollect(const table::Row *inputRows,
+                      const uint32_t *groups,
+                      Accumulator *const *groupAccs,
+                      size_t count) override;
     // global
     bool initMergeInput(const table::TablePtr &inputTable) override;
     bool initResultOutput(const table::TablePtr &outputTable) override;
     bool merge(table::Row inputRow, Accumulator *acc) override;
     bool outputResult(Accumulator *acc, table::Row outputRow) const override;
+    bool batchMerge(const table::Row *inputRows,
+                    const uint32_t *groups,
+                    Accumulator *const *groupAccs,
+                    size_t count) override;
 
 private:
     table::ColumnData<int64_t> *_inputColumn;
     table::ColumnData<int64_t> *_countColumn;
+    std::vector<int64_t> _batchValues;
     AUTIL_LOG_DECLARE();
 };
 
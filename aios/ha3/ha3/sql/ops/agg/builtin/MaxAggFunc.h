@@ -55,7 +55,7 @@ public:
 };
 
 template <typename InputType>
-class MaxAggFunc : public AggFunc {
+class MaxAggFunc : public AggFunc, public BatchAggFunc {
 public:
     MaxAggFunc(const std::vector<std::string> &inputs,
                const std::vector<std::string> &outputs,
@@ -79,10 +79,15 @@ private:
     bool initAccumulatorOutput(const table::TablePtr &outputTable) override;
     bool collect(table::Row inputRow, Accumulator *acc) override;
     bool outputAccumulator(Accumulator *acc, table::Row outputRow) const override;
+    bool batchCollect(const table::Row *inputRows,
+                      const uint32_t *groups,
+                      Accumulator *const *groupAccs,
+                      size_t count) override;
 
 private:
     table::ColumnData<InputType> *_inputColumn;
     table::ColumnData<InputType> *_maxColumn;
+    std::vector<InputType> _batchValues;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -130,6 +135,24 @@ bool MaxAggFunc<InputType>::collect(table::Row inputRow, Accumulator *acc) {
     return true;
 }
 
+template <typename InputType>
+bool MaxAggFunc<InputType>::batchCollect(const table::Row *inputRows,
+                                         const uint32_t *groups,
+                                         Accumulator *const *groupAccs,
+                                         size_t count) {
+    readColumn(_inputColumn, inputRows, count, _batchValues);
+    for (size_t i = 0; i < count; ++i) {
+        auto *maxAcc = static_cast<MaxAccumulator<InputType> *>(groupAccs[groups[i]]);
+        if (maxAcc->isFirstAggregate) {
+            maxAcc->value = _batchValues[i];
+            maxAcc->isFirstAggregate = false;
+        } else {
+            maxAcc->value = std::max(maxAcc->value, _batchValues[i]);
+        }
+    }
+    return true;
+}
+
 template <typename InputType>
 bool MaxAggFunc<InputType>::outputAccumulator(Accumulator *acc, table::Row outputRow) const {
     MaxAccumulator<InputType> *maxAcc = static_cast<MaxAccumulator<InputType> *>(acc);
@@ -53,7 +53,7 @@ public:
 };
 
 template <typename InputType>
-class MinAggFunc : public AggFunc {
+class MinAggFunc : public AggFunc, public BatchAggFunc {
 public:
     MinAggFunc(const std::vector<std::string> &inputs,
                const std::vector<std::string> &outputs,
@@ -77,10 +77,15 @@ private:
     bool initAccumulatorOutput(const table::TablePtr &outputTable) override;
     bool collect(table::Row inputRow, Accumulator *acc) override;
     bool outputAccumulator(Accumulator *acc, table::Row outputRow) const override;
+    bool batchCollect(const table::Row *inputRows,
+                      const uint32_t *groups,
+                      Accumulator *const *groupAccs,
+                      size_t count) override;
 
 private:
     table::ColumnData<InputType> *_inputColumn;
     table::ColumnData<InputType> *_minColumn;
+    std::vector<InputType> _batchValues;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -127,6 +132,24 @@ bool MinAggFunc<InputType>::collect(table::Row inputRow, Accumulator *acc) {
     return true;
 }
 
+template <typename InputType>
+bool MinAggFunc<InputType>::batchCollect(const table::Row *inputRows,
+                                         const uint32_t *groups,
+                                         Accumulator *const *groupAccs,
+                                         size_t count) {
+    readColumn(_inputColumn, inputRows, count, _batchValues);
+    for (size_t i = 0; i < count; ++i) {
+        auto *minAcc = static_cast<MinAccumulator<InputType> *>(groupAccs[groups[i]]);
+        if (minAcc->isFirstAggregate) {
+            minAcc->value = _batchValues[i];
+            minAcc->isFirstAggregate = false;
+        } else {
+            minAcc->value = std::min(minAcc->value, _batchValues[i]);
+        }
+    }
+    return true;
+}
+
 template <typename InputType>
 bool MinAggFunc<InputType>::outputAccumulator(Accumulator *acc, table::Row outputRow) const {
     MinAccumulator<InputType> *minAcc = static_cast<MinAccumulator<InputType> *>(acc);
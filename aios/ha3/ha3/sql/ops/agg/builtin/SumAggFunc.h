@@ -52,7 +52,7 @@ public:
 };
 
 template <typename InputType, typename AccumulatorType>
-class SumAggFunc : public AggFunc {
+class SumAggFunc : public AggFunc, public BatchAggFunc {
 public:
     SumAggFunc(const std::vector<std::string> &inputs,
                const std::vector<std::string> &outputs,
@@ -78,10 +78,15 @@ private:
     bool initAccumulatorOutput(const table::TablePtr &outputTable) override;
     bool collect(table::Row inputRow, Accumulator *acc) override;
     bool outputAccumulator(Accumulator *acc, table::Row outputRow) const override;
+    bool batchCollect(const table::Row *inputRows,
+                      const uint32_t *groups,
+                      Accumulator *const *groupAccs,
+                      size_t count) override;
 
 private:
     table::ColumnData<InputType> *_inputColumn;
     table::ColumnData<AccumulatorType> *_sumColumn;
+    std::vector<InputType> _batchValues;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -118,6 +123,19 @@ bool SumAggFunc<InputType, AccumulatorType>::collect(table::Row inputRow, Accumu
     return true;
 }
 
+template <typename InputType, typename AccumulatorType>
+bool SumAggFunc<InputType, AccumulatorType>::batchCollect(const table::Row *inputRows,
+                                                          const uint32_t *groups,
+                                                          Accumulator *const *groupAccs,
+                                                          size_t count) {
+    readColumn(_inputColumn, inputRows, count, _batchValues);
+    for (size_t i = 0; i < count; ++i) {
+        auto *sumAcc = static_cast<SumAccumulator<AccumulatorType> *>(groupAccs[groups[i]]);
+        sumAcc->value += _batchValues[i];
+    }
+    return true;
+}
+
 template <typename InputType, typename AccumulatorType>
 bool SumAggFunc<InputType, AccumulatorType>::outputAccumulator(Accumulator *acc,
                                                                table::Row outputRow) const {
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ha3/sql/ops/join/JoinHashTable.h"
+
+#include <string.h>
+
+#include "alog/Logger.h"
+#include "autil/mem_pool/Pool.h"
+#include "ha3/sql/common/Log.h"
+
+using namespace std;
+
+namespace isearch {
+namespace sql {
+AUTIL_LOG_SETUP(sql, JoinHashTable);
+
+JoinHashTable::JoinHashTable()
+    : _pool(new autil::mem_pool::Pool())
+    , _tags(nullptr)
+    , _hashes(nullptr)
+    , _heads(nullptr)
+    , _rows(nullptr)
+    , _next(nullptr)
+    , _capacity(0)
+    , _mask(0)
+    , _keyCount(0)
+    , _entryCount(0) {}
+
+JoinHashTable::~JoinHashTable() {}
+
+template <typename T>
+T *JoinHashTable::allocateArray(size_t count) {
+    return static_cast<T *>(_pool->allocate(sizeof(T) * count));
+}
+
+bool JoinHashTable::build(const HashValues &values) {
+    clear();
+    if (values.empty()) {
+        return true;
+    }
+    if (values.size() >= INVALID_ENTRY || values.back().first >= INVALID_ENTRY) {
+        SQL_LOG(ERROR, "too many rows [%zu] for join hash table", values.size());
+        return false;
+    }
+    size_t capacity = MIN_CAPACITY;
+    // keep load factor <= 0.5 even when all keys are distinct
+    while (capacity < values.size() * 2) {
+        capacity <<= 1;
+    }
+    _capacity = capacity;
+    _mask = capacity - 1;
+    _entryCount = values.size();
+    _tags = allocateArray<uint8_t>(_capacity);
+    _hashes = allocateArray<size_t>(_capacity);
+    _heads = allocateArray<uint32_t>(_capacity);
+    _rows = allocateArray<uint32_t>(_entryCount);
+    _next = allocateArray<uint32_t>(_entryCount);
+    if (!_tags || !_hashes || !_heads || !_rows || !_next) {
+        SQL_LOG(ERROR, "allocate join hash table failed, capacity [%zu]", _capacity);
+        clear();
+        return false;
+    }
+    memset(_tags, 0, sizeof(uint8_t) * _capacity);
+
+    // insert backward so that each chain is linked in ascending row order
+    for (size_t i = _entryCount; i > 0; --i) {
+        const uint32_t entry = i - 1;
+        const size_t hashKey = values[entry].second;
+        const uint8_t tag = makeTag(hashKey);
+        size_t pos = hashKey & _mask;
+        while (_tags[pos] != 0 && (_tags[pos] != tag || _hashes[pos] != hashKey)) {
+            pos = (pos + 1) & _mask;
+        }
+        if (_tags[pos] == 0) {
+            _tags[pos] = tag;
+            _hashes[pos] = hashKey;
+            _heads[pos] = INVALID_ENTRY;
+            ++_keyCount;
+        }
+        _rows[entry] = values[entry].first;
+        _next[entry] = _heads[pos];
+        _heads[pos] = entry;
+    }
+    return true;
+}
+
+void JoinHashTable::clear() {
+    _pool->reset();
+    _tags = nullptr;
+    _hashes = nullptr;
+    _heads = nullptr;
+    _rows = nullptr;
+    _next = nullptr;
+    _capacity = 0;
+    _mask = 0;
+    _keyCount = 0;
+    _entryCount = 0;
+}
+
+size_t JoinHashTable::getMemoryUse() const {
+    return _capacity * (sizeof(uint8_t) + sizeof(size_t) + sizeof(uint32_t))
+           + _entryCount * sizeof(uint32_t) * 2;
+}
+
+} // namespace sql
+} // namespace isearch
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "autil/Log.h"
+
+namespace autil {
+namespace mem_pool {
+class Pool;
+} // namespace mem_pool
+} // namespace autil
+
+namespace isearch {
+namespace sql {
+
+// Open-addressing (linear probing) hash table for hash join build side.
+// Each bucket keeps a tag byte, the full hash value and the head of a row
+// chain; rows of the same key are linked through a contiguous `next` array
+// in ascending row order. All arrays are allocated from a pool owned by the
+// table, which is reset on every build so rebuilding per partition does not
+// accumulate memory.
+class JoinHashTable {
+public:
+    typedef std::vector<std::pair<size_t, size_t>> HashValues; // row : hash value
+    static constexpr uint32_t INVALID_ENTRY = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MIN_CAPACITY = 16;
+
+public:
+    JoinHashTable();
+    ~JoinHashTable();
+    JoinHashTable(const JoinHashTable &) = delete;
+    JoinHashTable &operator=(const JoinHashTable &) = delete;
+
+public:
+    bool build(const HashValues &values);
+    void clear();
+
+    inline uint32_t find(size_t hashKey) const;
+    inline void prefetch(size_t hashKey) const;
+    uint32_t next(uint32_t entry) const {
+        return _next[entry];
+    }
+    size_t row(uint32_t entry) const {
+        return _rows[entry];
+    }
+    // distinct hash keys
+    size_t size() const {
+        return _keyCount;
+    }
+    size_t entryCount() const {
+        return _entryCount;
+    }
+    size_t capacity() const {
+        return _capacity;
+    }
+    size_t getMemoryUse() const;
+
+private:
+    static uint8_t makeTag(size_t hashKey) {
+        return (uint8_t)(hashKey >> 57) | 0x80;
+    }
+    template <typename T>
+    T *allocateArray(size_t count);
+
+private:
+    std::unique_ptr<autil::mem_pool::Pool> _pool;
+    uint8_t *_tags;
+    size_t *_hashes;
+    uint32_t *_heads;
+    uint32_t *_rows;
+    uint32_t *_next;
+    size_t _capacity;
+    size_t _mask;
+    size_t _keyCount;
+    size_t _entryCount;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+inline uint32_t JoinHashTable::find(size_t hashKey) const {
+    if (_capacity == 0) {
+        return INVALID_ENTRY;
+    }
+    const uint8_t tag = makeTag(hashKey);
+    size_t pos = hashKey & _mask;
+    while (_tags[pos] != 0) {
+        if (_tags[pos] == tag && _hashes[pos] == hashKey) {
+            return _heads[pos];
+        }
+        pos = (pos + 1) & _mask;
+    }
+    return INVALID_ENTRY;
+}
+
+inline void JoinHashTable::prefetch(size_t hashKey) const {
+    if (_capacity == 0) {
+        return;
+    }
+    size_t pos = hashKey & _mask;
+    __builtin_prefetch(_tags + pos, 0, 1);
+    __builtin_prefetch(_hashes + pos, 0, 1);
+}
+
+typedef std::shared_ptr<JoinHashTable> JoinHashTablePtr;
+} // namespace sql
+} // namespace isearch
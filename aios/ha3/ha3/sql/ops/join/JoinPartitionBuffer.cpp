@@ -0,0 +1,211 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ha3/sql/ops/join/JoinPartitionBuffer.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <utility>
+
+#include "alog/Logger.h"
+#include "autil/StringUtil.h"
+#include "autil/mem_pool/Pool.h"
+#include "ha3/sql/common/Log.h"
+#include "indexlib/file_system/ErrorCode.h"
+#include "indexlib/file_system/fslib/DeleteOption.h"
+#include "indexlib/file_system/fslib/FslibWrapper.h"
+#include "table/Row.h"
+
+using namespace std;
+using namespace autil;
+using namespace table;
+using namespace indexlib::file_system;
+
+namespace isearch {
+namespace sql {
+AUTIL_LOG_SETUP(sql, JoinPartitionBuffer);
+
+static std::atomic<uint64_t> spillFileSeq(0);
+
+JoinPartitionBuffer::JoinPartitionBuffer(size_t partitionCount,
+                                         const std::string &spillPath,
+                                         size_t spillRowLimit)
+    : _spillPath(spillPath)
+    , _spillRowLimit(spillRowLimit)
+    , _residentRowCount(0)
+    , _chunks(partitionCount)
+    , _rowCounts(partitionCount, 0)
+    , _spillFileCount(0)
+    , _spillBytes(0) {}
+
+JoinPartitionBuffer::~JoinPartitionBuffer() {
+    clear();
+}
+
+bool JoinPartitionBuffer::append(const TablePtr &table, const vector<uint32_t> &partIds) {
+    if (partIds.size() != table->getRowCount()) {
+        SQL_LOG(ERROR,
+                "partition id size [%zu] not match table row count [%zu]",
+                partIds.size(),
+                table->getRowCount());
+        return false;
+    }
+    vector<vector<Row>> partRows(_chunks.size());
+    for (size_t i = 0; i < partIds.size(); ++i) {
+        partRows[partIds[i]].emplace_back(table->getRow(i));
+    }
+    if (_emptyTableData.empty()) {
+        mem_pool::Pool pool;
+        Table emptyTable(vector<Row>(), table->getMatchDocAllocatorPtr());
+        emptyTable.serializeToString(_emptyTableData, &pool);
+    }
+    for (size_t partId = 0; partId < partRows.size(); ++partId) {
+        auto &rows = partRows[partId];
+        if (rows.empty()) {
+            continue;
+        }
+        _rowCounts[partId] += rows.size();
+        _residentRowCount += rows.size();
+        // chunks share allocator with input table, rows are not copied
+        Chunk chunk;
+        chunk.table.reset(new Table(rows, table->getMatchDocAllocatorPtr()));
+        chunk.table->mergeDependentPools(table);
+        _chunks[partId].emplace_back(std::move(chunk));
+    }
+    if (!_spillPath.empty() && _residentRowCount > _spillRowLimit) {
+        return spillResidentChunks();
+    }
+    return true;
+}
+
+bool JoinPartitionBuffer::spillResidentChunks() {
+    // a chunk keeps whole input allocator alive, spill all resident chunks so
+    // every input table referred by partitions is released
+    for (auto &chunks : _chunks) {
+        for (auto &chunk : chunks) {
+            if (!chunk.table) {
+                continue;
+            }
+            if (!spill(chunk.table, chunk.fileName)) {
+                return false;
+            }
+            chunk.table.reset();
+        }
+    }
+    _residentRowCount = 0;
+    return true;
+}
+
+bool JoinPartitionBuffer::popPartition(size_t partId, TablePtr &table) {
+    table.reset();
+    if (partId >= _chunks.size()) {
+        SQL_LOG(ERROR, "invalid partition id [%zu]", partId);
+        return false;
+    }
+    auto chunks = std::move(_chunks[partId]);
+    _chunks[partId].clear();
+    _rowCounts[partId] = 0;
+    if (_emptyTableData.empty()) {
+        return true;
+    }
+    // resident chunks share input allocators with other partitions, copy
+    // them into a table owning its allocator, join compacts probe table
+    deserializeChunk(_emptyTableData, table);
+    for (auto &chunk : chunks) {
+        TablePtr chunkTable = chunk.table;
+        bool copy = chunkTable != nullptr;
+        if (copy) {
+            _residentRowCount -= chunkTable->getRowCount();
+        } else if (!load(chunk.fileName, chunkTable)) {
+            return false;
+        }
+        if (!mergeChunk(chunkTable, copy, table)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void JoinPartitionBuffer::clear() {
+    for (auto &chunks : _chunks) {
+        for (auto &chunk : chunks) {
+            if (!chunk.fileName.empty()) {
+                auto ec = FslibWrapper::DeleteFile(chunk.fileName, DeleteOption::NoFence(true)).Code();
+                if (ec != FSEC_OK) {
+                    SQL_LOG(WARN, "remove spill file [%s] failed", chunk.fileName.c_str());
+                }
+            }
+        }
+        chunks.clear();
+    }
+    _rowCounts.assign(_rowCounts.size(), 0);
+    _residentRowCount = 0;
+}
+
+bool JoinPartitionBuffer::spill(const TablePtr &table, string &fileName) {
+    fileName = _spillPath + "/hash_join_spill_" + StringUtil::toString(getpid()) + "_"
+               + StringUtil::toString(spillFileSeq.fetch_add(1));
+    mem_pool::Pool pool;
+    string data;
+    table->serializeToString(data, &pool);
+    auto ec = FslibWrapper::Store(fileName, data).Code();
+    if (ec != FSEC_OK) {
+        SQL_LOG(ERROR, "spill partition to [%s] failed, ec [%d]", fileName.c_str(), ec);
+        return false;
+    }
+    ++_spillFileCount;
+    _spillBytes += data.size();
+    return true;
+}
+
+bool JoinPartitionBuffer::load(const string &fileName, TablePtr &table) {
+    string data;
+    auto ec = FslibWrapper::Load(fileName, data).Code();
+    if (ec != FSEC_OK) {
+        SQL_LOG(ERROR, "load spilled partition [%s] failed, ec [%d]", fileName.c_str(), ec);
+        return false;
+    }
+    ec = FslibWrapper::DeleteFile(fileName, DeleteOption::NoFence(true)).Code();
+    if (ec != FSEC_OK) {
+        SQL_LOG(WARN, "remove spill file [%s] failed", fileName.c_str());
+    }
+    deserializeChunk(data, table);
+    return true;
+}
+
+void JoinPartitionBuffer::deserializeChunk(const string &data, TablePtr &table) const {
+    // each chunk owns its pool, released with the joined partition;
+    // deserialized values may refer to buffer, keep it in that pool
+    mem_pool::PoolPtr poolPtr(new mem_pool::Pool());
+    char *buffer = static_cast<char *>(poolPtr->allocate(data.size()));
+    memcpy(buffer, data.data(), data.size());
+    table.reset(new Table(poolPtr));
+    table->deserializeFromString(buffer, data.size(), poolPtr.get());
+}
+
+bool JoinPartitionBuffer::mergeChunk(const TablePtr &chunk, bool copy, TablePtr &table) {
+    // loaded chunks own their allocator and can be merged without copy
+    bool ret = copy ? table->copyTable(chunk) : table->merge(chunk);
+    table->mergeDependentPools(chunk);
+    if (!ret) {
+        SQL_LOG(ERROR, "merge partition chunk failed");
+        return false;
+    }
+    return true;
+}
+
+} // namespace sql
+} // namespace isearch
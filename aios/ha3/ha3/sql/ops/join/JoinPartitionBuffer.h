@@ -0,0 +1,93 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "autil/Log.h"
+#include "table/Table.h"
+
+namespace isearch {
+namespace sql {
+
+// Rows of one join input split into hash partitions, used by partitioned
+// (grace) hash join. Partition chunks refer to rows of input tables, when
+// resident rows exceed spill row limit all resident chunks are serialized to
+// files under spill path, so input tables can be released.
+class JoinPartitionBuffer {
+public:
+    JoinPartitionBuffer(size_t partitionCount, const std::string &spillPath, size_t spillRowLimit);
+    ~JoinPartitionBuffer();
+    JoinPartitionBuffer(const JoinPartitionBuffer &) = delete;
+    JoinPartitionBuffer &operator=(const JoinPartitionBuffer &) = delete;
+
+public:
+    // partIds[i] is partition of row i in table, chunks keep table rows and
+    // pools alive until they are popped or spilled
+    bool append(const table::TablePtr &table, const std::vector<uint32_t> &partIds);
+    // merge all chunks of partition into one table, table has no rows if
+    // partition is empty, nullptr if nothing is appended
+    bool popPartition(size_t partId, table::TablePtr &table);
+    void clear();
+
+    size_t getPartitionCount() const {
+        return _chunks.size();
+    }
+    size_t getPartitionRowCount(size_t partId) const {
+        return _rowCounts[partId];
+    }
+    size_t getSpillFileCount() const {
+        return _spillFileCount;
+    }
+    size_t getSpillBytes() const {
+        return _spillBytes;
+    }
+
+private:
+    bool spillResidentChunks();
+    bool spill(const table::TablePtr &table, std::string &fileName);
+    bool load(const std::string &fileName, table::TablePtr &table);
+    void deserializeChunk(const std::string &data, table::TablePtr &table) const;
+    bool mergeChunk(const table::TablePtr &chunk, bool copy, table::TablePtr &table);
+
+private:
+    struct Chunk {
+        table::TablePtr table;
+        std::string fileName;
+    };
+
+private:
+    std::string _spillPath;
+    size_t _spillRowLimit;
+    size_t _residentRowCount;
+    // serialized input schema without rows, for empty partitions
+    std::string _emptyTableData;
+    std::vector<std::vector<Chunk>> _chunks;
+    std::vector<size_t> _rowCounts;
+    size_t _spillFileCount;
+    size_t _spillBytes;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+typedef std::shared_ptr<JoinPartitionBuffer> JoinPartitionBufferPtr;
+} // namespace sql
+} // namespace isearch
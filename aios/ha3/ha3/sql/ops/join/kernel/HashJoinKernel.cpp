@@ -15,6 +15,7 @@
  */
 #include "ha3/sql/ops/join/HashJoinKernel.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <stdint.h>
@@ -24,14 +25,18 @@
 #include <vector>
 
 #include "alog/Logger.h"
+#include "autil/StringUtil.h"
 #include "autil/TimeUtility.h"
 #include "autil/mem_pool/Pool.h"
 #include "ha3/sql/common/Log.h"
+#include "ha3/sql/common/common.h"
 #include "ha3/sql/data/TableData.h"
 #include "ha3/sql/data/TableType.h"
 #include "ha3/sql/ops/join/JoinBase.h"
+#include "ha3/sql/ops/join/JoinHashTable.h"
 #include "ha3/sql/ops/join/JoinInfoCollector.h"
 #include "ha3/sql/ops/join/JoinKernelBase.h"
+#include "ha3/sql/ops/join/JoinPartitionBuffer.h"
 #include "ha3/sql/ops/util/KernelUtil.h"
 #include "ha3/sql/proto/SqlSearchInfo.pb.h"
 #include "ha3/sql/proto/SqlSearchInfoCollector.h"
@@ -48,6 +53,8 @@
 #include "navi/engine/KernelConfigContext.h"
 #include "navi/engine/Resource.h"
 #include "navi/resource/GraphMemoryPoolResource.h" // IWYU pragma: keep
+#include "table/Column.h"
+#include "table/ColumnSchema.h"
 #include "table/Row.h"
 #include "table/Table.h"
 #include "table/TableUtil.h"
@@ -61,14 +68,26 @@ namespace isearch {
 namespace sql {
 
 const size_t HashJoinKernel::DEFAULT_BUFFER_LIMIT_SIZE = 1024 * 1024;
+const size_t HashJoinKernel::PROBE_PREFETCH_DISTANCE = 16;
+const size_t HashJoinKernel::DEFAULT_PARTITION_COUNT = 32;
+const size_t HashJoinKernel::DEFAULT_SPILL_ROW_LIMIT = 4 * 1024 * 1024;
+const std::string HashJoinKernel::HASH_TABLE_TYPE_DEFAULT = "default";
+const std::string HashJoinKernel::HASH_TABLE_TYPE_FLAT = "flat";
 
 HashJoinKernel::HashJoinKernel()
     : _bufferLimitSize(DEFAULT_BUFFER_LIMIT_SIZE)
+    , _hashTableType(HASH_TABLE_TYPE_DEFAULT)
     , _hashMapCreated(false)
     , _hashLeftTable(true)
     , _leftEof(false)
     , _rightEof(false)
     , _totalOutputRowCount(0)
+    , _partitionCount(DEFAULT_PARTITION_COUNT)
+    , _spillRowLimit(DEFAULT_SPILL_ROW_LIMIT)
+    , _partitionedJoin(false)
+    , _partitionInputDone(false)
+    , _partitionLoaded(false)
+    , _currentPartition(0)
 {}
 
 HashJoinKernel::~HashJoinKernel() {
@@ -92,6 +111,26 @@ bool HashJoinKernel::config(navi::KernelConfigContext &ctx) {
         return false;
     }
     ctx.Jsonize("buffer_limit_size", _bufferLimitSize, _bufferLimitSize);
+    ctx.Jsonize("hash_table_type", _hashTableType, _hashTableType);
+    auto iter = _hashHints.find("hashTableType");
+    if (iter != _hashHints.end()) {
+        _hashTableType = iter->second;
+    }
+    if (_hashTableType != HASH_TABLE_TYPE_DEFAULT && _hashTableType != HASH_TABLE_TYPE_FLAT) {
+        SQL_LOG(WARN,
+                "unknown hash table type [%s], use [%s]",
+                _hashTableType.c_str(),
+                HASH_TABLE_TYPE_DEFAULT.c_str());
+        _hashTableType = HASH_TABLE_TYPE_DEFAULT;
+    }
+    _joinInfo.set_hashtabletype(_hashTableType);
+    ctx.Jsonize("partition_count", _partitionCount, _partitionCount);
+    ctx.Jsonize("spill_path", _spillPath, _spillPath);
+    ctx.Jsonize("spill_row_limit", _spillRowLimit, _spillRowLimit);
+    iter = _hashHints.find("partitionCount");
+    if (iter != _hashHints.end()) {
+        StringUtil::fromString(iter->second, _partitionCount);
+    }
     return true;
 }
 
@@ -109,6 +148,15 @@ navi::ErrorCode HashJoinKernel::compute(navi::KernelComputeContext &runContext)
         SQL_LOG(ERROR, "get right input failed");
         return navi::EC_ABORT;
     }
+    if (!_partitionedJoin && !_hashMapCreated && needPartitionedJoin()) {
+        if (!initPartitionedJoin()) {
+            SQL_LOG(ERROR, "init partitioned hash join failed");
+            return navi::EC_ABORT;
+        }
+    }
+    if (_partitionedJoin) {
+        return computePartitioned(runContext, beginTime);
+    }
     if ((_leftEof && _leftBuffer == nullptr) || (_rightEof && _rightBuffer == nullptr)) {
         runContext.setOutput(outPort, nullptr, true);
         return navi::EC_NONE;
@@ -203,44 +251,289 @@ bool HashJoinKernel::doCompute(table::TablePtr &outputTable) {
     return true;
 }
 
+bool HashJoinKernel::needPartitionedJoin() const {
+    // partitions only bound memory when they can spill, keep normal path
+    // without spill path
+    if (_partitionCount <= 1 || _spillPath.empty() || !_leftBuffer
+        || _leftBuffer->getRowCount() <= _bufferLimitSize || !_rightBuffer
+        || _rightBuffer->getRowCount() <= _bufferLimitSize)
+    {
+        return false;
+    }
+    // multi value keys put one row into several partitions, keep normal path
+    return isSingleValueJoinKey(_leftBuffer, _leftJoinColumns)
+           && isSingleValueJoinKey(_rightBuffer, _rightJoinColumns);
+}
+
+bool HashJoinKernel::isSingleValueJoinKey(const table::TablePtr &table,
+                                          const vector<string> &joinColumns) const {
+    for (const auto &columnName : joinColumns) {
+        auto column = table->getColumn(columnName);
+        if (column == nullptr || column->getColumnSchema() == nullptr
+            || column->getColumnSchema()->getType().isMultiValue())
+        {
+            SQL_LOG(DEBUG,
+                    "join column [%s] is not single value, skip partitioned hash join",
+                    columnName.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HashJoinKernel::initPartitionedJoin() {
+    _leftPartitions.reset(new JoinPartitionBuffer(_partitionCount, _spillPath, _spillRowLimit));
+    _rightPartitions.reset(new JoinPartitionBuffer(_partitionCount, _spillPath, _spillRowLimit));
+    _partitionedJoin = true;
+    _joinInfo.set_partitioncount(_partitionCount);
+    SQL_LOG(DEBUG,
+            "input buffers exceed limit [%zu], use partitioned hash join,"
+            " partition count [%zu], spill path [%s]",
+            _bufferLimitSize,
+            _partitionCount,
+            _spillPath.c_str());
+    return true;
+}
+
+navi::ErrorCode HashJoinKernel::computePartitioned(navi::KernelComputeContext &runContext,
+                                                   uint64_t beginTime) {
+    navi::PortIndex outPort(0, navi::INVALID_INDEX);
+    if (!_partitionInputDone) {
+        if (!partitionInput(_leftBuffer, true, _leftEof)
+            || !partitionInput(_rightBuffer, false, _rightEof))
+        {
+            SQL_LOG(ERROR, "partition input failed");
+            return navi::EC_ABORT;
+        }
+        _joinInfo.set_spillfilecount(_leftPartitions->getSpillFileCount()
+                                     + _rightPartitions->getSpillFileCount());
+        _joinInfo.set_spillbytes(_leftPartitions->getSpillBytes()
+                                 + _rightPartitions->getSpillBytes());
+        if (!_leftEof || !_rightEof) {
+            JoinInfoCollector::incTotalTime(&_joinInfo, TimeUtility::currentTime() - beginTime);
+            return navi::EC_NONE;
+        }
+        _partitionInputDone = true;
+    }
+    table::TablePtr outputTable = nullptr;
+    if (!joinPartition(outputTable)) {
+        SQL_LOG(ERROR, "join partition [%zu] failed", _currentPartition);
+        return navi::EC_ABORT;
+    }
+    JoinInfoCollector::incTotalTime(&_joinInfo, TimeUtility::currentTime() - beginTime);
+    if (outputTable) {
+        _totalOutputRowCount += outputTable->getRowCount();
+    }
+    bool eof = _currentPartition >= _partitionCount
+               || canTruncate(_totalOutputRowCount, _truncateThreshold);
+    if (eof) {
+        SQL_LOG(DEBUG, "join info: [%s]", _joinInfo.ShortDebugString().c_str());
+    }
+    if (_sqlSearchInfoCollector) {
+        _sqlSearchInfoCollector->overwriteJoinInfo(_joinInfo);
+    }
+    if (outputTable) {
+        TableDataPtr tableData(new TableData(outputTable));
+        runContext.setOutput(outPort, tableData, eof);
+    } else if (eof) {
+        runContext.setOutput(outPort, nullptr, true);
+    }
+    return navi::EC_NONE;
+}
+
+bool HashJoinKernel::partitionInput(table::TablePtr &buffer, bool isLeft, bool eof) {
+    if (!buffer) {
+        return true;
+    }
+    if (buffer->getRowCount() < _bufferLimitSize && !eof) {
+        return true;
+    }
+    if (buffer->getRowCount() > 0) {
+        vector<uint32_t> partIds;
+        if (!getPartitionIds(buffer, isLeft, partIds)) {
+            return false;
+        }
+        auto &partitions = isLeft ? _leftPartitions : _rightPartitions;
+        if (!partitions->append(buffer, partIds)) {
+            return false;
+        }
+    }
+    // partitions keep input pools alive until their rows are spilled
+    buffer.reset();
+    return true;
+}
+
+bool HashJoinKernel::getPartitionIds(const table::TablePtr &table,
+                                     bool isLeft,
+                                     vector<uint32_t> &partIds) {
+    const auto &joinColumns = isLeft ? _leftJoinColumns : _rightJoinColumns;
+    HashValues values;
+    if (!getHashValues(table, 0, table->getRowCount(), joinColumns, values)) {
+        return false;
+    }
+    if (values.size() != table->getRowCount()) {
+        SQL_LOG(ERROR,
+                "partitioned hash join only supports single value join keys,"
+                " row count [%zu], hash value count [%zu]",
+                table->getRowCount(),
+                values.size());
+        return false;
+    }
+    partIds.resize(values.size());
+    for (const auto &valuePair : values) {
+        // use high bits, low bits are used by hash table buckets
+        partIds[valuePair.first] = (valuePair.second >> 32) % _partitionCount;
+    }
+    return true;
+}
+
+bool HashJoinKernel::loadPartition(size_t partId) {
+    if (!_leftPartitions->popPartition(partId, _leftBuffer)
+        || !_rightPartitions->popPartition(partId, _rightBuffer))
+    {
+        return false;
+    }
+    if (!_leftBuffer || !_rightBuffer) {
+        SQL_LOG(ERROR, "partition [%zu] has no schema, input is never partitioned", partId);
+        return false;
+    }
+    _hashMapCreated = false;
+    _shouldClearTable = false;
+    _partitionLoaded = true;
+    SQL_LOG(TRACE1,
+            "load partition [%zu], left row count [%zu], right row count [%zu]",
+            partId,
+            _leftBuffer->getRowCount(),
+            _rightBuffer->getRowCount());
+    return true;
+}
+
+bool HashJoinKernel::joinPartition(table::TablePtr &outputTable) {
+    bool rightRequired = _joinType == SQL_INNER_JOIN_TYPE || _joinType == SQL_SEMI_JOIN_TYPE;
+    while (_currentPartition < _partitionCount) {
+        if (!_partitionLoaded) {
+            // left rows drive every join type, skip partitions without output
+            if (_leftPartitions->getPartitionRowCount(_currentPartition) == 0
+                || (rightRequired
+                    && _rightPartitions->getPartitionRowCount(_currentPartition) == 0))
+            {
+                table::TablePtr dropped;
+                if (!_leftPartitions->popPartition(_currentPartition, dropped)
+                    || !_rightPartitions->popPartition(_currentPartition, dropped))
+                {
+                    return false;
+                }
+                ++_currentPartition;
+                continue;
+            }
+            if (!loadPartition(_currentPartition)) {
+                return false;
+            }
+        }
+        if (!_hashMapCreated && !tryCreateHashMap()) {
+            return false;
+        }
+        if (!doCompute(outputTable)) {
+            return false;
+        }
+        outputTable->mergeDependentPools(_leftBuffer);
+        outputTable->mergeDependentPools(_rightBuffer);
+        auto largeTable = _hashLeftTable ? _rightBuffer : _leftBuffer;
+        if (largeTable->getRowCount() == 0) {
+            // output keeps the pools it refers to, drop the rest of partition
+            _leftBuffer.reset();
+            _rightBuffer.reset();
+            _partitionLoaded = false;
+            ++_currentPartition;
+        }
+        return true;
+    }
+    return true;
+}
+
 bool HashJoinKernel::tryCreateHashMap() {
-    if (_leftBuffer && _leftBuffer->getRowCount() > _bufferLimitSize && _rightBuffer
-        && _rightBuffer->getRowCount() > _bufferLimitSize) {
+    if (!_partitionedJoin && _leftBuffer && _leftBuffer->getRowCount() > _bufferLimitSize
+        && _rightBuffer && _rightBuffer->getRowCount() > _bufferLimitSize) {
         SQL_LOG(ERROR, "input buffers exceed limit, cannot make hash join");
         return false;
     }
     // todo optimize
     if (_leftEof && _rightBuffer && _leftBuffer->getRowCount() <= _rightBuffer->getRowCount()) {
         _hashLeftTable = true;
-        if (!createHashMap(_leftBuffer, 0, _leftBuffer->getRowCount(), _hashLeftTable)) {
+        if (!createHashTable(_leftBuffer, _hashLeftTable)) {
             SQL_LOG(ERROR, "create hash table with left buffer failed.");
             return false;
         }
         _hashMapCreated = true;
         SQL_LOG(TRACE1,
-                "create hash table with left buffer."
+                "create [%s] hash table with left buffer."
                 " left buffer size[%zu], right buffer size[%zu], hash map size[%zu]",
+                _hashTableType.c_str(),
                 _leftBuffer->getRowCount(),
                 _rightBuffer->getRowCount(),
-                _hashJoinMap.size());
+                getHashTableSize());
     } else if (_rightEof && _leftBuffer
                && _rightBuffer->getRowCount() <= _leftBuffer->getRowCount()) {
         _hashLeftTable = false;
-        if (!createHashMap(_rightBuffer, 0, _rightBuffer->getRowCount(), _hashLeftTable)) {
+        if (!createHashTable(_rightBuffer, _hashLeftTable)) {
             SQL_LOG(ERROR, "create hash table with right buffer failed.");
             return false;
         }
         _hashMapCreated = true;
         SQL_LOG(TRACE1,
-                "create hash table with right buffer."
+                "create [%s] hash table with right buffer."
                 " left buffer size[%zu], right buffer size[%zu], hash map size[%zu]",
+                _hashTableType.c_str(),
                 _leftBuffer->getRowCount(),
                 _rightBuffer->getRowCount(),
-                _hashJoinMap.size());
+                getHashTableSize());
+    }
+    return true;
+}
+
+bool HashJoinKernel::createHashTable(const table::TablePtr &table, bool hashLeftTable) {
+    if (_hashTableType == HASH_TABLE_TYPE_FLAT) {
+        return createFlatHashTable(table, hashLeftTable);
+    }
+    return createHashMap(table, 0, table->getRowCount(), hashLeftTable);
+}
+
+bool HashJoinKernel::createFlatHashTable(const table::TablePtr &table, bool hashLeftTable) {
+    uint64_t beginHash = TimeUtility::currentTime();
+    const auto &joinColumns = hashLeftTable ? _leftJoinColumns : _rightJoinColumns;
+    HashValues values;
+    if (!getHashValues(table, 0, table->getRowCount(), joinColumns, values)) {
+        return false;
+    }
+    if (hashLeftTable) {
+        JoinInfoCollector::incLeftHashCount(&_joinInfo, values.size());
+    } else {
+        JoinInfoCollector::incRightHashCount(&_joinInfo, values.size());
+    }
+    uint64_t afterHash = TimeUtility::currentTime();
+    JoinInfoCollector::incHashTime(&_joinInfo, afterHash - beginHash);
+    if (!_flatHashTable) {
+        // reused by every partition of partitioned join, build resets its pool
+        _flatHashTable.reset(new JoinHashTable());
+    }
+    if (!_flatHashTable->build(values)) {
+        SQL_LOG(ERROR, "build flat join hash table failed");
+        return false;
     }
+    JoinInfoCollector::incHashMapSize(&_joinInfo, _flatHashTable->size());
+    _joinInfo.set_hashtablememoryuse(_flatHashTable->getMemoryUse());
+    uint64_t endHash = TimeUtility::currentTime();
+    JoinInfoCollector::incCreateTime(&_joinInfo, endHash - afterHash);
     return true;
 }
 
+size_t HashJoinKernel::getHashTableSize() const {
+    if (_flatHashTable) {
+        return _flatHashTable->size();
+    }
+    return _hashJoinMap.size();
+}
+
 bool HashJoinKernel::joinTable(size_t &joinedRowCount) {
     uint64_t beginJoin = TimeUtility::currentTime();
     auto largeTable = _hashLeftTable ? _rightBuffer : _leftBuffer;
@@ -256,7 +549,11 @@ bool HashJoinKernel::joinTable(size_t &joinedRowCount) {
     }
     uint64_t afterHash = TimeUtility::currentTime();
     JoinInfoCollector::incHashTime(&_joinInfo, afterHash - beginJoin);
-    joinedRowCount = makeHashJoin(largeTableValues);
+    if (_flatHashTable) {
+        joinedRowCount = makeFlatHashJoin(largeTableValues);
+    } else {
+        joinedRowCount = makeHashJoin(largeTableValues);
+    }
     uint64_t afterJoin = TimeUtility::currentTime();
     JoinInfoCollector::incJoinTime(&_joinInfo, afterJoin - afterHash);
     return true;
@@ -294,6 +591,45 @@ size_t HashJoinKernel::makeHashJoin(const HashValues &values) {
     return oriRow + 1;
 }
 
+size_t HashJoinKernel::makeFlatHashJoin(const HashValues &values) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t joinedCount = 0;
+    size_t oriRow = values[0].first;
+    reserveJoinRow(values.size());
+    const size_t valueCount = values.size();
+    for (size_t i = 0; i < std::min(PROBE_PREFETCH_DISTANCE, valueCount); ++i) {
+        _flatHashTable->prefetch(values[i].second);
+    }
+    for (size_t i = 0; i < valueCount; ++i) {
+        if (i + PROBE_PREFETCH_DISTANCE < valueCount) {
+            _flatHashTable->prefetch(values[i + PROBE_PREFETCH_DISTANCE].second);
+        }
+        const auto &valuePair = values[i];
+        auto &largeRow = valuePair.first;
+        // multi field joined same row
+        if (largeRow > oriRow && joinedCount >= _batchSize) {
+            SQL_LOG(TRACE1,
+                    "joined count[%zu] over batch size[%zu], used large row[%zu]",
+                    joinedCount,
+                    _batchSize,
+                    largeRow);
+            return largeRow;
+        }
+        for (uint32_t entry = _flatHashTable->find(valuePair.second);
+             entry != JoinHashTable::INVALID_ENTRY;
+             entry = _flatHashTable->next(entry))
+        {
+            joinRow(_flatHashTable->row(entry), largeRow);
+            ++joinedCount;
+        }
+        oriRow = largeRow;
+    }
+    SQL_LOG(TRACE1, "joined count[%zu], used large row[%zu]", joinedCount, oriRow + 1);
+    return oriRow + 1;
+}
+
 REGISTER_KERNEL(HashJoinKernel);
 
 } // namespace sql
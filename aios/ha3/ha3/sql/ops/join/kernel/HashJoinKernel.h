@@ -17,8 +17,13 @@
 
 #include <memory>
 #include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
 
+#include "ha3/sql/ops/join/JoinHashTable.h"
 #include "ha3/sql/ops/join/JoinKernelBase.h"
+#include "ha3/sql/ops/join/JoinPartitionBuffer.h"
 #include "navi/common.h"
 #include "navi/engine/KernelConfigContext.h"
 #include "table/Table.h"
@@ -34,6 +39,11 @@ namespace sql {
 class HashJoinKernel : public JoinKernelBase {
 public:
     static const size_t DEFAULT_BUFFER_LIMIT_SIZE;
+    static const size_t PROBE_PREFETCH_DISTANCE;
+    static const size_t DEFAULT_PARTITION_COUNT;
+    static const size_t DEFAULT_SPILL_ROW_LIMIT;
+    static const std::string HASH_TABLE_TYPE_DEFAULT;
+    static const std::string HASH_TABLE_TYPE_FLAT;
 
 public:
     HashJoinKernel();
@@ -46,12 +56,31 @@ public:
 
 private:
     bool doCompute(table::TablePtr &outputTable);
+    // partitioned (grace) hash join, used when both inputs exceed buffer limit
+    bool needPartitionedJoin() const;
+    bool isSingleValueJoinKey(const table::TablePtr &table,
+                              const std::vector<std::string> &joinColumns) const;
+    bool initPartitionedJoin();
+    navi::ErrorCode computePartitioned(navi::KernelComputeContext &runContext,
+                                       uint64_t beginTime);
+    bool partitionInput(table::TablePtr &buffer, bool isLeft, bool eof);
+    bool getPartitionIds(const table::TablePtr &table,
+                         bool isLeft,
+                         std::vector<uint32_t> &partIds);
+    bool loadPartition(size_t partId);
+    bool joinPartition(table::TablePtr &outputTable);
     bool tryCreateHashMap();
+    bool createHashTable(const table::TablePtr &table, bool hashLeftTable);
+    bool createFlatHashTable(const table::TablePtr &table, bool hashLeftTable);
+    size_t getHashTableSize() const;
     bool joinTable(size_t &joinedRowCount);
     size_t makeHashJoin(const HashValues &values);
+    size_t makeFlatHashJoin(const HashValues &values);
 
 private:
     size_t _bufferLimitSize;
+    std::string _hashTableType;
+    JoinHashTablePtr _flatHashTable;
     bool _hashMapCreated;
     bool _hashLeftTable;
     table::TablePtr _leftBuffer;
@@ -59,6 +88,15 @@ private:
     bool _leftEof;
     bool _rightEof;
     size_t _totalOutputRowCount;
+    size_t _partitionCount;
+    std::string _spillPath;
+    size_t _spillRowLimit;
+    bool _partitionedJoin;
+    bool _partitionInputDone;
+    bool _partitionLoaded;
+    size_t _currentPartition;
+    JoinPartitionBufferPtr _leftPartitions;
+    JoinPartitionBufferPtr _rightPartitions;
 };
 
 typedef std::shared_ptr<HashJoinKernel> HashJoinKernelPtr;
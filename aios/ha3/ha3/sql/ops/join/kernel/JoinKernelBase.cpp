@@ -57,6 +57,7 @@
 #include "ha3/sql/resource/TabletManagerR.h"
 #include "kmonitor/client/MetricMacro.h"
 #include "kmonitor/client/MetricsReporter.h"
+#include "kmonitor/client/core/MetricsTags.h"
 #include "kmonitor/client/core/MutableMetric.h"
 #include "matchdoc/ValueType.h"
 #include "matchdoc/flatbuffer/MatchDoc_generated.h"
@@ -77,10 +78,6 @@ class KernelComputeContext;
 class KernelInitContext;
 } // namespace navi
 
-namespace kmonitor {
-class MetricsTags;
-} // namespace kmonitor
-
 using namespace std;
 using namespace autil;
 using namespace matchdoc;
@@ -100,11 +97,15 @@ public:
         REGISTER_LATENCY_MUTABLE_METRIC(_totalEvaluateTime, "TotalEvaluateTime");
         REGISTER_LATENCY_MUTABLE_METRIC(_totalJoinTime, "TotalJoinTime");
         REGISTER_LATENCY_MUTABLE_METRIC(_totalHashTime, "TotalHashTime");
+        REGISTER_LATENCY_MUTABLE_METRIC(_totalCreateTime, "TotalCreateTime");
         REGISTER_LATENCY_MUTABLE_METRIC(_totalTime, "TotalTime");
         REGISTER_GAUGE_MUTABLE_METRIC(_totalJoinCount, "TotalJoinCount");
         REGISTER_GAUGE_MUTABLE_METRIC(_totalRightHashCount, "TotalRightHashCount");
         REGISTER_GAUGE_MUTABLE_METRIC(_totalLeftHashCount, "TotalLeftHashCount");
         REGISTER_GAUGE_MUTABLE_METRIC(_hashMapSize, "HashMapSize");
+        REGISTER_GAUGE_MUTABLE_METRIC(_hashTableMemoryUse, "HashTableMemoryUse");
+        REGISTER_GAUGE_MUTABLE_METRIC(_partitionCount, "PartitionCount");
+        REGISTER_GAUGE_MUTABLE_METRIC(_spillBytes, "SpillBytes");
         REGISTER_GAUGE_MUTABLE_METRIC(_totalComputeTimes, "TotalComputeTimes");
         REGISTER_GAUGE_MUTABLE_METRIC(_rightScanTime, "RightScanTime");
         REGISTER_GAUGE_MUTABLE_METRIC(_rightUpdateQueryTime, "RightUpdateQueryTime");
@@ -115,11 +116,15 @@ public:
         REPORT_MUTABLE_METRIC(_totalEvaluateTime, joinInfo->totalevaluatetime() / 1000.0);
         REPORT_MUTABLE_METRIC(_totalJoinTime, joinInfo->totaljointime() / 1000.0);
         REPORT_MUTABLE_METRIC(_totalHashTime, joinInfo->totalhashtime() / 1000.0);
+        REPORT_MUTABLE_METRIC(_totalCreateTime, joinInfo->totalcreatetime() / 1000.0);
         REPORT_MUTABLE_METRIC(_totalTime, joinInfo->totalusetime() / 1000.0);
         REPORT_MUTABLE_METRIC(_totalJoinCount, joinInfo->totaljoincount());
         REPORT_MUTABLE_METRIC(_totalRightHashCount, joinInfo->totalrighthashcount());
         REPORT_MUTABLE_METRIC(_totalLeftHashCount, joinInfo->totallefthashcount());
         REPORT_MUTABLE_METRIC(_hashMapSize, joinInfo->hashmapsize());
+        REPORT_MUTABLE_METRIC(_hashTableMemoryUse, joinInfo->hashtablememoryuse());
+        REPORT_MUTABLE_METRIC(_partitionCount, joinInfo->partitioncount());
+        REPORT_MUTABLE_METRIC(_spillBytes, joinInfo->spillbytes());
         REPORT_MUTABLE_METRIC(_totalComputeTimes, joinInfo->totalcomputetimes());
         REPORT_MUTABLE_METRIC(_rightScanTime, joinInfo->rightscantime() / 1000.0);
         REPORT_MUTABLE_METRIC(_rightUpdateQueryTime, joinInfo->rightupdatequerytime() / 1000.0);
@@ -130,6 +135,7 @@ private:
     MutableMetric *_totalEvaluateTime = nullptr;
     MutableMetric *_totalJoinTime = nullptr;
     MutableMetric *_totalHashTime = nullptr;
+    MutableMetric *_totalCreateTime = nullptr;
     MutableMetric *_totalTime = nullptr;
     MutableMetric *_totalJoinCount = nullptr;
     MutableMetric *_rightScanTime = nullptr;
@@ -137,6 +143,9 @@ private:
     MutableMetric *_totalRightHashCount = nullptr;
     MutableMetric *_totalLeftHashCount = nullptr;
     MutableMetric *_hashMapSize = nullptr;
+    MutableMetric *_hashTableMemoryUse = nullptr;
+    MutableMetric *_partitionCount = nullptr;
+    MutableMetric *_spillBytes = nullptr;
     MutableMetric *_totalComputeTimes = nullptr;
 };
 
@@ -587,7 +596,11 @@ void JoinKernelBase::patchHintInfo(const map<string, string> &hintsMap) {
 void JoinKernelBase::reportMetrics() {
     if (_queryMetricsReporter != nullptr) {
         string pathName = "sql.user.ops." + getKernelName();
-        auto opMetricsReporter = _queryMetricsReporter->getSubReporter(pathName, {});
+        kmonitor::MetricsTags tags;
+        if (!_joinInfo.hashtabletype().empty()) {
+            tags.AddTag("hash_table", _joinInfo.hashtabletype());
+        }
+        auto opMetricsReporter = _queryMetricsReporter->getSubReporter(pathName, tags);
         opMetricsReporter->report<JoinOpMetrics, JoinInfo>(nullptr, &_joinInfo);
     }
 }
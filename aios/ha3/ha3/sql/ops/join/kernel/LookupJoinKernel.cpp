@@ -17,14 +17,17 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <set>
 #include <stdint.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "alog/Logger.h"
 #include "autil/CommonMacros.h"
+#include "autil/Hyperloglog.h"
 #include "autil/MultiValueType.h"
 #include "autil/StringUtil.h"
 #include "autil/TimeUtility.h"
@@ -49,6 +52,7 @@
 #include "ha3/sql/common/Log.h"
 #include "ha3/sql/common/common.h"
 #include "ha3/sql/data/TableData.h"
+#include "ha3/sql/ops/condition/ExprUtil.h"
 #include "ha3/sql/ops/externalTable/ha3sql/Ha3SqlRemoteScan.h"
 #include "ha3/sql/ops/join/JoinBase.h"
 #include "ha3/sql/ops/join/JoinInfoCollector.h"
@@ -93,6 +97,12 @@ namespace isearch {
 namespace sql {
 
 static const size_t LOOKUP_BATCH_SIZE = 512;
+// adaptive mode scans whole build table into memory, limit its doc count
+static const size_t ADAPTIVE_BUILD_LIMIT = 1 << 20;
+// and its memory, docs of wide rows or long strings overflow it before doc limit
+static const size_t ADAPTIVE_BUILD_BYTES_LIMIT = 256UL << 20;
+// cost of one key lookup, in unit of docs seeked by full scan
+static const double ADAPTIVE_LOOKUP_COST_RATIO = 16.0;
 
 void LookupJoinBatch::reset(const std::shared_ptr<table::Table> &table_) {
     table = table_;
@@ -123,6 +133,12 @@ LookupJoinKernel::LookupJoinKernel()
     , _useMatchedRow(false)
     , _leftTableIndexed(false)
     , _disableMatchRowIndexOptimize(false)
+    , _adaptiveJoin(false)
+    , _strategyDecided(false)
+    , _useHashStrategy(false)
+    , _adaptiveBuildLimit(ADAPTIVE_BUILD_LIMIT)
+    , _adaptiveBuildBytesLimit(ADAPTIVE_BUILD_BYTES_LIMIT)
+    , _adaptiveLookupCostRatio(ADAPTIVE_LOOKUP_COST_RATIO)
     , _lookupBatchSize(LOOKUP_BATCH_SIZE)
     , _lookupTurncateThreshold(0)
     , _hasJoinedCount(0)
@@ -324,7 +340,12 @@ navi::ErrorCode LookupJoinKernel::finishLastJoin(navi::KernelComputeContext &run
         return navi::EC_NONE;
     }
     bool truncated;
-    if (!scanAndJoin(_streamQuery, _batch, _outputTable, truncated)) {
+    if (_useHashStrategy) {
+        if (!hashJoinBuildTable(_batch, _outputTable, truncated)) {
+            SQL_LOG(ERROR, "hash join with build table failed");
+            return navi::EC_ABORT;
+        }
+    } else if (!scanAndJoin(_streamQuery, _batch, _outputTable, truncated)) {
         SQL_LOG(ERROR, "batch scan and join failed");
         return navi::EC_ABORT;
     }
@@ -375,8 +396,14 @@ navi::ErrorCode LookupJoinKernel::startNewLookup(navi::KernelComputeContext &run
             runContext.setOutput(portIndex, nullptr, true);
             return navi::EC_NONE;
         }
+        if (_adaptiveJoin && !_strategyDecided && !decideJoinStrategy(inputTable)) {
+            return navi::EC_ABORT;
+        }
     }
     _batch.next(_lookupBatchSize);
+    if (_useHashStrategy) {
+        return navi::EC_NONE;
+    }
 
     _streamQuery = genFinalStreamQuery(_batch);
     if (_useMatchedRow) {
@@ -530,6 +557,10 @@ bool LookupJoinKernel::doHashJoin(const LookupJoinBatch &batch,
         SQL_LOG(ERROR, "create hash table with right buffer failed.");
         return false;
     }
+    return probeHashMap(batch);
+}
+
+bool LookupJoinKernel::probeHashMap(const LookupJoinBatch &batch) {
     uint64_t beginJoin = TimeUtility::currentTime();
     HashValues hashValues;
     if (!getHashValues(batch.table, batch.offset, batch.count, *_joinColumns, hashValues)) {
@@ -774,6 +805,34 @@ void LookupJoinKernel::patchLookupHintInfo(const map<string, string> &hintsMap)
     if (iter != hintsMap.end()) {
         _disableMatchRowIndexOptimize = (iter->second == "yes");
     }
+    iter = hintsMap.find("lookupAdaptive");
+    if (iter != hintsMap.end()) {
+        _adaptiveJoin = (iter->second == "yes");
+    }
+    iter = hintsMap.find("lookupAdaptiveBuildLimit");
+    if (iter != hintsMap.end()) {
+        size_t buildLimit = 0;
+        StringUtil::fromString(iter->second, buildLimit);
+        if (buildLimit > 0) {
+            _adaptiveBuildLimit = buildLimit;
+        }
+    }
+    iter = hintsMap.find("lookupAdaptiveBuildBytesLimit");
+    if (iter != hintsMap.end()) {
+        size_t buildBytesLimit = 0;
+        StringUtil::fromString(iter->second, buildBytesLimit);
+        if (buildBytesLimit > 0) {
+            _adaptiveBuildBytesLimit = buildBytesLimit;
+        }
+    }
+    iter = hintsMap.find("lookupAdaptiveCostRatio");
+    if (iter != hintsMap.end()) {
+        double costRatio = 0;
+        StringUtil::fromString(iter->second, costRatio);
+        if (costRatio > 0) {
+            _adaptiveLookupCostRatio = costRatio;
+        }
+    }
 }
 
 bool LookupJoinKernel::selectValidField(const TablePtr &input,
@@ -1102,6 +1161,189 @@ void LookupJoinKernel::fillTermsWithRowOptimized(const LookupJoinBatch &batch,
     }
 }
 
+bool LookupJoinKernel::canUseHashStrategy(const TablePtr &inputTable) {
+    // build table must be fully scanned by the iterator created in init, which
+    // is only available for local normal table before first query update
+    if (_initParam.isRemoteScan() || _initParam.tableType != SCAN_NORMAL_TABLE_TYPE) {
+        return false;
+    }
+    // left build join finishes each scanned table, keep lookup
+    if (_leftTableIndexed) {
+        return false;
+    }
+    std::string field;
+    if (getDocIdField(*_joinColumns, *_lookupColumns, field)) {
+        return false;
+    }
+    // limit truncates matched docs of lookups, full scan can not keep it
+    if (_scanBase->getLimit() != std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    // hash strategy compares typed values while lookup matches index terms, they
+    // only agree on plain key index with same single value type on both sides
+    static const std::unordered_set<std::string> plainKeyIndexTypes
+        = {"number", "string", "primary_key", "primarykey64", "primarykey128"};
+    for (size_t i = 0; i < _joinColumns->size(); ++i) {
+        const std::string &lookupField = (*_lookupColumns)[i];
+        auto indexIter = _lookupIndexInfos->find(lookupField);
+        if (indexIter == _lookupIndexInfos->end()
+            || plainKeyIndexTypes.count(indexIter->second.type) == 0) {
+            return false;
+        }
+        auto column = inputTable->getColumn((*_joinColumns)[i]);
+        if (column == nullptr) {
+            return false;
+        }
+        ValueType vt = column->getColumnSchema()->getType();
+        auto fieldIter = std::find(_initParam.outputFields.begin(), _initParam.outputFields.end(), lookupField);
+        size_t fieldIdx = fieldIter - _initParam.outputFields.begin();
+        if (vt.isMultiValue() || fieldIdx >= _initParam.outputFieldsType.size()) {
+            return false;
+        }
+        auto buildType = ExprUtil::transSqlTypeToVariableType(_initParam.outputFieldsType[fieldIdx]);
+        if (buildType.second || buildType.first != vt.getBuiltinType()) {
+            SQL_LOG(DEBUG,
+                    "join field [%s] type [%d] differs from lookup field [%s] type [%s], keep lookup",
+                    (*_joinColumns)[i].c_str(),
+                    (int)vt.getBuiltinType(),
+                    lookupField.c_str(),
+                    _initParam.outputFieldsType[fieldIdx].c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LookupJoinKernel::decideJoinStrategy(const TablePtr &inputTable) {
+    _strategyDecided = true;
+    _joinInfo.set_joinstrategy("lookup");
+    if (!canUseHashStrategy(inputTable)) {
+        return true;
+    }
+    HashValues hashValues;
+    if (!getHashValues(inputTable, 0, inputTable->getRowCount(), *_joinColumns, hashValues)) {
+        return false;
+    }
+    auto *pool = _queryResource->getPool();
+    auto *hllCtx = Hyperloglog::hllCtxCreate(HLL_SPARSE, pool);
+    if (!hllCtx) {
+        SQL_LOG(ERROR, "create hyperloglog context failed");
+        return false;
+    }
+    for (const auto &valuePair : hashValues) {
+        Hyperloglog::hllCtxAdd(hllCtx,
+                               (const unsigned char *)&valuePair.second,
+                               sizeof(valuePair.second),
+                               pool);
+    }
+    // keys of first input table are lower bound of total lookups, while full
+    // scan seeks each doc of build table once
+    uint64_t distinctKeys = Hyperloglog::hllCtxCount(hllCtx);
+    size_t buildDocCount = _scanBase->getTotalDocCount();
+    _joinInfo.set_estimateddistinctkeys(distinctKeys);
+    _useHashStrategy = buildDocCount <= _adaptiveBuildLimit
+                       && distinctKeys * _adaptiveLookupCostRatio >= buildDocCount;
+    SQL_LOG(DEBUG,
+            "input rows [%zu] distinct keys [%lu] build docs [%zu], use hash strategy [%d]",
+            inputTable->getRowCount(),
+            distinctKeys,
+            buildDocCount,
+            _useHashStrategy);
+    if (!_useHashStrategy) {
+        return true;
+    }
+    bool overLimit = false;
+    if (!scanBuildTable(overLimit)) {
+        return false;
+    }
+    if (overLimit) {
+        // lookup recreates scan iterator by each stream query, the partially
+        // consumed init iterator does not affect it
+        _useHashStrategy = false;
+        _buildTable.reset();
+        return true;
+    }
+    _joinInfo.set_joinstrategy("hash");
+    return true;
+}
+
+bool LookupJoinKernel::scanBuildTable(bool &overLimit) {
+    overLimit = false;
+    // batches may share data pool, count growth of each pool once
+    std::unordered_map<const autil::mem_pool::Pool *, size_t> poolUsedBytes;
+    size_t buildBytes = 0;
+    auto accumulateBytes = [&](const TablePtr &table) {
+        const auto *pool = table->getDataPool();
+        if (pool == nullptr) {
+            return;
+        }
+        size_t usedBytes = pool->getUsedBytes();
+        size_t &lastUsedBytes = poolUsedBytes[pool];
+        if (usedBytes > lastUsedBytes) {
+            buildBytes += usedBytes - lastUsedBytes;
+            lastUsedBytes = usedBytes;
+        }
+    };
+    TablePtr streamOutput;
+    for (bool eof = false; !eof;) {
+        if (!_scanBase->batchScan(streamOutput, eof)) {
+            SQL_LOG(ERROR, "scan build table [%s] failed", _initParam.tableName.c_str());
+            return false;
+        }
+        if (streamOutput == nullptr) {
+            SQL_LOG(WARN, "build table [%s] output is empty", _initParam.tableName.c_str());
+            return false;
+        }
+        accumulateBytes(streamOutput);
+        if (!_buildTable) {
+            _buildTable = streamOutput;
+        } else if (!_buildTable->merge(streamOutput)) {
+            SQL_LOG(ERROR, "merge build table [%s] failed", _initParam.tableName.c_str());
+            return false;
+        } else {
+            accumulateBytes(_buildTable);
+        }
+        if (buildBytes > _adaptiveBuildBytesLimit) {
+            SQL_LOG(DEBUG,
+                    "build table [%s] uses [%zu] bytes over limit [%zu] after [%zu] docs, fall back to lookup",
+                    _initParam.tableName.c_str(),
+                    buildBytes,
+                    _adaptiveBuildBytesLimit,
+                    _buildTable->getRowCount());
+            overLimit = true;
+            return true;
+        }
+    }
+    size_t rowCount = _buildTable->getRowCount();
+    incTotalRightInputTable(rowCount);
+    if (rowCount > 0 && !createHashMap(_buildTable, 0, rowCount, false)) {
+        SQL_LOG(ERROR, "create hash table with build table failed.");
+        return false;
+    }
+    return true;
+}
+
+bool LookupJoinKernel::hashJoinBuildTable(const LookupJoinBatch &batch,
+                                          TablePtr &outputTable,
+                                          bool &truncated) {
+    if (_buildTable->getRowCount() > 0 && !probeHashMap(batch)) {
+        return false;
+    }
+    if (!_joinPtr->generateResultTable(_tableAIndexes,
+                                       _tableBIndexes,
+                                       batch.table,
+                                       _buildTable,
+                                       batch.table->getRowCount(),
+                                       outputTable)) {
+        SQL_LOG(ERROR, "generate result table failed");
+        return false;
+    }
+    _tableAIndexes.clear();
+    _tableBIndexes.clear();
+    truncated = canTruncate(_hasJoinedCount, _lookupTurncateThreshold);
+    return true;
+}
+
 bool LookupJoinKernel::isDocIdsOptimize() {
     auto normalScan = dynamic_cast<NormalScan *>(_scanBase.get());
     if (normalScan != nullptr) {
@@ -114,6 +114,14 @@ private:
                      const LookupJoinBatch &batch,
                      table::TablePtr &outputTable,
                      bool &finished);
+    bool probeHashMap(const LookupJoinBatch &batch);
+    // adaptive mode, choose lookup or hash strategy by first input table
+    bool canUseHashStrategy(const table::TablePtr &inputTable);
+    bool decideJoinStrategy(const table::TablePtr &inputTable);
+    bool scanBuildTable(bool &overLimit);
+    bool hashJoinBuildTable(const LookupJoinBatch &batch,
+                            table::TablePtr &outputTable,
+                            bool &truncated);
 
     static bool getDocIdField(const std::vector<std::string> &inputFields,
                               const std::vector<std::string> &joinFields,
@@ -144,6 +152,12 @@ protected:
     bool _useMatchedRow;
     bool _leftTableIndexed;
     bool _disableMatchRowIndexOptimize;
+    bool _adaptiveJoin;
+    bool _strategyDecided;
+    bool _useHashStrategy;
+    size_t _adaptiveBuildLimit;
+    size_t _adaptiveBuildBytesLimit;
+    double _adaptiveLookupCostRatio;
     size_t _lookupBatchSize;
     size_t _lookupTurncateThreshold;
     size_t _hasJoinedCount;
@@ -158,6 +172,7 @@ protected:
     std::vector<std::string> *_joinColumns;
     std::map<std::string, sql::IndexInfo> *_lookupIndexInfos;
     std::shared_ptr<StreamQuery> _streamQuery;
+    std::shared_ptr<table::Table> _buildTable;
 };
 
 typedef std::shared_ptr<LookupJoinKernel> LookupJoinKernelPtr;
@@ -317,6 +317,8 @@ static const string EMPTY_STRING;
 GraphTransformEnv::GraphTransformEnv() {
     disableWatermark = autil::EnvUtil::getEnv("disableWatermark", disableWatermark);
     useQrsTimestamp = autil::EnvUtil::getEnv("useQrsTimestamp", useQrsTimestamp);
+    tableSerializeFormat = autil::EnvUtil::getEnv("sqlTableSerializeFormat", tableSerializeFormat);
+    tableSerializeCompress = autil::EnvUtil::getEnv("sqlTableSerializeCompress", tableSerializeCompress);
 }
 
 GraphTransformEnv::~GraphTransformEnv() {}
@@ -1131,7 +1133,7 @@ void GraphTransform::addExchangeBorder() {
             auto remoteGraphId = pair.first->root->getRoot()->getGraphId();
             bool sameGraph = (graphId == remoteGraphId);
             for (const auto &buildInput : pair.second) {
-                addExchangeBorder(buildOutput, node, buildInput, sameGraph);
+                addExchangeBorder(buildOutput, node, buildInput, sameGraph, remoteGraphId);
             }
         }
     }
@@ -1140,7 +1142,8 @@ void GraphTransform::addExchangeBorder() {
 void GraphTransform::addExchangeBorder(navi::P buildOutput,
                                        plan::ExchangeNode &exchangeNode,
                                        navi::P buildInput,
-                                       bool sameGraph) {
+                                       bool sameGraph,
+                                       navi::GraphId inputGraphId) {
     if (sameGraph) {
         if (exchangeNode.root->getRoot()->getGraphId() == _rootGraphId) {
             buildInput.from(buildOutput).require(true);
@@ -1151,13 +1154,21 @@ void GraphTransform::addExchangeBorder(navi::P buildOutput,
             buildInput.from(innerBuildOutput).require(true).merge("TableMergeKernel");
             _builder->subGraphAttr("table_distribution", ROOT_GRAPH_TABLE_DISTRIBUTION);
             auto innerBuildInput = _builder->node(identityName).in(DEFAULT_INPUT_PORT).autoNext();
-            addExchangeBorder(buildOutput, exchangeNode, innerBuildInput, false);
+            addExchangeBorder(buildOutput, exchangeNode, innerBuildInput, false, _rootGraphId);
         }
     } else {
         auto buildEdge = buildInput.from(buildOutput).require(true);
         buildEdge.merge("TableMergeKernel");
-        buildEdge.split("TableSplitKernel")
-            .attr("table_distribution", exchangeNode.root->getRemoteDist());
+        auto splitNode = buildEdge.split("TableSplitKernel");
+        splitNode.attr("table_distribution", exchangeNode.root->getRemoteDist());
+        // old receivers ignore serialize version, only send columnar tables
+        // to receivers known to decode them
+        const auto &env = GraphTransformEnv::get();
+        if ((env.tableSerializeFormat == "columnar" && inputGraphId == _rootGraphId)
+            || env.tableSerializeFormat == "columnar_all") {
+            splitNode.attr("table_serialize_format", "columnar");
+            splitNode.attr("table_serialize_compress", env.tableSerializeCompress);
+        }
     }
 }
 
@@ -198,6 +198,11 @@ public:
 public:
     bool disableWatermark = false;
     bool useQrsTimestamp = true;
+    // exchange edges sending columnar tables: "columnar" for edges into the
+    // root graph, which is decoded by this qrs, "columnar_all" for every edge
+    // once all searchers accept it
+    std::string tableSerializeFormat;
+    std::string tableSerializeCompress;
 };
 
 class GraphTransform : public plan::NodeVisitor {
@@ -305,7 +310,8 @@ private:
     void addExchangeBorder(navi::P buildOutput,
                            plan::ExchangeNode &exchangeNode,
                            navi::P buildInput,
-                           bool sameGraph);
+                           bool sameGraph,
+                           navi::GraphId inputGraphId);
     void addTargetWatermark(plan::ScanNode &node);
     void buildEdge(const std::string &outputNode, const navi::P &buildInput);
 
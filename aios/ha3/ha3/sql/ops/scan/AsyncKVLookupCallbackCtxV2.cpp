@@ -207,8 +207,7 @@ void AsyncKVLookupCallbackCtxV2::doSearch(std::shared_ptr<indexlibv2::framework:
     if (_asyncPipe == nullptr) {
         NAVI_LOG(DEBUG, "async pipe is nullptr, use sync with reader v2");
         incStartVersion();
-        auto result = future_lite::interface::syncAwaitViaExecutor(
-            kvReader->BatchGetAsync(_pksForSearch, _rawResults, _readOptions), _executor);
+        auto result = future_lite::interface::syncAwaitViaExecutor(batchGet(kvReader), _executor);
         processStatusVec(std::move(result));
         _metricsCollector.lookupTime = incCallbackVersion();
         endLookupSession({});
@@ -218,7 +217,7 @@ void AsyncKVLookupCallbackCtxV2::doSearch(std::shared_ptr<indexlibv2::framework:
         auto ctx = shared_from_this();
         incStartVersion();
         future_lite::interface::awaitViaExecutor(
-            kvReader->BatchGetAsync(_pksForSearch, _rawResults, _readOptions),
+            batchGet(kvReader),
             _executor,
             [ctx](use_try_t<StatusVector> statusVecTry) {
                 ctx->onSessionCallback(std::move(statusVecTry));
@@ -226,6 +225,14 @@ void AsyncKVLookupCallbackCtxV2::doSearch(std::shared_ptr<indexlibv2::framework:
     }
 }
 
+FL_LAZY(AsyncKVLookupCallbackCtxV2::StatusVector) AsyncKVLookupCallbackCtxV2::batchGet(
+    const std::shared_ptr<indexlibv2::index::KVIndexReader> &kvReader) {
+    if (_pksForSearch.size() >= MULTI_GET_MIN_KEY_COUNT) {
+        return kvReader->MultiGetAsync(_pksForSearch, _rawResults, _readOptions);
+    }
+    return kvReader->BatchGetAsync(_pksForSearch, _rawResults, _readOptions);
+}
+
 std::shared_ptr<indexlibv2::index::KVIndexReader>
 AsyncKVLookupCallbackCtxV2::getReader(std::shared_ptr<indexlibv2::framework::ITablet> tablet,
                                       const std::string &indexName) {
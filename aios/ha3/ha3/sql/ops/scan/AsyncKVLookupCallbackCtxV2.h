@@ -77,6 +77,7 @@ private:
     void onWaitTabletCallback(
         autil::result::Result<std::shared_ptr<indexlibv2::framework::ITablet>> res);
     void doSearch(std::shared_ptr<indexlibv2::framework::ITablet> tablet);
+    FL_LAZY(StatusVector) batchGet(const std::shared_ptr<indexlibv2::index::KVIndexReader> &kvReader);
     std::shared_ptr<indexlibv2::index::KVIndexReader>
     getReader(std::shared_ptr<indexlibv2::framework::ITablet> tablet, const std::string &indexName);
     void endLookupSession(std::optional<std::string> errorDesc);
@@ -91,6 +92,10 @@ private:
     future_lite::Executor *_executor;
     std::vector<autil::StringView> _rawResults;
     std::optional<std::string> _errorDesc;
+
+private:
+    // use sorted multi get of reader for large lookup batch
+    static constexpr size_t MULTI_GET_MIN_KEY_COUNT = 256;
 };
 
 } // end namespace sql
@@ -434,7 +434,8 @@ bool NormalScan::doUpdateScanQuery(const StreamQueryPtr &inputQuery) {
     if (!_param.matchType.empty()) {
         _matchDataManager->requireMatchData();
     }
-    if (_updateQueryCount != 0 && createInfo.filterWrapper != nullptr) {
+    // filter is shared with init iterator, which may be seeked before first update
+    if ((_updateQueryCount != 0 || _seekCount != 0) && createInfo.filterWrapper != nullptr) {
         createInfo.filterWrapper->resetFilter();
     }
     _scanIter = _scanIterCreator->createScanIterator(createInfo, _useSub, emptyScan);
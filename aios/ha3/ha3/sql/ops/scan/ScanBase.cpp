@@ -528,6 +528,14 @@ bool ScanBase::batchScan(TablePtr &table, bool &eof) {
     return true;
 }
 
+size_t ScanBase::getTotalDocCount() const {
+    if (!_indexPartitionReaderWrapper) {
+        return 0;
+    }
+    const auto &partitionInfo = _indexPartitionReaderWrapper->getPartitionInfo();
+    return partitionInfo ? partitionInfo->GetTotalDocCount() : 0;
+}
+
 bool ScanBase::updateScanQuery(const StreamQueryPtr &inputQuery) {
     autil::ScopedTime2 updateScanQueryTimer;
     auto ret = doUpdateScanQuery(inputQuery);
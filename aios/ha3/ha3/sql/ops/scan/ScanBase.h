@@ -197,6 +197,11 @@ public:
     bool getUseSub() const {
         return _useSub;
     }
+    uint32_t getLimit() const {
+        return _limit;
+    }
+    // doc count of scanned partition, 0 if table has no index partition
+    size_t getTotalDocCount() const;
     void setPushDownMode(bool pushDownMode) {
         _pushDownMode = pushDownMode;
     }
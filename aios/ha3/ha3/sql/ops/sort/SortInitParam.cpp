@@ -23,10 +23,15 @@ namespace sql {
 
 AUTIL_LOG_SETUP(sql, SortInitParam);
 
+const std::string SortInitParam::TOPK_MODE_DEFAULT = "default";
+const std::string SortInitParam::TOPK_MODE_HEAP = "heap";
+
 SortInitParam::SortInitParam()
     : limit(0)
     , offset(0)
     , topk(0)
+    , topKMode(TOPK_MODE_DEFAULT)
+    , inputSorted(false)
 {
 }
 
@@ -53,6 +58,12 @@ bool SortInitParam::initFromJson(navi::KernelConfigContext &ctx) {
     ctx.Jsonize("limit", limit);
     ctx.Jsonize("offset", offset);
     topk = offset + limit;
+    ctx.Jsonize("topk_mode", topKMode, topKMode);
+    if (topKMode != TOPK_MODE_DEFAULT && topKMode != TOPK_MODE_HEAP) {
+        SQL_LOG(WARN, "unknown topk mode [%s], use default", topKMode.c_str());
+        topKMode = TOPK_MODE_DEFAULT;
+    }
+    ctx.Jsonize("input_sorted", inputSorted, inputSorted);
     return true;
 }
 
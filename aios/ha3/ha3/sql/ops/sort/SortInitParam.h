@@ -25,6 +25,10 @@ namespace isearch {
 namespace sql {
 
 class SortInitParam {
+public:
+    static const std::string TOPK_MODE_DEFAULT;
+    static const std::string TOPK_MODE_HEAP;
+
 public:
     SortInitParam();
 public:
@@ -35,6 +39,10 @@ public:
     size_t topk;
     std::vector<std::string> keys;
     std::vector<bool> orders;
+    // heap: keep a bounded heap of row indexes across input batches
+    std::string topKMode;
+    // every input batch is already sorted by keys, e.g. sorted by searchers
+    bool inputSorted;
 private:
     AUTIL_LOG_DECLARE();
 };
@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "alog/Logger.h"
 #include "autil/HashAlgorithm.h"
@@ -79,6 +81,8 @@ public:
         REGISTER_LATENCY_MUTABLE_METRIC(_totalCompactTime, "totalCompactTime");
         REGISTER_LATENCY_MUTABLE_METRIC(_outputTime, "OutputTime");
         REGISTER_GAUGE_MUTABLE_METRIC(_totalInputCount, "TotalInputCount");
+        REGISTER_LATENCY_MUTABLE_METRIC(_totalFinalSortTime, "TotalFinalSortTime");
+        REGISTER_GAUGE_MUTABLE_METRIC(_totalDiscardCount, "TotalDiscardCount");
         return true;
     }
     void report(const kmonitor::MetricsTags *tags, SortInfo *sortInfo) {
@@ -89,6 +93,8 @@ public:
         REPORT_MUTABLE_METRIC(_totalCompactTime, sortInfo->totalcompacttime() / 1000);
         REPORT_MUTABLE_METRIC(_outputTime, sortInfo->totaloutputtime() / 1000);
         REPORT_MUTABLE_METRIC(_totalInputCount, sortInfo->totalinputcount());
+        REPORT_MUTABLE_METRIC(_totalFinalSortTime, sortInfo->totalfinalsorttime() / 1000);
+        REPORT_MUTABLE_METRIC(_totalDiscardCount, sortInfo->totaldiscardcount());
     }
 
 private:
@@ -99,6 +105,8 @@ private:
     MutableMetric *_totalCompactTime = nullptr;
     MutableMetric *_outputTime = nullptr;
     MutableMetric *_totalInputCount = nullptr;
+    MutableMetric *_totalFinalSortTime = nullptr;
+    MutableMetric *_totalDiscardCount = nullptr;
 };
 
 SortKernel::SortKernel()
@@ -139,6 +147,7 @@ navi::ErrorCode SortKernel::init(navi::KernelInitContext &context) {
     } else {
         _sortInfo.set_hashkey(_opId);
     }
+    _sortInfo.set_topkmode(_sortInitParam.inputSorted ? "merge" : _sortInitParam.topKMode);
     _poolPtr = _memoryPoolResource->getPool();
     KERNEL_REQUIRES(_poolPtr, "get pool failed");
     if (_metaInfoResource) {
@@ -176,25 +185,67 @@ void SortKernel::outputResult(navi::KernelComputeContext &runContext) {
     uint64_t beginTime = TimeUtility::currentTime();
     navi::PortIndex outputIndex(0, navi::INVALID_INDEX);
     if (_comparator != nullptr && _table != nullptr) {
-        if (_sortInitParam.offset > 0) {
-            size_t offset = std::min(_sortInitParam.offset, _table->getRowCount());
-            vector<Row> rows = _table->getRows();
-            nth_element(rows.begin(), rows.begin() + offset, rows.end(),
-                        [this] (Row a, Row b) { return _comparator->compare(a, b); });
-            sort(rows.begin() + offset, rows.end(),
-                 [this] (Row a, Row b) { return _comparator->compare(a, b); });
-            vector<Row> newRows(rows.begin() + offset, rows.end());
-            _table->setRows(newRows);
-        } else {
-            TableUtil::sort(_table, _comparator.get());
-        }
+        finalSort();
     }
+    uint64_t afterSortTime = TimeUtility::currentTime();
+    incFinalSortTime(afterSortTime - beginTime);
     SQL_LOG(TRACE1, "sort output table: [%s]", TableUtil::toString(_table, 10).c_str());
     TableDataPtr tableData(new TableData(_table));
     runContext.setOutput(outputIndex, tableData, true);
     incOutputTime(TimeUtility::currentTime() - beginTime);
 }
 
+void SortKernel::finalSort() {
+    if (_sortInitParam.inputSorted) {
+        mergeSortedRuns();
+        return;
+    }
+    if (_sortInitParam.offset > 0) {
+        size_t offset = std::min(_sortInitParam.offset, _table->getRowCount());
+        vector<Row> rows = _table->getRows();
+        nth_element(rows.begin(), rows.begin() + offset, rows.end(),
+                    [this] (Row a, Row b) { return _comparator->compare(a, b); });
+        sort(rows.begin() + offset, rows.end(),
+             [this] (Row a, Row b) { return _comparator->compare(a, b); });
+        vector<Row> newRows(rows.begin() + offset, rows.end());
+        _table->setRows(newRows);
+    } else {
+        TableUtil::sort(_table, _comparator.get());
+    }
+}
+
+void SortKernel::mergeSortedRuns() {
+    const vector<Row> rows = _table->getRows();
+    // min heap of run cursors: [current, end)
+    typedef std::pair<size_t, size_t> Cursor;
+    auto cursorGreater = [this, &rows](const Cursor &a, const Cursor &b) {
+        return _comparator->compare(rows[b.first], rows[a.first]);
+    };
+    vector<Cursor> cursors;
+    cursors.reserve(_sortedRuns.size());
+    for (const auto &run : _sortedRuns) {
+        if (run.first < run.second) {
+            cursors.emplace_back(run);
+        }
+    }
+    std::make_heap(cursors.begin(), cursors.end(), cursorGreater);
+    vector<Row> mergedRows;
+    mergedRows.reserve(std::min(_sortInitParam.topk, rows.size()));
+    while (!cursors.empty() && mergedRows.size() < _sortInitParam.topk) {
+        std::pop_heap(cursors.begin(), cursors.end(), cursorGreater);
+        auto &cursor = cursors.back();
+        mergedRows.push_back(rows[cursor.first]);
+        if (++cursor.first < cursor.second) {
+            std::push_heap(cursors.begin(), cursors.end(), cursorGreater);
+        } else {
+            cursors.pop_back();
+        }
+    }
+    size_t offset = std::min(_sortInitParam.offset, mergedRows.size());
+    vector<Row> newRows(mergedRows.begin() + offset, mergedRows.end());
+    _table->setRows(newRows);
+}
+
 bool SortKernel::doCompute(const navi::DataPtr &data) {
     uint64_t beginTime = TimeUtility::currentTime();
 
@@ -204,6 +255,10 @@ bool SortKernel::doCompute(const navi::DataPtr &data) {
         return false;
     }
     incTotalInputCount(inputTable->getRowCount());
+    if (_sortInitParam.inputSorted) {
+        truncateSortedInput(inputTable);
+    }
+    size_t newRowBegin = 0;
     if (_comparator == nullptr) {
         _table = inputTable;
         _comparator = ComparatorCreator::createComboComparator(_table, _sortInitParam.keys, _sortInitParam.orders, _poolPtr.get());
@@ -212,6 +267,7 @@ bool SortKernel::doCompute(const navi::DataPtr &data) {
             return false;
         }
     } else {
+        newRowBegin = _table->getRowCount();
         if (!_table->merge(inputTable)) {
             SQL_LOG(ERROR, "merge input table failed");
             return false;
@@ -220,15 +276,67 @@ bool SortKernel::doCompute(const navi::DataPtr &data) {
     }
     uint64_t afterMergeTime = TimeUtility::currentTime();
     incMergeTime(afterMergeTime - beginTime);
-    TableUtil::topK(_table, _comparator.get(), _sortInitParam.topk);
+    selectTopK(newRowBegin);
     uint64_t afterTopKTime = TimeUtility::currentTime();
     incTopKTime(afterTopKTime - afterMergeTime);
     _table->compact();
+    if (!_heap.empty()) {
+        // compact moves rows in place, heap order is kept
+        _heap = _table->getRows();
+    }
     incCompactTime(TimeUtility::currentTime() - afterTopKTime);
     SQL_LOG(TRACE1, "sort-topk output table: [%s]", TableUtil::toString(_table, 10).c_str());
     return true;
 }
 
+void SortKernel::truncateSortedInput(const TablePtr &inputTable) {
+    size_t rowCount = inputTable->getRowCount();
+    if (rowCount <= _sortInitParam.topk) {
+        return;
+    }
+    // rows after topk of a sorted batch can never make the cut
+    vector<Row> rows = inputTable->getRows();
+    rows.resize(_sortInitParam.topk);
+    inputTable->setRows(rows);
+    incDiscardCount(rowCount - _sortInitParam.topk);
+}
+
+void SortKernel::selectTopK(size_t newRowBegin) {
+    size_t rowCount = _table->getRowCount();
+    if (_sortInitParam.inputSorted) {
+        _sortedRuns.emplace_back(newRowBegin, rowCount);
+    } else if (_sortInitParam.topKMode == SortInitParam::TOPK_MODE_HEAP) {
+        heapTopK(newRowBegin);
+    } else {
+        TableUtil::topK(_table, _comparator.get(), _sortInitParam.topk);
+        incDiscardCount(rowCount - _table->getRowCount());
+    }
+}
+
+void SortKernel::heapTopK(size_t newRowBegin) {
+    const size_t topk = _sortInitParam.topk;
+    auto rowLess = [this](Row a, Row b) { return _comparator->compare(a, b); };
+    size_t rowCount = _table->getRowCount();
+    size_t discardCount = 0;
+    for (size_t i = newRowBegin; i < rowCount; ++i) {
+        Row row = _table->getRow(i);
+        if (_heap.size() < topk) {
+            _heap.push_back(row);
+            std::push_heap(_heap.begin(), _heap.end(), rowLess);
+        } else if (topk > 0 && _comparator->compare(row, _heap.front())) {
+            std::pop_heap(_heap.begin(), _heap.end(), rowLess);
+            _heap.back() = row;
+            std::push_heap(_heap.begin(), _heap.end(), rowLess);
+            ++discardCount;
+        } else {
+            ++discardCount;
+        }
+    }
+    vector<Row> rows = _heap;
+    _table->setRows(rows);
+    incDiscardCount(discardCount);
+}
+
 void SortKernel::reportMetrics() {
     if (_queryMetricsReporter != nullptr) {
         string pathName = "sql.user.ops." + getKernelName();
@@ -256,6 +364,14 @@ void SortKernel::incOutputTime(int64_t time) {
     _sortInfo.set_totaloutputtime(_sortInfo.totaloutputtime() + time);
 }
 
+void SortKernel::incFinalSortTime(int64_t time) {
+    _sortInfo.set_totalfinalsorttime(_sortInfo.totalfinalsorttime() + time);
+}
+
+void SortKernel::incDiscardCount(size_t count) {
+    _sortInfo.set_totaldiscardcount(_sortInfo.totaldiscardcount() + count);
+}
+
 void SortKernel::incTotalTime(int64_t time) {
     _sortInfo.set_totalusetime(_sortInfo.totalusetime() + time);
 }
@@ -19,6 +19,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "autil/Log.h"
@@ -30,6 +31,7 @@
 #include "navi/engine/Kernel.h"
 #include "navi/engine/KernelConfigContext.h"
 #include "table/ComboComparator.h"
+#include "table/Row.h"
 #include "table/Table.h"
 
 namespace navi {
@@ -77,12 +79,19 @@ private:
     void outputResult(navi::KernelComputeContext &runContext);
     bool doLimitCompute(const navi::DataPtr &data);
     bool doCompute(const navi::DataPtr &data);
+    void truncateSortedInput(const table::TablePtr &inputTable);
+    void selectTopK(size_t newRowBegin);
+    void heapTopK(size_t newRowBegin);
+    void finalSort();
+    void mergeSortedRuns();
     void reportMetrics();
     void incComputeTime();
     void incMergeTime(int64_t time);
     void incCompactTime(int64_t time);
     void incTopKTime(int64_t time);
     void incOutputTime(int64_t time);
+    void incFinalSortTime(int64_t time);
+    void incDiscardCount(size_t count);
     void incTotalTime(int64_t time);
     void incTotalInputCount(size_t count);
 private:
@@ -90,6 +99,10 @@ private:
     table::TablePtr _table;
     std::shared_ptr<autil::mem_pool::Pool> _poolPtr;
     table::ComboComparatorPtr _comparator;
+    // max heap by comparator, top is the worst row kept
+    std::vector<table::Row> _heap;
+    // [begin, end) of each sorted input batch in _table
+    std::vector<std::pair<size_t, size_t>> _sortedRuns;
     std::vector<int32_t> _reuseInputs;
     kmonitor::MetricsReporter *_queryMetricsReporter;
     SortInfo _sortInfo;
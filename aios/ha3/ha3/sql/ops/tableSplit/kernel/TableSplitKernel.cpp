@@ -46,6 +46,21 @@ bool TableSplitKernel::doConfig(navi::KernelConfigContext& ctx) {
             initTableDistribution(iter->second);
         }
     }
+    {
+        auto iter = binaryAttrs.find("table_serialize_format");
+        if (iter != iterEnd) {
+            _columnarSerialize = (iter->second == "columnar");
+        }
+    }
+    {
+        auto iter = binaryAttrs.find("table_serialize_compress");
+        if (iter != iterEnd && !iter->second.empty()) {
+            auto compressType = convertCompressType(iter->second);
+            if (compressType != CompressType::INVALID_COMPRESS_TYPE) {
+                _compressType = compressType;
+            }
+        }
+    }
     return true;
 }
 
@@ -75,6 +90,10 @@ navi::ErrorCode TableSplitKernel::doCompute(
         return navi::EC_NONE;
     }
     NAVI_KERNEL_LOG(DEBUG, "split failed, use broadcast");
+    if (_columnarSerialize) {
+        outputBroadcastData(table, dataVec);
+        return navi::EC_NONE;
+    }
     return DefaultSplitKernel::doCompute(streamData, dataVec);
 }
 
@@ -101,13 +120,29 @@ void TableSplitKernel::outputSplitData(
         }
         const auto& rows = partRows[partId];
         TablePtr partTable(new Table(rows, table.getMatchDocAllocatorPtr()));
-        dataVec[i].reset(new TableData(partTable));
+        auto tableData = new TableData(partTable);
+        if (_columnarSerialize) {
+            tableData->setColumnarSerialize(_compressType);
+        }
+        dataVec[i].reset(tableData);
         NAVI_KERNEL_LOG(DEBUG, "set dataVec[%ld], table row count:%ld",
             i, partTable->getRowCount());
         NAVI_KERNEL_LOG(TRACE3, "table:\n%s", TableUtil::toString(partTable, 10).c_str());
     }
 }
 
+void TableSplitKernel::outputBroadcastData(
+    const table::TablePtr& table,
+    std::vector<navi::DataPtr>& dataVec)
+{
+    // input data may be shared by other consumers, mark a new one
+    TableDataPtr tableData(new TableData(table));
+    tableData->setColumnarSerialize(_compressType);
+    for (size_t i = 0; i < dataVec.size(); ++i) {
+        dataVec[i] = tableData;
+    }
+}
+
 REGISTER_KERNEL(TableSplitKernel);
 
 } //end namespace kernel
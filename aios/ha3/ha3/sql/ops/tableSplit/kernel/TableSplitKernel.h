@@ -16,6 +16,7 @@
 #pragma once
 
 #include <vector>
+#include "autil/CompressionUtil.h"
 #include "navi/ops/DefaultSplitKernel.h"
 #include "ha3/sql/ops/tableSplit/TableSplit.h"
 
@@ -38,9 +39,15 @@ private:
         table::Table& table,
         const std::vector<std::vector<table::Row>>& partRows,
         std::vector<navi::DataPtr>& dataVec);
+    void outputBroadcastData(
+        const table::TablePtr& table,
+        std::vector<navi::DataPtr>& dataVec);
 private:
     TableDistribution _tableDist;
     TableSplit _tableSplit;
+    // receivers of this edge decode columnar tables, set by graph builder
+    bool _columnarSerialize = false;
+    autil::CompressType _compressType = autil::CompressType::NO_COMPRESS;
 };
 
 } //end namespace sql
@@ -223,6 +223,11 @@ static void mergeFrom(JoinInfo &lhs, const JoinInfo &rhs) {
     lhs.set_totalevaluatetime(lhs.totalevaluatetime() + rhs.totalevaluatetime());
     lhs.set_totalleftinputcount(lhs.totalleftinputcount() + rhs.totalleftinputcount());
     lhs.set_totalrightinputcount(lhs.totalrightinputcount() + rhs.totalrightinputcount());
+    lhs.set_hashtablememoryuse(lhs.hashtablememoryuse() + rhs.hashtablememoryuse());
+    lhs.set_hashtabletype(rhs.hashtabletype());
+    lhs.set_partitioncount(std::max(lhs.partitioncount(), rhs.partitioncount()));
+    lhs.set_spillfilecount(lhs.spillfilecount() + rhs.spillfilecount());
+    lhs.set_spillbytes(lhs.spillbytes() + rhs.spillbytes());
 }
 
 static void mergeFrom(AggInfo &lhs, const AggInfo &rhs) {
@@ -248,6 +253,9 @@ static void mergeFrom(SortInfo &lhs, const SortInfo &rhs) {
     lhs.set_totaloutputtime(lhs.totaloutputtime() + rhs.totaloutputtime());
     lhs.set_totalcomputetimes(lhs.totalcomputetimes() + rhs.totalcomputetimes());
     lhs.set_totalinputcount(lhs.totalinputcount() + rhs.totalinputcount());
+    lhs.set_totalfinalsorttime(lhs.totalfinalsorttime() + rhs.totalfinalsorttime());
+    lhs.set_totaldiscardcount(lhs.totaldiscardcount() + rhs.totaldiscardcount());
+    lhs.set_topkmode(rhs.topkmode());
 }
 
 static void mergeFrom(CalcInfo &lhs, const CalcInfo &rhs) {
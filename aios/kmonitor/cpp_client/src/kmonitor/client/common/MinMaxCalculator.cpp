@@ -29,6 +29,20 @@ void MinMaxCalculator::Add(double value) {
     count_++;
 }
 
+void MinMaxCalculator::Merge(const MinMaxCalculator &other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (other.max_ > max_) {
+        max_ = other.max_;
+    }
+    if (other.min_ < min_) {
+        min_ = other.min_;
+    }
+    sum_ += other.sum_;
+    count_ += other.count_;
+}
+
 void MinMaxCalculator::Reset() {
     max_ = std::numeric_limits<double>::lowest();
     min_ = std::numeric_limits<double>::max();
@@ -20,6 +20,7 @@ class MinMaxCalculator {
 
  public:
     void Add(double value);
+    void Merge(const MinMaxCalculator &other);
     void Reset();
     std::string ToString() const;
 
@@ -15,6 +15,9 @@ using namespace std;
 CounterMetric::CounterMetric(const string &name)
     : Metric(name),
       value_(0) {
+    if (ShardedRecordEnabled()) {
+        shards_.reset(new AtomicMetricShards());
+    }
 }
 
 CounterMetric::~CounterMetric() {
@@ -24,7 +27,18 @@ void CounterMetric::doUpdate(double value) {
     value_ += value;
 }
 
+bool CounterMetric::doShardedUpdate(double value) {
+    if (!shards_) {
+        return false;
+    }
+    shards_->Add(value);
+    return true;
+}
+
 void CounterMetric::doSnapshot(MetricsRecord *record, int64_t period) {
+    if (shards_) {
+        value_ += shards_->Take();
+    }
     record->AddValue(info_, value_);
 }
 
@@ -50,6 +50,13 @@ void DDSketch::Flush() {
     indexCountMap_.clear();
 }
 
+void DDSketch::mergeWith(DDSketch &other) {
+    other.Flush();
+    Flush();
+    store_.mergeWith(other.store_);
+    zeroCount_ += other.zeroCount_;
+}
+
 //use autil::legacy::ToJsonString(DDSketch, true) to get
 void DDSketch::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json)
 {
@@ -24,6 +24,8 @@ public:
     ~DDSketch() {}
     void accept(double value);
     void Flush();
+    // add all values accepted by other, other is flushed
+    void mergeWith(DDSketch &other);
     void Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) override;
     
 private:
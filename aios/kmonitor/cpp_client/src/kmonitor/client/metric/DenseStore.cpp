@@ -37,6 +37,17 @@ void DenseStore::add(int32_t index, int64_t count)
     counts_[arrayIndex] += count;
 }
 
+void DenseStore::mergeWith(const DenseStore &other)
+{
+    if (other.maxIndex_ < other.minIndex_) {
+        return;
+    }
+    extendRange(other.minIndex_, other.maxIndex_);
+    for (int32_t index = other.minIndex_; index <= other.maxIndex_; index++) {
+        counts_[index - offset_] += other.counts_[index - other.offset_];
+    }
+}
+
 int64_t DenseStore::getTotalCount(int32_t fromIndex, int32_t toIndex)
 {
     if (isEmpty()) {
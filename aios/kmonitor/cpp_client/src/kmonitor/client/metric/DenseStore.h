@@ -25,6 +25,7 @@ class DenseStore
     ~DenseStore();
                
     void add(int32_t index, int64_t count = 1);
+    void mergeWith(const DenseStore &other);
     int32_t normalize(int32_t index);
     int64_t getTotalCount(int32_t fromIndex, int32_t toIndex);
     void extendRange(int32_t newMinIndex, int32_t newMaxIndex);
@@ -17,6 +17,9 @@ using std::string;
 
 GaugeMetric::GaugeMetric(const string &name)
     : Metric(name) {
+    if (ShardedRecordEnabled()) {
+        shards_.reset(new MetricShards<MinMaxCalculator>());
+    }
 }
 
 GaugeMetric::~GaugeMetric() {
@@ -26,7 +29,21 @@ void GaugeMetric::doUpdate(double value) {
     calculator_.Add(value);
 }
 
+bool GaugeMetric::doShardedUpdate(double value) {
+    if (!shards_) {
+        return false;
+    }
+    shards_->Update([value](MinMaxCalculator &calculator) { calculator.Add(value); });
+    return true;
+}
+
 void GaugeMetric::doSnapshot(MetricsRecord *record, int64_t period) {
+    if (shards_) {
+        shards_->Merge([this](MinMaxCalculator &calculator) {
+            calculator_.Merge(calculator);
+            calculator.Reset();
+        });
+    }
     if (calculator_.Count() == 0) {
         return;
     }
@@ -8,11 +8,13 @@
 #ifndef KMONITOR_CLIENT_METRIC_GAUGEMETRIC_H_
 #define KMONITOR_CLIENT_METRIC_GAUGEMETRIC_H_
 
+#include <memory>
 #include <vector>
 #include <string>
 #include "kmonitor/client/common/Common.h"
 #include "kmonitor/client/metric/Metric.h"
 #include "kmonitor/client/common/MinMaxCalculator.h"
+#include "kmonitor/client/metric/MetricShards.h"
 
 BEGIN_KMONITOR_NAMESPACE(kmonitor);
 
@@ -22,6 +24,7 @@ class GaugeMetric : public Metric {
     GaugeMetric(const std::string &name);
     void doUpdate(double value) override;
     void doSnapshot(MetricsRecord *record, int64_t period) override;
+    bool doShardedUpdate(double value) override;
 
  private:
     GaugeMetric(const GaugeMetric &);
@@ -29,6 +32,7 @@ class GaugeMetric : public Metric {
 
  private:
     MinMaxCalculator calculator_;
+    std::unique_ptr<MetricShards<MinMaxCalculator>> shards_;
 };
 
 TYPEDEF_PTR(GaugeMetric);
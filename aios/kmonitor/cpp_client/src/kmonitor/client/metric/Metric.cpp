@@ -5,6 +5,11 @@
  * Author Email: xsank.mz@alibaba-inc.com
  * */
 
+#include <sched.h>
+#include <string.h>
+#include <algorithm>
+#include <thread>
+#include "kmonitor/client/common/Util.h"
 #include "kmonitor/client/core/MetricsInfo.h"
 #include "kmonitor/client/metric/Metric.h"
 
@@ -23,5 +28,26 @@ Metric::Metric(const std::string &name)
 Metric::~Metric() {
 }
 
+bool Metric::ShardedRecordEnabled() {
+    static const bool enabled = strcmp(Util::GetEnv("KMONITOR_SHARDED_METRIC", "false"), "true") == 0;
+    return enabled;
+}
+
+size_t Metric::ShardNum() {
+    static const size_t num = std::max(std::thread::hardware_concurrency(), 1u);
+    return num;
+}
+
+size_t Metric::ShardIndex() {
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % ShardNum();
+    }
+    static std::atomic<size_t> next_index(0);
+    static thread_local size_t index =
+        next_index.fetch_add(1, std::memory_order_relaxed) % ShardNum();
+    return index;
+}
+
 END_KMONITOR_NAMESPACE(kmonitor);
 
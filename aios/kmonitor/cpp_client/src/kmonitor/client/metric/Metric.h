@@ -8,6 +8,7 @@
 #ifndef KMONITOR_CLIENT_METRIC_METRIC_H_
 #define KMONITOR_CLIENT_METRIC_METRIC_H_
 
+#include <atomic>
 #include "autil/Lock.h"
 #include "kmonitor/client/common/Common.h"
 #include "kmonitor/client/MetricLevel.h"
@@ -30,9 +31,18 @@ class Metric {
  protected:
     virtual void doUpdate(double value) = 0;
     virtual void doSnapshot(MetricsRecord* record, int64_t period/*ms*/) = 0;
+    // record value into shard of current thread without metric_mutex_,
+    // return false if metric is not sharded. shards are merged in doSnapshot
+    virtual bool doShardedUpdate(double value) {
+        return false;
+    }
 
  public:
     void Update(double value) {
+        if (doShardedUpdate(value)) {
+            Touch();
+            return;
+        }
         autil::ScopedLock lock(metric_mutex_);
         doUpdate(value);
         Touch();
@@ -72,18 +82,26 @@ class Metric {
 
 public:
     void Touch() {
-        untouch_num_ = 0;
+        if (untouch_num_.load(std::memory_order_relaxed) != 0) {
+            untouch_num_.store(0, std::memory_order_relaxed);
+        }
     }
 
     void Untouch() {
-        ++untouch_num_;
+        untouch_num_.fetch_add(1, std::memory_order_relaxed);
     }
 
+    // sharded recording is enabled by env KMONITOR_SHARDED_METRIC=true
+    static bool ShardedRecordEnabled();
+    // one shard per cpu, updates pick the shard of the cpu they run on
+    static size_t ShardNum();
+    static size_t ShardIndex();
+
  private:
     Metric &operator=(const Metric &);
 
  private:
-    int8_t untouch_num_;
+    std::atomic<int8_t> untouch_num_;
     int32_t ref_cnt_;
     autil::ThreadMutex metric_mutex_;
 
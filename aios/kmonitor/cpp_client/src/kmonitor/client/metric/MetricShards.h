@@ -0,0 +1,90 @@
+/*
+ * Copyright 2014-2020 Alibaba Inc. All rights reserved.
+ * */
+
+#ifndef KMONITOR_CLIENT_METRIC_METRICSHARDS_H_
+#define KMONITOR_CLIENT_METRIC_METRICSHARDS_H_
+
+#include <atomic>
+#include <memory>
+#include "autil/Lock.h"
+#include "kmonitor/client/common/Common.h"
+#include "kmonitor/client/metric/Metric.h"
+
+BEGIN_KMONITOR_NAMESPACE(kmonitor);
+
+// per cpu slots of metric state, each slot has its own cache line and
+// lock so updates from different cpus do not contend
+template <typename T>
+class MetricShards {
+ public:
+    MetricShards() : shards_(new Shard[Metric::ShardNum()]) {}
+    ~MetricShards() {}
+
+ private:
+    MetricShards(const MetricShards &);
+    MetricShards &operator=(const MetricShards &);
+
+ public:
+    template <typename Func>
+    void Update(Func func) {
+        Shard &shard = shards_[Metric::ShardIndex()];
+        autil::ScopedSpinLock lock(shard.lock);
+        func(shard.value);
+    }
+
+    // func should move shard value into merged result and reset shard
+    template <typename Func>
+    void Merge(Func func) {
+        for (size_t i = 0; i < Metric::ShardNum(); ++i) {
+            autil::ScopedSpinLock lock(shards_[i].lock);
+            func(shards_[i].value);
+        }
+    }
+
+ private:
+    struct alignas(64) Shard {
+        autil::SpinLock lock;
+        T value{};
+    };
+    std::unique_ptr<Shard[]> shards_;
+};
+
+// per cpu sums updated with relaxed atomics, for counter and qps whose
+// state is a single value
+class AtomicMetricShards {
+ public:
+    AtomicMetricShards() : shards_(new Shard[Metric::ShardNum()]) {}
+    ~AtomicMetricShards() {}
+
+ private:
+    AtomicMetricShards(const AtomicMetricShards &);
+    AtomicMetricShards &operator=(const AtomicMetricShards &);
+
+ public:
+    void Add(double value) {
+        std::atomic<double> &sum = shards_[Metric::ShardIndex()].sum;
+        double current = sum.load(std::memory_order_relaxed);
+        while (!sum.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // returns the sum recorded since last call and resets all shards
+    double Take() {
+        double total = 0;
+        for (size_t i = 0; i < Metric::ShardNum(); ++i) {
+            total += shards_[i].sum.exchange(0, std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+ private:
+    struct alignas(64) Shard {
+        std::atomic<double> sum{0};
+    };
+    std::unique_ptr<Shard[]> shards_;
+};
+
+END_KMONITOR_NAMESPACE(kmonitor);
+
+#endif  // KMONITOR_CLIENT_METRIC_METRICSHARDS_H_
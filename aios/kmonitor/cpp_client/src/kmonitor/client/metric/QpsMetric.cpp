@@ -18,6 +18,9 @@ using namespace std;
 QpsMetric::QpsMetric(const string &name)
     : Metric(name),
       value_(0) {
+    if (ShardedRecordEnabled()) {
+        shards_.reset(new AtomicMetricShards());
+    }
 }
 
 QpsMetric::~QpsMetric() {
@@ -27,7 +30,18 @@ void QpsMetric::doUpdate(double value) {
     value_ += value;
 }
 
+bool QpsMetric::doShardedUpdate(double value) {
+    if (!shards_) {
+        return false;
+    }
+    shards_->Add(value);
+    return true;
+}
+
 void QpsMetric::doSnapshot(MetricsRecord *record, int64_t period) {
+    if (shards_) {
+        value_ += shards_->Take();
+    }
     if (period > 0) {
         record->AddValue(info_, value_ * 1000/period);
     }
@@ -8,9 +8,11 @@
 #ifndef KMONITOR_CLIENT_METRIC_QPSMETRIC_H_
 #define KMONITOR_CLIENT_METRIC_QPSMETRIC_H_
 
+#include <memory>
 #include <string>
 #include "kmonitor/client/common/Common.h"
 #include "kmonitor/client/metric/Metric.h"
+#include "kmonitor/client/metric/MetricShards.h"
 
 BEGIN_KMONITOR_NAMESPACE(kmonitor);
 
@@ -20,6 +22,7 @@ class QpsMetric : public Metric {
     explicit QpsMetric(const std::string &name);
     virtual void doUpdate(double value) override;
     virtual void doSnapshot(MetricsRecord *record, int64_t period/*ms*/) override;
+    bool doShardedUpdate(double value) override;
 
  private:
     QpsMetric(const QpsMetric &);
@@ -27,6 +30,7 @@ class QpsMetric : public Metric {
 
  private:
     double value_;
+    std::unique_ptr<AtomicMetricShards> shards_;
  private:
     friend class QpsMetricTest_TestUpdate_Test;
     friend class QpsMetricTest_TestSnapshot_Test;
@@ -20,6 +20,9 @@ SummaryMetric::SummaryMetric(const string &name)
     const string fullMetric = name + ".summary";
     summary_info_ = MetricsInfoPtr(new MetricsInfo(fullMetric, fullMetric, {{Metric::HEADER_FORMAT, "ddsketch"}}));
     ddsketch_ = new DDSketch(RELATIVE_ACCURACY);
+    if (ShardedRecordEnabled()) {
+        shards_.reset(new MetricShards<SummaryShard>());
+    }
 }
 
 void SummaryMetric::doUpdate(double value) {
@@ -30,7 +33,35 @@ void SummaryMetric::doUpdate(double value) {
     ddsketch_->accept(value);
 }
 
+bool SummaryMetric::doShardedUpdate(double value) {
+    if (!shards_) {
+        return false;
+    }
+    if (::isnan(value)) {
+        return true;
+    }
+    shards_->Update([value](SummaryShard &shard) {
+        if (!shard.ddsketch) {
+            shard.ddsketch.reset(new DDSketch(RELATIVE_ACCURACY));
+        }
+        shard.calculator.Add(value);
+        shard.ddsketch->accept(value);
+    });
+    return true;
+}
+
 void SummaryMetric::doSnapshot(MetricsRecord *record, int64_t period) {
+    if (shards_ && ddsketch_ != nullptr) {
+        shards_->Merge([this](SummaryShard &shard) {
+            if (shard.calculator.Count() == 0) {
+                return;
+            }
+            calculator_.Merge(shard.calculator);
+            shard.calculator.Reset();
+            ddsketch_->mergeWith(*shard.ddsketch);
+            shard.ddsketch.reset();
+        });
+    }
     if (ddsketch_ == nullptr) {
         ddsketch_ = new DDSketch(RELATIVE_ACCURACY);
         return;
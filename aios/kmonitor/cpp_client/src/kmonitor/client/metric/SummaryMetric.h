@@ -8,11 +8,13 @@
 #ifndef KMONITOR_CLIENT_METRIC_SUMMARYMETRIC_H_
 #define KMONITOR_CLIENT_METRIC_SUMMARYMETRIC_H_
 
+#include <memory>
 #include <string>
 #include "kmonitor/client/common/Common.h"
 #include "kmonitor/client/metric/Metric.h"
 #include "kmonitor/client/metric/DDSketch.h"
 #include "kmonitor/client/common/MinMaxCalculator.h"
+#include "kmonitor/client/metric/MetricShards.h"
 
 BEGIN_KMONITOR_NAMESPACE(kmonitor);
 
@@ -22,6 +24,7 @@ class SummaryMetric : public Metric {
     explicit SummaryMetric(const std::string &name);
     void doUpdate(double value) override;
     void doSnapshot(MetricsRecord *record, int64_t period) override;
+    bool doShardedUpdate(double value) override;
 
  private:
     SummaryMetric(const SummaryMetric &);
@@ -32,6 +35,13 @@ class SummaryMetric : public Metric {
     DDSketch* ddsketch_;
     MinMaxCalculator calculator_;
     static const double RELATIVE_ACCURACY;
+
+    // ddsketch is created on first update so idle cpu shards stay small
+    struct SummaryShard {
+        std::unique_ptr<DDSketch> ddsketch;
+        MinMaxCalculator calculator;
+    };
+    std::unique_ptr<MetricShards<SummaryShard>> shards_;
     
  private:
     friend class SummaryMetricTest_TestUpdate_Test;
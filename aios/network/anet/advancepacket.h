@@ -258,6 +258,12 @@ public:
     /* overridden virtual functions from Packet */
     virtual bool encode(DataBuffer *output);
     virtual bool decode(DataBuffer *input, PacketHeader *header);
+    /* Checksum covers the body, so it is never borrowed. */
+    virtual bool encodeWithPayload(DataBuffer *output, const char *&payload,
+                                   size_t &payloadLen)
+    {
+        return Packet::encodeWithPayload(output, payload, payloadLen);
+    }
 
     /* Get channel id by combing the chid field in Packet and chidHigh field
      * in AdvancePacket. */
@@ -131,6 +131,19 @@ bool DefaultPacket::encode(DataBuffer *output) {
     return true;
 }
 
+bool DefaultPacket::encodeWithPayload(DataBuffer *output, const char *&payload,
+                                      size_t &payloadLen)
+{
+    if (_bodyLength < BORROW_BODY_MIN_LENGTH) {
+        payload = NULL;
+        payloadLen = 0;
+        return encode(output);
+    }
+    payload = _body;
+    payloadLen = _bodyLength;
+    return true;
+}
+
 bool DefaultPacket::decode(DataBuffer *input, PacketHeader *header) {
     assert(input->getDataLen() >= header->_dataLen);
     bool rc = setBody(input->getData(), header->_dataLen);
@@ -34,6 +34,10 @@ class DataBuffer;
 
 class DefaultPacket : public Packet
 {
+public:
+    // smaller body is copied into output buffer, cheaper than one more iovec
+    static const size_t BORROW_BODY_MIN_LENGTH = 4096;
+
 public:
     DefaultPacket();
     ~DefaultPacket();
@@ -46,6 +50,7 @@ public:
     char* getBody();
 
     bool encode(DataBuffer *output);
+    bool encodeWithPayload(DataBuffer *output, const char *&payload, size_t &payloadLen);
     bool decode(DataBuffer *input, PacketHeader *header); 
 
     int64_t getSpaceUsed();
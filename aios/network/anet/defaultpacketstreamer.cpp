@@ -80,6 +80,20 @@ Packet *DefaultPacketStreamer::decode(DataBuffer *input, PacketHeader *header) {
 }
 
 bool DefaultPacketStreamer::encode(Packet *packet, DataBuffer *output) {
+    const char *payload = NULL;
+    size_t payloadLen = 0;
+    if (!encodeWithPayload(packet, output, payload, payloadLen)) {
+        return false;
+    }
+    if (payloadLen > 0) {
+        output->writeBytes(payload, payloadLen);
+    }
+    return true;
+}
+
+bool DefaultPacketStreamer::encodeWithPayload(Packet *packet, DataBuffer *output,
+                                              const char *&payload, size_t &payloadLen)
+{
     PacketHeader *header = packet->getPacketHeader();
 
     // 为了当encode失败恢复时用
@@ -102,13 +116,13 @@ bool DefaultPacketStreamer::encode(Packet *packet, DataBuffer *output) {
         headerSize = 4 * sizeof(int32_t);
     }
     // 写数据
-    if (packet->encode(output) == false) {
+    if (packet->encodeWithPayload(output, payload, payloadLen) == false) {
         ANET_LOG(ERROR, "encode error");
         output->stripData(output->getDataLen() - oldLen);
         return false;
     }
     // 计算包长度
-    header->_dataLen = output->getDataLen() - oldLen - headerSize;
+    header->_dataLen = output->getDataLen() - oldLen - headerSize + payloadLen;
 
     // Assert the invalid situation
     DBGASSERT(output->getDataLen() >= oldLen + headerSize);
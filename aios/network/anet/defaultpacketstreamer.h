@@ -56,6 +56,13 @@ public:
      */
     bool encode(Packet *packet, DataBuffer *output);
 
+    /**
+     * encode a packet, large body may be left in packet as payload, data
+     * length in packet header includes the payload
+     */
+    bool encodeWithPayload(Packet *packet, DataBuffer *output,
+                           const char *&payload, size_t &payloadLen);
+
     bool processData(DataBuffer *dataBuffer, StreamingContext *context); 
 
 };
@@ -21,6 +21,8 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdint.h>
+#include <sys/uio.h>
+#include <algorithm>
 
 #include "aios/network/anet/channel.h"
 #include "aios/network/anet/channelpool.h"
@@ -118,15 +120,10 @@ bool DirectTCPConnection::writeData() {
                 }
             }
         CONTINUE_WRITE_PAYLOAD:
-            if (_payloadLeftToWrite > 0) {  // write direct payload:
-                if (_output.getDataLen() > 0) {
-                    ret = sendBuffer(writeCnt, error);
-                    if (_output.getDataLen() > 0) {
-                        break;
-                    }
-                }
-                ret = sendPayload(writeCnt, error);
-                if (0UL == _payloadLeftToWrite) {  // write to socket success with payload
+            if (_payloadLeftToWrite > 0) {  // write buffered data and direct payload in one call:
+                ret = sendBufferAndPayload(writeCnt, error);
+                if (_output.getDataLen() == 0 && 0UL == _payloadLeftToWrite) {
+                    // write to socket success with payload
                     finishPacketWrite();
                 }
                 break;
@@ -296,15 +293,33 @@ int DirectTCPConnection::sendBuffer(int &writeCnt, int &error) {
     return ret;
 }
 
-int DirectTCPConnection::sendPayload(int &writeCnt, int &error) {
+int DirectTCPConnection::sendBufferAndPayload(int &writeCnt, int &error) {
     assert(_payloadLeftToWrite > 0UL && nullptr != _writingPacket);
     auto addr = _writingPayload.getAddr();
     auto len = _writingPayload.getLen();
-    int ret = _socket->write(addr + len - _payloadLeftToWrite, _payloadLeftToWrite);
+    // payload is borrowed from packet, gather it after buffered header
+    // instead of copying it into _output
+    struct iovec iov[2];
+    int iovcnt = 0;
+    size_t bufferLen = _output.getDataLen();
+    if (bufferLen > 0) {
+        iov[iovcnt].iov_base = _output.getData();
+        iov[iovcnt].iov_len = bufferLen;
+        iovcnt++;
+    }
+    iov[iovcnt].iov_base = const_cast<char *>(addr) + len - _payloadLeftToWrite;
+    iov[iovcnt].iov_len = _payloadLeftToWrite;
+    iovcnt++;
+    int ret = _socket->writev(iov, iovcnt);
     if (ret > 0) {
-        ANET_LOG(SPAM, "%d bytes written from payload:[%p]", ret, addr);
+        ANET_LOG(SPAM, "%d bytes written from buffer and payload:[%p]", ret, addr);
         _stats.totalTxBytes += ret;
-        _payloadLeftToWrite -= ret;
+        size_t bufferWritten = std::min(bufferLen, (size_t)ret);
+        if (bufferWritten > 0) {
+            _output.drainData(bufferWritten);
+            ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - (int64_t)bufferWritten);
+        }
+        _payloadLeftToWrite -= ret - bufferWritten;
     } else {
         error = _socket->getSoError();
     }
@@ -39,7 +39,7 @@ private:
     void clearWritingPacket();
     void finishPacketWrite();
     int sendBuffer(int &writeCnt, int &error);
-    int sendPayload(int &writeCnt, int &error);
+    int sendBufferAndPayload(int &writeCnt, int &error);
 
 private:
     DirectPacketStreamer *_directStreamer;
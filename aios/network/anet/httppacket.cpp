@@ -342,6 +342,22 @@ bool HTTPPacket::encode(DataBuffer *output) {
             && encodeBody(output));
 }
 
+bool HTTPPacket::encodeWithPayload(DataBuffer *output, const char *&payload,
+                                   size_t &payloadLen)
+{
+    payload = NULL;
+    payloadLen = 0;
+    if (!encodeStartLine(output) || !encodeHeaders(output)) {
+        return false;
+    }
+    if (_bodyLength < BORROW_BODY_MIN_LENGTH) {
+        return encodeBody(output);
+    }
+    payload = _body;
+    payloadLen = _bodyLength;
+    return true;
+}
+
 bool HTTPPacket::encodeStartLine(DataBuffer *output) {
     if (PT_REQUEST == getPacketType()) {
         const char *methodStr = getMethodString();
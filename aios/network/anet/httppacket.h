@@ -102,6 +102,7 @@ public:
     bool encodeStartLine(DataBuffer *output);
     bool encodeHeaders(DataBuffer *output);
     bool encodeBody(DataBuffer *output);
+    bool encodeWithPayload(DataBuffer *output, const char *&payload, size_t &payloadLen);
 
     bool decode(DataBuffer *input, PacketHeader *header) {
         return false;
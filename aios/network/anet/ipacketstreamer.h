@@ -67,6 +67,18 @@ public:
      */
     virtual bool encode(Packet *packet, DataBuffer *output) = 0;
 
+    /*
+     * Same as encode(), payload borrowed from packet follows the bytes in
+     * output on the wire, see Packet::encodeWithPayload()
+     */
+    virtual bool encodeWithPayload(Packet *packet, DataBuffer *output,
+                                   const char *&payload, size_t &payloadLen)
+    {
+        payload = NULL;
+        payloadLen = 0;
+        return encode(packet, output);
+    }
+
     /*
      * 是否有数据包头
      */
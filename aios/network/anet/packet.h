@@ -91,6 +91,24 @@ public:
      */
     virtual bool encode(DataBuffer *output) = 0;
 
+    /**
+     * Same as encode(), except that a tail of packet data may be left in
+     * packet and returned as payload instead of being copied into output.
+     * Payload is written to socket right after the bytes in output and
+     * must stay valid until the packet is freed. Default copies all.
+     *
+     * @param output target DataBuffer
+     * @param payload borrowed tail, NULL if none
+     * @param payloadLen length of borrowed tail
+     */
+    virtual bool encodeWithPayload(DataBuffer *output, const char *&payload,
+                                   size_t &payloadLen)
+    {
+        payload = NULL;
+        payloadLen = 0;
+        return encode(output);
+    }
+
     /**
      * Read data form DataBuffer according to the information in
      * PacketHeader and construct packet. The DataBuffer contains
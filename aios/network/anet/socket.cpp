@@ -23,6 +23,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <stdio.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
@@ -228,6 +229,28 @@ int Socket::write(const void *data, int len) {
     return res;
 }
 
+int Socket::writev(const struct iovec *iov, int iovcnt) {
+    if (_socketHandle == -1) {
+        return -1;
+    }
+    if (iov == NULL || iovcnt <= 0)
+        return -1;
+
+    int res = -1;
+    do {
+        res = ::writev(_socketHandle, iov, iovcnt);
+        if (res > 0)
+        {
+            ANET_COUNT_DATA_WRITE(res);
+        }
+        else if (-1 == res && (errno != EINTR && errno != EAGAIN))
+        {
+            writeErrInc();
+        }
+    } while (res < 0 && errno == EINTR);
+    return res;
+}
+
 int Socket::read (void *data, int len) {
     if (_socketHandle == -1) {
         return -1;
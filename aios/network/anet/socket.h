@@ -25,6 +25,7 @@
 #include <string>
 
 struct sockaddr_in;
+struct iovec;
 
 namespace anet {
 const int LISTEN_BACKLOG = 256;
@@ -71,6 +72,12 @@ public:
     void setIOComponent(IOComponent *ioc);
 
     virtual int write(const void *data, int len);
+    /*
+     * gather write, iov can mix buffered data and borrowed payload
+     *
+     * @return bytes written, same as write
+     */
+    virtual int writev(const struct iovec *iov, int iovcnt);
     virtual int read(void *data, int len);
 
     bool setKeepAlive(bool on) {
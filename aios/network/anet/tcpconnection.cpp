@@ -25,6 +25,8 @@
 #include <errno.h>
 #include <stdint.h>
 #include <string.h>
+#include <sys/uio.h>
+#include <algorithm>
 
 #include "aios/network/anet/connection.h"
 #include "aios/network/anet/databuffer.h"
@@ -47,24 +49,92 @@ TCPConnection::TCPConnection(Socket *socket, IPacketStreamer *streamer,
     _outputBufferSpaceAllocated = 0;
     _maxRecvPacketSize = 0;
     _maxSendPacketSize = 0;
+    _outputPayloadLen = 0;
 }
 
 TCPConnection::~TCPConnection() {
     addInputBufferSpaceAllocated(0 - _input.getSpaceUsed());
     addOutputBufferSpaceAllocated(0 - _output.getSpaceUsed());
     ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - _output.getDataLen());
+    clearOutputSlices();
 }
 
 void TCPConnection::clearOutputBuffer() {
     ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - _output.getDataLen());
     _output.clear();
+    clearOutputSlices();
+}
+
+void TCPConnection::clearOutputSlices() {
+    for (size_t i = 0; i < _outputSlices.size(); i++) {
+        _outputSlices[i].packet->free();
+    }
+    _outputSlices.clear();
+    _outputPayloadLen = 0;
+}
+
+int TCPConnection::writeOutput() {
+    if (_outputSlices.empty()) {
+        return _socket->write(_output.getData(), _output.getDataLen());
+    }
+    // buffered bytes and borrowed payloads in wire order, one writev
+    static const int MAX_WRITE_IOV = 64;
+    struct iovec iov[MAX_WRITE_IOV];
+    int iovcnt = 0;
+    char *data = _output.getData();
+    char *end = data + _output.getDataLen();
+    for (size_t i = 0; i < _outputSlices.size() && iovcnt + 2 <= MAX_WRITE_IOV; i++) {
+        const OutputSlice &slice = _outputSlices[i];
+        if (slice.bufferLen > 0) {
+            iov[iovcnt].iov_base = data;
+            iov[iovcnt].iov_len = slice.bufferLen;
+            iovcnt++;
+            data += slice.bufferLen;
+        }
+        iov[iovcnt].iov_base = const_cast<char *>(slice.payload);
+        iov[iovcnt].iov_len = slice.payloadLen;
+        iovcnt++;
+    }
+    if (data < end && iovcnt < MAX_WRITE_IOV) {
+        iov[iovcnt].iov_base = data;
+        iov[iovcnt].iov_len = end - data;
+        iovcnt++;
+    }
+    return _socket->writev(iov, iovcnt);
+}
+
+void TCPConnection::drainOutput(size_t len) {
+    size_t bufferDrained = 0;
+    while (len > 0 && !_outputSlices.empty()) {
+        OutputSlice &slice = _outputSlices.front();
+        size_t n = std::min(len, slice.bufferLen);
+        slice.bufferLen -= n;
+        bufferDrained += n;
+        len -= n;
+        if (slice.bufferLen > 0) {
+            break;
+        }
+        n = std::min(len, slice.payloadLen);
+        slice.payload += n;
+        slice.payloadLen -= n;
+        _outputPayloadLen -= n;
+        len -= n;
+        if (slice.payloadLen > 0) {
+            break;
+        }
+        slice.packet->free();
+        _outputSlices.pop_front();
+    }
+    bufferDrained += len;
+    _output.drainData(bufferDrained);
+    ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - (int64_t)bufferDrained);
 }
 
 bool TCPConnection::writeData() {
     //to reduce the odds of blocking postPacket()
     _outputCond.lock();
     _outputQueue.moveTo(&_myQueue);
-    if (_myQueue.size() == 0 && _output.getDataLen() == 0) {
+    if (_myQueue.size() == 0 && _output.getDataLen() == 0 && _outputSlices.empty()) {
         ANET_LOG(DEBUG,"IOC(%p)->enableWrite(false)",_iocomponent);
         _iocomponent->enableWrite(false);
         _outputCond.unlock();
@@ -81,7 +151,7 @@ bool TCPConnection::writeData() {
 
     _lasttime = TimeUtil::getTime();
     do {
-        while (_output.getDataLen() < _readWriteBufSize) {
+        while (_output.getDataLen() + _outputPayloadLen < (size_t)_readWriteBufSize) {
             if (myQueueSize == 0) {
                 break;
             }
@@ -90,12 +160,14 @@ bool TCPConnection::writeData() {
             myQueueSize --;
             int64_t oldDataLen = _output.getDataLen();
             int64_t oldSpaceAllocated = _output.getSpaceUsed();
-            _streamer->encode(packet, &_output);
+            const char *payload = NULL;
+            size_t payloadLen = 0;
+            _streamer->encodeWithPayload(packet, &_output, payload, payloadLen);
             int64_t newDataLen = _output.getDataLen();
             int64_t newSpaceAllocated = _output.getSpaceUsed();
             int64_t packetSizeInBuffer = newDataLen - oldDataLen;
-            if (packetSizeInBuffer > _maxSendPacketSize) {
-                _maxSendPacketSize = packetSizeInBuffer;
+            if (packetSizeInBuffer + (int64_t)payloadLen > _maxSendPacketSize) {
+                _maxSendPacketSize = packetSizeInBuffer + payloadLen;
             }
             addOutputBufferSpaceAllocated(newSpaceAllocated - oldSpaceAllocated);
             ANET_ADD_OUTPUT_BUFFER_SPACE_USED(packetSizeInBuffer);
@@ -115,27 +187,37 @@ bool TCPConnection::writeData() {
             }
             updateQueueStatus(packet, false);
             packet->invokeDequeueCB();
-            packet->free();
+            if (payloadLen > 0) {
+                // packet keeps payload alive until it is written
+                size_t sliceBufferLen = newDataLen;
+                for (size_t i = 0; i < _outputSlices.size(); i++) {
+                    sliceBufferLen -= _outputSlices[i].bufferLen;
+                }
+                OutputSlice slice = {sliceBufferLen, payload, payloadLen, packet};
+                _outputSlices.push_back(slice);
+                _outputPayloadLen += payloadLen;
+            } else {
+                packet->free();
+            }
 
             ANET_COUNT_PACKET_WRITE(1);
         }
 
-        if (_output.getDataLen() == 0) {
+        if (_output.getDataLen() == 0 && _outputSlices.empty()) {
             break;
         }
 
         // write data
-        ret = _socket->write(_output.getData(), _output.getDataLen());
+        ret = writeOutput();
         if (ret > 0) {
-            _output.drainData(ret);
+            drainOutput(ret);
             _stats.totalTxBytes += ret;
-            ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - ret);
         } else {
             error = _socket->getSoError();
         }
 
         writeCnt ++;
-    } while (ret > 0 && _output.getDataLen() == 0
+    } while (ret > 0 && _output.getDataLen() == 0 && _outputSlices.empty()
              /**@todo remove magic number 10*/
              && myQueueSize>0 && writeCnt < 10);
     _stats.callWriteCount += writeCnt;
@@ -151,7 +233,8 @@ bool TCPConnection::writeData() {
         clearOutputBuffer();
         return false;
     }
-    int queueSize = _outputQueue.size() + (_output.getDataLen() > 0 ? 1 : 0);
+    int queueSize = _outputQueue.size() +
+                    (_output.getDataLen() > 0 || !_outputSlices.empty() ? 1 : 0);
     if (queueSize > 0) {
 //when using level triggered mode, do NOT need to call enableWrite() any more.
 //        ANET_LOG(DEBUG,"IOC(%p)->enableWrite(true)", _iocomponent);
@@ -16,6 +16,8 @@
 #ifndef ANET_TCPCONNECTION_H_
 #define ANET_TCPCONNECTION_H_
 #include <stdint.h>
+#include <stddef.h>
+#include <deque>
 
 #include "aios/network/anet/databuffer.h"
 #include "aios/network/anet/connection.h"
@@ -123,8 +125,26 @@ public:
         return ret;
     }
 
+protected:
+    /*
+     * payload borrowed from packet, written after bufferLen bytes of
+     * _output (counted from end of previous slice), packet is freed when
+     * payload is written
+     */
+    struct OutputSlice {
+        size_t bufferLen;
+        const char *payload;
+        size_t payloadLen;
+        Packet *packet;
+    };
+    int writeOutput();
+    void drainOutput(size_t len);
+    void clearOutputSlices();
+
 protected:
     DataBuffer _output;         // 输出的buffer
+    std::deque<OutputSlice> _outputSlices;
+    size_t _outputPayloadLen;   // payload bytes in _outputSlices
     DataBuffer _input;          // 读入的buffer
     PacketHeader _packetHeader; // 读入的packet header
     bool _gotHeader;            // packet header已经取过
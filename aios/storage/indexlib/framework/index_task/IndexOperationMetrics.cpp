@@ -31,6 +31,8 @@ void IndexOperationMetrics::RegisterMetrics()
     REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, metricName, "index_task/" #metricName, kmonitor::GAUGE)
 
     REGISTER_INDEX_OP_METRIC(operationExecuteTime);
+    REGISTER_INDEX_OP_METRIC(indexMergeItemThroughput);
+    REGISTER_INDEX_OP_METRIC(indexMergeBytesThroughput);
 }
 
 void IndexOperationMetrics::ReportOpExecuteTime(const kmonitor::MetricsTags& tags, int64_t executeTimeInUs)
@@ -38,4 +40,11 @@ void IndexOperationMetrics::ReportOpExecuteTime(const kmonitor::MetricsTags& tag
     INDEXLIB_FM_REPORT_METRIC_WITH_TAGS_AND_VALUE(&tags, operationExecuteTime, executeTimeInUs);
 }
 
+void IndexOperationMetrics::ReportIndexMergeThroughput(const kmonitor::MetricsTags& tags, double itemsPerSecond,
+                                                       double bytesPerSecond)
+{
+    INDEXLIB_FM_REPORT_METRIC_WITH_TAGS_AND_VALUE(&tags, indexMergeItemThroughput, itemsPerSecond);
+    INDEXLIB_FM_REPORT_METRIC_WITH_TAGS_AND_VALUE(&tags, indexMergeBytesThroughput, bytesPerSecond);
+}
+
 } // namespace indexlibv2::framework
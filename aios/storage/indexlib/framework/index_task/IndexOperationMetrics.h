@@ -33,9 +33,12 @@ public:
     void RegisterMetrics() override;
 
     void ReportOpExecuteTime(const kmonitor::MetricsTags& tags, int64_t executeTimeInUs);
+    void ReportIndexMergeThroughput(const kmonitor::MetricsTags& tags, double itemsPerSecond, double bytesPerSecond);
 
 private:
     INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, operationExecuteTime);
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(double, indexMergeItemThroughput);
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(double, indexMergeBytesThroughput);
     std::shared_ptr<kmonitor::MetricsReporter> _metricsReporter;
 
 private:
@@ -52,6 +52,12 @@ public:
         std::vector<std::shared_ptr<framework::Segment>> baseVersionSegments;
         std::shared_ptr<indexlib::file_system::RelocatableFolder> relocatableGlobalRoot;
     };
+    // filled by mergers tracking throughput, reported through index operation metrics after Merge
+    struct MergeStatistics {
+        size_t itemCount = 0;
+        size_t bytesWritten = 0;
+        int64_t timeUsedInUs = 0;
+    };
 
 public:
     IIndexMerger() = default;
@@ -61,6 +67,7 @@ public:
                         const std::map<std::string, std::any>& params) = 0;
     virtual Status Merge(const SegmentMergeInfos& segMergeInfos,
                          const std::shared_ptr<framework::IndexTaskResourceManager>& taskResourceManager) = 0;
+    virtual MergeStatistics GetMergeStatistics() const { return MergeStatistics(); }
 };
 
 } // namespace indexlibv2::index
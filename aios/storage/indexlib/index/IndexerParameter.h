@@ -62,6 +62,8 @@ struct IndexerParameter {
     std::shared_ptr<indexlib::framework::SegmentMetrics> segmentMetrics;
 
     config::SortDescriptions sortDescriptions;
+    // building segment of kv index split into shards built in parallel when > 1
+    uint32_t buildingShardCount = 1;
     enum {
         READER_NORMAL,        // normal mode
         READER_DEFAULT_VALUE, // not physical index, for default value
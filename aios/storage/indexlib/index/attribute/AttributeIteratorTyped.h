@@ -72,6 +72,9 @@ public:
     BatchSeek(const std::vector<docid_t>& docIds, indexlib::file_system::ReadOption readOption,
               std::vector<std::string>* values) noexcept override;
 
+    // docIds should be sorted, docs in the same built segment are read in one batch
+    bool BatchSeek(const docid_t* docIds, size_t count, T* values, bool* isNulls);
+
 private:
     bool SeekInRandomMode(docid_t docId, T& value, bool& isNull);
 
@@ -379,4 +382,33 @@ AttributeIteratorTyped<T, ReaderTraits>::BatchSeek(const std::vector<docid_t>& d
     co_return result;
 }
 
+template <typename T, typename ReaderTraits>
+bool AttributeIteratorTyped<T, ReaderTraits>::BatchSeek(const docid_t* docIds, size_t count, T* values, bool* isNulls)
+{
+    assert(std::is_sorted(docIds, docIds + count));
+    std::vector<docid_t> segmentDocIds;
+    docid_t baseDocId = 0;
+    size_t docIdx = 0;
+    for (size_t i = 0; i < _segmentDocCount.size() && docIdx < count; ++i) {
+        docid_t segmentEndDocId = baseDocId + (docid_t)_segmentDocCount[i];
+        size_t beginIdx = docIdx;
+        segmentDocIds.clear();
+        while (docIdx < count && docIds[docIdx] < segmentEndDocId) {
+            segmentDocIds.push_back(docIds[docIdx++] - baseDocId);
+        }
+        if (!segmentDocIds.empty() &&
+            !_segmentReaders[i]->BatchRead(segmentDocIds.data(), segmentDocIds.size(), values + beginIdx,
+                                           isNulls + beginIdx, _segmentReadContext[i])) {
+            return false;
+        }
+        baseDocId = segmentEndDocId;
+    }
+    for (; docIdx < count; ++docIdx) {
+        if (!ReadFromMemSegment(docIds[docIdx], values[docIdx], _buildingSegIdx, isNulls[docIdx], _pool)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace indexlibv2::index
@@ -59,6 +59,9 @@ public:
     BatchRead(const std::vector<docid_t>& docIds,
               indexlib::index::EquivalentCompressSessionReader<T>& compressSessionReader,
               indexlib::file_system::ReadOption readOption, typename std::vector<T>* values) const noexcept;
+    // docIds should be sorted, each compress slot is decoded once for docs located in it
+    Status BatchRead(const docid_t* docIds, size_t count,
+                     indexlib::index::EquivalentCompressSessionReader<T>& compressSessionReader, T* values) const;
 
     bool UpdateField(docid_t docId, uint8_t* buf, uint32_t bufLen);
     size_t EvaluateCurrentMemUsed();
@@ -245,6 +248,30 @@ future_lite::coro::Lazy<indexlib::index::ErrorCodeVec> SingleValueAttributeCompr
     co_return result;
 }
 
+template <typename T>
+inline Status SingleValueAttributeCompressReader<T>::BatchRead(
+    const docid_t* docIds, size_t count, indexlib::index::EquivalentCompressSessionReader<T>& compressSessionReader,
+    T* values) const
+{
+    if (count == 0) {
+        return Status::OK();
+    }
+    if (docIds[0] < 0 || docIds[count - 1] >= (docid_t)(this->_docCount)) {
+        return Status::NotFound("docId range[%d, %d] not in range[%d, %d]", docIds[0], docIds[count - 1], 0,
+                                this->_docCount);
+    }
+    if (!this->_data) {
+        // data not in memory, read by session reader which has its own block cache
+        for (size_t i = 0; i < count; ++i) {
+            auto [status, val] = compressSessionReader.Get(docIds[i]);
+            RETURN_IF_STATUS_ERROR(status, "compress session reader get failed.");
+            values[i] = val;
+        }
+        return Status::OK();
+    }
+    return _equivalentCompressReader->BatchGet(docIds, count, values);
+}
+
 template <typename T>
 bool SingleValueAttributeCompressReader<T>::UpdateField(docid_t docId, uint8_t* buf, uint32_t bufLen)
 {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include <algorithm>
 #include <fcntl.h>
 #include <memory>
 #include <sstream>
@@ -136,6 +137,8 @@ public:
         return _fieldPrinter->Print(isNull, attrValue, value);
     }
     inline bool Read(docid_t docId, T& value, bool& isNull, ReadContext& ctx) const __ALWAYS_INLINE;
+    // docIds should be sorted, compress slots are decoded once for docs in the same slot
+    bool BatchRead(const docid_t* docIds, size_t count, T* values, bool* isNulls, ReadContext& ctx) const;
     template <class Compare>
     Status Search(T value, const DocIdRange& rangeLimit, const config::SortPattern& sortType, docid_t& docId) const;
     int32_t SearchNullCount(const config::SortPattern& sortType) const;
@@ -281,6 +284,22 @@ inline bool SingleValueAttributeDiskIndexer<T>::Read(docid_t docId, T& value, bo
     return false;
 }
 
+template <typename T>
+inline bool SingleValueAttributeDiskIndexer<T>::BatchRead(const docid_t* docIds, size_t count, T* values,
+                                                          bool* isNulls, ReadContext& ctx) const
+{
+    if (_patch != nullptr || _attrReaderType != AttributeReaderType::COMPRESS_READER) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!Read(docIds[i], values[i], isNulls[i], ctx)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    std::fill(isNulls, isNulls + count, false);
+    return _compressReader->BatchRead(docIds, count, ctx.compressSessionReader, values).IsOK();
+}
+
 template <typename T>
 inline future_lite::coro::Lazy<indexlib::index::ErrorCodeVec> SingleValueAttributeDiskIndexer<T>::BatchRead(
     const std::vector<docid_t>& docIds, ReadContext& ctx, indexlib::file_system::ReadOption readOption,
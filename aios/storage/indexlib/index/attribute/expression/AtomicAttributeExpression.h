@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "autil/Log.h"
 #include "autil/NoCopyable.h"
 #include "expression/framework/AttributeExpressionTyped.h"
@@ -47,7 +51,7 @@ public:
 
 public:
     void evaluate(const matchdoc::MatchDoc& matchDoc) override;
-    void batchEvaluate(matchdoc::MatchDoc* matchDocs, uint32_t docCount) override { assert(false); }
+    void batchEvaluate(matchdoc::MatchDoc* matchDocs, uint32_t docCount) override;
     Status InitPrefetcher(TabletSessionResource* resource) override;
     Status Prefetch(const matchdoc::MatchDoc& matchDoc) override;
 
@@ -82,4 +86,31 @@ void AtomicAttributeExpression<T>::evaluate(const matchdoc::MatchDoc& matchDoc)
     this->storeValue(matchDoc, value);
 }
 
+template <typename T>
+void AtomicAttributeExpression<T>::batchEvaluate(matchdoc::MatchDoc* matchDocs, uint32_t docCount)
+{
+    // read in one batch in docid order to decode each compress block once, matchdocs from scan are already in
+    // docid order, others are read through a sorted permutation and values are scattered back
+    std::vector<docid_t> docIds(docCount);
+    for (uint32_t i = 0; i < docCount; ++i) {
+        docIds[i] = matchDocs[i].getDocId();
+    }
+    std::vector<uint32_t> order;
+    if (!std::is_sorted(docIds.begin(), docIds.end())) {
+        order.resize(docCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&docIds](uint32_t lhs, uint32_t rhs) { return docIds[lhs] < docIds[rhs]; });
+        for (uint32_t i = 0; i < docCount; ++i) {
+            docIds[i] = matchDocs[order[i]].getDocId();
+        }
+    }
+    std::vector<T> values(docCount);
+    [[maybe_unused]] auto status = _prefetcher.BatchFetch(docIds.data(), docCount, values.data());
+    assert(status.IsOK());
+    for (uint32_t i = 0; i < docCount; ++i) {
+        this->storeValue(matchDocs[order.empty() ? i : order[i]], values[i]);
+    }
+}
+
 } // namespace indexlibv2::index
@@ -15,6 +15,7 @@
  */
 #pragma once
 #include "autil/Log.h"
+#include "autil/MultiValueType.h"
 #include "autil/NoCopyable.h"
 #include "autil/memory.h"
 #include "indexlib/index/attribute/AttributeIndexFactory.h"
@@ -37,6 +38,8 @@ public:
     Status Init(autil::mem_pool::Pool* pool, const std::shared_ptr<config::AttributeConfig>& attrConfig,
                 std::vector<std::shared_ptr<framework::Segment>> segments);
     Status Prefetch(docid_t docId);
+    // docIds should be sorted
+    Status BatchFetch(const docid_t* docIds, size_t count, T* values);
     T GetValue() const { return _currentValue.second; }
     docid_t GetCurrentDocId() const { return _currentValue.first; }
 
@@ -102,4 +105,40 @@ Status AttributePrefetcher<T>::Prefetch(docid_t docId)
     return Status::OK();
 }
 
+template <typename T>
+Status AttributePrefetcher<T>::BatchFetch(const docid_t* docIds, size_t count, T* values)
+{
+    if constexpr (autil::IsMultiType<T>::value) {
+        // read by iterator directly, docIds may be lower than current prefetched doc
+        for (size_t i = 0; i < count; ++i) {
+            bool success = false;
+            try {
+                success = _attrIterator->Seek(docIds[i], values[i]);
+            } catch (...) {
+                AUTIL_LOG(ERROR, "batch fetch docid [%d] failed", docIds[i]);
+                return Status::Corruption("batch fetch failed, exception");
+            }
+            if (!success) {
+                AUTIL_LOG(ERROR, "batch fetch docid [%d] failed, seek failed", docIds[i]);
+                return Status::Corruption("batch fetch failed");
+            }
+        }
+        return Status::OK();
+    } else {
+        std::unique_ptr<bool[]> isNulls(new bool[count]);
+        bool success = false;
+        try {
+            success = _attrIterator->BatchSeek(docIds, count, values, isNulls.get());
+        } catch (...) {
+            AUTIL_LOG(ERROR, "batch fetch [%lu] docs failed", count);
+            return Status::Corruption("batch fetch failed, exception");
+        }
+        if (!success) {
+            AUTIL_LOG(ERROR, "batch fetch [%lu] docs failed, seek failed", count);
+            return Status::Corruption("batch fetch failed");
+        }
+        return Status::OK();
+    }
+}
+
 } // namespace indexlibv2::index
@@ -109,6 +109,7 @@ public:
 
     bool Insert(uint64_t key, const autil::StringView& value) override;
     bool Delete(uint64_t key, const autil::StringView& value = autil::StringView()) override;
+    void Prefetch(uint64_t key) const override { __builtin_prefetch(&_bucket[(_KT)key % _bucketCount]); }
 
 public:
     static bool Probe(const _KT& key, uint64_t& probeCount, uint64_t& bucketId, uint64_t bucketCount);
@@ -32,6 +32,7 @@ enum HashTableAccessType {
     CUCKOO_TABLE,
     DENSE_READER,
     CUCKOO_READER,
+    SWISS_TABLE,
 };
 
 typedef std::map<std::string, std::string> KVMap;
@@ -86,6 +87,8 @@ public:
     virtual void* Address() const = 0;
     virtual bool Stretch() = 0;
     virtual size_t Compress(BucketCompressor* bucketCompressor) = 0;
+    // load bucket of key into cache ahead of Find, used by batch lookup
+    virtual void Prefetch(uint64_t key) const {}
 
 public:
     virtual int32_t GetRecommendedOccupancy(int32_t occupancy) const = 0;
@@ -94,6 +97,8 @@ public:
     virtual size_t TableMemroyToCapacity(size_t tableMemory, int32_t occupancyPct) const = 0;
     virtual size_t BuildMemoryToCapacity(size_t buildMemory, int32_t occupancyPct) const = 0;
     virtual size_t BuildMemoryToTableMemory(size_t buildMemory, int32_t occupancyPct) const = 0;
+    // memory used beside table memory after MountForRead
+    virtual size_t TableMemoryToReadAssistantMemory(size_t tableMemory) const { return 0; }
 
 private:
     AUTIL_LOG_DECLARE();
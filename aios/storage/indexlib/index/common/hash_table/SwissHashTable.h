@@ -0,0 +1,627 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <atomic>
+#include <memory>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "indexlib/index/common/hash_table/DenseHashTable.h"
+
+namespace indexlibv2::index {
+
+// FORMAT: same as dense_hash_table.h, buckets are placed by the same linear probing, so dumped
+// files are read by DenseHashTableFileReader and iterated by ClosedHashTable(File)Iterator.
+// In memory, one control byte per bucket keeps 7 bits of key hash (CTRL_EMPTY for empty bucket).
+// Lookup compares GROUP_WIDTH control bytes at once and only touches buckets with matching tag.
+template <typename _KT, typename _VT, bool HasSpecialKey = ClosedHashTableTraits<_KT, _VT, false>::HasSpecialKey,
+          bool useCompactBucket = false>
+class SwissHashTableBase : public DenseHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>
+{
+public:
+    typedef DenseHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket> Base;
+    typedef typename Base::Bucket Bucket;
+    typedef typename Base::HashTableHeader HashTableHeader;
+    using Base::OCCUPANCY_PCT;
+
+public:
+    static constexpr uint64_t GROUP_WIDTH = 16;
+    static constexpr uint8_t CTRL_EMPTY = 0x80;
+
+public:
+    // control bytes are placed at the tail of data, buckets are mounted on the rest
+    bool MountForWrite(void* data, size_t size, const HashTableOptions& options = OCCUPANCY_PCT) override;
+    // control bytes are not dumped, rebuild them from buckets in heap
+    bool MountForRead(const void* data, size_t size) override;
+    uint64_t BuildAssistantMemoryUse() const override { return _ctrlCount; }
+    size_t TableMemoryToReadAssistantMemory(size_t tableMemory) const override
+    {
+        return DoTableMemoryToReadAssistantMemory(tableMemory);
+    }
+    bool Shrink(int32_t occupancyPct = 0) override;
+
+    uint64_t CapacityToBuildMemory(uint64_t maxKeyCount, const HashTableOptions& options) const override
+    {
+        return DoCapacityToBuildMemory(maxKeyCount, options);
+    }
+    size_t BuildMemoryToCapacity(size_t buildMemory, int32_t occupancyPct) const override
+    {
+        return DoBuildMemoryToCapacity(buildMemory, occupancyPct);
+    }
+
+    bool Insert(uint64_t key, const autil::StringView& value) override;
+    bool Delete(uint64_t key, const autil::StringView& value = autil::StringView()) override;
+    void Prefetch(uint64_t key) const override
+    {
+        uint64_t bucketId = (_KT)key % _bucketCount;
+        __builtin_prefetch(&_ctrl[bucketId]);
+        __builtin_prefetch(&_bucket[bucketId]);
+    }
+
+public:
+    static uint64_t DoCapacityToBuildMemory(uint64_t maxKeyCount, const HashTableOptions& options)
+    {
+        uint64_t tableMemory = Base::DoCapacityToTableMemory(maxKeyCount, options);
+        return tableMemory + (tableMemory - sizeof(HashTableHeader)) / sizeof(Bucket) + GROUP_WIDTH;
+    }
+    static size_t DoBuildMemoryToCapacity(size_t buildMemory, int32_t occupancyPct)
+    {
+        size_t bucketCount = BuildMemoryToBucketCount(buildMemory);
+        return Base::DoTableMemroyToCapacity(sizeof(HashTableHeader) + bucketCount * sizeof(Bucket), occupancyPct);
+    }
+    static size_t DoTableMemoryToReadAssistantMemory(size_t tableMemory)
+    {
+        if (tableMemory < sizeof(HashTableHeader)) {
+            return 0;
+        }
+        return (tableMemory - sizeof(HashTableHeader)) / sizeof(Bucket) + GROUP_WIDTH;
+    }
+
+public:
+    indexlib::util::Status Find(const _KT& key, const _VT*& value) const;
+    indexlib::util::Status FindForReadWrite(const _KT& key, _VT& value) const;
+    bool Insert(const _KT& key, const _VT& value);
+
+protected:
+    // tailSize bytes after buckets are left to derived table, control bytes follow them
+    bool MountWithControl(void* data, size_t size, size_t tailSize, const HashTableOptions& options);
+    template <typename functor>
+    bool InternalInsert(const _KT& key, const _VT& value);
+    Bucket* InternalFindBucket(const _KT& key) const;
+    void ResetControl();
+    void SetControl(uint64_t bucketId, uint8_t ctrl);
+    uint64_t ToBucketId(uint64_t bucketId) const { return bucketId < _bucketCount ? bucketId : bucketId % _bucketCount; }
+
+    // H2 of swiss table, high 7 bits of a multiplicative hash, independent of the home bucket (key % bucketCount)
+    static uint8_t Tag(const _KT& key) { return (uint8_t)(((uint64_t)key * 0x9E3779B97F4A7C15UL) >> 57); }
+    static uint32_t MatchGroup(const uint8_t* ctrl, uint8_t tag, uint32_t& emptyMask);
+    static size_t BuildMemoryToBucketCount(size_t buildMemory)
+    {
+        if (buildMemory < sizeof(HashTableHeader) + GROUP_WIDTH) {
+            return 0;
+        }
+        return (buildMemory - sizeof(HashTableHeader) - GROUP_WIDTH) / (sizeof(Bucket) + 1);
+    }
+
+protected:
+    using Base::_bucket;
+    using Base::_bucketCount;
+    using Base::_logger;
+
+    // _bucketCount + GROUP_WIDTH bytes, the tail mirrors the head so that a group never wraps around.
+    // points into the mounted data for write, into _ctrlBuffer for read
+    uint8_t* _ctrl = nullptr;
+    uint64_t _ctrlCount = 0;
+    std::unique_ptr<uint8_t[]> _ctrlBuffer;
+
+private:
+    friend class SwissHashTableTest;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline uint32_t SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::MatchGroup(const uint8_t* ctrl,
+                                                                                          uint8_t tag,
+                                                                                          uint32_t& emptyMask)
+{
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    emptyMask = (uint32_t)_mm_movemask_epi8(group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+#else
+    uint32_t matchMask = 0;
+    emptyMask = 0;
+    for (uint32_t i = 0; i < GROUP_WIDTH; ++i) {
+        matchMask |= (uint32_t)(ctrl[i] == tag) << i;
+        emptyMask |= (uint32_t)(ctrl[i] == CTRL_EMPTY) << i;
+    }
+    return matchMask;
+#endif
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool
+SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::MountForWrite(void* data, size_t size,
+                                                                             const HashTableOptions& options)
+{
+    return MountWithControl(data, size, 0, options);
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::MountWithControl(
+    void* data, size_t size, size_t tailSize, const HashTableOptions& options)
+{
+    if (size < tailSize + sizeof(HashTableHeader) + GROUP_WIDTH) {
+        AUTIL_LOG(ERROR, "not enough space, min size[%lu], give[%lu]", tailSize + sizeof(HashTableHeader) + GROUP_WIDTH,
+                  size);
+        return false;
+    }
+    uint64_t bucketCount = BuildMemoryToBucketCount(size - tailSize);
+    if (!Base::MountForWrite(data, sizeof(HashTableHeader) + bucketCount * sizeof(Bucket), options)) {
+        return false;
+    }
+    assert(_bucketCount == bucketCount);
+    _ctrlCount = _bucketCount + GROUP_WIDTH;
+    _ctrl = (uint8_t*)data + size - _ctrlCount;
+    _ctrlBuffer.reset();
+    ResetControl();
+    return true;
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::MountForRead(const void* data, size_t size)
+{
+    if (!Base::MountForRead(data, size)) {
+        return false;
+    }
+    _ctrlCount = _bucketCount + GROUP_WIDTH;
+    _ctrlBuffer.reset(new uint8_t[_ctrlCount]);
+    _ctrl = _ctrlBuffer.get();
+    ResetControl();
+    return true;
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::Shrink(int32_t occupancyPct)
+{
+    // buckets are placed as dense hash table does, only control bytes need rebuilding, bucket count never grows
+    bool ret = Base::Shrink(occupancyPct);
+    _ctrlCount = _bucketCount + GROUP_WIDTH;
+    ResetControl();
+    return ret;
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline void SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::ResetControl()
+{
+    assert(_ctrl && _ctrlCount == _bucketCount + GROUP_WIDTH);
+    for (uint64_t i = 0; i < _bucketCount; ++i) {
+        _ctrl[i] = _bucket[i].IsEmpty() ? CTRL_EMPTY : Tag(_bucket[i].Key());
+    }
+    for (uint64_t i = 0; i < GROUP_WIDTH; ++i) {
+        _ctrl[_bucketCount + i] = _bucketCount > 0 ? _ctrl[i % _bucketCount] : CTRL_EMPTY;
+    }
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline void SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::SetControl(uint64_t bucketId, uint8_t ctrl)
+{
+    // bucket must be visible to concurrent readers before its tag
+    std::atomic_thread_fence(std::memory_order_release);
+    _ctrl[bucketId] = ctrl;
+    for (uint64_t i = bucketId; i < GROUP_WIDTH; i += _bucketCount) {
+        _ctrl[_bucketCount + i] = ctrl;
+    }
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline typename SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::Bucket*
+SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::InternalFindBucket(const _KT& key) const
+{
+    uint64_t bucketCount = _bucketCount;
+    uint64_t bucketId = key % bucketCount;
+    uint8_t tag = Tag(key);
+    for (uint64_t probeCount = 0; probeCount < bucketCount; probeCount += GROUP_WIDTH) {
+        uint32_t emptyMask = 0;
+        uint32_t matchMask = MatchGroup(&_ctrl[bucketId], tag, emptyMask);
+        if (emptyMask) {
+            // linear probing never places a key behind an empty bucket
+            matchMask &= (emptyMask & -emptyMask) - 1;
+        }
+        while (matchMask) {
+            Bucket& bucket = _bucket[ToBucketId(bucketId + __builtin_ctz(matchMask))];
+            if (bucket.IsEqual(key)) {
+                return &bucket;
+            }
+            matchMask &= matchMask - 1;
+        }
+        if (emptyMask) {
+            return &_bucket[ToBucketId(bucketId + __builtin_ctz(emptyMask))];
+        }
+        bucketId = ToBucketId(bucketId + GROUP_WIDTH);
+    }
+    AUTIL_LOG(ERROR, "too many probings for key[%lu], bucketCount[%lu]", (uint64_t)key, bucketCount);
+    return NULL;
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline indexlib::util::Status
+SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::Find(const _KT& key, const _VT*& value) const
+{
+    auto bucket = InternalFindBucket(key);
+    // tag of a bucket being inserted concurrently may be not visible yet
+    if (!bucket || bucket->IsEmpty() || !bucket->IsEqual(key)) {
+        return indexlib::util::NOT_FOUND;
+    }
+    value = &bucket->Value();
+    return bucket->IsDeleted() ? indexlib::util::DELETED : indexlib::util::OK;
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline indexlib::util::Status
+SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::FindForReadWrite(const _KT& key, _VT& value) const
+{
+    auto bucket = InternalFindBucket(key);
+    if (!bucket || bucket->IsEmpty() || !bucket->IsEqual(key)) {
+        return indexlib::util::NOT_FOUND;
+    }
+    auto [isDeleted, tmpValue] = bucket->DeletedOrValue();
+    value = tmpValue;
+    if (isDeleted) {
+        return indexlib::util::DELETED;
+    }
+    return indexlib::util::OK;
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::Insert(const _KT& key, const _VT& value)
+{
+    struct InsertFunctor {
+        void operator()(Bucket& bucket, const _KT& key, const _VT& value, uint64_t& deleteCount)
+        {
+            if (bucket.IsDeleted()) {
+                deleteCount--;
+            }
+            bucket.Set(key, value);
+        }
+    };
+    return InternalInsert<InsertFunctor>(key, value);
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::Insert(uint64_t key,
+                                                                                  const autil::StringView& value)
+{
+    const _VT& v = *reinterpret_cast<const _VT*>(value.data());
+    assert(sizeof(_VT) == value.size());
+    return Insert((_KT)key, v);
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::Delete(uint64_t key,
+                                                                                  const autil::StringView& value)
+{
+    struct DeleteFunctor {
+        void operator()(Bucket& bucket, const _KT& key, const _VT& value, uint64_t& deleteCount)
+        {
+            if (!bucket.IsDeleted()) {
+                deleteCount++;
+            }
+            bucket.SetDelete(key, value);
+        }
+    };
+
+    if (value.empty()) {
+        return InternalInsert<DeleteFunctor>(key, _VT());
+    }
+    const _VT& v = *reinterpret_cast<const _VT*>(value.data());
+    assert(sizeof(_VT) == value.size());
+    return InternalInsert<DeleteFunctor>(key, v);
+}
+
+template <typename _KT, typename _VT, bool HasSpecialKey, bool useCompactBucket>
+template <typename functor>
+inline bool SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>::InternalInsert(const _KT& key,
+                                                                                          const _VT& value)
+{
+    Bucket* bucket = InternalFindBucket(key);
+    if (unlikely(!bucket)) {
+        return false;
+    }
+    bool isNewKey = bucket->IsEmpty();
+    functor()(*bucket, key, value, Base::_deleteCount); // insert or delete
+    if (isNewKey) {
+        SetControl(bucket - _bucket, Tag(key));
+        ++(Base::Header()->keyCount);
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename _KT, typename _VT, bool HasSpecialKey = ClosedHashTableTraits<_KT, _VT, false>::HasSpecialKey,
+          bool useCompactBucket = false>
+class SwissHashTable final : public SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket>
+{
+public:
+    typedef SwissHashTableBase<_KT, _VT, HasSpecialKey, useCompactBucket> Base;
+    using Base::Find;
+    using Base::FindForReadWrite;
+    using Base::Insert;
+    using Base::OCCUPANCY_PCT;
+
+public:
+    indexlib::util::Status Find(uint64_t key, autil::StringView& value) const override final
+    {
+        const _VT* typedValuePtr = NULL;
+        auto status = Base::Find((_KT)key, typedValuePtr);
+        value = {(char*)typedValuePtr, sizeof(_VT)};
+        return status;
+    }
+
+    indexlib::util::Status FindForReadWrite(uint64_t key, autil::StringView& value,
+                                            autil::mem_pool::Pool* pool) const override final
+    {
+        assert(pool);
+        _VT* valueBuffer = (_VT*)IE_POOL_NEW_VECTOR(pool, char, sizeof(_VT));
+        auto status = Base::FindForReadWrite((_KT)key, *valueBuffer);
+        value = {(char*)valueBuffer, sizeof(_VT)};
+        return status;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+// hide some methods, special buckets are kept as DenseHashTable does
+template <typename _KT, typename _VT, bool useCompactBucket>
+class SwissHashTable<_KT, _VT, true, useCompactBucket> final
+    : public SwissHashTableBase<_KT, _VT, false, useCompactBucket>
+{
+public:
+    typedef ClosedHashTableTraits<_KT, _VT, useCompactBucket> Traits;
+    typedef typename Traits::Bucket Bucket;
+    typedef typename Traits::SpecialBucket SpecialBucket;
+
+private:
+    typedef SwissHashTableBase<_KT, _VT, false, useCompactBucket> Base;
+    using Base::_bucket;
+    using Base::_bucketCount;
+    using Base::_logger;
+    using Base::OCCUPANCY_PCT;
+
+public:
+    typedef typename Base::HashTableHeader HashTableHeader;
+
+public:
+    indexlib::util::Status Find(uint64_t key, autil::StringView& value) const override final
+    {
+        const _VT* typedValuePtr = NULL;
+        auto status = Find((_KT)key, typedValuePtr);
+        value = {(char*)typedValuePtr, sizeof(_VT)};
+        return status;
+    }
+
+    indexlib::util::Status FindForReadWrite(uint64_t key, autil::StringView& value,
+                                            autil::mem_pool::Pool* pool) const override final
+    {
+        assert(pool);
+        _VT* valueBuffer = (_VT*)IE_POOL_NEW_VECTOR(pool, char, sizeof(_VT));
+        indexlib::util::Status status = indexlib::util::NOT_FOUND;
+        if (likely(!Bucket::IsEmptyKey((_KT)key) && !Bucket::IsDeleteKey((_KT)key))) {
+            status = Base::FindForReadWrite((_KT)key, *valueBuffer);
+        } else {
+            SpecialBucket* bucket = Bucket::IsEmptyKey((_KT)key) ? EmptyBucket() : DeleteBucket();
+            if (!bucket->IsEmpty()) {
+                *valueBuffer = bucket->Value();
+                status = bucket->IsDeleted() ? indexlib::util::DELETED : indexlib::util::OK;
+            }
+        }
+        value = {(char*)valueBuffer, sizeof(_VT)};
+        return status;
+    }
+
+    bool Insert(uint64_t key, const autil::StringView& value) override final
+    {
+        const _VT& v = *reinterpret_cast<const _VT*>(value.data());
+        assert(sizeof(_VT) == value.size());
+        return Insert(key, v);
+    }
+
+    bool Insert(const _KT& key, const _VT& value)
+    {
+        struct InsertFunctor {
+            void operator()(Bucket& bucket, const _KT& key, const _VT& value, uint64_t& deleteCount)
+            {
+                if (bucket.IsDeleted()) {
+                    deleteCount--;
+                }
+                bucket.Set(key, value);
+            }
+            void operator()(SpecialBucket& bucket, const _KT& key, const _VT& value, uint64_t& deleteCount)
+            {
+                if (bucket.IsDeleted()) {
+                    deleteCount--;
+                }
+                bucket.Set(key, value);
+            }
+        };
+        return InternalInsert<InsertFunctor>(key, value);
+    }
+
+    bool Delete(uint64_t key, const autil::StringView& value = autil::StringView()) override final
+    {
+        struct DeleteFunctor {
+            void operator()(Bucket& bucket, const _KT& key, const _VT& value, uint64_t& deleteCount)
+            {
+                if (!bucket.IsDeleted()) {
+                    deleteCount++;
+                }
+                bucket.SetDelete(key, value);
+            }
+            void operator()(SpecialBucket& bucket, const _KT& key, const _VT& value, uint64_t& deleteCount)
+            {
+                if (!bucket.IsDeleted()) {
+                    deleteCount++;
+                }
+                bucket.SetDelete(key, value);
+            }
+        };
+
+        if (value.empty()) {
+            return InternalInsert<DeleteFunctor>(key, _VT());
+        }
+        const _VT& v = *reinterpret_cast<const _VT*>(value.data());
+        assert(sizeof(_VT) == value.size());
+        return InternalInsert<DeleteFunctor>(key, v);
+    }
+
+    uint64_t MemoryUse() const override final { return Base::MemoryUse() + sizeof(SpecialBucket) * 2; }
+
+    bool Shrink(int32_t occupancyPct = 0) override final
+    {
+        SpecialBucket emptyBucket = *EmptyBucket();
+        SpecialBucket deleteBucket = *DeleteBucket();
+        if (!Base::Shrink(occupancyPct)) {
+            return false;
+        }
+        *EmptyBucket() = emptyBucket;
+        *DeleteBucket() = deleteBucket;
+        return true;
+    }
+
+    bool MountForWrite(void* data, size_t size, const HashTableOptions& inputOptions = OCCUPANCY_PCT) override final
+    {
+        HashTableOptions options(OCCUPANCY_PCT);
+        if (inputOptions.Valid()) {
+            options = inputOptions;
+        }
+
+        size_t minSize = sizeof(HashTableHeader) + sizeof(SpecialBucket) * 2;
+        if (size < minSize) {
+            AUTIL_LOG(ERROR, "not enough space, min size[%lu], give[%lu]", minSize, size);
+            return false;
+        }
+        // special buckets follow buckets, control bytes follow special buckets
+        if (!Base::MountWithControl(data, size, sizeof(SpecialBucket) * 2, options)) {
+            return false;
+        }
+        new (EmptyBucket()) SpecialBucket();
+        new (DeleteBucket()) SpecialBucket();
+
+        return true;
+    }
+
+    bool MountForRead(const void* data, size_t size) override
+    {
+        if (size < sizeof(SpecialBucket) * 2) {
+            AUTIL_LOG(ERROR, "too small size[%lu], BucketSize[%lu]", size, sizeof(SpecialBucket));
+            return false;
+        }
+        return Base::MountForRead(data, size - sizeof(SpecialBucket) * 2);
+    }
+
+public:
+    uint64_t CapacityToTableMemory(uint64_t maxKeyCount, const HashTableOptions& options) const override
+    {
+        return DoCapacityToTableMemory(maxKeyCount, options);
+    }
+
+    uint64_t CapacityToBuildMemory(uint64_t maxKeyCount, const HashTableOptions& options) const override
+    {
+        return DoCapacityToBuildMemory(maxKeyCount, options);
+    }
+
+    size_t TableMemroyToCapacity(size_t tableMemory, int32_t occupancyPct) const override
+    {
+        return DoTableMemroyToCapacity(tableMemory, occupancyPct);
+    }
+
+    size_t BuildMemoryToCapacity(size_t buildMemory, int32_t occupancyPct) const override
+    {
+        return DoBuildMemoryToCapacity(buildMemory, occupancyPct);
+    }
+
+public:
+    static uint64_t DoCapacityToTableMemory(uint64_t maxKeyCount, const HashTableOptions& options)
+    {
+        return Base::DoCapacityToTableMemory(maxKeyCount, options) + sizeof(SpecialBucket) * 2;
+    }
+    static uint64_t DoCapacityToBuildMemory(uint64_t maxKeyCount, const HashTableOptions& options)
+    {
+        return Base::DoCapacityToBuildMemory(maxKeyCount, options) + sizeof(SpecialBucket) * 2;
+    }
+    static size_t DoBuildMemoryToCapacity(size_t buildMemory, int32_t occupancyPct)
+    {
+        if (buildMemory < sizeof(SpecialBucket) * 2) {
+            return 0;
+        }
+        return Base::DoBuildMemoryToCapacity(buildMemory - sizeof(SpecialBucket) * 2, occupancyPct);
+    }
+    static size_t DoTableMemroyToCapacity(size_t tableMemory, int32_t occupancyPct)
+    {
+        if (tableMemory < sizeof(SpecialBucket) * 2) {
+            return 0;
+        }
+        return Base::DoTableMemroyToCapacity(tableMemory - sizeof(SpecialBucket) * 2, occupancyPct);
+    }
+
+public:
+    indexlib::util::Status Find(const _KT& key, const _VT*& value) const
+    {
+        if (likely(!Bucket::IsEmptyKey(key) && !Bucket::IsDeleteKey(key))) {
+            return Base::Find(key, value);
+        }
+
+        SpecialBucket* bucket = Bucket::IsEmptyKey(key) ? EmptyBucket() : DeleteBucket();
+        if (bucket->IsEmpty()) {
+            return indexlib::util::NOT_FOUND;
+        }
+        value = &(bucket->Value());
+        return bucket->IsDeleted() ? indexlib::util::DELETED : indexlib::util::OK;
+    }
+
+private:
+    SpecialBucket* EmptyBucket() const { return reinterpret_cast<SpecialBucket*>(&_bucket[_bucketCount]); }
+
+    SpecialBucket* DeleteBucket() const { return reinterpret_cast<SpecialBucket*>(&_bucket[_bucketCount]) + 1; }
+
+    template <typename functor>
+    bool InternalInsert(const _KT& key, const _VT& value)
+    {
+        if (unlikely(Bucket::IsEmptyKey(key))) {
+            SpecialBucket* bucket = EmptyBucket();
+            bool isNewKey = bucket->IsEmpty();
+            functor()(*bucket, key, value, Base::_deleteCount);
+            if (isNewKey) {
+                ++(Base::Header()->keyCount);
+            }
+            return true;
+        } else if (unlikely(Bucket::IsDeleteKey(key))) {
+            SpecialBucket* bucket = DeleteBucket();
+            bool isNewKey = bucket->IsEmpty();
+            functor()(*bucket, key, value, Base::_deleteCount);
+            if (isNewKey) {
+                ++(Base::Header()->keyCount);
+            }
+            return true;
+        }
+        return Base::template InternalInsert<functor>(key, value);
+    }
+
+private:
+    friend class SwissHashTableTest;
+};
+} // namespace indexlibv2::index
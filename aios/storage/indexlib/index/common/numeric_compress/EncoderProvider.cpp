@@ -19,6 +19,7 @@
 #include "indexlib/index/common/numeric_compress/NewPfordeltaIntEncoder.h"
 #include "indexlib/index/common/numeric_compress/NoCompressIntEncoder.h"
 #include "indexlib/index/common/numeric_compress/ReferenceCompressIntEncoder.h"
+#include "indexlib/index/common/numeric_compress/StreamVbyteInt32Encoder.h"
 #include "indexlib/index/common/numeric_compress/VbyteInt32Encoder.h"
 
 namespace indexlib::index {
@@ -46,6 +47,7 @@ void EncoderProvider::Init()
 
     _int32NoCompressNoLengthEncoder.reset(new NoCompressInt32Encoder(false));
     _int32VByteEncoder.reset(new VbyteInt32Encoder());
+    _int32StreamVByteEncoder.reset(new StreamVbyteInt32Encoder());
     _int32ReferenceCompressEncoder.reset(new ReferenceCompressInt32Encoder());
 }
 } // namespace indexlib::index
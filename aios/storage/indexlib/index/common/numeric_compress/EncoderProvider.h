@@ -28,15 +28,18 @@ public:
     struct EncoderParam {
     public:
         explicit EncoderParam(uint8_t _mode = PFOR_DELTA_COMPRESS_MODE, bool _shortListVbyteCompress = false,
-                              bool _enableP4DeltaBlockOpt = false)
+                              bool _enableP4DeltaBlockOpt = false, bool _docListStreamVbyteCompress = false)
             : mode(_mode)
             , shortListVbyteCompress(_shortListVbyteCompress)
             , enableP4DeltaBlockOpt(_enableP4DeltaBlockOpt)
+            , docListStreamVbyteCompress(_docListStreamVbyteCompress)
         {
         }
         uint8_t mode = PFOR_DELTA_COMPRESS_MODE;
         bool shortListVbyteCompress = false;
         bool enableP4DeltaBlockOpt = false;
+        // only affects doc list of PFOR_DELTA_COMPRESS_MODE
+        bool docListStreamVbyteCompress = false;
     };
 
 public:
@@ -111,6 +114,7 @@ protected:
     std::shared_ptr<Int32Encoder> _int32ReferenceCompressEncoder;
 
     std::shared_ptr<Int32Encoder> _int32VByteEncoder;
+    std::shared_ptr<Int32Encoder> _int32StreamVByteEncoder;
     bool _disableSseOptimize;
 
 private:
@@ -126,6 +130,9 @@ private:
 inline const Int32Encoder* EncoderProvider::GetDocListEncoder(const EncoderParam& param) const
 {
     if (param.mode == PFOR_DELTA_COMPRESS_MODE) {
+        if (param.docListStreamVbyteCompress) {
+            return _int32StreamVByteEncoder.get();
+        }
         return GetInt32PForDeltaEncoder(param.enableP4DeltaBlockOpt);
     } else if (param.mode == SHORT_LIST_COMPRESS_MODE) {
         return param.shortListVbyteCompress ? _int32VByteEncoder.get() : _int32NoCompressEncoder.get();
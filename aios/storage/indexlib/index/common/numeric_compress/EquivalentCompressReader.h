@@ -250,6 +250,9 @@ public:
 
     inline std::pair<Status, T> Get(size_t pos) const __ALWAYS_INLINE { return (*this)[pos]; }
 
+    // positions should be non-decreasing, slot item and delta array are decoded once for positions in the same slot
+    inline Status BatchGet(const docid_t* positions, size_t count, T* values) const;
+
     bool Update(size_t pos, T value);
 
     Iterator CreateIterator() const
@@ -297,6 +300,14 @@ private:
 
     inline std::pair<Status, T> ReadLongValueType(size_t pos) const __ALWAYS_INLINE;
 
+    template <typename DeltaGetter>
+    static void FillSlotValues(UT baseValue, uint32_t slotMask, const docid_t* positions, size_t count,
+                               DeltaGetter&& getDelta, T* values) __ALWAYS_INLINE;
+    inline void DecodeSlotValues(SlotItemType slotType, uint8_t* deltaArray, UT baseValue, const docid_t* positions,
+                                 size_t count, T* values) const;
+    inline void DecodeLongSlotValues(uint64_t deltaType, uint8_t* deltaArray, UT baseValue, const docid_t* positions,
+                                     size_t count, T* values) const;
+
     bool ExpandUpdateDeltaArray(uint8_t* slotItem, uint8_t* slotData, size_t pos, UT updateEncodeValue);
 
     inline std::pair<Status, UT> ReadDeltaValueBySlotItem(SlotItemType slotType, size_t valueOffset,
@@ -333,6 +344,13 @@ private:
         return std::make_pair(Status::OK(), type());                                                                   \
     }                                                                                                                  \
     template <>                                                                                                        \
+    inline Status EquivalentCompressReader<type>::BatchGet(const docid_t* positions, size_t count, type* values)       \
+        const                                                                                                          \
+    {                                                                                                                  \
+        assert(false);                                                                                                 \
+        return Status::Unimplement();                                                                                  \
+    }                                                                                                                  \
+    template <>                                                                                                        \
     inline bool EquivalentCompressReader<type>::Update(size_t pos, type value)                                         \
     {                                                                                                                  \
         assert(false);                                                                                                 \
@@ -391,6 +409,131 @@ inline std::pair<Status, T> EquivalentCompressReader<T>::operator[](size_t pos)
     return std::make_pair(Status::OK(), ZigZagEncoder::Decode(arrayHeader.baseValue + deltaValue));
 }
 
+template <typename T>
+inline Status EquivalentCompressReader<T>::BatchGet(const docid_t* positions, size_t count, T* values) const
+{
+    constexpr bool isLongValueType = std::is_same<T, uint64_t>::value || std::is_same<T, int64_t>::value ||
+                                     std::is_same<T, double>::value;
+    size_t begin = 0;
+    while (begin < count) {
+        assert(positions[begin] >= 0 && (size_t)positions[begin] < _itemCount);
+        size_t slotIdx = (size_t)positions[begin] >> _slotBitNum;
+        size_t end = begin + 1;
+        while (end < count && ((size_t)positions[end] >> _slotBitNum) == slotIdx) {
+            ++end;
+        }
+        if (!_valueBaseAddr) {
+            for (size_t i = begin; i < end; ++i) {
+                auto [status, value] = Get(positions[i]);
+                RETURN_IF_STATUS_ERROR(status, "get value of pos [%d] failed", positions[i]);
+                values[i] = value;
+            }
+            begin = end;
+            continue;
+        }
+        if constexpr (isLongValueType) {
+            auto [status, slotItem] = GetLongSlotItem(_fileStream, slotIdx);
+            RETURN_IF_STATUS_ERROR(status, "get long slot item fail");
+            if (slotItem.isValue == 1) {
+                std::fill(values + begin, values + end, ZigZagEncoder::Decode(slotItem.value));
+            } else {
+                uint8_t* valueItemsAddr = GetDeltaBlockAddress(slotItem.value);
+                LongValueArrayHeader* valueArray = (LongValueArrayHeader*)valueItemsAddr;
+                DecodeLongSlotValues(valueArray->deltaType, valueItemsAddr + sizeof(LongValueArrayHeader),
+                                     valueArray->baseValue, positions + begin, end - begin, values + begin);
+            }
+        } else {
+            auto [status, slotItem] = GetSlotItem(_fileStream, slotIdx);
+            RETURN_IF_STATUS_ERROR(status, "get slot item fail");
+            if (slotItem.slotType == SIT_EQUAL) {
+                std::fill(values + begin, values + end, ZigZagEncoder::Decode((UT)(slotItem.value)));
+            } else {
+                DeltaValueArray* valueArray = (DeltaValueArray*)GetDeltaBlockAddress(slotItem.value);
+                DecodeSlotValues((SlotItemType)slotItem.slotType, valueArray->delta, valueArray->baseValue,
+                                 positions + begin, end - begin, values + begin);
+            }
+        }
+        begin = end;
+    }
+    return Status::OK();
+}
+
+template <typename T>
+template <typename DeltaGetter>
+inline void EquivalentCompressReader<T>::FillSlotValues(UT baseValue, uint32_t slotMask, const docid_t* positions,
+                                                        size_t count, DeltaGetter&& getDelta, T* values)
+{
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = ZigZagEncoder::Decode(baseValue + (UT)getDelta(positions[i] & slotMask));
+    }
+}
+
+template <typename T>
+inline void EquivalentCompressReader<T>::DecodeSlotValues(SlotItemType slotType, uint8_t* deltaArray, UT baseValue,
+                                                          const docid_t* positions, size_t count, T* values) const
+{
+    // switch on delta type once for the whole slot, so that the decode loop is branch free
+    switch (slotType) {
+    case SIT_DELTA_UINT8:
+        FillSlotValues(baseValue, _slotMask, positions, count, [deltaArray](size_t idx) { return deltaArray[idx]; },
+                       values);
+        break;
+    case SIT_DELTA_UINT16:
+        FillSlotValues(
+            baseValue, _slotMask, positions, count,
+            [deltaArray](size_t idx) { return ((uint16_t*)deltaArray)[idx]; }, values);
+        break;
+    case SIT_DELTA_UINT32:
+        FillSlotValues(
+            baseValue, _slotMask, positions, count,
+            [deltaArray](size_t idx) { return ((uint32_t*)deltaArray)[idx]; }, values);
+        break;
+    case SIT_DELTA_UINT64:
+        FillSlotValues(
+            baseValue, _slotMask, positions, count,
+            [deltaArray](size_t idx) { return ((uint64_t*)deltaArray)[idx]; }, values);
+        break;
+    case SIT_DELTA_BIT1:
+        FillSlotValues(
+            baseValue, _slotMask, positions, count,
+            [deltaArray](size_t idx) {
+                return EquivalentCompressFileFormat::DecodeBitValue(7, 3, 0, 1, idx, deltaArray);
+            },
+            values);
+        break;
+    case SIT_DELTA_BIT2:
+        FillSlotValues(
+            baseValue, _slotMask, positions, count,
+            [deltaArray](size_t idx) {
+                return EquivalentCompressFileFormat::DecodeBitValue(3, 2, 1, 3, idx, deltaArray);
+            },
+            values);
+        break;
+    case SIT_DELTA_BIT4:
+        FillSlotValues(
+            baseValue, _slotMask, positions, count,
+            [deltaArray](size_t idx) {
+                return EquivalentCompressFileFormat::DecodeBitValue(1, 1, 2, 15, idx, deltaArray);
+            },
+            values);
+        break;
+    default:
+        assert(false);
+    }
+}
+
+template <typename T>
+inline void EquivalentCompressReader<T>::DecodeLongSlotValues(uint64_t deltaType, uint8_t* deltaArray, UT baseValue,
+                                                              const docid_t* positions, size_t count, T* values) const
+{
+    // same delta type order as EquivalentCompressFileFormat::GetDeltaValueByDeltaType
+    static const SlotItemType DELTA_TYPE_TO_SLOT_TYPE[] = {SIT_DELTA_UINT8,  SIT_DELTA_UINT16, SIT_DELTA_UINT32,
+                                                           SIT_DELTA_UINT64, SIT_DELTA_BIT1,   SIT_DELTA_BIT2,
+                                                           SIT_DELTA_BIT4};
+    assert(deltaType < sizeof(DELTA_TYPE_TO_SLOT_TYPE) / sizeof(DELTA_TYPE_TO_SLOT_TYPE[0]));
+    DecodeSlotValues(DELTA_TYPE_TO_SLOT_TYPE[deltaType], deltaArray, baseValue, positions, count, values);
+}
+
 template <typename T>
 inline std::pair<Status, T> EquivalentCompressReader<T>::ReadLongValueType(size_t pos) const
 {
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/common/numeric_compress/StreamVbyteInt32Encoder.h"
+
+#include <immintrin.h>
+#include <string.h>
+
+namespace indexlib::index {
+namespace {
+
+struct StreamVbyteTable {
+    StreamVbyteTable()
+    {
+        for (uint32_t ctrl = 0; ctrl < 256; ++ctrl) {
+            uint8_t offset = 0;
+            for (uint32_t i = 0; i < 4; ++i) {
+                uint8_t len = ((ctrl >> (i * 2)) & 0x3) + 1;
+                for (uint8_t j = 0; j < 4; ++j) {
+                    shuffle[ctrl][i * 4 + j] = j < len ? offset + j : 0xFF;
+                }
+                offset += len;
+            }
+            length[ctrl] = offset;
+        }
+    }
+    alignas(16) uint8_t shuffle[256][16];
+    uint8_t length[256];
+};
+
+const StreamVbyteTable TABLE;
+
+// decode full groups of 4 values while a 16 bytes load from data stays inside [data, end)
+typedef uint32_t (*DecodeGroupsFunc)(uint32_t* dest, const uint8_t* ctrl, uint32_t groupCount, const uint8_t*& data,
+                                     const uint8_t* end);
+
+// reads exactly the data bytes of each value, never past end, so all groups are decoded
+uint32_t DecodeGroupsScalar(uint32_t* dest, const uint8_t* ctrl, uint32_t groupCount, const uint8_t*& data,
+                            const uint8_t* end)
+{
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            uint32_t len = ((ctrl[i] >> (j * 2)) & 0x3) + 1;
+            uint32_t value = 0;
+            // little endian, low bytes first
+            memcpy(&value, data, len);
+            dest[i * 4 + j] = value;
+            data += len;
+        }
+    }
+    return groupCount;
+}
+
+__attribute__((target("ssse3"))) uint32_t DecodeGroupsSse(uint32_t* dest, const uint8_t* ctrl, uint32_t groupCount,
+                                                          const uint8_t*& data, const uint8_t* end)
+{
+    uint32_t i = 0;
+    for (; i < groupCount && data + 16 <= end; ++i) {
+        __m128i value = _mm_loadu_si128((const __m128i*)data);
+        __m128i mask = _mm_load_si128((const __m128i*)TABLE.shuffle[ctrl[i]]);
+        _mm_storeu_si128((__m128i*)(dest + i * 4), _mm_shuffle_epi8(value, mask));
+        data += TABLE.length[ctrl[i]];
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) uint32_t DecodeGroupsAvx2(uint32_t* dest, const uint8_t* ctrl, uint32_t groupCount,
+                                                          const uint8_t*& data, const uint8_t* end)
+{
+    uint32_t i = 0;
+    // _mm256_shuffle_epi8 shuffles inside each 128 bits lane, so two groups are expanded per step
+    for (; i + 1 < groupCount; i += 2) {
+        uint8_t len = TABLE.length[ctrl[i]];
+        if (data + len + 16 > end) {
+            break;
+        }
+        __m256i value = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)data)),
+                                                _mm_loadu_si128((const __m128i*)(data + len)), 1);
+        __m256i mask =
+            _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_load_si128((const __m128i*)TABLE.shuffle[ctrl[i]])),
+                                    _mm_load_si128((const __m128i*)TABLE.shuffle[ctrl[i + 1]]), 1);
+        _mm256_storeu_si256((__m256i*)(dest + i * 4), _mm256_shuffle_epi8(value, mask));
+        data += len + TABLE.length[ctrl[i + 1]];
+    }
+    return i + DecodeGroupsSse(dest + i * 4, ctrl + i, groupCount - i, data, end);
+}
+
+DecodeGroupsFunc ChooseDecodeGroupsFunc()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return DecodeGroupsAvx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return DecodeGroupsSse;
+    }
+    return DecodeGroupsScalar;
+}
+
+const DecodeGroupsFunc DECODE_GROUPS = ChooseDecodeGroupsFunc();
+
+} // namespace
+
+AUTIL_LOG_SETUP(indexlib.index, StreamVbyteInt32Encoder);
+
+StreamVbyteInt32Encoder::StreamVbyteInt32Encoder() {}
+
+StreamVbyteInt32Encoder::~StreamVbyteInt32Encoder() {}
+
+std::pair<Status, uint32_t> StreamVbyteInt32Encoder::Encode(file_system::ByteSliceWriter& sliceWriter,
+                                                            const uint32_t* src, uint32_t srcLen) const
+{
+    // same head as GroupVint32Encoder: encode len using int16_t, src len omitted for full record
+    if (srcLen > MAX_RECORD_SIZE) {
+        RETURN2_IF_STATUS_ERROR(Status::InvalidArgs(), 0, "src len [%u] exceed max record size", srcLen);
+    }
+    uint8_t buffer[ENCODER_BUFFER_SIZE];
+    uint32_t encodeLen = Compress(buffer, src, srcLen);
+
+    uint32_t headLen = sizeof(int16_t);
+    if (srcLen != MAX_RECORD_SIZE) {
+        sliceWriter.WriteInt16((int16_t)encodeLen | SRC_LEN_FLAG);
+        sliceWriter.WriteByte((uint8_t)srcLen);
+        headLen = sizeof(int16_t) + sizeof(uint8_t);
+    } else {
+        sliceWriter.WriteInt16((int16_t)encodeLen);
+    }
+    sliceWriter.Write(buffer, encodeLen);
+    return std::make_pair(Status::OK(), encodeLen + headLen);
+}
+
+std::pair<Status, uint32_t> StreamVbyteInt32Encoder::Encode(uint8_t* dest, const uint32_t* src, uint32_t srcLen) const
+{
+    return std::make_pair(Status::OK(), Compress(dest, src, srcLen));
+}
+
+std::pair<Status, uint32_t> StreamVbyteInt32Encoder::Decode(uint32_t* dest, uint32_t destLen,
+                                                            file_system::ByteSliceReader& sliceReader) const
+{
+    uint32_t compLen = (uint32_t)sliceReader.ReadInt16();
+    uint32_t srcLen = MAX_RECORD_SIZE;
+    if (compLen & SRC_LEN_FLAG) {
+        srcLen = (uint32_t)sliceReader.ReadByte();
+        compLen &= ~SRC_LEN_FLAG;
+    }
+    if (srcLen > destLen || compLen > ENCODER_BUFFER_SIZE) {
+        RETURN2_IF_STATUS_ERROR(Status::Corruption(), 0, "StreamVbyte Decode FAILED, srcLen [%u], compLen [%u]",
+                                srcLen, compLen);
+    }
+
+    uint8_t buffer[ENCODER_BUFFER_SIZE];
+    void* bufPtr = buffer;
+    size_t len = sliceReader.ReadMayCopy(bufPtr, compLen);
+    if (len != compLen) {
+        RETURN2_IF_STATUS_ERROR(Status::Corruption(), 0, "StreamVbyte Decode FAILED.");
+    }
+    if (!Decompress(dest, (const uint8_t*)bufPtr, srcLen, compLen)) {
+        RETURN2_IF_STATUS_ERROR(Status::Corruption(), 0, "StreamVbyte Decode FAILED, data len mismatch.");
+    }
+    return std::make_pair(Status::OK(), srcLen);
+}
+
+uint32_t StreamVbyteInt32Encoder::Compress(uint8_t* dest, const uint32_t* src, uint32_t srcLen)
+{
+    uint32_t ctrlLen = (srcLen + 3) / 4;
+    uint8_t* ctrl = dest;
+    uint8_t* data = dest + ctrlLen;
+    memset(ctrl, 0, ctrlLen);
+    for (uint32_t i = 0; i < srcLen; ++i) {
+        uint32_t value = src[i];
+        uint8_t code = value < (1U << 8) ? 0 : value < (1U << 16) ? 1 : value < (1U << 24) ? 2 : 3;
+        ctrl[i >> 2] |= code << ((i & 3) * 2);
+        // little endian, low bytes first
+        memcpy(data, &value, code + 1);
+        data += code + 1;
+    }
+    return data - dest;
+}
+
+bool StreamVbyteInt32Encoder::Decompress(uint32_t* dest, const uint8_t* src, uint32_t srcLen, uint32_t compLen)
+{
+    uint32_t ctrlLen = (srcLen + 3) / 4;
+    if (compLen < ctrlLen) {
+        return false;
+    }
+    const uint8_t* ctrl = src;
+    const uint8_t* data = src + ctrlLen;
+    const uint8_t* end = src + compLen;
+    uint32_t groupCount = srcLen / 4;
+
+    // check data length from control bytes first, so that kernels never read past the record
+    uint32_t dataLen = 0;
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        dataLen += TABLE.length[ctrl[i]];
+    }
+    for (uint32_t i = groupCount * 4; i < srcLen; ++i) {
+        dataLen += ((ctrl[i >> 2] >> ((i & 3) * 2)) & 0x3) + 1;
+    }
+    if (dataLen != compLen - ctrlLen) {
+        return false;
+    }
+
+    uint32_t i = DECODE_GROUPS(dest, ctrl, groupCount, data, end) * 4;
+    for (; i < srcLen; ++i) {
+        uint32_t len = ((ctrl[i >> 2] >> ((i & 3) * 2)) & 0x3) + 1;
+        uint32_t value = 0;
+        memcpy(&value, data, len);
+        dest[i] = value;
+        data += len;
+    }
+    return true;
+}
+
+} // namespace indexlib::index
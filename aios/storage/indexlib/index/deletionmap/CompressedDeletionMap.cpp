@@ -0,0 +1,259 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/deletionmap/CompressedDeletionMap.h"
+
+#include <iterator>
+
+#include "indexlib/util/Bitmap.h"
+
+namespace indexlibv2::index {
+AUTIL_LOG_SETUP(indexlib.index, CompressedDeletionMap);
+
+CompressedDeletionMap::CompressedDeletionMap(uint32_t docCount) : _docCount(docCount), _deletedDocCount(0)
+{
+    _containers.resize((docCount + CHUNK_DOC_COUNT - 1) / CHUNK_DOC_COUNT);
+}
+
+CompressedDeletionMap::~CompressedDeletionMap() {}
+
+std::unique_ptr<CompressedDeletionMap> CompressedDeletionMap::Create(const indexlib::util::Bitmap& bitmap)
+{
+    auto deletionMap = std::make_unique<CompressedDeletionMap>(bitmap.GetValidItemCount());
+    deletionMap->_containers.clear();
+    std::vector<uint16_t> deletedDocs;
+    uint32_t chunkBegin = 0;
+    uint32_t docid = bitmap.Begin();
+    while (chunkBegin < deletionMap->_docCount) {
+        uint32_t chunkEnd = chunkBegin + CHUNK_DOC_COUNT;
+        deletedDocs.clear();
+        while (docid != indexlib::util::Bitmap::INVALID_INDEX && docid < chunkEnd) {
+            if (docid < deletionMap->_docCount) {
+                deletedDocs.push_back((uint16_t)(docid - chunkBegin));
+            }
+            docid = bitmap.Next(docid);
+        }
+        deletionMap->AppendChunk(deletedDocs);
+        chunkBegin = chunkEnd;
+    }
+    deletionMap->_arrays.shrink_to_fit();
+    deletionMap->_bitmaps.shrink_to_fit();
+    deletionMap->_runs.shrink_to_fit();
+    return deletionMap;
+}
+
+void CompressedDeletionMap::AppendChunk(const std::vector<uint16_t>& deletedDocs)
+{
+    Container container;
+    _deletedDocCount += deletedDocs.size();
+    if (deletedDocs.empty()) {
+        _containers.push_back(container);
+        return;
+    }
+    size_t runCount = 1;
+    for (size_t i = 1; i < deletedDocs.size(); ++i) {
+        if (deletedDocs[i] != deletedDocs[i - 1] + 1) {
+            ++runCount;
+        }
+    }
+    size_t arraySize = deletedDocs.size() * sizeof(uint16_t);
+    size_t runSize = runCount * sizeof(Run);
+    size_t bitmapSize = CHUNK_BITMAP_WORDS * sizeof(uint64_t);
+    if (runSize <= arraySize && runSize <= bitmapSize) {
+        container.type = ContainerType::RUN;
+        container.count = runCount;
+        container.offset = _runs.size();
+        Run run = {deletedDocs[0], deletedDocs[0]};
+        for (size_t i = 1; i < deletedDocs.size(); ++i) {
+            if (deletedDocs[i] != run.last + 1) {
+                _runs.push_back(run);
+                run.first = deletedDocs[i];
+            }
+            run.last = deletedDocs[i];
+        }
+        _runs.push_back(run);
+    } else if (arraySize <= bitmapSize) {
+        container.type = ContainerType::ARRAY;
+        container.count = deletedDocs.size();
+        container.offset = _arrays.size();
+        _arrays.insert(_arrays.end(), deletedDocs.begin(), deletedDocs.end());
+    } else {
+        container.type = ContainerType::BITMAP;
+        container.count = deletedDocs.size();
+        container.offset = _bitmaps.size();
+        _bitmaps.resize(_bitmaps.size() + CHUNK_BITMAP_WORDS, 0);
+        uint64_t* words = _bitmaps.data() + container.offset;
+        for (uint16_t low : deletedDocs) {
+            words[low >> 6] |= (uint64_t)1 << (low & 63);
+        }
+    }
+    _containers.push_back(container);
+}
+
+void CompressedDeletionMap::DecodeChunk(size_t chunk, std::vector<uint16_t>& deletedDocs) const
+{
+    deletedDocs.clear();
+    const Container& container = _containers[chunk];
+    switch (container.type) {
+    case ContainerType::EMPTY:
+        break;
+    case ContainerType::ARRAY:
+        deletedDocs.assign(_arrays.begin() + container.offset, _arrays.begin() + container.offset + container.count);
+        break;
+    case ContainerType::BITMAP: {
+        const uint64_t* words = _bitmaps.data() + container.offset;
+        for (uint32_t i = 0; i < CHUNK_BITMAP_WORDS; ++i) {
+            uint64_t word = words[i];
+            while (word) {
+                deletedDocs.push_back((uint16_t)(i * 64 + __builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+        break;
+    }
+    case ContainerType::RUN: {
+        const Run* runs = _runs.data() + container.offset;
+        for (size_t i = 0; i < container.count; ++i) {
+            for (uint32_t low = runs[i].first; low <= runs[i].last; ++low) {
+                deletedDocs.push_back((uint16_t)low);
+            }
+        }
+        break;
+    }
+    }
+}
+
+std::unique_ptr<CompressedDeletionMap> CompressedDeletionMap::Patch(const indexlib::util::Bitmap& patch) const
+{
+    auto deletionMap = std::make_unique<CompressedDeletionMap>(_docCount);
+    deletionMap->_containers.clear();
+    std::vector<uint16_t> deletedDocs;
+    std::vector<uint16_t> patchDocs;
+    std::vector<uint16_t> mergedDocs;
+    uint32_t docid = patch.Begin();
+    for (size_t chunk = 0; chunk < _containers.size(); ++chunk) {
+        uint32_t chunkBegin = chunk << CHUNK_BITS;
+        uint32_t chunkEnd = chunkBegin + CHUNK_DOC_COUNT;
+        patchDocs.clear();
+        while (docid != indexlib::util::Bitmap::INVALID_INDEX && docid < chunkEnd) {
+            if (docid < _docCount) {
+                patchDocs.push_back((uint16_t)(docid - chunkBegin));
+            }
+            docid = patch.Next(docid);
+        }
+        if (patchDocs.empty()) {
+            deletionMap->CopyChunk(*this, chunk);
+            continue;
+        }
+        DecodeChunk(chunk, deletedDocs);
+        mergedDocs.clear();
+        std::set_union(deletedDocs.begin(), deletedDocs.end(), patchDocs.begin(), patchDocs.end(),
+                       std::back_inserter(mergedDocs));
+        deletionMap->AppendChunk(mergedDocs);
+    }
+    deletionMap->_arrays.shrink_to_fit();
+    deletionMap->_bitmaps.shrink_to_fit();
+    deletionMap->_runs.shrink_to_fit();
+    return deletionMap;
+}
+
+std::unique_ptr<CompressedDeletionMap> CompressedDeletionMap::Delete(docid_t docid) const
+{
+    assert((uint32_t)docid < _docCount);
+    auto deletionMap = std::make_unique<CompressedDeletionMap>(_docCount);
+    deletionMap->_containers.clear();
+    deletionMap->_arrays.reserve(_arrays.size() + 1);
+    deletionMap->_bitmaps.reserve(_bitmaps.size());
+    deletionMap->_runs.reserve(_runs.size() + 1);
+    size_t deletedChunk = (uint32_t)docid >> CHUNK_BITS;
+    std::vector<uint16_t> deletedDocs;
+    for (size_t chunk = 0; chunk < _containers.size(); ++chunk) {
+        if (chunk != deletedChunk) {
+            deletionMap->CopyChunk(*this, chunk);
+            continue;
+        }
+        DecodeChunk(chunk, deletedDocs);
+        uint16_t low = (uint16_t)docid;
+        auto iter = std::lower_bound(deletedDocs.begin(), deletedDocs.end(), low);
+        if (iter == deletedDocs.end() || *iter != low) {
+            deletedDocs.insert(iter, low);
+        }
+        deletionMap->AppendChunk(deletedDocs);
+    }
+    return deletionMap;
+}
+
+void CompressedDeletionMap::CopyChunk(const CompressedDeletionMap& other, size_t chunk)
+{
+    const Container& source = other._containers[chunk];
+    Container container = source;
+    switch (container.type) {
+    case ContainerType::EMPTY:
+        break;
+    case ContainerType::ARRAY:
+        _deletedDocCount += container.count;
+        container.offset = _arrays.size();
+        _arrays.insert(_arrays.end(), other._arrays.begin() + source.offset,
+                       other._arrays.begin() + source.offset + source.count);
+        break;
+    case ContainerType::BITMAP:
+        _deletedDocCount += container.count;
+        container.offset = _bitmaps.size();
+        _bitmaps.insert(_bitmaps.end(), other._bitmaps.begin() + source.offset,
+                        other._bitmaps.begin() + source.offset + CHUNK_BITMAP_WORDS);
+        break;
+    case ContainerType::RUN: {
+        container.offset = _runs.size();
+        const Run* runs = other._runs.data() + source.offset;
+        for (size_t i = 0; i < container.count; ++i) {
+            _deletedDocCount += runs[i].last - runs[i].first + 1;
+            _runs.push_back(runs[i]);
+        }
+        break;
+    }
+    }
+    _containers.push_back(container);
+}
+
+void CompressedDeletionMap::GetDeletedDocRanges(std::vector<std::pair<docid_t, docid_t>>& ranges) const
+{
+    ranges.clear();
+    ForEachDeletedRange([&ranges](docid_t begin, docid_t end) {
+        // merge ranges across chunk boundary
+        if (!ranges.empty() && ranges.back().second == begin) {
+            ranges.back().second = end;
+        } else {
+            ranges.emplace_back(begin, end);
+        }
+    });
+}
+
+void CompressedDeletionMap::Materialize(indexlib::util::Bitmap* bitmap) const
+{
+    assert(bitmap->GetItemCount() >= _docCount);
+    ForEachDeletedRange([bitmap](docid_t begin, docid_t end) {
+        for (docid_t docid = begin; docid < end; ++docid) {
+            bitmap->Set(docid);
+        }
+    });
+}
+
+size_t CompressedDeletionMap::EvaluateMemUsed() const
+{
+    return sizeof(*this) + _containers.capacity() * sizeof(Container) + _arrays.capacity() * sizeof(uint16_t) +
+           _bitmaps.capacity() * sizeof(uint64_t) + _runs.capacity() * sizeof(Run);
+}
+
+} // namespace indexlibv2::index
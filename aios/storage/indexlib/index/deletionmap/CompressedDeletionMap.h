@@ -0,0 +1,185 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "autil/Log.h"
+#include "autil/NoCopyable.h"
+#include "indexlib/base/Types.h"
+
+namespace indexlib::util {
+class Bitmap;
+}
+
+namespace indexlibv2::index {
+
+// Read only deletion map of a built segment, docs are split into chunks of 64K, deleted docs of each chunk are
+// kept in a sorted array, a bitmap or runs of deleted docs, whichever is smallest. Mostly empty segments cost a few
+// bytes per chunk instead of a full bitmap.
+class CompressedDeletionMap : private autil::NoCopyable
+{
+public:
+    explicit CompressedDeletionMap(uint32_t docCount);
+    ~CompressedDeletionMap();
+
+public:
+    static std::unique_ptr<CompressedDeletionMap> Create(const indexlib::util::Bitmap& bitmap);
+
+public:
+    bool IsDeleted(docid_t docid) const;
+    uint32_t GetDocCount() const { return _docCount; }
+    uint32_t GetDeletedDocCount() const { return _deletedDocCount; }
+    // new map with deleted docs of patch added, merged chunk by chunk
+    std::unique_ptr<CompressedDeletionMap> Patch(const indexlib::util::Bitmap& patch) const;
+    // new map with docid deleted, only the chunk of docid is re-encoded
+    std::unique_ptr<CompressedDeletionMap> Delete(docid_t docid) const;
+    // calls func(begin, end) for each [begin, end) of deleted docs in ascending order, ranges are not merged across
+    // chunk boundary
+    template <typename Func>
+    void ForEachDeletedRange(Func&& func) const;
+    // [begin, end) of deleted docs, ascending
+    void GetDeletedDocRanges(std::vector<std::pair<docid_t, docid_t>>& ranges) const;
+    // set deleted docs to bitmap, bitmap item count should not be less than doc count
+    void Materialize(indexlib::util::Bitmap* bitmap) const;
+    size_t EvaluateMemUsed() const;
+
+private:
+    enum class ContainerType : uint8_t {
+        EMPTY = 0,
+        ARRAY = 1,
+        BITMAP = 2,
+        RUN = 3,
+    };
+    struct Container {
+        ContainerType type = ContainerType::EMPTY;
+        // count of array items or runs
+        uint32_t count = 0;
+        // offset in _arrays, _bitmaps or _runs
+        uint32_t offset = 0;
+    };
+    struct Run {
+        uint16_t first;
+        uint16_t last;
+    };
+
+private:
+    void AppendChunk(const std::vector<uint16_t>& deletedDocs);
+    void DecodeChunk(size_t chunk, std::vector<uint16_t>& deletedDocs) const;
+    void CopyChunk(const CompressedDeletionMap& other, size_t chunk);
+
+private:
+    static constexpr uint32_t CHUNK_BITS = 16;
+    static constexpr uint32_t CHUNK_DOC_COUNT = 1 << CHUNK_BITS;
+    static constexpr uint32_t CHUNK_BITMAP_WORDS = CHUNK_DOC_COUNT / 64;
+
+    uint32_t _docCount;
+    uint32_t _deletedDocCount;
+    std::vector<Container> _containers;
+    std::vector<uint16_t> _arrays;
+    std::vector<uint64_t> _bitmaps;
+    std::vector<Run> _runs;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+inline bool CompressedDeletionMap::IsDeleted(docid_t docid) const
+{
+    assert((uint32_t)docid < _docCount);
+    const Container& container = _containers[(uint32_t)docid >> CHUNK_BITS];
+    uint16_t low = (uint16_t)docid;
+    switch (container.type) {
+    case ContainerType::EMPTY:
+        return false;
+    case ContainerType::ARRAY: {
+        const uint16_t* begin = _arrays.data() + container.offset;
+        const uint16_t* end = begin + container.count;
+        const uint16_t* iter = std::lower_bound(begin, end, low);
+        return iter != end && *iter == low;
+    }
+    case ContainerType::BITMAP:
+        return (_bitmaps[container.offset + (low >> 6)] >> (low & 63)) & 1;
+    case ContainerType::RUN: {
+        const Run* begin = _runs.data() + container.offset;
+        const Run* end = begin + container.count;
+        const Run* iter =
+            std::upper_bound(begin, end, low, [](uint16_t value, const Run& run) { return value < run.first; });
+        return iter != begin && (iter - 1)->last >= low;
+    }
+    }
+    return false;
+}
+
+template <typename Func>
+void CompressedDeletionMap::ForEachDeletedRange(Func&& func) const
+{
+    for (size_t chunk = 0; chunk < _containers.size(); ++chunk) {
+        const Container& container = _containers[chunk];
+        docid_t chunkBase = chunk << CHUNK_BITS;
+        switch (container.type) {
+        case ContainerType::EMPTY:
+            break;
+        case ContainerType::ARRAY: {
+            const uint16_t* values = _arrays.data() + container.offset;
+            size_t i = 0;
+            while (i < container.count) {
+                size_t j = i + 1;
+                while (j < container.count && values[j] == values[j - 1] + 1) {
+                    ++j;
+                }
+                func(chunkBase + values[i], chunkBase + values[j - 1] + 1);
+                i = j;
+            }
+            break;
+        }
+        case ContainerType::BITMAP: {
+            const uint64_t* words = _bitmaps.data() + container.offset;
+            int32_t rangeBegin = -1;
+            for (uint32_t low = 0; low < CHUNK_DOC_COUNT; ++low) {
+                uint64_t word = words[low >> 6];
+                if (word == 0 && (low & 63) == 0 && rangeBegin < 0) {
+                    low += 63;
+                    continue;
+                }
+                bool deleted = (word >> (low & 63)) & 1;
+                if (deleted && rangeBegin < 0) {
+                    rangeBegin = low;
+                } else if (!deleted && rangeBegin >= 0) {
+                    func(chunkBase + rangeBegin, chunkBase + low);
+                    rangeBegin = -1;
+                }
+            }
+            if (rangeBegin >= 0) {
+                func(chunkBase + rangeBegin, chunkBase + CHUNK_DOC_COUNT);
+            }
+            break;
+        }
+        case ContainerType::RUN: {
+            const Run* runs = _runs.data() + container.offset;
+            for (size_t i = 0; i < container.count; ++i) {
+                func(chunkBase + runs[i].first, chunkBase + runs[i].last + 1);
+            }
+            break;
+        }
+        }
+    }
+}
+
+} // namespace indexlibv2::index
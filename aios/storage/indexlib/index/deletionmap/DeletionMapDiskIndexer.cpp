@@ -15,11 +15,13 @@
  */
 #include "indexlib/index/deletionmap/DeletionMapDiskIndexer.h"
 
+#include "autil/EnvUtil.h"
 #include "autil/mem_pool/Pool.h"
 #include "indexlib/file_system/Directory.h"
 #include "indexlib/file_system/IDirectory.h"
 #include "indexlib/file_system/file/FileReader.h"
 #include "indexlib/file_system/file/FileWriter.h"
+#include "indexlib/framework/mem_reclaimer/IIndexMemoryReclaimer.h"
 #include "indexlib/index/deletionmap/Common.h"
 #include "indexlib/index/deletionmap/DeletionMapMetrics.h"
 #include "indexlib/index/deletionmap/DeletionMapUtil.h"
@@ -28,9 +30,16 @@ using std::string;
 
 namespace indexlibv2::index {
 AUTIL_LOG_SETUP(indexlib.index, DeletionMapDiskIndexer);
-DeletionMapDiskIndexer::DeletionMapDiskIndexer(size_t docCount, segmentid_t segmentId)
+DeletionMapDiskIndexer::DeletionMapDiskIndexer(size_t docCount, segmentid_t segmentId,
+                                               framework::IIndexMemoryReclaimer* indexMemoryReclaimer)
     : _docCount(docCount)
     , _segmentId(segmentId)
+    , _enableCompressedDeletionMap(autil::EnvUtil::getEnv("INDEXLIB_ENABLE_COMPRESSED_DELETION_MAP", false))
+    , _indexMemoryReclaimer(indexMemoryReclaimer)
+    , _compressedDeletionMap(nullptr)
+    , _compressedDeletedDocCount(0)
+    , _compressedMemUsed(0)
+    , _bitmapPtr(nullptr)
 {
 }
 DeletionMapDiskIndexer::~DeletionMapDiskIndexer()
@@ -40,7 +49,9 @@ DeletionMapDiskIndexer::~DeletionMapDiskIndexer()
         _metrics->Stop();
         _metrics.reset();
     }
+    _bitmapPtr.store(nullptr, std::memory_order_release);
     _bitmap.reset();
+    delete _compressedDeletionMap.exchange(nullptr, std::memory_order_acq_rel);
     _pool.reset();
     _allocator.reset();
 }
@@ -50,6 +61,7 @@ void DeletionMapDiskIndexer::TEST_InitWithoutOpen()
     _allocator.reset(new indexlib::util::MMapAllocator);
     _pool.reset(new autil::mem_pool::Pool(_allocator.get(), 1 * 1024 * 1024));
     _bitmap.reset(new indexlib::util::Bitmap(_docCount, false, _pool.get()));
+    _bitmapPtr.store(_bitmap.get(), std::memory_order_release);
 }
 
 Status DeletionMapDiskIndexer::Open(const std::shared_ptr<config::IIndexConfig>& indexConfig,
@@ -62,9 +74,21 @@ Status DeletionMapDiskIndexer::Open(const std::shared_ptr<config::IIndexConfig>&
     _directory = indexDirectory;
     _allocator.reset(new indexlib::util::MMapAllocator);
     _pool.reset(new autil::mem_pool::Pool(_allocator.get(), 1 * 1024 * 1024));
-    _bitmap.reset(new indexlib::util::Bitmap(_docCount, false, _pool.get()));
     auto [status, diskBitmap] = GetDeletionMapPatch(_segmentId);
     RETURN_IF_STATUS_ERROR(status, "read disk bitmap for segment [%d] failed", _segmentId);
+    if (_enableCompressedDeletionMap && (!diskBitmap || diskBitmap->GetValidItemCount() == _docCount)) {
+        // not published yet, build compressed map from disk bitmap directly
+        auto compressedDeletionMap = diskBitmap ? CompressedDeletionMap::Create(*diskBitmap)
+                                                : std::make_unique<CompressedDeletionMap>(_docCount);
+        if (compressedDeletionMap->EvaluateMemUsed() < indexlib::util::Bitmap::GetDumpSize(_docCount)) {
+            ReplaceCompressedDeletionMap(nullptr, std::move(compressedDeletionMap));
+            diskBitmap.reset();
+        }
+    }
+    if (!_compressedDeletionMap.load(std::memory_order_acquire)) {
+        _bitmap.reset(new indexlib::util::Bitmap(_docCount, false, _pool.get()));
+        _bitmapPtr.store(_bitmap.get(), std::memory_order_release);
+    }
     if (diskBitmap) {
         RETURN_IF_STATUS_ERROR(ApplyDeletionMapPatch(diskBitmap.get()), "apply deletionmap patch failed");
     }
@@ -76,16 +100,75 @@ Status DeletionMapDiskIndexer::Open(const std::shared_ptr<config::IIndexConfig>&
 
 Status DeletionMapDiskIndexer::Delete(docid_t docid)
 {
-    _bitmap->Set(docid);
+    std::lock_guard<std::mutex> guard(_writeMutex);
+    if (_bitmapPtr.load(std::memory_order_acquire)) {
+        _bitmap->Set(docid);
+        return Status::OK();
+    }
+    auto currentDeletionMap = _compressedDeletionMap.load(std::memory_order_acquire);
+    if (currentDeletionMap->IsDeleted(docid)) {
+        return Status::OK();
+    }
+    if (!_indexMemoryReclaimer) {
+        MaterializeBitmap(*currentDeletionMap);
+        _bitmap->Set(docid);
+        return Status::OK();
+    }
+    auto compressedDeletionMap = currentDeletionMap->Delete(docid);
+    if (compressedDeletionMap->EvaluateMemUsed() >= indexlib::util::Bitmap::GetDumpSize(_docCount)) {
+        MaterializeBitmap(*compressedDeletionMap);
+        return Status::OK();
+    }
+    ReplaceCompressedDeletionMap(currentDeletionMap, std::move(compressedDeletionMap));
     return Status::OK();
 }
 uint32_t DeletionMapDiskIndexer::GetDeletedDocCount() const
 {
-    auto bitmap = _bitmap.get();
+    auto bitmap = _bitmapPtr.load(std::memory_order_acquire);
     if (bitmap) {
         return bitmap->GetSetCount();
     }
-    return 0;
+    return _compressedDeletedDocCount.load(std::memory_order_relaxed);
+}
+
+void DeletionMapDiskIndexer::GetDeletedDocRanges(std::vector<std::pair<docid_t, docid_t>>& ranges) const
+{
+    ranges.clear();
+    auto bitmap = _bitmapPtr.load(std::memory_order_acquire);
+    if (!bitmap) {
+        _compressedDeletionMap.load(std::memory_order_acquire)->GetDeletedDocRanges(ranges);
+        return;
+    }
+    for (uint32_t docid = bitmap->Begin(); docid != indexlib::util::Bitmap::INVALID_INDEX && docid < _docCount;
+         docid = bitmap->Next(docid)) {
+        if (!ranges.empty() && ranges.back().second == (docid_t)docid) {
+            ++ranges.back().second;
+        } else {
+            ranges.emplace_back(docid, docid + 1);
+        }
+    }
+}
+
+void DeletionMapDiskIndexer::ReplaceCompressedDeletionMap(CompressedDeletionMap* currentDeletionMap,
+                                                          std::unique_ptr<CompressedDeletionMap> compressedDeletionMap)
+{
+    _compressedDeletedDocCount.store(compressedDeletionMap->GetDeletedDocCount(), std::memory_order_relaxed);
+    _compressedMemUsed.store(compressedDeletionMap->EvaluateMemUsed(), std::memory_order_relaxed);
+    _compressedDeletionMap.store(compressedDeletionMap.release(), std::memory_order_release);
+    if (currentDeletionMap) {
+        _indexMemoryReclaimer->Retire(currentDeletionMap,
+                                      [](void* addr) { delete static_cast<CompressedDeletionMap*>(addr); });
+    }
+}
+
+void DeletionMapDiskIndexer::MaterializeBitmap(const CompressedDeletionMap& compressedDeletionMap)
+{
+    std::unique_ptr<indexlib::util::Bitmap> bitmap(new indexlib::util::Bitmap(_docCount, false, _pool.get()));
+    compressedDeletionMap.Materialize(bitmap.get());
+    _bitmap = std::move(bitmap);
+    _bitmapPtr.store(_bitmap.get(), std::memory_order_release);
+    AUTIL_LOG(DEBUG, "materialize deletion map bitmap for segment [%d], deleted doc count [%u]", _segmentId,
+              _bitmap->GetSetCount());
 }
 
 segmentid_t DeletionMapDiskIndexer::GetSegmentId() const { return _segmentId; }
@@ -111,7 +194,15 @@ size_t DeletionMapDiskIndexer::EstimateMemUsed(const std::shared_ptr<config::IIn
     return indexlib::util::Bitmap::GetDumpSize(_docCount);
 }
 
-size_t DeletionMapDiskIndexer::EvaluateCurrentMemUsed() { return indexlib::util::Bitmap::GetDumpSize(_docCount); }
+size_t DeletionMapDiskIndexer::EvaluateCurrentMemUsed()
+{
+    if (!_enableCompressedDeletionMap) {
+        return indexlib::util::Bitmap::GetDumpSize(_docCount);
+    }
+    // compressed map may be retired concurrently, only use the cached size
+    size_t memUsed = _bitmapPtr.load(std::memory_order_acquire) ? indexlib::util::Bitmap::GetDumpSize(_docCount) : 0;
+    return memUsed + _compressedMemUsed.load(std::memory_order_relaxed);
+}
 
 Status DeletionMapDiskIndexer::ApplyDeletionMapPatch(indexlib::util::Bitmap* bitmap)
 {
@@ -124,7 +215,29 @@ Status DeletionMapDiskIndexer::ApplyDeletionMapPatch(indexlib::util::Bitmap* bit
                   bitmap->GetValidItemCount(), _docCount);
         return Status::InvalidArgs("apply deletionmap patch failed");
     }
-    *_bitmap |= *bitmap;
+    std::lock_guard<std::mutex> guard(_writeMutex);
+    if (_bitmapPtr.load(std::memory_order_acquire)) {
+        *_bitmap |= *bitmap;
+        return Status::OK();
+    }
+    if (bitmap->Begin() == indexlib::util::Bitmap::INVALID_INDEX) {
+        return Status::OK();
+    }
+    auto currentDeletionMap = _compressedDeletionMap.load(std::memory_order_acquire);
+    if (!_indexMemoryReclaimer) {
+        // replaced map can not be freed safely while readers may hold it, switch to dense bitmap
+        MaterializeBitmap(*currentDeletionMap);
+        *_bitmap |= *bitmap;
+        return Status::OK();
+    }
+    // compressed map is read only, merge patch into a new one
+    auto compressedDeletionMap = currentDeletionMap->Patch(*bitmap);
+    if (compressedDeletionMap->EvaluateMemUsed() >= indexlib::util::Bitmap::GetDumpSize(_docCount)) {
+        // densely deleted segment, keep dense bitmap
+        MaterializeBitmap(*compressedDeletionMap);
+        return Status::OK();
+    }
+    ReplaceCompressedDeletionMap(currentDeletionMap, std::move(compressedDeletionMap));
     return Status::OK();
 }
 
@@ -191,11 +304,24 @@ DeletionMapDiskIndexer::GetDeletionMapPatch(segmentid_t segmentId)
 
 Status DeletionMapDiskIndexer::Dump(const std::shared_ptr<indexlib::file_system::IDirectory>& indexDirectory)
 {
-    if (!_bitmap) {
-        AUTIL_LOG(ERROR, "_bitmap is nullptr");
-        return Status::Corruption("_bitmap is nullptr");
+    // writers may replace and retire the compressed map
+    std::lock_guard<std::mutex> guard(_writeMutex);
+    auto bitmap = _bitmapPtr.load(std::memory_order_acquire);
+    std::unique_ptr<indexlib::util::Bitmap> materializedBitmap;
+    if (!bitmap) {
+        auto compressedDeletionMap = _compressedDeletionMap.load(std::memory_order_acquire);
+        if (!compressedDeletionMap) {
+            AUTIL_LOG(ERROR, "_bitmap is nullptr");
+            return Status::Corruption("_bitmap is nullptr");
+        }
+        if (compressedDeletionMap->GetDeletedDocCount() == 0) {
+            return Status::OK();
+        }
+        materializedBitmap.reset(new indexlib::util::Bitmap((uint32_t)_docCount));
+        compressedDeletionMap->Materialize(materializedBitmap.get());
+        bitmap = materializedBitmap.get();
     }
-    if (_bitmap->GetSetCount() == 0) {
+    if (bitmap->GetSetCount() == 0) {
         return Status::OK();
     }
     std::string fileName = DeletionMapUtil::GetDeletionMapFileName(_segmentId);
@@ -207,7 +333,7 @@ Status DeletionMapDiskIndexer::Dump(const std::shared_ptr<indexlib::file_system:
         return Status::IOError("create file writer failed");
     }
     std::shared_ptr<indexlib::file_system::FileWriter> writer = writerResult.Value();
-    RETURN_IF_STATUS_ERROR(DeletionMapUtil::DumpBitmap(writer, _bitmap.get(), _bitmap->GetValidItemCount()),
+    RETURN_IF_STATUS_ERROR(DeletionMapUtil::DumpBitmap(writer, bitmap, bitmap->GetValidItemCount()),
                            "dump bitmap fail");
 
     auto ret = writer->Close();
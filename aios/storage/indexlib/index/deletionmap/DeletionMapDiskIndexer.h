@@ -15,14 +15,21 @@
  */
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "autil/Log.h"
 #include "indexlib/base/Types.h"
 #include "indexlib/index/IDiskIndexer.h"
+#include "indexlib/index/deletionmap/CompressedDeletionMap.h"
 #include "indexlib/util/Bitmap.h"
 
 namespace indexlib::util {
 class MMapAllocator;
 }
+namespace indexlibv2::framework {
+class IIndexMemoryReclaimer;
+}
 namespace indexlib::file_system {
 class FileReader;
 class IDirectory;
@@ -35,7 +42,8 @@ class DeletionMapMetrics;
 class DeletionMapDiskIndexer : public IDiskIndexer
 {
 public:
-    DeletionMapDiskIndexer(size_t docCount, segmentid_t segmentId);
+    DeletionMapDiskIndexer(size_t docCount, segmentid_t segmentId,
+                           framework::IIndexMemoryReclaimer* indexMemoryReclaimer = nullptr);
     ~DeletionMapDiskIndexer();
 
     Status Open(const std::shared_ptr<config::IIndexConfig>& indexConfig,
@@ -47,6 +55,8 @@ public:
     bool IsDeleted(docid_t docid) const;
     Status Delete(docid_t docid);
     uint32_t GetDeletedDocCount() const;
+    // [begin, end) of deleted docs, ascending
+    void GetDeletedDocRanges(std::vector<std::pair<docid_t, docid_t>>& ranges) const;
     segmentid_t GetSegmentId() const;
     void TEST_InitWithoutOpen();
 
@@ -58,11 +68,27 @@ public:
 private:
     Status LoadFileHeader(const std::shared_ptr<indexlib::file_system::FileReader>& fileReader,
                           DeletionMapFileHeader& fileHeader);
+    void MaterializeBitmap(const CompressedDeletionMap& compressedDeletionMap);
+    void ReplaceCompressedDeletionMap(CompressedDeletionMap* currentDeletionMap,
+                                      std::unique_ptr<CompressedDeletionMap> compressedDeletionMap);
 
 private:
     size_t _docCount;
     segmentid_t _segmentId;
     std::shared_ptr<DeletionMapMetrics> _metrics;
+    // with compressed deletion map enabled, segment is opened with a read only compressed map, the dense bitmap is
+    // materialized when compressed map is larger, readers test _bitmapPtr once it is published. Delete and patch
+    // copy the compressed map and replace the current one, the replaced one is retired to _indexMemoryReclaimer and
+    // freed once no reader holds it, without reclaimer they materialize the dense bitmap instead. Writers are
+    // serialized by _writeMutex
+    bool _enableCompressedDeletionMap;
+    framework::IIndexMemoryReclaimer* _indexMemoryReclaimer;
+    std::atomic<CompressedDeletionMap*> _compressedDeletionMap;
+    // deleted doc count and memory of current compressed map, metrics thread reads them without holding the map
+    std::atomic<uint32_t> _compressedDeletedDocCount;
+    std::atomic<size_t> _compressedMemUsed;
+    std::mutex _writeMutex;
+    std::atomic<indexlib::util::Bitmap*> _bitmapPtr;
     std::unique_ptr<indexlib::util::Bitmap> _bitmap;
     std::unique_ptr<indexlib::util::MMapAllocator> _allocator;
     std::unique_ptr<autil::mem_pool::Pool> _pool;
@@ -75,7 +101,11 @@ private:
 inline bool DeletionMapDiskIndexer::IsDeleted(docid_t docid) const
 {
     assert(docid < _docCount);
-    return _bitmap->Test(docid);
+    auto bitmap = _bitmapPtr.load(std::memory_order_acquire);
+    if (bitmap) {
+        return bitmap->Test(docid);
+    }
+    return _compressedDeletionMap.load(std::memory_order_acquire)->IsDeleted(docid);
 }
 
 } // namespace indexlibv2::index
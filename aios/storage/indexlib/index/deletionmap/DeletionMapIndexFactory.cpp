@@ -43,7 +43,8 @@ DeletionMapIndexFactory::CreateDiskIndexer(const std::shared_ptr<config::IIndexC
 {
     assert(nullptr != indexerParam.metricsManager);
     segmentid_t segmentid = indexerParam.segmentId;
-    auto diskIndexer = std::make_shared<index::DeletionMapDiskIndexer>(indexerParam.docCount, segmentid);
+    auto diskIndexer = std::make_shared<index::DeletionMapDiskIndexer>(indexerParam.docCount, segmentid,
+                                                                   indexerParam.indexMemoryReclaimer);
     std::string identifier = "__disk_deletionmap_metrics_identifier_" + std::to_string((uint64_t)(diskIndexer.get())) +
                              "_" + std::to_string(segmentid);
     auto tags = make_shared<kmonitor::MetricsTags>("segmentid", std::to_string(segmentid));
@@ -15,11 +15,73 @@
  */
 #include "indexlib/index/inverted_index/AndPostingExecutor.h"
 
+#include <algorithm>
+#include <immintrin.h>
+
 namespace indexlib::index {
+namespace {
+
+// return count of leading docs less than target in docs[0, 8)
+__attribute__((target("avx2"))) uint32_t CountLessAvx2(const docid_t* docs, docid_t target)
+{
+    __m256i values = _mm256_loadu_si256((const __m256i*)docs);
+    __m256i less = _mm256_cmpgt_epi32(_mm256_set1_epi32(target), values);
+    return __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(less)));
+}
+
+uint32_t CountLessScalar(const docid_t* docs, docid_t target)
+{
+    uint32_t count = 0;
+    while (count < 8 && docs[count] < target) {
+        ++count;
+    }
+    return count;
+}
+
+typedef uint32_t (*CountLessFunc)(const docid_t* docs, docid_t target);
+
+CountLessFunc ChooseCountLessFunc()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? CountLessAvx2 : CountLessScalar;
+}
+
+const CountLessFunc COUNT_LESS = ChooseCountLessFunc();
+
+// first position in [begin, end) whose doc >= target, docs are ascending
+uint32_t GallopLowerBound(const docid_t* docs, uint32_t begin, uint32_t end, docid_t target)
+{
+    // compare next 8 docs at once first, candidates are usually close
+    if (begin + 8 <= end) {
+        uint32_t lessCount = COUNT_LESS(docs + begin, target);
+        if (lessCount < 8) {
+            return begin + lessCount;
+        }
+        begin += 8;
+    }
+    uint32_t step = 1;
+    uint32_t low = begin;
+    while (begin + step < end && docs[begin + step] < target) {
+        low = begin + step;
+        step <<= 1;
+    }
+    uint32_t high = std::min(begin + step + 1, end);
+    return std::lower_bound(docs + low, docs + high, target) - docs;
+}
+
+} // namespace
+
 AUTIL_LOG_SETUP(indexlib.index, AndPostingExecutor);
 
-AndPostingExecutor::AndPostingExecutor(const std::vector<std::shared_ptr<PostingExecutor>>& postingExecutors)
+AndPostingExecutor::AndPostingExecutor(const std::vector<std::shared_ptr<PostingExecutor>>& postingExecutors,
+                                       bool enableBlockMode)
     : _postingExecutors(postingExecutors)
+    , _enableBlockMode(enableBlockMode)
+    , _matchedCount(0)
+    , _matchedCursor(0)
+    , _lastCandidate(INVALID_DOCID)
+    , _examinedDocCount(0)
+    , _matchedDocCount(0)
 {
     sort(_postingExecutors.begin(), _postingExecutors.end(), DFCompare());
 }
@@ -36,6 +98,14 @@ df_t AndPostingExecutor::GetDF() const
 }
 
 docid_t AndPostingExecutor::DoSeek(docid_t id)
+{
+    if (_enableBlockMode && !_postingExecutors.empty()) {
+        return BlockSeek(id);
+    }
+    return LeapfrogSeek(id);
+}
+
+docid_t AndPostingExecutor::LeapfrogSeek(docid_t id)
 {
     auto firstIter = _postingExecutors.begin();
     auto currentIter = firstIter;
@@ -53,4 +123,59 @@ docid_t AndPostingExecutor::DoSeek(docid_t id)
     } while (END_DOCID != current && currentIter != endIter);
     return current;
 }
+
+docid_t AndPostingExecutor::BlockSeek(docid_t id)
+{
+    while (_matchedCursor < _matchedCount && _matchedDocs[_matchedCursor] < id) {
+        ++_matchedCursor;
+    }
+    if (_matchedCursor < _matchedCount) {
+        return _matchedDocs[_matchedCursor];
+    }
+
+    // executors are sorted by df, the first one leads
+    PostingExecutor* leader = _postingExecutors[0].get();
+    docid_t startId = std::max(id, _lastCandidate + 1);
+    while (true) {
+        uint32_t count = leader->SeekBlock(startId, _matchedDocs, BLOCK_SIZE);
+        if (count == 0) {
+            _matchedCount = 0;
+            _matchedCursor = 0;
+            return END_DOCID;
+        }
+        _examinedDocCount += count;
+        _lastCandidate = _matchedDocs[count - 1];
+        for (size_t i = 1; i < _postingExecutors.size() && count > 0; ++i) {
+            count = IntersectBlock(_postingExecutors[i].get(), _matchedDocs, count);
+        }
+        if (count > 0) {
+            _matchedDocCount += count;
+            _matchedCount = count;
+            _matchedCursor = 0;
+            return _matchedDocs[0];
+        }
+        startId = _lastCandidate + 1;
+    }
+}
+
+uint32_t AndPostingExecutor::IntersectBlock(PostingExecutor* executor, docid_t* candidates, uint32_t count)
+{
+    uint32_t matched = 0;
+    uint32_t cursor = 0;
+    while (cursor < count) {
+        uint32_t blockSize = executor->SeekBlock(candidates[cursor], _blockBuffer, BLOCK_SIZE);
+        if (blockSize == 0) {
+            break;
+        }
+        docid_t blockLast = _blockBuffer[blockSize - 1];
+        uint32_t pos = 0;
+        for (; cursor < count && candidates[cursor] <= blockLast; ++cursor) {
+            pos = GallopLowerBound(_blockBuffer, pos, blockSize, candidates[cursor]);
+            if (_blockBuffer[pos] == candidates[cursor]) {
+                candidates[matched++] = candidates[cursor];
+            }
+        }
+    }
+    return matched;
+}
 } // namespace indexlib::index
@@ -24,9 +24,14 @@ namespace indexlib::index {
 class AndPostingExecutor : public PostingExecutor
 {
 public:
-    AndPostingExecutor(const std::vector<std::shared_ptr<PostingExecutor>>& postingExecutors);
+    // enableBlockMode: take candidates from executor with min df block by block, and intersect them with blocks
+    // of other executors by galloping search, instead of leapfrog seek one doc at a time
+    AndPostingExecutor(const std::vector<std::shared_ptr<PostingExecutor>>& postingExecutors,
+                       bool enableBlockMode = false);
     ~AndPostingExecutor();
 
+    static constexpr uint32_t BLOCK_SIZE = 128;
+
 public:
     struct DFCompare {
         bool operator()(const std::shared_ptr<PostingExecutor>& lhs, const std::shared_ptr<PostingExecutor>& rhs)
@@ -37,8 +42,26 @@ public:
     df_t GetDF() const override;
     docid_t DoSeek(docid_t docId) override;
 
+    // candidate docs taken from leading executor, only counted in block mode
+    int64_t GetExaminedDocCount() const { return _examinedDocCount; }
+    int64_t GetMatchedDocCount() const { return _matchedDocCount; }
+
+private:
+    docid_t LeapfrogSeek(docid_t docId);
+    docid_t BlockSeek(docid_t docId);
+    uint32_t IntersectBlock(PostingExecutor* executor, docid_t* candidates, uint32_t count);
+
 private:
     std::vector<std::shared_ptr<PostingExecutor>> _postingExecutors;
+    bool _enableBlockMode;
+    // matched docs of current candidate block
+    docid_t _matchedDocs[BLOCK_SIZE];
+    uint32_t _matchedCount;
+    uint32_t _matchedCursor;
+    docid_t _lastCandidate;
+    docid_t _blockBuffer[BLOCK_SIZE];
+    int64_t _examinedDocCount;
+    int64_t _matchedDocCount;
 
     AUTIL_LOG_DECLARE();
 };
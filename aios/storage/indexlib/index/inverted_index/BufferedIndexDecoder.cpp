@@ -254,10 +254,12 @@ BufferedSegmentIndexDecoder* BufferedIndexDecoder::CreateNormalSegmentDecoder(ui
 
     if (mCurSegPostingFormatOption.HasTfList()) {
         return IE_POOL_COMPATIBLE_NEW_CLASS(_sessionPool, SkipListSegmentDecoder<TriValueSkipListReader>, _sessionPool,
-                                            &_docListReader, docListBeginPos, compressMode);
+                                            &_docListReader, docListBeginPos, compressMode,
+                                            mCurSegPostingFormatOption.IsStreamVbyteCompress());
     } else {
         return IE_POOL_COMPATIBLE_NEW_CLASS(_sessionPool, SkipListSegmentDecoder<PairValueSkipListReader>, _sessionPool,
-                                            &_docListReader, docListBeginPos, compressMode);
+                                            &_docListReader, docListBeginPos, compressMode,
+                                            mCurSegPostingFormatOption.IsStreamVbyteCompress());
     }
 }
 } // namespace indexlib::index
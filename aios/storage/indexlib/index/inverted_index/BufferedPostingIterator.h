@@ -59,6 +59,9 @@ public:
     // for runtime inline.
     docid_t InnerSeekDoc(docid_t docId);
     index::ErrorCode InnerSeekDoc(docid_t docId, docid_t& result);
+    // seek to first doc >= docId (stay if docId not greater than current doc), copy it and following docs
+    // already decoded in doc buffer to docIds, at most capacity. count is 0 when reach end
+    index::ErrorCode SeekDocBlock(docid_t docId, docid_t* docIds, uint32_t capacity, uint32_t& count);
     fieldmap_t GetFieldMap();
     index::ErrorCode GetFieldMap(fieldmap_t& fieldMap);
     void Reset() override;
@@ -223,6 +226,30 @@ inline index::ErrorCode BufferedPostingIterator::InnerSeekDoc(docid_t docId, doc
     return SeekDocForNormal(docId, result);
 }
 
+inline index::ErrorCode BufferedPostingIterator::SeekDocBlock(docid_t docId, docid_t* docIds, uint32_t capacity,
+                                                             uint32_t& count)
+{
+    count = 0;
+    docid_t curDocId = _currentDocId;
+    if (docId > curDocId) {
+        auto ec = InnerSeekDoc(docId, curDocId);
+        if (ec != index::ErrorCode::OK || curDocId == INVALID_DOCID) {
+            return ec;
+        }
+    }
+    docIds[count++] = curDocId;
+    if (_postingFormatOption.IsReferenceCompress()) {
+        return index::ErrorCode::OK;
+    }
+    // doc buffer keeps delta of doc ids, iterator itself stays at first doc
+    const docid_t* cursor = _docBufferCursor;
+    while (count < capacity && curDocId < _lastDocIdInBuffer) {
+        curDocId += *(cursor++);
+        docIds[count++] = curDocId;
+    }
+    return index::ErrorCode::OK;
+}
+
 inline index::ErrorCode BufferedPostingIterator::SeekDocForNormal(docid_t docId, docid_t& result)
 {
     docid_t curDocId = _currentDocId;
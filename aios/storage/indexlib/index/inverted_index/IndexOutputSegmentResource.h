@@ -52,6 +52,7 @@ public:
 
     void Reset();
     std::shared_ptr<IndexDataWriter>& GetIndexDataWriter(SegmentTermInfo::TermIndexMode mode);
+    const file_system::DirectoryPtr& GetMergeDirectory() const { return _mergeDir; }
 
 private:
     void CreateNormalIndexDataWriter(const std::shared_ptr<indexlibv2::config::InvertedIndexConfig>& indexConfig,
@@ -15,6 +15,12 @@
  */
 #include "indexlib/index/inverted_index/InvertedIndexMerger.h"
 
+#include <algorithm>
+
+#include "autil/EnvUtil.h"
+#include "autil/StringUtil.h"
+#include "autil/ThreadPool.h"
+#include "autil/TimeUtility.h"
 #include "indexlib/config/TabletSchema.h"
 #include "indexlib/file_system/file/CompressFileInfo.h"
 #include "indexlib/file_system/relocatable/RelocatableFolder.h"
@@ -34,6 +40,7 @@
 #include "indexlib/index/inverted_index/builtin_index/bitmap/BitmapPostingMerger.h"
 #include "indexlib/index/inverted_index/config/HighFrequencyVocabulary.h"
 #include "indexlib/index/inverted_index/config/TruncateOptionConfig.h"
+#include "indexlib/index/inverted_index/format/ShortListOptimizeUtil.h"
 #include "indexlib/index/inverted_index/format/dictionary/DictionaryCreator.h"
 #include "indexlib/index/inverted_index/format/dictionary/DictionaryIterator.h"
 #include "indexlib/index/inverted_index/format/dictionary/DictionaryReader.h"
@@ -55,10 +62,29 @@ using indexlibv2::framework::SegmentMeta;
 using indexlibv2::framework::SegmentStatistics;
 using indexlibv2::index::DocMapper;
 using indexlibv2::index::IIndexMerger;
+
+// indexes with less posting bytes than this are merged by one thread
+constexpr int64_t TERM_RANGE_MERGE_MIN_POSTING_BYTES = 64 * 1024 * 1024;
+constexpr size_t TERM_RANGE_SAMPLE_COUNT = 64; // per range per source segment
+constexpr size_t TERM_RANGE_COPY_BUFFER_SIZE = 4 * 1024 * 1024;
+const std::string TERM_RANGE_DIR_PREFIX = "term_range_";
 } // namespace
 
 AUTIL_LOG_SETUP(indexlib.index, InvertedIndexMerger);
 
+// terms in [beginKey, endKey) are merged into chunk files under term_range_${idx} of each target index dir
+struct TermRangeMergeContext {
+    std::optional<DictKeyInfo> beginKey;
+    std::optional<DictKeyInfo> endKey;
+    std::string chunkDirName;
+    std::shared_ptr<OnDiskIndexIteratorCreator> onDiskIndexIterCreator;
+    util::SimplePool simplePool;
+    std::vector<std::shared_ptr<IndexOutputSegmentResource>> outputResources;
+    Status status;
+    size_t termCount = 0;
+    int64_t timeUsed = 0;
+};
+
 InvertedIndexMerger::~InvertedIndexMerger()
 {
     _byteSlicePool.reset();
@@ -155,30 +181,324 @@ Status InvertedIndexMerger::DoMerge(const SegmentMergeInfos& segMergeInfos,
         _termExtender->Init(segMergeInfos.targetSegments, _indexOutputSegmentResources);
     }
 
-    // Init term queue
-    auto onDiskIndexIterCreator = CreateOnDiskIndexIteratorCreator();
-    SegmentTermInfoQueue termInfoQueue(_indexConfig, onDiskIndexIterCreator);
-    status = termInfoQueue.Init(segMergeInfos.srcSegments, _patchInfos);
-    RETURN_IF_STATUS_ERROR(status, "init term info queue for index [%s] failed", _indexConfig->GetIndexName().c_str());
+    int64_t beginTime = autil::TimeUtility::currentTime();
+    size_t termCount = 0;
+    std::vector<DictKeyInfo> rangeBoundaries;
+    size_t rangeCount = GetTermRangeCount();
+    if (rangeCount > 1) {
+        std::tie(status, rangeBoundaries) = SampleTermRangeBoundaries(segMergeInfos.srcSegments, rangeCount);
+        RETURN_IF_STATUS_ERROR(status, "sample term range for index [%s] failed", _indexName.c_str());
+    }
+    if (!rangeBoundaries.empty()) {
+        status = MergeTermRanges(segMergeInfos, docMapper, rangeBoundaries, termCount);
+        RETURN_IF_STATUS_ERROR(status, "merge term ranges for index [%s] failed", _indexName.c_str());
+    } else {
+        // Init term queue
+        auto onDiskIndexIterCreator = CreateOnDiskIndexIteratorCreator();
+        SegmentTermInfoQueue termInfoQueue(_indexConfig, onDiskIndexIterCreator);
+        status = termInfoQueue.Init(segMergeInfos.srcSegments, _patchInfos);
+        RETURN_IF_STATUS_ERROR(status, "init term info queue for index [%s] failed",
+                               _indexConfig->GetIndexName().c_str());
 
-    DictKeyInfo key;
-    while (!termInfoQueue.Empty()) {
-        SegmentTermInfo::TermIndexMode termMode;
-        const auto& segTermInfos = termInfoQueue.CurrentTermInfos(key, termMode);
-        status = MergeTerm(key, segTermInfos, termMode, docMapper, segMergeInfos.targetSegments);
-        RETURN_IF_STATUS_ERROR(status, "merge term failed.");
-        termInfoQueue.MoveToNextTerm();
+        DictKeyInfo key;
+        while (!termInfoQueue.Empty()) {
+            SegmentTermInfo::TermIndexMode termMode;
+            const auto& segTermInfos = termInfoQueue.CurrentTermInfos(key, termMode);
+            status = MergeTerm(key, segTermInfos, termMode, docMapper, segMergeInfos.targetSegments);
+            RETURN_IF_STATUS_ERROR(status, "merge term failed.");
+            termInfoQueue.MoveToNextTerm();
+            ++termCount;
+        }
     }
     if (_termExtender) {
         _termExtender->Destroy();
         _termExtender.reset();
     }
+    UpdateMergeStatistics(termCount, rangeBoundaries.size() + 1, beginTime);
     EndMerge();
     status = MergePatches(segMergeInfos);
     RETURN_IF_STATUS_ERROR(status, "merge patches failed");
     return Status::OK();
 }
 
+size_t InvertedIndexMerger::GetTermRangeCount() const
+{
+    uint32_t threadCount = autil::EnvUtil::getEnv("INDEXLIB_PARALLEL_TERM_MERGE_THREAD_COUNT", (uint32_t)0);
+    if (threadCount <= 1) {
+        return 1;
+    }
+    if (!SupportTermRangeMerge()) {
+        AUTIL_LOG(INFO, "index [%s] iterator does not support key range, merge terms in one thread",
+                  _indexName.c_str());
+        return 1;
+    }
+    // truncate and adaptive bitmap writers see terms in key order, patches are not split by key range
+    if (_termExtender || _indexConfig->GetHighFreqVocabulary() || !_patchInfos.empty()) {
+        AUTIL_LOG(INFO, "index [%s] has truncate, bitmap or patch, merge terms in one thread", _indexName.c_str());
+        return 1;
+    }
+    return threadCount;
+}
+
+std::pair<Status, std::vector<DictKeyInfo>>
+InvertedIndexMerger::SampleTermRangeBoundaries(const std::vector<SourceSegment>& srcSegments, size_t rangeCount) const
+{
+    // sample pairs of (key, posting bytes of terms before key since last sample) from source dictionaries,
+    // boundaries split posting bytes evenly
+    std::vector<std::pair<DictKeyInfo, int64_t>> samples;
+    int64_t totalPostingBytes = 0;
+    for (const auto& srcSegment : srcSegments) {
+        auto indexDirectory = GetIndexDirectory(srcSegment.segment->GetSegmentDirectory());
+        if (!indexDirectory || !indexDirectory->IsExist(DICTIONARY_FILE_NAME)) {
+            continue;
+        }
+        int64_t postingFileLength = 0;
+        std::shared_ptr<file_system::CompressFileInfo> compressInfo =
+            indexDirectory->GetCompressFileInfo(POSTING_FILE_NAME);
+        if (compressInfo) {
+            postingFileLength = compressInfo->deCompressFileLen;
+        } else {
+            postingFileLength = indexDirectory->GetFileLength(POSTING_FILE_NAME);
+        }
+        totalPostingBytes += postingFileLength;
+        int64_t sampleStep = std::max(postingFileLength / (int64_t)(rangeCount * TERM_RANGE_SAMPLE_COUNT), (int64_t)1);
+
+        std::unique_ptr<DictionaryReader> dictReader(DictionaryCreator::CreateDiskReader(_indexConfig));
+        auto status = dictReader->Open(indexDirectory, DICTIONARY_FILE_NAME, true);
+        RETURN2_IF_STATUS_ERROR(status, std::vector<DictKeyInfo>(), "open dictionary of segment [%d] failed",
+                                srcSegment.segment->GetSegmentId());
+        std::shared_ptr<DictionaryIterator> dictIter = dictReader->CreateIterator();
+        int64_t lastSampleOffset = 0;
+        DictKeyInfo key;
+        dictvalue_t value;
+        while (dictIter->HasNext()) {
+            dictIter->Next(key, value);
+            int64_t offset = 0;
+            // null term is the largest key, always merged in last range
+            if (key.IsNull() || !ShortListOptimizeUtil::GetOffset(value, offset)) {
+                continue;
+            }
+            if (offset - lastSampleOffset >= sampleStep) {
+                samples.emplace_back(key, offset - lastSampleOffset);
+                lastSampleOffset = offset;
+            }
+        }
+    }
+    if (totalPostingBytes < TERM_RANGE_MERGE_MIN_POSTING_BYTES) {
+        AUTIL_LOG(INFO, "index [%s] posting bytes [%ld] too small, merge terms in one thread", _indexName.c_str(),
+                  totalPostingBytes);
+        return {Status::OK(), {}};
+    }
+
+    std::sort(samples.begin(), samples.end(),
+              [](const auto& left, const auto& right) { return left.first < right.first; });
+    int64_t sampledBytes = 0;
+    for (const auto& sample : samples) {
+        sampledBytes += sample.second;
+    }
+    std::vector<DictKeyInfo> boundaries;
+    int64_t accumulatedBytes = 0;
+    for (const auto& [key, bytes] : samples) {
+        if (boundaries.size() + 1 >= rangeCount) {
+            break;
+        }
+        accumulatedBytes += bytes;
+        if (accumulatedBytes * (int64_t)rangeCount < sampledBytes * (int64_t)(boundaries.size() + 1)) {
+            continue;
+        }
+        if (boundaries.empty() || boundaries.back() < key) {
+            boundaries.push_back(key);
+        }
+    }
+    AUTIL_LOG(INFO, "index [%s] split into [%lu] term ranges by [%lu] samples, posting bytes [%ld]",
+              _indexName.c_str(), boundaries.size() + 1, samples.size(), totalPostingBytes);
+    return {Status::OK(), boundaries};
+}
+
+Status InvertedIndexMerger::MergeTermRanges(const SegmentMergeInfos& segMergeInfos,
+                                            const std::shared_ptr<DocMapper>& docMapper,
+                                            const std::vector<DictKeyInfo>& rangeBoundaries, size_t& termCount)
+{
+    size_t rangeCount = rangeBoundaries.size() + 1;
+    std::vector<std::unique_ptr<TermRangeMergeContext>> contexts;
+    for (size_t i = 0; i < rangeCount; ++i) {
+        auto context = std::make_unique<TermRangeMergeContext>();
+        if (i > 0) {
+            context->beginKey = rangeBoundaries[i - 1];
+        }
+        if (i < rangeBoundaries.size()) {
+            context->endKey = rangeBoundaries[i];
+        }
+        context->chunkDirName = TERM_RANGE_DIR_PREFIX + autil::StringUtil::toString(i);
+        context->onDiskIndexIterCreator = CreateOnDiskIndexIteratorCreator();
+        for (const auto& indexOutputSegmentResource : _indexOutputSegmentResources) {
+            auto chunkDir = indexOutputSegmentResource->GetMergeDirectory()->MakeDirectory(context->chunkDirName);
+            auto chunkResource = std::make_shared<IndexOutputSegmentResource>();
+            chunkResource->Init(chunkDir, _indexConfig, _ioConfig, /*temperatureLayerStr*/ "", &context->simplePool,
+                                /*needCreateBitmapIndex*/ false);
+            context->outputResources.push_back(chunkResource);
+        }
+        contexts.push_back(std::move(context));
+    }
+
+    autil::ThreadPool threadPool(rangeCount, rangeCount);
+    if (!threadPool.start("TermRangeMerge")) {
+        AUTIL_LOG(ERROR, "start term range merge thread pool failed");
+        return Status::InternalError("start term range merge thread pool failed");
+    }
+    for (auto& context : contexts) {
+        auto contextPtr = context.get();
+        auto ec = threadPool.pushTask([this, &segMergeInfos, &docMapper, contextPtr]() {
+            try {
+                contextPtr->status = MergeTermRange(segMergeInfos, docMapper, contextPtr);
+            } catch (const std::exception& e) {
+                AUTIL_LOG(ERROR, "merge [%s] of index [%s] failed, exception [%s]", contextPtr->chunkDirName.c_str(),
+                          _indexName.c_str(), e.what());
+                contextPtr->status = Status::IOError("merge term range failed");
+            } catch (...) {
+                AUTIL_LOG(ERROR, "merge [%s] of index [%s] failed, unknown exception",
+                          contextPtr->chunkDirName.c_str(), _indexName.c_str());
+                contextPtr->status = Status::IOError("merge term range failed");
+            }
+        });
+        if (ec != autil::ThreadPool::ERROR_NONE) {
+            threadPool.waitFinish();
+            AUTIL_LOG(ERROR, "push term range merge task failed, ec [%d]", ec);
+            return Status::InternalError("push term range merge task failed");
+        }
+    }
+    threadPool.waitFinish();
+
+    for (const auto& context : contexts) {
+        RETURN_IF_STATUS_ERROR(context->status, "merge [%s] of index [%s] failed", context->chunkDirName.c_str(),
+                               _indexName.c_str());
+        AUTIL_LOG(INFO, "index [%s] [%s] merged [%lu] terms, time used [%.3f]s", _indexName.c_str(),
+                  context->chunkDirName.c_str(), context->termCount, context->timeUsed / 1000000.0);
+        termCount += context->termCount;
+    }
+    // ranges are ordered by key, concatenate chunks and rebase posting offsets in dictionary values
+    for (size_t i = 0; i < _indexOutputSegmentResources.size(); ++i) {
+        const auto& dataWriter = _indexOutputSegmentResources[i]->GetIndexDataWriter(SegmentTermInfo::TM_NORMAL);
+        const auto& mergeDir = _indexOutputSegmentResources[i]->GetMergeDirectory();
+        for (const auto& context : contexts) {
+            auto status = AppendTermRangeChunk(context->outputResources[i]->GetMergeDirectory(), dataWriter);
+            RETURN_IF_STATUS_ERROR(status, "append [%s] of index [%s] failed", context->chunkDirName.c_str(),
+                                   _indexName.c_str());
+            status = mergeDir->GetIDirectory()->RemoveDirectory(context->chunkDirName, file_system::RemoveOption())
+                         .Status();
+            RETURN_IF_STATUS_ERROR(status, "remove [%s] of index [%s] failed", context->chunkDirName.c_str(),
+                                   _indexName.c_str());
+        }
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexMerger::MergeTermRange(const SegmentMergeInfos& segMergeInfos,
+                                           const std::shared_ptr<DocMapper>& docMapper,
+                                           TermRangeMergeContext* context) const
+{
+    int64_t beginTime = autil::TimeUtility::currentTime();
+    util::MMapAllocator allocator;
+    autil::mem_pool::Pool byteSlicePool(&allocator, DEFAULT_CHUNK_SIZE * 1024 * 1024);
+    autil::mem_pool::RecyclePool bufferPool(&allocator, DEFAULT_CHUNK_SIZE * 1024 * 1024);
+    PostingWriterResource postingWriterResource(&context->simplePool, &byteSlicePool, &bufferPool,
+                                                _indexFormatOption.GetPostingFormatOption());
+
+    SegmentTermInfoQueue termInfoQueue(_indexConfig, context->onDiskIndexIterCreator);
+    termInfoQueue.SetKeyRange(context->beginKey, context->endKey);
+    auto status = termInfoQueue.Init(segMergeInfos.srcSegments, _patchInfos);
+    RETURN_IF_STATUS_ERROR(status, "init term info queue for index [%s] failed", _indexName.c_str());
+
+    DictKeyInfo key;
+    while (!termInfoQueue.Empty()) {
+        SegmentTermInfo::TermIndexMode termMode;
+        const auto& segTermInfos = termInfoQueue.CurrentTermInfos(key, termMode);
+        // iterators not created by on disk iterator creator (e.g. default value) ignore key range
+        if (context->endKey && !(key < context->endKey.value())) {
+            break;
+        }
+        // no high frequency vocabulary in term range merge, bitmap postings are dropped as MergeTerm does
+        if (termMode != SegmentTermInfo::TM_BITMAP && (!context->beginKey || !(key < context->beginKey.value()))) {
+            PostingMergerImpl postingMerger(&postingWriterResource, segMergeInfos.targetSegments);
+            postingMerger.Merge(segTermInfos, docMapper);
+            if (postingMerger.GetDocFreq() > 0) {
+                postingMerger.Dump(key, context->outputResources);
+            }
+            ++context->termCount;
+        }
+        byteSlicePool.reset();
+        bufferPool.reset();
+        termInfoQueue.MoveToNextTerm();
+    }
+    for (auto& outputResource : context->outputResources) {
+        outputResource->Reset();
+    }
+    context->timeUsed = autil::TimeUtility::currentTime() - beginTime;
+    return Status::OK();
+}
+
+Status InvertedIndexMerger::AppendTermRangeChunk(const std::shared_ptr<file_system::Directory>& chunkDir,
+                                                 const std::shared_ptr<IndexDataWriter>& dataWriter) const
+{
+    int64_t baseOffset = dataWriter->postingWriter->GetLogicLength();
+    std::unique_ptr<DictionaryReader> dictReader(DictionaryCreator::CreateDiskReader(_indexConfig));
+    auto status = dictReader->Open(chunkDir, DICTIONARY_FILE_NAME, true);
+    RETURN_IF_STATUS_ERROR(status, "open dictionary in [%s] failed", chunkDir->DebugString().c_str());
+    std::shared_ptr<DictionaryIterator> dictIter = dictReader->CreateIterator();
+    DictKeyInfo key;
+    dictvalue_t value;
+    while (dictIter->HasNext()) {
+        dictIter->Next(key, value);
+        int64_t offset = 0;
+        if (ShortListOptimizeUtil::GetOffset(value, offset)) {
+            value = ShortListOptimizeUtil::CreateDictValue(ShortListOptimizeUtil::GetCompressMode(value),
+                                                           baseOffset + offset);
+        }
+        dataWriter->dictWriter->AddItem(key, value);
+    }
+
+    file_system::ReaderOption option(file_system::FSOT_BUFFERED);
+    option.supportCompress = true;
+    auto postingReader = chunkDir->CreateFileReader(POSTING_FILE_NAME, option);
+    size_t postingLength = postingReader->GetLogicLength();
+    std::vector<char> buffer(std::min(postingLength, TERM_RANGE_COPY_BUFFER_SIZE));
+    size_t cursor = 0;
+    while (cursor < postingLength) {
+        size_t readLen =
+            postingReader->Read(buffer.data(), std::min(buffer.size(), postingLength - cursor), cursor).GetOrThrow();
+        if (readLen == 0) {
+            AUTIL_LOG(ERROR, "read posting in [%s] failed at [%lu]", chunkDir->DebugString().c_str(), cursor);
+            return Status::Corruption("read term range posting failed");
+        }
+        dataWriter->postingWriter->Write(buffer.data(), readLen).GetOrThrow();
+        cursor += readLen;
+    }
+    postingReader->Close().GetOrThrow();
+    return Status::OK();
+}
+
+void InvertedIndexMerger::UpdateMergeStatistics(size_t termCount, size_t rangeCount, int64_t beginTime)
+{
+    size_t postingBytes = 0;
+    for (const auto& indexOutputSegmentResource : _indexOutputSegmentResources) {
+        for (auto mode : {SegmentTermInfo::TM_NORMAL, SegmentTermInfo::TM_BITMAP}) {
+            const auto& dataWriter = indexOutputSegmentResource->GetIndexDataWriter(mode);
+            if (dataWriter && dataWriter->postingWriter) {
+                postingBytes += dataWriter->postingWriter->GetLogicLength();
+            }
+        }
+    }
+    _mergeStatistics.itemCount = termCount;
+    _mergeStatistics.bytesWritten = postingBytes;
+    _mergeStatistics.timeUsedInUs = std::max(autil::TimeUtility::currentTime() - beginTime, (int64_t)1);
+    double timeUsed = _mergeStatistics.timeUsedInUs / 1000000.0;
+    AUTIL_LOG(INFO,
+              "merge index [%s] in [%lu] term ranges, term count [%lu], posting bytes [%lu], time used [%.3f]s, "
+              "throughput [%.1f] terms/s [%.2f] MB/s",
+              _indexName.c_str(), rangeCount, termCount, postingBytes, timeUsed, termCount / timeUsed,
+              postingBytes / timeUsed / 1024 / 1024);
+}
+
 Status InvertedIndexMerger::MergeTerm(DictKeyInfo key, const SegmentTermInfos& segTermInfos,
                                       SegmentTermInfo::TermIndexMode mode, const std::shared_ptr<DocMapper>& docMapper,
                                       const std::vector<std::shared_ptr<SegmentMeta>>& targetSegments)
@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "autil/Log.h"
 #include "autil/mem_pool/ChunkAllocatorBase.h"
@@ -68,6 +69,8 @@ class OnDiskIndexIteratorCreator;
 class PostingMerger;
 class MultiAdaptiveBitmapIndexWriter;
 struct PostingWriterResource;
+struct IndexDataWriter;
+struct TermRangeMergeContext;
 
 class InvertedIndexMerger : public indexlibv2::index::IIndexMerger
 {
@@ -81,10 +84,13 @@ public:
     Status Merge(const SegmentMergeInfos& segMergeInfos,
                  const std::shared_ptr<indexlibv2::framework::IndexTaskResourceManager>& taskResourceManager) override;
     virtual std::string GetIdentifier() const = 0;
+    MergeStatistics GetMergeStatistics() const override { return _mergeStatistics; }
     void SetPatchInfos(const indexlibv2::index::PatchInfos& patchInfos);
 
 protected:
     virtual std::shared_ptr<OnDiskIndexIteratorCreator> CreateOnDiskIndexIteratorCreator() = 0;
+    // true if on disk iterators of this index honor OnDiskIndexIterator::SetKeyRange
+    virtual bool SupportTermRangeMerge() const { return false; }
     virtual PostingMerger*
     CreatePostingMerger(const std::vector<std::shared_ptr<indexlibv2::framework::SegmentMeta>>& targetSegments);
     virtual PostingMerger*
@@ -139,6 +145,20 @@ private:
         const std::shared_ptr<indexlibv2::framework::IndexTaskResourceManager>& taskResourceManager);
     Status InitWithoutParam(const std::shared_ptr<indexlibv2::config::IIndexConfig>& indexConfig);
 
+    // split dictionary key space into ranges merged concurrently, see INDEXLIB_PARALLEL_TERM_MERGE_THREAD_COUNT
+    size_t GetTermRangeCount() const;
+    std::pair<Status, std::vector<DictKeyInfo>> SampleTermRangeBoundaries(const std::vector<SourceSegment>& srcSegments,
+                                                                          size_t rangeCount) const;
+    Status MergeTermRanges(const SegmentMergeInfos& segMergeInfos,
+                           const std::shared_ptr<indexlibv2::index::DocMapper>& docMapper,
+                           const std::vector<DictKeyInfo>& rangeBoundaries, size_t& termCount);
+    Status MergeTermRange(const SegmentMergeInfos& segMergeInfos,
+                          const std::shared_ptr<indexlibv2::index::DocMapper>& docMapper,
+                          TermRangeMergeContext* context) const;
+    Status AppendTermRangeChunk(const std::shared_ptr<file_system::Directory>& chunkDir,
+                                const std::shared_ptr<IndexDataWriter>& dataWriter) const;
+    void UpdateMergeStatistics(size_t termCount, size_t rangeCount, int64_t beginTime);
+
 private:
     std::unique_ptr<PostingFormat> _postingFormat;
     std::unique_ptr<autil::mem_pool::ChunkAllocatorBase> _allocator;
@@ -154,6 +174,7 @@ private:
     indexlibv2::index::PatchInfos _patchInfos;
 
     bool _isOptimizeMerge = false;
+    MergeStatistics _mergeStatistics;
 
     std::map<std::string, std::any> _params;
     std::map<std::string, std::shared_ptr<BucketMap>> _bucketMaps;
@@ -15,6 +15,7 @@
  */
 #pragma once
 #include <memory>
+#include <optional>
 
 #include "fslib/common/common_type.h"
 #include "indexlib/file_system/fslib/IoConfig.h"
@@ -41,10 +42,19 @@ public:
     virtual void Init() = 0;
     virtual size_t GetPostingFileLength() const = 0;
 
+    // call before Init, iterator may skip terms out of [beginKey, endKey)
+    void SetKeyRange(const std::optional<index::DictKeyInfo>& beginKey, const std::optional<index::DictKeyInfo>& endKey)
+    {
+        _beginKey = beginKey;
+        _endKey = endKey;
+    }
+
 protected:
     file_system::DirectoryPtr _indexDirectory;
     PostingFormatOption _postingFormatOption;
     file_system::IOConfig _ioConfig;
+    std::optional<index::DictKeyInfo> _beginKey;
+    std::optional<index::DictKeyInfo> _endKey;
 };
 
 } // namespace indexlib::index
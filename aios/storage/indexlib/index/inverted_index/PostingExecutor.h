@@ -37,6 +37,19 @@ public:
         return _current;
     }
 
+    // seek to first doc >= id, and fill docIds with it and following docs (at most capacity) in ascending order.
+    // return doc count, 0 means no more doc. executor is positioned at docIds[0] after call.
+    // default only returns seeked doc, executors which decode postings by block return the whole block
+    virtual uint32_t SeekBlock(docid_t id, docid_t* docIds, uint32_t capacity)
+    {
+        docid_t docId = Seek(id);
+        if (docId == END_DOCID || docId == INVALID_DOCID) {
+            return 0;
+        }
+        docIds[0] = docId;
+        return 1;
+    }
+
     bool Test(docid_t id)
     {
         if (id < 0 || id == END_DOCID) {
@@ -184,10 +184,12 @@ RangeSegmentPostingsIterator::CreateNormalSegmentDecoder(file_system::ByteSliceR
 
     if (curSegPostingFormatOption.HasTfList()) {
         return IE_POOL_COMPATIBLE_NEW_CLASS(_sessionPool, SkipListSegmentDecoder<TriValueSkipListReader>, _sessionPool,
-                                            docListReader, docListBeginPos, compressMode);
+                                            docListReader, docListBeginPos, compressMode,
+                                            curSegPostingFormatOption.IsStreamVbyteCompress());
     } else {
         return IE_POOL_COMPATIBLE_NEW_CLASS(_sessionPool, SkipListSegmentDecoder<PairValueSkipListReader>, _sessionPool,
-                                            docListReader, docListBeginPos, compressMode);
+                                            docListReader, docListBeginPos, compressMode,
+                                            curSegPostingFormatOption.IsStreamVbyteCompress());
     }
 }
 } // namespace indexlib::index
@@ -194,6 +194,7 @@ SegmentTermInfoQueue::CreateOnDiskNormalIterator(const std::shared_ptr<file_syst
     std::shared_ptr<IndexIterator> indexIt;
     if (onDiskIndexIter) {
         indexIt.reset(onDiskIndexIter);
+        onDiskIndexIter->SetKeyRange(_beginKey, _endKey);
         onDiskIndexIter->Init();
     }
     return indexIt;
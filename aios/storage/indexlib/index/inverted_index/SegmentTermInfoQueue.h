@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "autil/Log.h"
 #include "indexlib/index/IIndexMerger.h"
@@ -37,6 +38,13 @@ public:
                          const std::shared_ptr<OnDiskIndexIteratorCreator>& onDiskIndexIterCreator);
     virtual ~SegmentTermInfoQueue();
 
+    // call before Init, on disk iterators skip terms out of [beginKey, endKey)
+    void SetKeyRange(const std::optional<index::DictKeyInfo>& beginKey, const std::optional<index::DictKeyInfo>& endKey)
+    {
+        _beginKey = beginKey;
+        _endKey = endKey;
+    }
+
     Status Init(const std::vector<indexlibv2::index::IIndexMerger::SourceSegment>& srcSegments,
                 const indexlibv2::index::PatchInfos& patchInfos);
     Status Init(const std::shared_ptr<file_system::Directory>& indexDir,
@@ -84,6 +92,8 @@ private:
     std::map<segmentid_t, indexlibv2::index::PatchFileInfos> _patchInfos;
     std::shared_ptr<indexlibv2::config::InvertedIndexConfig> _indexConfig;
     std::shared_ptr<OnDiskIndexIteratorCreator> _onDiskIndexIterCreator;
+    std::optional<index::DictKeyInfo> _beginKey;
+    std::optional<index::DictKeyInfo> _endKey;
 
     AUTIL_LOG_DECLARE();
 };
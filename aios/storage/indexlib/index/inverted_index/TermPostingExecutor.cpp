@@ -15,6 +15,7 @@
  */
 #include "indexlib/index/inverted_index/TermPostingExecutor.h"
 
+#include "indexlib/index/inverted_index/BufferedPostingIterator.h"
 #include "indexlib/index/inverted_index/PostingIterator.h"
 #include "indexlib/index/inverted_index/format/TermMeta.h"
 
@@ -23,7 +24,11 @@ AUTIL_LOG_SETUP(indexlib.index, TermPostingExecutor);
 
 TermPostingExecutor::TermPostingExecutor(const std::shared_ptr<PostingIterator>& postingIterator)
     : _iter(postingIterator)
+    , _bufferedIter(nullptr)
 {
+    if (_iter && _iter->GetType() == pi_buffered) {
+        _bufferedIter = static_cast<BufferedPostingIterator*>(_iter.get());
+    }
 }
 
 TermPostingExecutor::~TermPostingExecutor() {}
@@ -36,4 +41,15 @@ docid_t TermPostingExecutor::DoSeek(docid_t id)
     return (docId == INVALID_DOCID) ? END_DOCID : docId;
 }
 
+uint32_t TermPostingExecutor::SeekBlock(docid_t id, docid_t* docIds, uint32_t capacity)
+{
+    if (!_bufferedIter) {
+        return PostingExecutor::SeekBlock(id, docIds, capacity);
+    }
+    uint32_t count = 0;
+    index::ThrowIfError(_bufferedIter->SeekDocBlock(std::max(id, _current), docIds, capacity, count));
+    _current = (count == 0) ? END_DOCID : docIds[0];
+    return count;
+}
+
 } // namespace indexlib::index
@@ -22,6 +22,7 @@
 
 namespace indexlib::index {
 class PostingIterator;
+class BufferedPostingIterator;
 class TermPostingExecutor : public PostingExecutor
 {
 public:
@@ -30,9 +31,11 @@ public:
 
     df_t GetDF() const override;
     docid_t DoSeek(docid_t id) override;
+    uint32_t SeekBlock(docid_t id, docid_t* docIds, uint32_t capacity) override;
 
 private:
     std::shared_ptr<PostingIterator> _iter;
+    BufferedPostingIterator* _bufferedIter;
 
     AUTIL_LOG_DECLARE();
 };
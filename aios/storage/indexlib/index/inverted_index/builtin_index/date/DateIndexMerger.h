@@ -28,6 +28,8 @@ public:
     std::string GetIdentifier() const override;
 
 protected:
+    // date terms are leveled range keys, keep them in one sequential walk
+    bool SupportTermRangeMerge() const override { return false; }
     Status
     DoMerge(const SegmentMergeInfos& segMergeInfos,
             const std::shared_ptr<indexlibv2::framework::IndexTaskResourceManager>& taskResourceManager) override;
@@ -57,6 +57,7 @@ public:
     }
 
     std::shared_ptr<OnDiskIndexIteratorCreator> CreateOnDiskIndexIteratorCreator() override;
+    bool SupportTermRangeMerge() const override { return true; }
 
 private:
     AUTIL_LOG_DECLARE();
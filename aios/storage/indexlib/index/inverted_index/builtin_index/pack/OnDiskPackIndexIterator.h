@@ -27,6 +27,7 @@
 #include "indexlib/index/inverted_index/format/ShortListOptimizeUtil.h"
 #include "indexlib/index/inverted_index/format/TermMetaLoader.h"
 #include "indexlib/index/inverted_index/format/dictionary/DictionaryCreator.h"
+#include "indexlib/index/inverted_index/format/dictionary/KeyRangeDictionaryIterator.h"
 #include "indexlib/util/Bitmap.h"
 #include "indexlib/util/PathUtil.h"
 #include "indexlib/util/Status2Exception.h"
@@ -171,6 +172,10 @@ void OnDiskPackIndexIteratorTyped<DictKey>::Init()
     auto status = dictionaryReader->Open(_indexDirectory, DICTIONARY_FILE_NAME, supportCompress);
     THROW_IF_STATUS_ERROR(status);
     _dictionaryIterator = dictionaryReader->CreateIterator();
+    if (this->_beginKey || this->_endKey) {
+        _dictionaryIterator =
+            std::make_shared<KeyRangeDictionaryIterator>(_dictionaryIterator, this->_beginKey, this->_endKey);
+    }
 
     file_system::ReaderOption option(file_system::FSOT_BUFFERED);
     option.supportCompress = supportCompress;
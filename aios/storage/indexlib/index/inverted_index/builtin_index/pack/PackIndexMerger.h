@@ -35,6 +35,7 @@ public:
         return std::shared_ptr<OnDiskIndexIteratorCreator>(new OnDiskPackIndexIteratorTyped<dictkey_t>::Creator(
             _indexFormatOption.GetPostingFormatOption(), _ioConfig, _indexConfig));
     }
+    bool SupportTermRangeMerge() const override { return true; }
 
     Status Init(const std::shared_ptr<indexlibv2::config::IIndexConfig>& indexConfig,
                 const std::map<std::string, std::any>& params) override;
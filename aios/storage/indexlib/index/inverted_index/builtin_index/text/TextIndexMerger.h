@@ -37,6 +37,7 @@ public:
         return std::shared_ptr<OnDiskIndexIteratorCreator>(
             new OnDiskTextIndexIterator::Creator(_indexFormatOption.GetPostingFormatOption(), _ioConfig, _indexConfig));
     }
+    bool SupportTermRangeMerge() const override { return true; }
 
 private:
     AUTIL_LOG_DECLARE();
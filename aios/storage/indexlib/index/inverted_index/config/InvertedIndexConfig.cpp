@@ -81,6 +81,7 @@ struct InvertedIndexConfig::Impl {
     bool isPatchCompressed = false;
     bool isVirtual = false;
     bool isShortListVbyteCompress = false;
+    bool isDocListStreamVbyteCompress = false;
     bool hasTruncate = false;
     indexlib::config::PayloadConfig payloadConfig;
 
@@ -113,6 +114,7 @@ struct InvertedIndexConfig::Impl {
         , isPatchCompressed(other.isPatchCompressed)
         , isVirtual(other.isVirtual)
         , isShortListVbyteCompress(other.isShortListVbyteCompress)
+        , isDocListStreamVbyteCompress(other.isDocListStreamVbyteCompress)
         , hasTruncate(other.hasTruncate)
     {
     }
@@ -183,6 +185,8 @@ Status InvertedIndexConfig::CheckEqual(const InvertedIndexConfig& other) const
     CHECK_CONFIG_EQUAL(_impl->formatVersionId, other._impl->formatVersionId, "_impl->formatVersionId not equal");
     CHECK_CONFIG_EQUAL(_impl->isShortListVbyteCompress, other._impl->isShortListVbyteCompress,
                        "_impl->isShortListVbyteCompress not equal");
+    CHECK_CONFIG_EQUAL(_impl->isDocListStreamVbyteCompress, other._impl->isDocListStreamVbyteCompress,
+                       "_impl->isDocListStreamVbyteCompress not equal");
 
     for (size_t i = 0; i < _impl->shardingIndexConfigs.size(); i++) {
         auto status = _impl->shardingIndexConfigs[i]->CheckEqual(*other._impl->shardingIndexConfigs[i]);
@@ -333,6 +337,12 @@ void InvertedIndexConfig::SetShortListVbyteCompress(bool isShortListVbyteCompres
     _impl->isShortListVbyteCompress = isShortListVbyteCompress;
 }
 
+bool InvertedIndexConfig::IsDocListStreamVbyteCompress() const { return _impl->isDocListStreamVbyteCompress; }
+void InvertedIndexConfig::SetDocListStreamVbyteCompress(bool isDocListStreamVbyteCompress)
+{
+    _impl->isDocListStreamVbyteCompress = isDocListStreamVbyteCompress;
+}
+
 void InvertedIndexConfig::SetIsReferenceCompress(bool isReferenceCompress)
 {
     _impl->isReferenceCompress = isReferenceCompress;
@@ -175,6 +175,9 @@ public:
 
     bool IsShortListVbyteCompress() const;
     void SetShortListVbyteCompress(bool isShortListVbyteCompress);
+    // doc list of pfor delta compress mode encoded by simd stream vbyte
+    bool IsDocListStreamVbyteCompress() const;
+    void SetDocListStreamVbyteCompress(bool isDocListStreamVbyteCompress);
 
     void SetIsReferenceCompress(bool isReferenceCompress);
     bool IsReferenceCompress() const;
@@ -277,6 +280,7 @@ protected:
     inline static const std::string HIGH_FREQUENCY_DICTIONARY_SELF_ADAPTIVE_FLAG =
         "high_frequency_dictionary_self_adaptive_flag";
     inline static const std::string HAS_SHORTLIST_VBYTE_COMPRESS = "has_shortlist_vbyte_compress";
+    inline static const std::string HAS_DOCLIST_STREAM_VBYTE_COMPRESS = "has_doclist_stream_vbyte_compress";
     inline static const std::string INDEX_COMPRESS_MODE = "compress_mode";
     inline static const std::string INDEX_COMPRESS_MODE_PFOR_DELTA = "pfordelta";
     inline static const std::string INDEX_COMPRESS_MODE_REFERENCE = "reference";
@@ -457,6 +457,9 @@ void InvertedIndexConfigSerializer::JsonizeShortListVbyteCompress(
     assert(json->GetMode() == autil::legacy::Jsonizable::TO_JSON);
     json->Jsonize(indexlibv2::config::InvertedIndexConfig::HAS_SHORTLIST_VBYTE_COMPRESS,
                   indexConfig.IsShortListVbyteCompress());
+    if (indexConfig.IsDocListStreamVbyteCompress()) {
+        json->Jsonize(indexlibv2::config::InvertedIndexConfig::HAS_DOCLIST_STREAM_VBYTE_COMPRESS, true);
+    }
 }
 
 void InvertedIndexConfigSerializer::JsonizeShortListVbyteCompress(autil::legacy::Jsonizable::JsonWrapper& json,
@@ -473,6 +476,11 @@ void InvertedIndexConfigSerializer::JsonizeShortListVbyteCompress(autil::legacy:
     bool compress = false;
     json.Jsonize(indexlibv2::config::InvertedIndexConfig::HAS_SHORTLIST_VBYTE_COMPRESS, compress, defaultValue);
     indexConfig->SetShortListVbyteCompress(compress);
+
+    bool streamVbyteCompress = false;
+    json.Jsonize(indexlibv2::config::InvertedIndexConfig::HAS_DOCLIST_STREAM_VBYTE_COMPRESS, streamVbyteCompress,
+                 streamVbyteCompress);
+    indexConfig->SetDocListStreamVbyteCompress(streamVbyteCompress);
 }
 
 } // namespace indexlib::index
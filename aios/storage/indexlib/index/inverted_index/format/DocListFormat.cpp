@@ -32,7 +32,8 @@ void DocListFormat::Init(const DocListFormatOption& option)
     _##atomic_value_type##Value->SetLocation(rowCount++);                                                              \
     _##atomic_value_type##Value->SetOffset(offset);                                                                    \
     for (size_t i = 0; i < COMPRESS_MODE_SIZE; ++i) {                                                                  \
-        EncoderProvider::EncoderParam param(i, option.IsShortListVbyteCompress(), enableP4DeltaBlockOpt);              \
+        EncoderProvider::EncoderParam param(i, option.IsShortListVbyteCompress(), enableP4DeltaBlockOpt,               \
+                                            option.IsStreamVbyteCompress());                                           \
         _##atomic_value_type##Value->SetEncoder(i, EncoderProvider::GetInstance()->encoder_func(param));               \
     }                                                                                                                  \
     AddAtomicValue(_##atomic_value_type##Value);                                                                       \
@@ -23,7 +23,8 @@ bool DocListFormatOption::operator==(const DocListFormatOption& right) const
 {
     return _hasTf == right._hasTf && _hasTfList == right._hasTfList && _hasTfBitmap == right._hasTfBitmap &&
            _hasDocPayload == right._hasDocPayload && _hasFieldMap == right._hasFieldMap &&
-           _shortListVbyteCompress == right._shortListVbyteCompress;
+           _shortListVbyteCompress == right._shortListVbyteCompress &&
+           _streamVbyteCompress == right._streamVbyteCompress;
 }
 
 void JsonizableDocListFormatOption::Jsonize(autil::legacy::Jsonizable::JsonWrapper& json)
@@ -34,6 +35,7 @@ void JsonizableDocListFormatOption::Jsonize(autil::legacy::Jsonizable::JsonWrapp
     bool hasDocPayload;
     bool hasFieldMap;
     bool shortListVbyteCompress = false;
+    bool streamVbyteCompress = false;
 
     if (json.GetMode() == FROM_JSON) {
         json.Jsonize("has_term_frequency", hasTf);
@@ -42,6 +44,7 @@ void JsonizableDocListFormatOption::Jsonize(autil::legacy::Jsonizable::JsonWrapp
         json.Jsonize("has_doc_payload", hasDocPayload);
         json.Jsonize("has_field_map", hasFieldMap);
         json.Jsonize("is_shortlist_vbyte_compress", shortListVbyteCompress, shortListVbyteCompress);
+        json.Jsonize("is_stream_vbyte_compress", streamVbyteCompress, streamVbyteCompress);
 
         _docListFormatOption._hasTf = hasTf ? 1 : 0;
         _docListFormatOption._hasTfList = hasTfList ? 1 : 0;
@@ -49,6 +52,7 @@ void JsonizableDocListFormatOption::Jsonize(autil::legacy::Jsonizable::JsonWrapp
         _docListFormatOption._hasDocPayload = hasDocPayload ? 1 : 0;
         _docListFormatOption._hasFieldMap = hasFieldMap ? 1 : 0;
         _docListFormatOption.SetShortListVbyteCompress(shortListVbyteCompress);
+        _docListFormatOption.SetStreamVbyteCompress(streamVbyteCompress);
     } else {
         hasTf = _docListFormatOption._hasTf == 1;
         hasTfList = _docListFormatOption._hasTfList == 1;
@@ -56,6 +60,7 @@ void JsonizableDocListFormatOption::Jsonize(autil::legacy::Jsonizable::JsonWrapp
         hasDocPayload = _docListFormatOption._hasDocPayload == 1;
         hasFieldMap = _docListFormatOption._hasFieldMap == 1;
         shortListVbyteCompress = _docListFormatOption.IsShortListVbyteCompress();
+        streamVbyteCompress = _docListFormatOption.IsStreamVbyteCompress();
 
         json.Jsonize("has_term_frequency", hasTf);
         json.Jsonize("has_term_frequency_list", hasTfList);
@@ -63,6 +68,9 @@ void JsonizableDocListFormatOption::Jsonize(autil::legacy::Jsonizable::JsonWrapp
         json.Jsonize("has_doc_payload", hasDocPayload);
         json.Jsonize("has_field_map", hasFieldMap);
         json.Jsonize("is_shortlist_vbyte_compress", shortListVbyteCompress);
+        if (streamVbyteCompress) {
+            json.Jsonize("is_stream_vbyte_compress", streamVbyteCompress);
+        }
     }
 }
 
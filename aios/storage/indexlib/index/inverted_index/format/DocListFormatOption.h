@@ -49,6 +49,7 @@ public:
             _hasTfBitmap = 0;
         }
         _shortListVbyteCompress = 0;
+        _streamVbyteCompress = 0;
         _unused = 0;
     }
 
@@ -60,6 +61,8 @@ public:
     bool operator==(const DocListFormatOption& right) const;
     bool IsShortListVbyteCompress() const { return _shortListVbyteCompress == 1; }
     void SetShortListVbyteCompress(bool flag) { _shortListVbyteCompress = flag ? 1 : 0; }
+    bool IsStreamVbyteCompress() const { return _streamVbyteCompress == 1; }
+    void SetStreamVbyteCompress(bool flag) { _streamVbyteCompress = flag ? 1 : 0; }
 
 private:
     uint8_t _hasTf                  : 1;
@@ -68,7 +71,8 @@ private:
     uint8_t _hasDocPayload          : 1;
     uint8_t _hasFieldMap            : 1;
     uint8_t _shortListVbyteCompress : 1;
-    uint8_t _unused                 : 2;
+    uint8_t _streamVbyteCompress    : 1;
+    uint8_t _unused                 : 1;
 
     friend class DocListEncoderTest;
     friend class DocListMemoryBufferTest;
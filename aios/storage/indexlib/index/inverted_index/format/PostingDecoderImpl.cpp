@@ -205,7 +205,8 @@ void PostingDecoderImpl::InitDocListEncoder(const DocListFormatOption& docListFo
     uint8_t docCompressMode =
         ShortListOptimizeUtil::GetDocListCompressMode(df, _postingFormatOption.GetDocListCompressMode());
 
-    EncoderProvider::EncoderParam param(docCompressMode, docListFormatOption.IsShortListVbyteCompress(), true);
+    EncoderProvider::EncoderParam param(docCompressMode, docListFormatOption.IsShortListVbyteCompress(), true,
+                                        docListFormatOption.IsStreamVbyteCompress());
     _docIdEncoder = EncoderProvider::GetInstance()->GetDocListEncoder(param);
     if (docListFormatOption.HasTfList()) {
         _tfListEncoder = EncoderProvider::GetInstance()->GetTfListEncoder(param);
@@ -48,6 +48,7 @@ public:
                                                                      : indexlib::index::PFOR_DELTA_COMPRESS_MODE;
         _formatVersion = indexConfigPtr->GetIndexFormatVersionId();
         _docListFormatOption.SetShortListVbyteCompress(indexConfigPtr->IsShortListVbyteCompress());
+        _docListFormatOption.SetStreamVbyteCompress(indexConfigPtr->IsDocListStreamVbyteCompress());
     }
 
     bool HasTfBitmap() const { return _docListFormatOption.HasTfBitmap(); }
@@ -59,9 +60,11 @@ public:
     bool HasTermFrequency() const { return _docListFormatOption.HasTermFrequency(); }
     bool HasTermPayload() const { return _hasTermPayload; }
     bool IsShortListVbyteCompress() const { return _docListFormatOption.IsShortListVbyteCompress(); }
+    bool IsStreamVbyteCompress() const { return _docListFormatOption.IsStreamVbyteCompress(); }
     format_versionid_t GetFormatVersion() const { return _formatVersion; }
     void SetFormatVersion(format_versionid_t id) { _formatVersion = id; }
     void SetShortListVbyteCompress(bool flag) { _docListFormatOption.SetShortListVbyteCompress(flag); }
+    void SetStreamVbyteCompress(bool flag) { _docListFormatOption.SetStreamVbyteCompress(flag); }
 
     const DocListFormatOption& GetDocListFormatOption() const { return _docListFormatOption; }
 
@@ -28,7 +28,7 @@ class SkipListSegmentDecoder : public BufferedSegmentIndexDecoder
 {
 public:
     SkipListSegmentDecoder(autil::mem_pool::Pool* sessionPool, file_system::ByteSliceReader* docListReader,
-                           uint32_t docListBegin, uint8_t docCompressMode);
+                           uint32_t docListBegin, uint8_t docCompressMode, bool enableStreamVbyteCompress = false);
     ~SkipListSegmentDecoder();
 
 protected:
@@ -64,14 +64,15 @@ private:
 template <class SkipListType>
 SkipListSegmentDecoder<SkipListType>::SkipListSegmentDecoder(autil::mem_pool::Pool* sessionPool,
                                                              file_system::ByteSliceReader* docListReader,
-                                                             uint32_t docListBegin, uint8_t docCompressMode)
+                                                             uint32_t docListBegin, uint8_t docCompressMode,
+                                                             bool enableStreamVbyteCompress)
     : _skipListReader(nullptr)
     , _sessionPool(sessionPool)
     , _docListReader(docListReader)
     , _docListBeginPos(docListBegin)
 {
     assert(docCompressMode != SHORT_LIST_COMPRESS_MODE);
-    EncoderProvider::EncoderParam param(docCompressMode, false, true);
+    EncoderProvider::EncoderParam param(docCompressMode, false, true, enableStreamVbyteCompress);
     _docEncoder = EncoderProvider::GetInstance()->GetDocListEncoder(param);
     _tfEncoder = EncoderProvider::GetInstance()->GetTfListEncoder(param);
     _docPayloadEncoder = EncoderProvider::GetInstance()->GetDocPayloadEncoder(param);
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/inverted_index/format/dictionary/KeyRangeDictionaryIterator.h"
+
+namespace indexlib::index {
+AUTIL_LOG_SETUP(indexlib.index, KeyRangeDictionaryIterator);
+
+KeyRangeDictionaryIterator::KeyRangeDictionaryIterator(const std::shared_ptr<DictionaryIterator>& iterator,
+                                                       const std::optional<index::DictKeyInfo>& beginKey,
+                                                       const std::optional<index::DictKeyInfo>& endKey)
+    : _iterator(iterator)
+    , _endKey(endKey)
+{
+    assert(_iterator);
+    MoveToNext();
+    if (!beginKey) {
+        return;
+    }
+    while (_hasCurrent && _currentKey < beginKey.value()) {
+        MoveToNext();
+    }
+}
+
+void KeyRangeDictionaryIterator::Next(index::DictKeyInfo& key, dictvalue_t& value)
+{
+    assert(_hasCurrent);
+    key = _currentKey;
+    value = _currentValue;
+    MoveToNext();
+}
+
+void KeyRangeDictionaryIterator::MoveToNext()
+{
+    _hasCurrent = false;
+    if (!_iterator->HasNext()) {
+        return;
+    }
+    _iterator->Next(_currentKey, _currentValue);
+    _hasCurrent = !_endKey || _currentKey < _endKey.value();
+}
+
+} // namespace indexlib::index
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "autil/Log.h"
+#include "indexlib/index/inverted_index/format/dictionary/DictionaryIterator.h"
+
+namespace indexlib::index {
+
+// only output terms in [beginKey, endKey) of inner iterator, null term is larger than any other key
+class KeyRangeDictionaryIterator : public DictionaryIterator
+{
+public:
+    KeyRangeDictionaryIterator(const std::shared_ptr<DictionaryIterator>& iterator,
+                               const std::optional<index::DictKeyInfo>& beginKey,
+                               const std::optional<index::DictKeyInfo>& endKey);
+    ~KeyRangeDictionaryIterator() = default;
+
+    bool HasNext() const override { return _hasCurrent; }
+    void Next(index::DictKeyInfo& key, dictvalue_t& value) override;
+
+private:
+    void MoveToNext();
+
+private:
+    std::shared_ptr<DictionaryIterator> _iterator;
+    std::optional<index::DictKeyInfo> _endKey;
+    index::DictKeyInfo _currentKey;
+    dictvalue_t _currentValue = 0;
+    bool _hasCurrent = false;
+
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlib::index
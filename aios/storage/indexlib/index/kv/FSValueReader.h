@@ -36,6 +36,11 @@ public:
     inline FL_LAZY(bool) Read(indexlib::file_system::FileReader* reader, autil::StringView& value, offset_t offset,
                               autil::mem_pool::Pool* pool, KVMetricsCollector* collector,
                               autil::TimeoutTerminator* timeoutTerminator) const __attribute__((always_inline));
+    // read values at offsets with two batch io (count header, value), adjacent reads are
+    // coalesced by file reader, succ[i] is false if values[i] failed to read
+    inline FL_LAZY(void) BatchRead(indexlib::file_system::FileReader* reader, const offset_t* offsets, size_t count,
+                                   autil::StringView* values, bool* succ, autil::mem_pool::Pool* pool,
+                                   KVMetricsCollector* collector, autil::TimeoutTerminator* timeoutTerminator) const;
 
 public:
     void SetFixedValueLen(int32_t fixedValueLen);
@@ -100,4 +105,87 @@ FSValueReader::Read(indexlib::file_system::FileReader* reader, autil::StringView
     FL_CORETURN true;
 }
 
+FL_LAZY(void)
+FSValueReader::BatchRead(indexlib::file_system::FileReader* reader, const offset_t* offsets, size_t count,
+                         autil::StringView* values, bool* succ, autil::mem_pool::Pool* pool,
+                         KVMetricsCollector* collector, autil::TimeoutTerminator* timeoutTerminator) const
+{
+    static constexpr size_t MAX_ENCODE_COUNT_LEN = 4;
+
+    indexlib::file_system::ReadOption option;
+    option.blockCounter = collector ? collector->GetBlockCounter() : nullptr;
+    option.advice = indexlib::file_system::IO_ADVICE_LOW_LATENCY;
+    option.timeoutTerminator = timeoutTerminator;
+
+    std::vector<size_t> valueOffsets(count);
+    std::vector<size_t> itemLens(count, _fixedValueLen);
+    indexlib::file_system::BatchIO batchIO;
+    batchIO.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        succ[i] = true;
+        valueOffsets[i] = offsets[i];
+    }
+    if (!IsFixedLen()) {
+        size_t fileLength = reader->GetLogicLength();
+        char* lenBuffer = (char*)pool->allocate(count * MAX_ENCODE_COUNT_LEN);
+        for (size_t i = 0; i < count; ++i) {
+            if (offsets[i] >= fileLength) {
+                AUTIL_LOG(ERROR, "value offset [%lu] out of file[%s]", offsets[i], reader->DebugString().c_str());
+                succ[i] = false;
+                continue;
+            }
+            size_t len = std::min(MAX_ENCODE_COUNT_LEN, fileLength - offsets[i]);
+            batchIO.emplace_back(lenBuffer + i * MAX_ENCODE_COUNT_LEN, len, offsets[i]);
+        }
+        auto lenResult = FL_COAWAIT reader->BatchRead(batchIO, option);
+        size_t ioIdx = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!succ[i]) {
+                continue;
+            }
+            auto& ret = lenResult[ioIdx];
+            const char* buffer = (const char*)batchIO[ioIdx].buffer;
+            ++ioIdx;
+            size_t encodeCountLen =
+                ret.OK() ? MultiValueAttributeFormatter::GetEncodedCountFromFirstByte(buffer[0]) : 0;
+            if (!ret.OK() || encodeCountLen > ret.Value()) {
+                AUTIL_LOG(ERROR, "read encodeCount from file[%s]", reader->DebugString().c_str());
+                succ[i] = false;
+                continue;
+            }
+            bool isNull = false;
+            itemLens[i] = MultiValueAttributeFormatter::DecodeCount(buffer, encodeCountLen, isNull);
+            assert(!isNull);
+            valueOffsets[i] += encodeCountLen;
+        }
+        batchIO.clear();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (succ[i]) {
+            batchIO.emplace_back(pool->allocate(itemLens[i]), itemLens[i], valueOffsets[i]);
+        }
+    }
+    auto dataResult = FL_COAWAIT reader->BatchRead(batchIO, option);
+    size_t ioIdx = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!succ[i]) {
+            continue;
+        }
+        auto& ret = dataResult[ioIdx];
+        const auto& singleIO = batchIO[ioIdx];
+        ++ioIdx;
+        if (!ret.OK() || singleIO.len != ret.Value()) {
+            AUTIL_LOG(ERROR, "read value from file[%s]", reader->DebugString().c_str());
+            succ[i] = false;
+            continue;
+        }
+        values[i] = {(const char*)singleIO.buffer, singleIO.len};
+        if (_plainFormatEncoder && !_plainFormatEncoder->Decode(values[i], pool, values[i])) {
+            AUTIL_LOG(ERROR, "decode plain format from file[%s] fail.", reader->DebugString().c_str());
+            succ[i] = false;
+        }
+    }
+}
+
 } // namespace indexlibv2::index
@@ -27,6 +27,7 @@
 #include "indexlib/index/kv/FixedLenCuckooHashTableFileReaderCreator.h"
 #include "indexlib/index/kv/FixedLenDenseHashTableCreator.h"
 #include "indexlib/index/kv/FixedLenDenseHashTableFileReaderCreator.h"
+#include "indexlib/index/kv/FixedLenSwissHashTableCreator.h"
 #include "indexlib/index/kv/KVTypeId.h"
 
 namespace indexlibv2::index {
@@ -39,7 +40,9 @@ HashTableInfoPtr FixedLenHashTableCreator::CreateHashTableForReader(const KVType
 {
     assert(!typeId.isVarLen);
     if (useFileReader) {
-        if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH) {
+        // swiss hash table dumps the same file format as dense hash table
+        if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH ||
+            typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
             return InnerCreate(DENSE_READER, typeId);
         } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
             return InnerCreate(CUCKOO_READER, typeId);
@@ -51,6 +54,8 @@ HashTableInfoPtr FixedLenHashTableCreator::CreateHashTableForReader(const KVType
             return InnerCreate(DENSE_TABLE, typeId);
         } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
             return InnerCreate(CUCKOO_TABLE, typeId);
+        } else if (typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
+            return InnerCreate(SWISS_TABLE, typeId);
         } else {
             return nullptr;
         }
@@ -64,6 +69,8 @@ HashTableInfoPtr FixedLenHashTableCreator::CreateHashTableForWriter(const KVType
         return InnerCreate(DENSE_TABLE, typeId);
     } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
         return InnerCreate(CUCKOO_TABLE, typeId);
+    } else if (typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
+        return InnerCreate(SWISS_TABLE, typeId);
     } else {
         return nullptr;
     }
@@ -72,7 +79,8 @@ HashTableInfoPtr FixedLenHashTableCreator::CreateHashTableForWriter(const KVType
 HashTableInfoPtr FixedLenHashTableCreator::CreateHashTableForMerger(const KVTypeId& typeId)
 {
     assert(!typeId.isVarLen);
-    if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH) {
+    if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH ||
+        typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
         return InnerCreate(DENSE_READER, typeId);
     } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
         return InnerCreate(CUCKOO_READER, typeId);
@@ -159,6 +167,11 @@ HashTableInfoPtr FixedLenHashTableCreator::CreateWithKeyTypeValueTypeWithCompact
                                                      useCompactBucket>::CreateHashTableFileIterator();
         break;
     }
+    case SWISS_TABLE: {
+        hashTableInfo->hashTable =
+            FixedLenSwissHashTableCreator<KeyType, ValueType, useCompactBucket>::CreateHashTable();
+        break;
+    }
     default:
         return nullptr;
     }
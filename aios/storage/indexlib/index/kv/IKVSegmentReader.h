@@ -16,8 +16,10 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "autil/StringView.h"
+#include "autil/mem_pool/pool_allocator.h"
 #include "future_lite/CoroInterface.h"
 #include "indexlib/index/kv/KVCommonDefine.h"
 #include "indexlib/index/kv/KVMetricsCollector.h"
@@ -44,8 +46,59 @@ public:
     virtual FL_LAZY(indexlib::util::Status)
         Get(keytype_t key, autil::StringView& value, uint64_t& ts, autil::mem_pool::Pool* pool,
             KVMetricsCollector* collector, autil::TimeoutTerminator* timeoutTerminator) const = 0;
+    // batch form of Get, keys are ascending and unique, all output arrays have count elements.
+    // probes that may wait for io run concurrently, at most maxConcurrency (0 for all) at a time
+    virtual FL_LAZY(void)
+        BatchGet(const keytype_t* keys, size_t count, indexlib::util::Status* statuses, autil::StringView* values,
+                 uint64_t* tss, autil::mem_pool::Pool* pool, KVMetricsCollector* collector,
+                 autil::TimeoutTerminator* timeoutTerminator, size_t maxConcurrency, bool yield) const
+    {
+        FL_COAWAIT WindowedProbe(
+            count,
+            [&](size_t i, KVMetricsCollector* keyCollector) {
+                return Get(keys[i], values[i], tss[i], pool, keyCollector, timeoutTerminator);
+            },
+            statuses, pool, collector, maxConcurrency, yield);
+    }
     virtual std::unique_ptr<IKVIterator> CreateIterator() = 0;
     virtual size_t EvaluateCurrentMemUsed() = 0;
+
+public:
+    // distance in keys between hash bucket prefetch and probe in BatchGet
+    static constexpr size_t BATCH_GET_PREFETCH_DISTANCE = 8;
+
+protected:
+    // statuses[i] = FL_COAWAIT probe(i, keyCollector) for each key with collectAllWindowed,
+    // every probe has its own metrics collector, they are added to collector at last
+    template <typename Probe>
+    static FL_LAZY(void) WindowedProbe(size_t count, Probe probe, indexlib::util::Status* statuses,
+                                       autil::mem_pool::Pool* pool, KVMetricsCollector* collector,
+                                       size_t maxConcurrency, bool yield);
 };
 
+template <typename Probe>
+inline FL_LAZY(void) IKVSegmentReader::WindowedProbe(size_t count, Probe probe, indexlib::util::Status* statuses,
+                                                     autil::mem_pool::Pool* pool, KVMetricsCollector* collector,
+                                                     size_t maxConcurrency, bool yield)
+{
+    using LazyType = FL_LAZY(indexlib::util::Status);
+    autil::mem_pool::pool_allocator<LazyType> lazyAlloc(pool);
+    std::vector<LazyType, decltype(lazyAlloc)> tasks(lazyAlloc);
+    tasks.reserve(count);
+    autil::mem_pool::pool_allocator<KVMetricsCollector> metricsAlloc(pool);
+    std::vector<KVMetricsCollector, decltype(metricsAlloc)> keyCollectors(collector ? count : 0, metricsAlloc);
+    for (size_t i = 0; i < count; ++i) {
+        tasks.push_back(probe(i, collector ? &keyCollectors[i] : nullptr));
+    }
+    autil::mem_pool::pool_allocator<future_lite::interface::use_try_t<indexlib::util::Status>> outAlloc(pool);
+    auto results =
+        FL_COAWAIT future_lite::interface::collectAllWindowed(maxConcurrency, yield, std::move(tasks), outAlloc);
+    for (size_t i = 0; i < count; ++i) {
+        statuses[i] = future_lite::interface::getTryValue(results[i]);
+    }
+    for (const auto& keyCollector : keyCollectors) {
+        *collector += keyCollector;
+    }
+}
+
 } // namespace indexlibv2::index
@@ -26,6 +26,8 @@ KVIndexType ParseKVIndexType(const std::string& str)
         return KVIndexType::KIT_DENSE_HASH;
     } else if (str == "cuckoo") {
         return KVIndexType::KIT_CUCKOO_HASH;
+    } else if (str == "swiss") {
+        return KVIndexType::KIT_SWISS_HASH;
     } else {
         AUTIL_LOG(WARN, "unknown hash type %s, use dense by default", str.c_str());
         return KVIndexType::KIT_DENSE_HASH;
@@ -39,6 +41,8 @@ const char* PrintKVIndexType(KVIndexType type)
         return "dense";
     case KVIndexType::KIT_CUCKOO_HASH:
         return "cuckoo";
+    case KVIndexType::KIT_SWISS_HASH:
+        return "swiss";
     default:
         return "unknown";
     }
@@ -16,8 +16,10 @@
 #include "indexlib/index/kv/KVDiskIndexer.h"
 
 #include "indexlib/file_system/Directory.h"
+#include "indexlib/index/kv/FixedLenHashTableCreator.h"
 #include "indexlib/index/kv/FixedLenKVLeafReader.h"
 #include "indexlib/index/kv/KVTypeId.h"
+#include "indexlib/index/kv/VarLenHashTableCreator.h"
 #include "indexlib/index/kv/VarLenKVCompressedLeafReader.h"
 #include "indexlib/index/kv/VarLenKVLeafReader.h"
 #include "indexlib/index/kv/config/KVIndexConfig.h"
@@ -88,7 +90,18 @@ size_t KVDiskIndexer::EstimateMemUsed(const std::shared_ptr<config::IIndexConfig
         compressMapperMemory = CompressFileAddressMapper::EstimateMemUsed(kvDir->GetIDirectory(), KV_VALUE_FILE_NAME,
                                                                           indexlib::file_system::FSOT_LOAD_CONFIG);
     }
-    return keyMemory + valueMemory + compressMapperMemory;
+    size_t keyAssistantMemory = 0;
+    if (typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
+        // control bytes of swiss hash table are rebuilt in heap when key file is mounted
+        auto hashTableInfo = typeId.isVarLen ? VarLenHashTableCreator::CreateHashTableForReader(typeId, false)
+                                             : FixedLenHashTableCreator::CreateHashTableForReader(typeId, false);
+        auto hashTable = hashTableInfo ? hashTableInfo->StealHashTable<HashTableBase>() : nullptr;
+        auto keyFileLength = kvDir->GetIDirectory()->GetFileLength(KV_KEY_FILE_NAME);
+        if (hashTable && keyFileLength.OK()) {
+            keyAssistantMemory = hashTable->TableMemoryToReadAssistantMemory(keyFileLength.result);
+        }
+    }
+    return keyMemory + keyAssistantMemory + valueMemory + compressMapperMemory;
 }
 
 size_t KVDiskIndexer::EvaluateCurrentMemUsed() { return _reader ? _reader->EvaluateCurrentMemUsed() : 0; }
@@ -25,6 +25,7 @@
 #include "indexlib/index/kv/KVIndexFieldsParser.h"
 #include "indexlib/index/kv/KVTypeId.h"
 #include "indexlib/index/kv/SegmentStatistics.h"
+#include "indexlib/index/kv/ShardedVarLenKVMemIndexer.h"
 #include "indexlib/index/kv/SingleShardKVIndexReader.h"
 #include "indexlib/index/kv/VarLenKVMemIndexer.h"
 #include "indexlib/index/kv/VarLenKVMerger.h"
@@ -83,6 +84,11 @@ KVIndexFactory::CreateVarLenKVMemIndexer(const std::shared_ptr<indexlibv2::confi
     // TODO: delete when use buffer file writer
     // half memory for dump
     int64_t maxBuildMemoryUse = indexerParam.maxMemoryUseInBytes / _memoryFactor;
+    if (indexerParam.buildingShardCount > 1) {
+        return std::make_shared<ShardedVarLenKVMemIndexer>(maxBuildMemoryUse, keyValueMemRatio, valueCompressRatio,
+                                                           indexerParam.sortDescriptions,
+                                                           indexerParam.buildingShardCount);
+    }
     return std::make_shared<VarLenKVMemIndexer>(maxBuildMemoryUse, keyValueMemRatio, valueCompressRatio,
                                                 indexerParam.sortDescriptions, indexerParam.indexMemoryReclaimer);
 }
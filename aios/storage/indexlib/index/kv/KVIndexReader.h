@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <algorithm>
+
 #include "autil/ConstString.h"
 #include "autil/Log.h"
 #include "autil/mem_pool/pool_allocator.h"
@@ -124,6 +126,19 @@ public:
     FL_LAZY(ResultPoolVector)
     BatchGetAsync(const std::vector<autil::StringView, StringAlloc>& keys, const KVReadOptions& options) const noexcept;
 
+    // lookup for large key batch: keys are sorted and deduplicated, each segment is probed for
+    // all unresolved keys at once and values are read in batch, results are in input order
+    template <typename KeyTypeAlloc = std::allocator<index::keytype_t>,
+              typename StringAlloc = std::allocator<autil::StringView>>
+    FL_LAZY(StatusPoolVector)
+    MultiGetAsync(const std::vector<index::keytype_t, KeyTypeAlloc>& keyHashes,
+                  std::vector<autil::StringView, StringAlloc>& values, const KVReadOptions& options) const noexcept;
+
+    template <typename StringAlloc = std::allocator<autil::StringView>>
+    FL_LAZY(StatusPoolVector)
+    MultiGetAsync(const std::vector<autil::StringView, StringAlloc>& keys,
+                  std::vector<autil::StringView, StringAlloc>& values, const KVReadOptions& options) const noexcept;
+
     static bool GetHashKeyWithType(indexlib::HashFunctionType hashType, const autil::StringView& keyStr, dictkey_t& key)
     {
         return indexlib::util::GetHashKey(hashType, keyStr, key);
@@ -152,6 +167,17 @@ protected:
         InnerGet(const KVReadOptions* readOptions, index::keytype_t key, autil::StringView& value,
                  index::KVMetricsCollector* metricsCollector = NULL) const noexcept = 0;
 
+    // sortedKeys are ascending and unique, statuses and values have same size as sortedKeys
+    virtual FL_LAZY(void)
+        InnerMultiGet(const KVReadOptions* readOptions, const std::vector<index::keytype_t>& sortedKeys,
+                      std::vector<KVResultStatus>& statuses, std::vector<autil::StringView>& values) const noexcept
+    {
+        auto statusVec = FL_COAWAIT InnerBatchGetAsync(sortedKeys, values, *readOptions);
+        for (size_t i = 0; i < statusVec.size(); ++i) {
+            statuses[i] = future_lite::interface::getTryValue(statusVec[i]);
+        }
+    }
+
     FL_LAZY(KVResultStatus)
     InnerGet(const KVReadOptions* readOptions, const autil::StringView& key, autil::StringView& value,
              index::KVMetricsCollector* metricsCollector = NULL) const noexcept
@@ -265,6 +291,52 @@ inline FL_LAZY(KVIndexReader::StatusPoolVector) KVIndexReader::BatchGetAsync(
     FL_CORETURN FL_COAWAIT InnerBatchGetAsync(keyHashes, values, options);
 }
 
+template <typename KeyTypeAlloc, typename StringAlloc>
+inline FL_LAZY(KVIndexReader::StatusPoolVector) KVIndexReader::MultiGetAsync(
+    const std::vector<index::keytype_t, KeyTypeAlloc>& keyHashes, std::vector<autil::StringView, StringAlloc>& values,
+    const KVReadOptions& options) const noexcept
+{
+    assert(options.pool);
+    std::vector<index::keytype_t> sortedKeys(keyHashes.begin(), keyHashes.end());
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+    sortedKeys.erase(std::unique(sortedKeys.begin(), sortedKeys.end()), sortedKeys.end());
+    std::vector<KVResultStatus> sortedStatuses(sortedKeys.size(), KVResultStatus::NOT_FOUND);
+    std::vector<autil::StringView> sortedValues(sortedKeys.size());
+    FL_COAWAIT InnerMultiGet(&options, sortedKeys, sortedStatuses, sortedValues);
+
+    values.resize(keyHashes.size());
+    StatusPoolAlloc alloc(options.pool);
+    StatusPoolVector result(alloc);
+    result.reserve(keyHashes.size());
+    for (size_t i = 0; i < keyHashes.size(); ++i) {
+        size_t pos = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), keyHashes[i]) - sortedKeys.begin();
+        values[i] = sortedValues[pos];
+        result.emplace_back(sortedStatuses[pos]);
+    }
+    FL_CORETURN result;
+}
+
+template <typename StringAlloc>
+inline FL_LAZY(KVIndexReader::StatusPoolVector) KVIndexReader::MultiGetAsync(
+    const std::vector<autil::StringView, StringAlloc>& keys, std::vector<autil::StringView, StringAlloc>& values,
+    const KVReadOptions& options) const noexcept
+{
+    // keys failed to hash are reported as not found
+    std::vector<index::keytype_t> keyHashes(keys.size());
+    std::vector<bool> hashed(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        hashed[i] = GetHashKey(keys[i], keyHashes[i]);
+    }
+    auto result = FL_COAWAIT MultiGetAsync(keyHashes, values, options);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!hashed[i]) {
+            values[i] = autil::StringView();
+            result[i] = use_try_t<KVResultStatus>(KVResultStatus::NOT_FOUND);
+        }
+    }
+    FL_CORETURN result;
+}
+
 template <typename StringAlloc, typename KeysType>
 inline FL_LAZY(KVIndexReader::StatusPoolVector)
     KVIndexReader::InnerBatchGetAsync(const KeysType& keys, std::vector<autil::StringView, StringAlloc>& values,
@@ -75,15 +75,7 @@ Status KVMemIndexerBase::Build(document::IDocumentBatch* docBatch)
             continue;
         }
         KVIndexFields::SingleField singleField;
-        singleField.pkeyHash = kvDoc->GetPKeyHash();
-        singleField.skeyHash = kvDoc->GetSKeyHash();
-        singleField.hasSkey = kvDoc->HasSKey();
-        singleField.value = kvDoc->GetValue();
-        singleField.ttl = kvDoc->GetTTL();
-        singleField.userTimestamp = kvDoc->GetUserTimestamp();
-        singleField.hasFormatError = kvDoc->HasFormatError();
-        singleField.pkFieldName = kvDoc->GetPkFieldName();
-        singleField.pkFieldValue = kvDoc->GetPkFieldValue();
+        ExtractSingleField(*kvDoc, singleField);
 
         auto s = BuildSingleField(kvDoc->GetDocOperateType(), singleField);
         if (!s.IsOK()) {
@@ -186,6 +178,19 @@ autil::StringView KVMemIndexerBase::GetIndexType() const { return KV_INDEX_TYPE_
 uint64_t KVMemIndexerBase::GetIndexNameHash() const { return _indexNameHash; }
 void KVMemIndexerBase::Seal() {}
 
+void KVMemIndexerBase::ExtractSingleField(const document::KVDocument& kvDoc, KVIndexFields::SingleField& singleField)
+{
+    singleField.pkeyHash = kvDoc.GetPKeyHash();
+    singleField.skeyHash = kvDoc.GetSKeyHash();
+    singleField.hasSkey = kvDoc.HasSKey();
+    singleField.value = kvDoc.GetValue();
+    singleField.ttl = kvDoc.GetTTL();
+    singleField.userTimestamp = kvDoc.GetUserTimestamp();
+    singleField.hasFormatError = kvDoc.HasFormatError();
+    singleField.pkFieldName = kvDoc.GetPkFieldName();
+    singleField.pkFieldValue = kvDoc.GetPkFieldValue();
+}
+
 Status KVMemIndexerBase::BuildSingleField(DocOperateType docType, const KVIndexFields::SingleField& singleField)
 {
     if (IsFull()) {
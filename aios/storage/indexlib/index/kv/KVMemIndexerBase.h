@@ -80,11 +80,18 @@ private:
     virtual void UpdateMemoryUsage(MemoryUsage& memoryUsage) const = 0;
     virtual void DoFillStatistics(SegmentStatistics& stat) const = 0;
 
+protected:
+    static void ExtractSingleField(const document::KVDocument& kvDoc, KVIndexFields::SingleField& singleField);
+
 private:
     Status BuildSingleField(DocOperateType docType, const KVIndexFields::SingleField& singleField);
     Status AddField(const KVIndexFields::SingleField& field);
     Status DeleteField(const KVIndexFields::SingleField& field);
 
+private:
+    // builds and dumps through private interface of its shard indexers
+    friend class ShardedVarLenKVMemIndexer;
+
 protected:
     std::shared_ptr<indexlibv2::config::KVIndexConfig> _indexConfig;
     uint64_t _indexNameHash;
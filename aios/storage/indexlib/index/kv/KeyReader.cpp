@@ -116,7 +116,10 @@ std::unique_ptr<KVKeyIterator> KeyReader::CreateIterator() const
 
 size_t KeyReader::EvaluateCurrentMemUsed()
 {
-    return _inMemory ? _keyFileReader->GetLength() : indexlib::file_system::ReaderOption::DEFAULT_BUFFER_SIZE;
+    if (_inMemory) {
+        return _keyFileReader->GetLength() + _memoryReader->TableMemoryToReadAssistantMemory(_keyFileReader->GetLength());
+    }
+    return indexlib::file_system::ReaderOption::DEFAULT_BUFFER_SIZE;
 }
 
 } // namespace indexlibv2::index
@@ -53,6 +53,14 @@ public:
         Find(keytype_t key, autil::StringView& value, uint64_t& ts, KVMetricsCollector* collector,
              autil::mem_pool::Pool* pool, autil::TimeoutTerminator* timeoutTerminator) const __ALWAYS_INLINE;
 
+    bool InMemory() const { return _inMemory; }
+    void Prefetch(keytype_t key) const
+    {
+        if (_inMemory) {
+            _memoryReader->Prefetch(key);
+        }
+    }
+
     std::unique_ptr<KVKeyIterator> CreateIterator() const; // for merge
     size_t EvaluateCurrentMemUsed();
 
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/kv/ShardedKVMemoryReader.h"
+
+#include "indexlib/index/kv/IKVIterator.h"
+
+namespace indexlibv2::index {
+
+ShardedKVMemoryReader::ShardedKVMemoryReader(std::vector<std::shared_ptr<IKVSegmentReader>> shardReaders)
+    : _shardReaders(std::move(shardReaders))
+{
+}
+
+ShardedKVMemoryReader::~ShardedKVMemoryReader() {}
+
+std::unique_ptr<IKVIterator> ShardedKVMemoryReader::CreateIterator() { return nullptr; }
+
+size_t ShardedKVMemoryReader::EvaluateCurrentMemUsed()
+{
+    size_t memUsed = 0;
+    for (const auto& reader : _shardReaders) {
+        memUsed += reader->EvaluateCurrentMemUsed();
+    }
+    return memUsed;
+}
+
+} // namespace indexlibv2::index
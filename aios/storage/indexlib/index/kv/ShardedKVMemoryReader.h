@@ -0,0 +1,59 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "indexlib/index/kv/IKVSegmentReader.h"
+
+namespace indexlibv2::index {
+
+// in memory reader of sharded building segment, each key lives in exactly one shard
+class ShardedKVMemoryReader final : public IKVSegmentReader
+{
+public:
+    explicit ShardedKVMemoryReader(std::vector<std::shared_ptr<IKVSegmentReader>> shardReaders);
+    ~ShardedKVMemoryReader();
+
+public:
+    FL_LAZY(indexlib::util::Status)
+    Get(keytype_t key, autil::StringView& value, uint64_t& ts, autil::mem_pool::Pool* pool = nullptr,
+        KVMetricsCollector* collector = nullptr, autil::TimeoutTerminator* timeoutTerminator = nullptr) const override;
+    std::unique_ptr<IKVIterator> CreateIterator() override;
+    size_t EvaluateCurrentMemUsed() override;
+
+public:
+    static size_t GetShardIdx(keytype_t key, size_t shardCount)
+    {
+        // pkey hash also decides bucket in shard hash table, remix it before mod
+        return ((key * 0x9E3779B97F4A7C15UL) >> 32) % shardCount;
+    }
+
+private:
+    std::vector<std::shared_ptr<IKVSegmentReader>> _shardReaders;
+};
+
+inline FL_LAZY(indexlib::util::Status) ShardedKVMemoryReader::Get(keytype_t key, autil::StringView& value,
+                                                                  uint64_t& ts, autil::mem_pool::Pool* pool,
+                                                                  KVMetricsCollector* collector,
+                                                                  autil::TimeoutTerminator* timeoutTerminator) const
+{
+    const auto& reader = _shardReaders[GetShardIdx(key, _shardReaders.size())];
+    FL_CORETURN FL_COAWAIT reader->Get(key, value, ts, pool, collector, timeoutTerminator);
+}
+
+} // namespace indexlibv2::index
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/kv/ShardedVarLenKVMemIndexer.h"
+
+#include <algorithm>
+
+#include "autil/Log.h"
+#include "autil/ThreadPool.h"
+#include "indexlib/document/kv/KVDocumentBatch.h"
+#include "indexlib/index/kv/SegmentStatistics.h"
+#include "indexlib/index/kv/ShardedKVMemoryReader.h"
+#include "indexlib/index/kv/VarLenKVMemIndexer.h"
+#include "indexlib/index/kv/config/KVIndexConfig.h"
+
+using namespace std;
+
+namespace indexlibv2::index {
+AUTIL_DECLARE_AND_SETUP_LOGGER(indexlib.index, ShardedVarLenKVMemIndexer);
+
+ShardedVarLenKVMemIndexer::ShardedVarLenKVMemIndexer(int64_t maxMemoryUse, float keyValueSizeRatio,
+                                                     float valueCompressRatio,
+                                                     const config::SortDescriptions& sortDescriptions,
+                                                     uint32_t shardCount)
+    : _maxMemoryUse(maxMemoryUse)
+    , _keyValueSizeRatio(keyValueSizeRatio)
+    , _valueCompressRatio(valueCompressRatio)
+    , _sortDescriptions(sortDescriptions)
+    , _shards(shardCount)
+{
+    assert(shardCount > 1);
+}
+
+ShardedVarLenKVMemIndexer::~ShardedVarLenKVMemIndexer()
+{
+    if (_threadPool) {
+        _threadPool->stop();
+    }
+}
+
+Status ShardedVarLenKVMemIndexer::DoInit()
+{
+    // memory reclaim and sort dump are left to the merged indexer created when dump
+    int64_t shardMemoryUse = _maxMemoryUse / _shards.size();
+    for (auto& shard : _shards) {
+        shard = std::make_shared<VarLenKVMemIndexer>(shardMemoryUse, _keyValueSizeRatio, _valueCompressRatio);
+        RETURN_IF_STATUS_ERROR(shard->Init(_indexConfig, nullptr), "init shard indexer for [%s] failed",
+                               GetIndexName().c_str());
+    }
+
+    // caller thread builds shard 0 in blockingParallel
+    _threadPool = std::make_unique<autil::ThreadPool>(_shards.size() - 1, autil::ThreadPool::DEFAULT_QUEUESIZE,
+                                                      true /*stopIfHasException*/, "KVShardBuild");
+    if (!_threadPool->start("KVShardBuild")) {
+        AUTIL_LOG(ERROR, "start build thread pool for [%s] failed", GetIndexName().c_str());
+        return Status::InternalError("start build thread pool failed");
+    }
+    AUTIL_LOG(INFO, "kv index [%s] build with [%lu] shards, shard buffer size: %ld", GetIndexName().c_str(),
+              _shards.size(), shardMemoryUse);
+    return Status::OK();
+}
+
+Status ShardedVarLenKVMemIndexer::Build(document::IDocumentBatch* docBatch)
+{
+    document::KVDocumentBatch* kvDocBatch = dynamic_cast<document::KVDocumentBatch*>(docBatch);
+    if (kvDocBatch == nullptr) {
+        return Status::InternalError("only support KVDocumentBatch for kv index");
+    }
+    if (kvDocBatch->GetBatchSize() < MIN_PARALLEL_BUILD_DOC_COUNT) {
+        return KVMemIndexerBase::Build(docBatch);
+    }
+
+    auto indexNameHash = GetIndexNameHash();
+    std::vector<ShardFields> shardFields(_shards.size());
+    for (size_t i = 0; i < kvDocBatch->GetBatchSize(); ++i) {
+        if (kvDocBatch->IsDropped(i)) {
+            continue;
+        }
+        auto kvDoc = std::dynamic_pointer_cast<document::KVDocument>((*kvDocBatch)[i]);
+        auto curIndexNameHash = kvDoc->GetIndexNameHash();
+        if (curIndexNameHash != 0 && indexNameHash != curIndexNameHash) {
+            continue;
+        }
+        KVIndexFields::SingleField singleField;
+        ExtractSingleField(*kvDoc, singleField);
+        auto shardIdx = ShardedKVMemoryReader::GetShardIdx(singleField.pkeyHash, _shards.size());
+        shardFields[shardIdx].emplace_back(kvDoc->GetDocOperateType(), singleField);
+    }
+    return BuildShards(shardFields);
+}
+
+Status ShardedVarLenKVMemIndexer::Build(const document::IIndexFields* indexFields, size_t n)
+{
+    if (n < MIN_PARALLEL_BUILD_DOC_COUNT) {
+        return KVMemIndexerBase::Build(indexFields, n);
+    }
+
+    std::vector<ShardFields> shardFields(_shards.size());
+    for (size_t i = 0; i < n; ++i) {
+        auto kvIndexFields = dynamic_cast<const KVIndexFields*>(indexFields + i);
+        if (!kvIndexFields) {
+            return Status::InternalError("not KVIndexFields!");
+        }
+        auto singleField = kvIndexFields->GetSingleField(GetIndexNameHash());
+        if (!singleField) {
+            continue;
+        }
+        auto shardIdx = ShardedKVMemoryReader::GetShardIdx(singleField->pkeyHash, _shards.size());
+        shardFields[shardIdx].emplace_back(kvIndexFields->GetDocOperateType(), *singleField);
+    }
+    return BuildShards(shardFields);
+}
+
+Status ShardedVarLenKVMemIndexer::BuildShards(const std::vector<ShardFields>& shardFields)
+{
+    std::vector<Status> shardStatus(_shards.size());
+    auto buildShard = [this, &shardFields, &shardStatus](int shardIdx) -> bool {
+        KVMemIndexerBase* shard = _shards[shardIdx].get();
+        for (const auto& [docType, singleField] : shardFields[shardIdx]) {
+            auto s = shard->BuildSingleField(docType, singleField);
+            if (!s.IsOK()) {
+                shardStatus[shardIdx] = std::move(s);
+                return false;
+            }
+        }
+        return true;
+    };
+    if (_threadPool->blockingParallel(_shards.size(), buildShard)) {
+        return Status::OK();
+    }
+
+    // NeedDump only if no shard failed for other reasons
+    Status status;
+    for (auto& s : shardStatus) {
+        if (s.IsOK()) {
+            continue;
+        }
+        if (!s.IsNeedDump()) {
+            AUTIL_LOG(ERROR, "build kv index [%s] failed, error: %s", GetIndexName().c_str(), s.ToString().c_str());
+            return s;
+        }
+        status = s;
+    }
+    return status;
+}
+
+KVMemIndexerBase* ShardedVarLenKVMemIndexer::GetShard(uint64_t key) const
+{
+    return _shards[ShardedKVMemoryReader::GetShardIdx(key, _shards.size())].get();
+}
+
+std::shared_ptr<IKVSegmentReader> ShardedVarLenKVMemIndexer::CreateInMemoryReader() const
+{
+    std::vector<std::shared_ptr<IKVSegmentReader>> shardReaders;
+    shardReaders.reserve(_shards.size());
+    for (const auto& shard : _shards) {
+        shardReaders.emplace_back(shard->CreateInMemoryReader());
+    }
+    return std::make_shared<ShardedKVMemoryReader>(std::move(shardReaders));
+}
+
+bool ShardedVarLenKVMemIndexer::IsFull()
+{
+    for (const auto& shard : _shards) {
+        if (static_cast<KVMemIndexerBase*>(shard.get())->IsFull()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Status ShardedVarLenKVMemIndexer::Add(uint64_t key, const autil::StringView& value, uint32_t timestamp)
+{
+    return GetShard(key)->Add(key, value, timestamp);
+}
+
+Status ShardedVarLenKVMemIndexer::Delete(uint64_t key, uint32_t timestamp)
+{
+    return GetShard(key)->Delete(key, timestamp);
+}
+
+Status ShardedVarLenKVMemIndexer::DoDump(autil::mem_pool::PoolBase* pool,
+                                         const std::shared_ptr<indexlib::file_system::Directory>& directory)
+{
+    // merge shards into one plain building indexer, which dumps hash table and value file in the
+    // same format as a non-sharded building segment
+    auto mergedIndexer = std::make_shared<VarLenKVMemIndexer>(_maxMemoryUse, _keyValueSizeRatio, _valueCompressRatio,
+                                                              _sortDescriptions);
+    RETURN_IF_STATUS_ERROR(mergedIndexer->Init(_indexConfig, nullptr), "init merged indexer for [%s] failed",
+                           GetIndexName().c_str());
+    KVMemIndexerBase* merged = mergedIndexer.get();
+
+    std::vector<Record> records;
+    for (size_t shardIdx = 0; shardIdx < _shards.size(); ++shardIdx) {
+        records.clear();
+        _shards[shardIdx]->CollectRecords(records);
+        for (const auto& record : records) {
+            auto status = record.deleted ? merged->Delete(record.key, record.timestamp)
+                                         : merged->Add(record.key, record.value, record.timestamp);
+            if (!status.IsOK()) {
+                AUTIL_LOG(ERROR, "merge shard [%lu] of kv index [%s] failed, error: %s", shardIdx,
+                          GetIndexName().c_str(), status.ToString().c_str());
+                return status;
+            }
+        }
+    }
+    return merged->DoDump(pool, directory);
+}
+
+void ShardedVarLenKVMemIndexer::UpdateMemoryUsage(MemoryUsage& memoryUsage) const
+{
+    for (const auto& shard : _shards) {
+        MemoryUsage shardMemUsage;
+        static_cast<const KVMemIndexerBase*>(shard.get())->UpdateMemoryUsage(shardMemUsage);
+        memoryUsage += shardMemUsage;
+    }
+    // shards are copied to merged indexer when dump
+    memoryUsage.dumpMemory += memoryUsage.buildMemory;
+}
+
+void ShardedVarLenKVMemIndexer::DoFillStatistics(SegmentStatistics& stat) const
+{
+    // hash table memory of a shard is proportional to its bucket count, weight occupancy by it
+    double weightedOccupancy = 0;
+    int32_t maxOccupancyPct = 0;
+    for (const auto& shard : _shards) {
+        SegmentStatistics shardStat;
+        static_cast<const KVMemIndexerBase*>(shard.get())->DoFillStatistics(shardStat);
+        stat.keyMemoryUse += shardStat.keyMemoryUse;
+        stat.valueMemoryUse += shardStat.valueMemoryUse;
+        stat.keyCount += shardStat.keyCount;
+        stat.deletedKeyCount += shardStat.deletedKeyCount;
+        weightedOccupancy += 1.0 * shardStat.occupancyPct * shardStat.keyMemoryUse;
+        maxOccupancyPct = std::max(maxOccupancyPct, shardStat.occupancyPct);
+    }
+    stat.occupancyPct =
+        stat.keyMemoryUse > 0 ? static_cast<int32_t>(weightedOccupancy / stat.keyMemoryUse + 0.5) : maxOccupancyPct;
+    stat.totalMemoryUse = stat.keyMemoryUse + stat.valueMemoryUse;
+    stat.keyValueSizeRatio = stat.totalMemoryUse > 0 ? 1.0f * stat.keyMemoryUse / stat.totalMemoryUse : 0;
+}
+
+} // namespace indexlibv2::index
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "indexlib/config/SortDescription.h"
+#include "indexlib/index/kv/KVMemIndexerBase.h"
+#include "indexlib/index/kv/Record.h"
+
+namespace autil {
+class ThreadPool;
+}
+
+namespace indexlibv2::index {
+class VarLenKVMemIndexer;
+
+// Building segment of var len kv split into shards by key hash, every shard is
+// a VarLenKVMemIndexer with its own pool and hash table so a doc batch can be
+// built by one thread per shard. Shards are merged into one hash table and
+// value file when dump, on-disk format is same as VarLenKVMemIndexer.
+class ShardedVarLenKVMemIndexer final : public KVMemIndexerBase
+{
+public:
+    ShardedVarLenKVMemIndexer(int64_t maxMemoryUse, float keyValueSizeRatio, float valueCompressRatio,
+                              const config::SortDescriptions& sortDescriptions, uint32_t shardCount);
+    ~ShardedVarLenKVMemIndexer();
+
+public:
+    Status Build(document::IDocumentBatch* docBatch) override;
+    Status Build(const document::IIndexFields* indexFields, size_t n) override;
+    std::shared_ptr<IKVSegmentReader> CreateInMemoryReader() const override;
+    size_t GetShardCount() const { return _shards.size(); }
+
+private:
+    Status DoInit() override;
+    bool IsFull() override;
+    Status Add(uint64_t key, const autil::StringView& value, uint32_t timestamp) override;
+    Status Delete(uint64_t key, uint32_t timestamp) override;
+    Status DoDump(autil::mem_pool::PoolBase* pool,
+                  const std::shared_ptr<indexlib::file_system::Directory>& directory) override;
+    void UpdateMemoryUsage(MemoryUsage& memoryUsage) const override;
+    void DoFillStatistics(SegmentStatistics& stat) const override;
+
+    typedef std::vector<std::pair<DocOperateType, KVIndexFields::SingleField>> ShardFields;
+    Status BuildShards(const std::vector<ShardFields>& shardFields);
+    KVMemIndexerBase* GetShard(uint64_t key) const;
+
+private:
+    int64_t _maxMemoryUse;
+    float _keyValueSizeRatio;
+    float _valueCompressRatio;
+    config::SortDescriptions _sortDescriptions;
+    std::vector<std::shared_ptr<VarLenKVMemIndexer>> _shards;
+    std::unique_ptr<autil::ThreadPool> _threadPool;
+
+public:
+    // batches smaller than this are built in caller thread
+    static constexpr size_t MIN_PARALLEL_BUILD_DOC_COUNT = 64;
+};
+
+} // namespace indexlibv2::index
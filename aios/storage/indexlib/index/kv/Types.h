@@ -30,7 +30,7 @@ enum KVValueType {
     KVVT_PACKED_MULTI_FIELD,
     KVVT_UNKNOWN,
 };
-enum class KVIndexType : int8_t { KIT_DENSE_HASH, KIT_CUCKOO_HASH, KIT_UNKOWN };
+enum class KVIndexType : int8_t { KIT_DENSE_HASH, KIT_CUCKOO_HASH, KIT_SWISS_HASH, KIT_UNKOWN };
 } // namespace indexlib::index::enum_namespace
 
 namespace indexlib::index {
@@ -26,7 +26,9 @@ AUTIL_DECLARE_AND_SETUP_LOGGER(indexlib.index, VarLenHashTableCollector);
 void VarLenHashTableCollector::CollectRecords(const KVTypeId& typeId, const std::shared_ptr<HashTableBase>& hashTable,
                                               const CollectFuncType& func)
 {
-    if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH) {
+    // swiss hash table is a dense hash table with in memory control bytes
+    if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH ||
+        typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
         InnerCollect(DENSE_TABLE, typeId, hashTable, func);
     } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
         InnerCollect(CUCKOO_TABLE, typeId, hashTable, func);
@@ -22,6 +22,7 @@
 #include "indexlib/index/common/hash_table/CuckooHashTableFileReader.h"
 #include "indexlib/index/common/hash_table/DenseHashTable.h"
 #include "indexlib/index/common/hash_table/DenseHashTableFileReader.h"
+#include "indexlib/index/common/hash_table/SwissHashTable.h"
 #include "indexlib/index/kv/KVTypeId.h"
 
 namespace indexlibv2::index {
@@ -33,7 +34,9 @@ HashTableInfoPtr VarLenHashTableCreator::CreateHashTableForReader(const KVTypeId
 {
     assert(typeId.isVarLen);
     if (useFileReader) {
-        if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH) {
+        // swiss hash table dumps the same file format as dense hash table
+        if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH ||
+            typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
             return InnerCreate(DENSE_READER, typeId);
         } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
             return InnerCreate(CUCKOO_READER, typeId);
@@ -45,6 +48,8 @@ HashTableInfoPtr VarLenHashTableCreator::CreateHashTableForReader(const KVTypeId
             return InnerCreate(DENSE_TABLE, typeId);
         } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
             return InnerCreate(CUCKOO_TABLE, typeId);
+        } else if (typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
+            return InnerCreate(SWISS_TABLE, typeId);
         } else {
             return nullptr;
         }
@@ -58,6 +63,8 @@ HashTableInfoPtr VarLenHashTableCreator::CreateHashTableForWriter(const KVTypeId
         return InnerCreate(DENSE_TABLE, typeId);
     } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
         return InnerCreate(CUCKOO_TABLE, typeId);
+    } else if (typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
+        return InnerCreate(SWISS_TABLE, typeId);
     } else {
         return nullptr;
     }
@@ -66,7 +73,8 @@ HashTableInfoPtr VarLenHashTableCreator::CreateHashTableForWriter(const KVTypeId
 HashTableInfoPtr VarLenHashTableCreator::CreateHashTableForMerger(const KVTypeId& typeId)
 {
     assert(typeId.isVarLen);
-    if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH) {
+    if (typeId.offlineIndexType == KVIndexType::KIT_DENSE_HASH ||
+        typeId.offlineIndexType == KVIndexType::KIT_SWISS_HASH) {
         return InnerCreate(DENSE_READER, typeId);
     } else if (typeId.offlineIndexType == KVIndexType::KIT_CUCKOO_HASH) {
         return InnerCreate(CUCKOO_READER, typeId);
@@ -142,6 +150,13 @@ HashTableInfoPtr VarLenHashTableCreator::CreateWithKeyTypeValueType(HashTableAcc
         hashTableInfo->hashTableFileIterator = std::make_unique<IteratorType>();
         break;
     }
+    case SWISS_TABLE: {
+        using HashTableType = SwissHashTable<KeyType, ValueType, false>;
+        hashTableInfo->hashTable = std::make_unique<HashTableType>();
+        using BucketCompressorType = BucketOffsetCompressor<typename HashTableType::Bucket>;
+        hashTableInfo->bucketCompressor = std::make_unique<BucketCompressorType>();
+        break;
+    }
     default:
         return nullptr;
     }
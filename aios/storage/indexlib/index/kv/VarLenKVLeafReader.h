@@ -47,6 +47,10 @@ public:
     FL_LAZY(indexlib::util::Status)
     Get(keytype_t key, autil::StringView& value, uint64_t& ts, autil::mem_pool::Pool* pool,
         KVMetricsCollector* collector, autil::TimeoutTerminator* timeoutTerminator) const override;
+    FL_LAZY(void)
+    BatchGet(const keytype_t* keys, size_t count, indexlib::util::Status* statuses, autil::StringView* values,
+             uint64_t* tss, autil::mem_pool::Pool* pool, KVMetricsCollector* collector,
+             autil::TimeoutTerminator* timeoutTerminator, size_t maxConcurrency, bool yield) const override;
 
     std::unique_ptr<IKVIterator> CreateIterator() override;
     size_t EvaluateCurrentMemUsed() override;
@@ -64,6 +68,13 @@ private:
                                    autil::mem_pool::Pool* pool) const __ALWAYS_INLINE;
 
     inline bool InMemory() const { return _valueBaseAddr != nullptr; }
+    inline offset_t DecodeOffset(const autil::StringView& offsetStr) const
+    {
+        if (_formatOpts.IsShortOffset()) {
+            return *(short_offset_t*)(offsetStr.data());
+        }
+        return *(offset_t*)(offsetStr.data());
+    }
 
 protected:
     KVFormatOptions _formatOpts;
@@ -112,16 +123,69 @@ inline FL_LAZY(indexlib::util::Status) VarLenKVLeafReader::Get(keytype_t key, au
     autil::StringView offsetStr;
     auto ret = FL_COAWAIT _offsetReader.Find(key, offsetStr, ts, collector, pool, timeoutTerminator);
     if (ret == indexlib::util::OK) {
-        offset_t offset = 0;
-        if (_formatOpts.IsShortOffset()) {
-            offset = *(short_offset_t*)(offsetStr.data());
-        } else {
-            offset = *(offset_t*)(offsetStr.data());
-        }
+        offset_t offset = DecodeOffset(offsetStr);
         auto status = FL_COAWAIT GetValue(value, offset, pool, collector, timeoutTerminator);
         ret = status ? indexlib::util::OK : indexlib::util::FAIL;
     }
     FL_CORETURN ret;
 }
 
+inline FL_LAZY(void) VarLenKVLeafReader::BatchGet(const keytype_t* keys, size_t count,
+                                                  indexlib::util::Status* statuses, autil::StringView* values,
+                                                  uint64_t* tss, autil::mem_pool::Pool* pool,
+                                                  KVMetricsCollector* collector,
+                                                  autil::TimeoutTerminator* timeoutTerminator, size_t maxConcurrency,
+                                                  bool yield) const
+{
+    // probe all keys first, prefetch buckets of following keys if hash table is in memory,
+    // otherwise probes may wait for io and run concurrently
+    std::vector<autil::StringView> offsetStrs(count);
+    if (_offsetReader.InMemory()) {
+        for (size_t i = 0; i < count; ++i) {
+            if (i + BATCH_GET_PREFETCH_DISTANCE < count) {
+                _offsetReader.Prefetch(keys[i + BATCH_GET_PREFETCH_DISTANCE]);
+            }
+            statuses[i] =
+                FL_COAWAIT _offsetReader.Find(keys[i], offsetStrs[i], tss[i], collector, pool, timeoutTerminator);
+        }
+    } else {
+        FL_COAWAIT WindowedProbe(
+            count,
+            [&](size_t i, KVMetricsCollector* keyCollector) {
+                return _offsetReader.Find(keys[i], offsetStrs[i], tss[i], keyCollector, pool, timeoutTerminator);
+            },
+            statuses, pool, collector, maxConcurrency, yield);
+    }
+    std::vector<size_t> foundIdxs;
+    std::vector<offset_t> offsets;
+    for (size_t i = 0; i < count; ++i) {
+        if (statuses[i] == indexlib::util::OK) {
+            foundIdxs.push_back(i);
+            offsets.push_back(DecodeOffset(offsetStrs[i]));
+        }
+    }
+    if (foundIdxs.empty()) {
+        FL_CORETURN;
+    }
+
+    if (InMemory()) {
+        for (size_t j = 0; j < foundIdxs.size(); ++j) {
+            auto i = foundIdxs[j];
+            statuses[i] = GetValueFromMemory(values[i], offsets[j], pool) ? indexlib::util::OK : indexlib::util::FAIL;
+        }
+        FL_CORETURN;
+    }
+
+    // read values of all found keys in one batch so that reads in same block are merged
+    std::vector<autil::StringView> foundValues(foundIdxs.size());
+    std::unique_ptr<bool[]> succ(new bool[foundIdxs.size()]);
+    FL_COAWAIT _fsValueReader.BatchRead(_valueFileReader.get(), offsets.data(), offsets.size(), foundValues.data(),
+                                        succ.get(), pool, collector, timeoutTerminator);
+    for (size_t j = 0; j < foundIdxs.size(); ++j) {
+        auto i = foundIdxs[j];
+        values[i] = foundValues[j];
+        statuses[i] = succ[j] ? indexlib::util::OK : indexlib::util::FAIL;
+    }
+}
+
 } // namespace indexlibv2::index
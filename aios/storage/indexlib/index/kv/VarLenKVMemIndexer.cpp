@@ -254,6 +254,20 @@ void VarLenKVMemIndexer::SortByValue()
     _sortDataCollector->Sort();
 }
 
+void VarLenKVMemIndexer::CollectRecords(std::vector<Record>& records) const
+{
+    records.reserve(records.size() + _keyWriter->GetHashTable()->Size());
+    auto valueAccessor = _valueWriter->GetValueAccessor();
+    auto func = [this, &records, &valueAccessor](Record& record) {
+        if (!record.deleted) {
+            offset_t offset = DecodeOffset(record.value.data());
+            record.value = DecodeValue(valueAccessor->GetValue(offset));
+        }
+        records.push_back(record);
+    };
+    _keyWriter->CollectRecord(func);
+}
+
 offset_t VarLenKVMemIndexer::DecodeOffset(const char* data) const
 {
     if (_formatOpts.IsShortOffset()) {
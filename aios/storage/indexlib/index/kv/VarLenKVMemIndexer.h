@@ -22,6 +22,7 @@
 #include "indexlib/index/kv/KVMemIndexerBase.h"
 #include "indexlib/index/kv/KVSortDataCollector.h"
 #include "indexlib/index/kv/KeyWriter.h"
+#include "indexlib/index/kv/Record.h"
 
 namespace indexlib::file_system {
 class FileWriter;
@@ -52,6 +53,8 @@ public:
 
 public:
     std::shared_ptr<IKVSegmentReader> CreateInMemoryReader() const override;
+    // collect all keys with values decoded from value writer
+    void CollectRecords(std::vector<Record>& records) const;
     const InMemoryValueWriter* TEST_GetValueWriter() const { return _valueWriter.get(); }
 
 private:
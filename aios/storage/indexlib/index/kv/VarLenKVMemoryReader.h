@@ -52,6 +52,10 @@ public:
     FL_LAZY(indexlib::util::Status)
     Get(keytype_t key, autil::StringView& value, uint64_t& ts, autil::mem_pool::Pool* pool = nullptr,
         KVMetricsCollector* collector = nullptr, autil::TimeoutTerminator* timeoutTerminator = nullptr) const override;
+    FL_LAZY(void)
+    BatchGet(const keytype_t* keys, size_t count, indexlib::util::Status* statuses, autil::StringView* values,
+             uint64_t* tss, autil::mem_pool::Pool* pool, KVMetricsCollector* collector,
+             autil::TimeoutTerminator* timeoutTerminator, size_t maxConcurrency, bool yield) const override;
     std::unique_ptr<IKVIterator> CreateIterator() override;
     size_t EvaluateCurrentMemUsed() override { return 0; }
 
@@ -101,4 +105,19 @@ inline FL_LAZY(indexlib::util::Status) VarLenKVMemoryReader::Get(keytype_t key,
     FL_CORETURN indexlib::util::OK;
 }
 
+inline FL_LAZY(void) VarLenKVMemoryReader::BatchGet(const keytype_t* keys, size_t count,
+                                                    indexlib::util::Status* statuses, autil::StringView* values,
+                                                    uint64_t* tss, autil::mem_pool::Pool* pool,
+                                                    KVMetricsCollector* collector,
+                                                    autil::TimeoutTerminator* timeoutTerminator, size_t maxConcurrency,
+                                                    bool yield) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (i + BATCH_GET_PREFETCH_DISTANCE < count) {
+            _hashTable->Prefetch(keys[i + BATCH_GET_PREFETCH_DISTANCE]);
+        }
+        statuses[i] = FL_COAWAIT Get(keys[i], values[i], tss[i], pool, collector, timeoutTerminator);
+    }
+}
+
 } // namespace indexlibv2::index
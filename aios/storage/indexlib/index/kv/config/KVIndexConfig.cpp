@@ -74,9 +74,9 @@ void KVIndexConfig::Check() const
     }
 
     _impl->indexPreference.Check();
-    if (_impl->indexPreference.GetHashDictParam().GetHashType() != "dense" &&
-        _impl->indexPreference.GetHashDictParam().GetHashType() != "cuckoo") {
-        INDEXLIB_FATAL_ERROR(Schema, "key only support dense or cuckoo now");
+    const auto& hashType = _impl->indexPreference.GetHashDictParam().GetHashType();
+    if (hashType != "dense" && hashType != "cuckoo" && hashType != "swiss") {
+        INDEXLIB_FATAL_ERROR(Schema, "key only support dense, cuckoo or swiss now");
     }
 }
 
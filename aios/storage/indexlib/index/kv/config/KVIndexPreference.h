@@ -79,7 +79,8 @@ public:
             if (_hashType.empty()) {
                 return;
             }
-            if (_hashType != "dense" && _hashType != "separate_chain" && _hashType != "cuckoo") {
+            if (_hashType != "dense" && _hashType != "separate_chain" && _hashType != "cuckoo" &&
+                _hashType != "swiss") {
                 INDEXLIB_FATAL_ERROR(BadParameter, "unsupported hash dict type [%s]", _hashType.c_str());
             }
             if (_occupancyPct <= 0 || _occupancyPct > 100) {
@@ -51,6 +51,11 @@ public:
     //[docIdRange.first, docIdRange.second)
     virtual bool Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                          const std::vector<std::pair<docid_t, docid_t>>& docidRange) const = 0;
+    // Process is split into target doc lookup and modification, so that replayer can resolve docids in batch
+    // INVALID_DOCID if not found in docidRange
+    virtual docid_t LookupDocId(const PrimaryKeyIndexReader* pkReader,
+                                const std::vector<std::pair<docid_t, docid_t>>& docidRange) const = 0;
+    virtual bool ProcessDoc(docid_t docId, OperationLogProcessor* processor) const = 0;
     void SetOperationFieldInfo(const std::shared_ptr<OperationFieldInfo>& operationFieldInfo)
     {
         _operationFieldInfo = operationFieldInfo;
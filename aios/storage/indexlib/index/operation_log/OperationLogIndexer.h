@@ -25,6 +25,7 @@ namespace indexlib::index {
 class SegmentOperationIterator;
 class OperationMeta;
 class BatchOpLogIterator;
+class OperationLogMetrics;
 class OperationLogIndexer
 {
 public:
@@ -38,6 +39,8 @@ public:
     CreateSegmentOperationIterator(size_t offset, const indexlibv2::framework::Locator& locator) = 0;
     virtual std::pair<Status, std::shared_ptr<BatchOpLogIterator>> CreateBatchIterator() = 0;
     virtual bool IsSealed() const = 0;
+    // only building indexer has metrics
+    virtual std::shared_ptr<OperationLogMetrics> GetOperationLogMetrics() const { return nullptr; }
 
 private:
     AUTIL_LOG_DECLARE();
@@ -72,6 +72,7 @@ public:
     autil::StringView GetIndexType() const override;
     size_t GetTotalOperationCount() const;
     void RegisterMetrics(const std::shared_ptr<OperationLogMetrics>& metrics);
+    std::shared_ptr<OperationLogMetrics> GetOperationLogMetrics() const override { return _metrics; }
     void Seal() override;
     bool IsDirty() const override;
 
@@ -50,6 +50,29 @@ void OperationLogMetrics::RegisterMetrics()
     std::lock_guard<std::mutex> guard(_mutex);
     REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, operationWriterTotalOpCount,
                                          "build/operationWriterTotalOpCount", kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, operationRedoQps, "build/operationRedoQps", kmonitor::QPS);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, operationRedoLatency, "build/operationRedoLatency",
+                                         kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, operationRedoThroughput, "build/operationRedoThroughput",
+                                         kmonitor::GAUGE);
+}
+
+void OperationLogMetrics::ReportRedoMetrics(size_t redoOperationCount, int64_t redoLatencyInUs)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (_stop) {
+        return;
+    }
+    if (_operationRedoQpsMetric) {
+        _operationRedoQpsMetric->IncreaseQps(redoOperationCount, _tags.get());
+    }
+    if (_operationRedoLatencyMetric) {
+        _operationRedoLatencyMetric->Report(_tags.get(), redoLatencyInUs);
+    }
+    if (_operationRedoThroughputMetric && redoLatencyInUs > 0) {
+        // operations per second
+        _operationRedoThroughputMetric->Report(_tags.get(), redoOperationCount * 1000000.0 / redoLatencyInUs);
+    }
 }
 
 } // namespace indexlib::index
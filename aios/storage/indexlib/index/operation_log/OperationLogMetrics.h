@@ -43,11 +43,16 @@ public:
     void ReportMetrics() override;
     void RegisterMetrics() override;
     void Stop();
+    // redo throughput of operation log replayer, reported once for each redo
+    void ReportRedoMetrics(size_t redoOperationCount, int64_t redoLatencyInUs);
 
 private:
     std::shared_ptr<kmonitor::MetricsReporter> _metricsReporter;
     std::function<size_t()> _getOperationCountFunc;
     std::shared_ptr<util::Metric> _operationWriterTotalOpCountMetric;
+    std::shared_ptr<util::Metric> _operationRedoQpsMetric;
+    std::shared_ptr<util::Metric> _operationRedoLatencyMetric;
+    std::shared_ptr<util::Metric> _operationRedoThroughputMetric;
     std::shared_ptr<kmonitor::MetricsTags> _tags;
     bool _stop;
     std::mutex _mutex;
@@ -15,18 +15,61 @@
  */
 #include "indexlib/index/operation_log/OperationLogReplayer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+
+#include "autil/Scope.h"
+#include "autil/ThreadPool.h"
+#include "autil/TimeUtility.h"
 #include "autil/UnitUtil.h"
+#include "autil/mem_pool/Pool.h"
 #include "indexlib/base/MemoryQuotaController.h"
 #include "indexlib/index/operation_log/OperationBase.h"
 #include "indexlib/index/operation_log/OperationCursor.h"
 #include "indexlib/index/operation_log/OperationIterator.h"
 #include "indexlib/index/operation_log/OperationLogIndexer.h"
+#include "indexlib/index/operation_log/OperationLogMetrics.h"
 #include "indexlib/index/operation_log/OperationLogProcessor.h"
 #include "indexlib/index/operation_log/OperationRedoStrategy.h"
 
 namespace indexlib::index {
 namespace {
 using indexlibv2::framework::Locator;
+
+// inverted index modifiers create indexers and report build resource metrics lazily on shared state,
+// token updates from different partitions are applied one at a time
+class TokenSerializedProcessor : public OperationLogProcessor
+{
+public:
+    explicit TokenSerializedProcessor(OperationLogProcessor* processor) : _processor(processor) {}
+
+    Status RemoveDocument(docid_t docid) override { return _processor->RemoveDocument(docid); }
+    bool UpdateFieldValue(docid_t docId, const std::string& fieldName, const autil::StringView& value,
+                          bool isNull) override
+    {
+        return _processor->UpdateFieldValue(docId, fieldName, value, isNull);
+    }
+    Status UpdateFieldTokens(docid_t docId, const document::ModifiedTokens& modifiedTokens) override
+    {
+        std::lock_guard<std::mutex> guard(_tokenMutex);
+        return _processor->UpdateFieldTokens(docId, modifiedTokens);
+    }
+
+private:
+    OperationLogProcessor* _processor;
+    std::mutex _tokenMutex;
+};
+
+// low 64 bits of pk hash, collisions only cause an extra batch flush
+uint64_t GetPkHashKey(const OperationBase* operation)
+{
+    uint64_t key = 0;
+    memcpy(&key, operation->GetPkHashPointer(), sizeof(key));
+    return key;
+}
 } // namespace
 
 AUTIL_LOG_SETUP(indexlib.index, OperationLogReplayer);
@@ -83,6 +126,30 @@ std::pair<Status, OperationCursor> OperationLogReplayer::InnerDoOperation(const
     RETURN2_IF_STATUS_ERROR(iter.Init(skipCursor, locator), invalidCursor, "init operation iterator failed");
     OperationCursor lastCursur = skipCursor;
     size_t updateCount = 0, deleteCount = 0, skipUpdateCount = 0, skipDeleteCount = 0;
+    int64_t beginTime = autil::TimeUtility::currentTimeInMicroSeconds();
+
+    std::unique_ptr<autil::ThreadPool> threadPool;
+    if (params.parallelRedoThreadCount > 1 && !params.partitionBaseDocids.empty()) {
+        threadPool = std::make_unique<autil::ThreadPool>(params.parallelRedoThreadCount,
+                                                         autil::ThreadPool::DEFAULT_QUEUESIZE);
+        if (!threadPool->start("OpLogRedo")) {
+            AUTIL_LOG(WARN, "start redo thread pool failed, redo in serial");
+            threadPool.reset();
+        }
+    }
+    // operations of iterator may be released when switching block, clone them to pool in parallel mode
+    autil::mem_pool::Pool pool;
+    std::vector<RedoItem> redoItems;
+    // pk of delete operations in current batch, docids of later operations with same pk are resolved after the
+    // batch is applied
+    std::unordered_set<uint64_t> deletedPkInBatch;
+    autil::ScopeGuard redoItemsGuard([this, &redoItems, &pool]() { ResetRedoItems(redoItems, &pool); });
+    auto flushRedoItems = [&]() -> bool {
+        bool ret = RedoBatchOperations(params, threadPool.get(), redoItems);
+        ResetRedoItems(redoItems, &pool);
+        deletedPkInBatch.clear();
+        return ret;
+    };
     while (true) {
         auto [nextStatus, hasNext] = iter.HasNext();
         RETURN2_IF_STATUS_ERROR(nextStatus, invalidCursor, "move to next failed");
@@ -111,7 +178,29 @@ std::pair<Status, OperationCursor> OperationLogReplayer::InnerDoOperation(const
                 AUTIL_LOG(ERROR, "left memory [%s] is not enough", autil::UnitUtil::GiBDebugString(leftMemory).c_str());
                 return {Status::NoMem("left memory is not enough"), invalidCursor};
             }
-            if (!RedoOneOperation(pkReader, processor, operation, targetDocRanges)) {
+            if (threadPool) {
+                uint64_t pkHashKey = GetPkHashKey(operation);
+                if (deletedPkInBatch.count(pkHashKey) > 0 && !flushRedoItems()) {
+                    AUTIL_LOG(ERROR, "redo batch operations failed");
+                    return {Status::InternalError("redo operation failed"), invalidCursor};
+                }
+                if (docType == DELETE_DOC) {
+                    deletedPkInBatch.insert(pkHashKey);
+                }
+                RedoItem item;
+                item.operation = operation->Clone(&pool);
+                if (!item.operation) {
+                    return {Status::NoMem("clone operation failed"), invalidCursor};
+                }
+                item.targetDocRanges = std::move(targetDocRanges);
+                redoItems.push_back(std::move(item));
+                if (redoItems.size() >= PARALLEL_REDO_BATCH_SIZE || pool.getUsedBytes() >= PARALLEL_REDO_BATCH_MEMORY) {
+                    if (!flushRedoItems()) {
+                        AUTIL_LOG(ERROR, "redo batch operations failed");
+                        return {Status::InternalError("redo operation failed"), invalidCursor};
+                    }
+                }
+            } else if (!RedoOneOperation(pkReader, processor, operation, targetDocRanges)) {
                 AUTIL_LOG(ERROR, "redo operation failed");
                 return {Status::InternalError("redo operation failed"), invalidCursor};
             }
@@ -127,13 +216,89 @@ std::pair<Status, OperationCursor> OperationLogReplayer::InnerDoOperation(const
             break;
         }
     }
+    if (!redoItems.empty()) {
+        if (!flushRedoItems()) {
+            AUTIL_LOG(ERROR, "redo batch operations failed");
+            return {Status::InternalError("redo operation failed"), invalidCursor};
+        }
+    }
+    if (threadPool) {
+        threadPool->stop();
+    }
+    int64_t redoLatency = autil::TimeUtility::currentTimeInMicroSeconds() - beginTime;
     AUTIL_LOG(
         INFO,
-        "update redo count [%lu], delete redo count [%lu], skip update redo count[%lu], skip delete redo count [%lu]",
-        updateCount, deleteCount, skipUpdateCount, skipDeleteCount);
+        "update redo count [%lu], delete redo count [%lu], skip update redo count[%lu], skip delete redo count [%lu], "
+        "redo thread count [%lu], use [%ld] us",
+        updateCount, deleteCount, skipUpdateCount, skipDeleteCount, threadPool ? params.parallelRedoThreadCount : 1,
+        redoLatency);
+    ReportRedoMetrics(updateCount + deleteCount, redoLatency);
     return {Status::OK(), lastCursur};
 }
 
+bool OperationLogReplayer::RedoBatchOperations(const RedoParams& params, autil::ThreadPool* threadPool,
+                                               std::vector<RedoItem>& redoItems) const
+{
+    auto pkReader = params.pkReader;
+    TokenSerializedProcessor processor(params.processor);
+    int threadCount = params.parallelRedoThreadCount;
+
+    // resolve target docids, pk lookup is read only
+    size_t step = (redoItems.size() + threadCount - 1) / threadCount;
+    threadPool->blockingParallel(threadCount, [&](int idx) -> bool {
+        size_t end = std::min(redoItems.size(), step * (idx + 1));
+        for (size_t i = step * idx; i < end; ++i) {
+            redoItems[i].docId = redoItems[i].operation->LookupDocId(pkReader, redoItems[i].targetDocRanges);
+        }
+        return true;
+    });
+
+    // partition by target docid, keep operation order of same doc
+    const auto& baseDocids = params.partitionBaseDocids;
+    std::vector<std::vector<size_t>> partitions(baseDocids.size());
+    for (size_t i = 0; i < redoItems.size(); ++i) {
+        docid_t docId = redoItems[i].docId;
+        if (docId == INVALID_DOCID) {
+            continue;
+        }
+        size_t partitionIdx = std::upper_bound(baseDocids.begin(), baseDocids.end(), docId) - baseDocids.begin();
+        partitions[partitionIdx > 0 ? partitionIdx - 1 : 0].push_back(i);
+    }
+
+    std::atomic<size_t> nextPartition(0);
+    threadPool->blockingParallel(threadCount, [&](int idx) -> bool {
+        size_t partitionIdx = 0;
+        while ((partitionIdx = nextPartition.fetch_add(1)) < partitions.size()) {
+            for (size_t itemIdx : partitions[partitionIdx]) {
+                const auto& item = redoItems[itemIdx];
+                [[maybe_unused]] bool processResult = item.operation->ProcessDoc(item.docId, &processor);
+            }
+        }
+        return true;
+    });
+    return true;
+}
+
+void OperationLogReplayer::ResetRedoItems(std::vector<RedoItem>& redoItems, autil::mem_pool::Pool* pool) const
+{
+    for (auto& item : redoItems) {
+        item.operation->~OperationBase();
+    }
+    redoItems.clear();
+    pool->reset();
+}
+
+void OperationLogReplayer::ReportRedoMetrics(size_t redoOperationCount, int64_t redoLatencyInUs) const
+{
+    for (auto iter = _indexers.rbegin(); iter != _indexers.rend(); ++iter) {
+        auto metrics = (*iter)->GetOperationLogMetrics();
+        if (metrics) {
+            metrics->ReportRedoMetrics(redoOperationCount, redoLatencyInUs);
+            return;
+        }
+    }
+}
+
 bool OperationLogReplayer::RedoOneOperation(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                                             OperationBase* operation,
                                             const std::vector<std::pair<docid_t, docid_t>>& targetRanges) const
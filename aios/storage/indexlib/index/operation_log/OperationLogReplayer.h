@@ -19,6 +19,12 @@
 #include "indexlib/base/Status.h"
 #include "indexlib/base/Types.h"
 
+namespace autil {
+class ThreadPool;
+}
+namespace autil::mem_pool {
+class Pool;
+}
 namespace indexlibv2 {
 class MemoryQuotaController;
 }
@@ -45,6 +51,13 @@ public:
         OperationLogProcessor* processor;
         const OperationRedoStrategy* redoStrategy;
         indexlibv2::MemoryQuotaController* memoryQuotaController;
+        // redo in parallel when thread count > 1: target docids of a batch of operations are resolved
+        // concurrently, then operations are partitioned by partitionBaseDocids (ascending, processor should
+        // allow concurrent RemoveDocument/UpdateFieldValue on different partitions, e.g. segment base docids)
+        // and applied concurrently, operations inside one partition keep original order. UpdateFieldTokens
+        // is serialized. A batch ends before an operation whose pk is deleted earlier in the same batch
+        size_t parallelRedoThreadCount = 0;
+        std::vector<docid_t> partitionBaseDocids;
     };
 
 public:
@@ -64,6 +77,20 @@ private:
     bool RedoOneOperation(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                           OperationBase* operation, const std::vector<std::pair<docid_t, docid_t>>& targetRange) const;
 
+    struct RedoItem {
+        OperationBase* operation = nullptr;
+        std::vector<std::pair<docid_t, docid_t>> targetDocRanges;
+        docid_t docId = INVALID_DOCID;
+    };
+    bool RedoBatchOperations(const RedoParams& params, autil::ThreadPool* threadPool,
+                             std::vector<RedoItem>& redoItems) const;
+    void ResetRedoItems(std::vector<RedoItem>& redoItems, autil::mem_pool::Pool* pool) const;
+    void ReportRedoMetrics(size_t redoOperationCount, int64_t redoLatencyInUs) const;
+
+private:
+    static constexpr size_t PARALLEL_REDO_BATCH_SIZE = 64 * 1024;
+    static constexpr size_t PARALLEL_REDO_BATCH_MEMORY = 64 * 1024 * 1024; // 64MB
+
 private:
     std::vector<std::shared_ptr<OperationLogIndexer>> _indexers;
     std::shared_ptr<OperationLogConfig> _indexConfig;
@@ -43,6 +43,9 @@ public:
     const T& GetPkHash() const { return _pkHash; }
     bool Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                  const std::vector<std::pair<docid_t, docid_t>>& docidRange) const override;
+    docid_t LookupDocId(const PrimaryKeyIndexReader* pkReader,
+                        const std::vector<std::pair<docid_t, docid_t>>& docidRange) const override;
+    bool ProcessDoc(docid_t docId, OperationLogProcessor* processor) const override;
     const char* GetPkHashPointer() const override { return (char*)(&_pkHash); }
 
 private:
@@ -94,17 +97,33 @@ size_t RemoveOperation<T>::Serialize(char* buffer, size_t bufferLen) const
 template <typename T>
 bool RemoveOperation<T>::Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                                  const std::vector<std::pair<docid_t, docid_t>>& docidRanges) const
+{
+    auto docId = LookupDocId(pkReader, docidRanges);
+    if (docId == INVALID_DOCID) {
+        return true;
+    }
+    return ProcessDoc(docId, processor);
+}
+
+template <typename T>
+docid_t RemoveOperation<T>::LookupDocId(const PrimaryKeyIndexReader* pkReader,
+                                        const std::vector<std::pair<docid_t, docid_t>>& docidRanges) const
 {
     // TODO(mokauo.mnb) add executor
     for (const auto& docidRange : docidRanges) {
         auto docId = pkReader->LookupWithDocRange(_pkHash, docidRange, nullptr);
-        if (docId == INVALID_DOCID) {
-            continue;
+        if (docId != INVALID_DOCID) {
+            return docId;
         }
-        auto status = processor->RemoveDocument(docId);
-        return status.IsOK();
     }
-    return true;
+    return INVALID_DOCID;
+}
+
+template <typename T>
+bool RemoveOperation<T>::ProcessDoc(docid_t docId, OperationLogProcessor* processor) const
+{
+    auto status = processor->RemoveDocument(docId);
+    return status.IsOK();
 }
 
 } // namespace indexlib::index
@@ -49,6 +49,9 @@ public:
     const T& GetPkHash() const { return _pkHash; }
     bool Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                  const std::vector<std::pair<docid_t, docid_t>>& docidRange) const override;
+    docid_t LookupDocId(const PrimaryKeyIndexReader* pkReader,
+                        const std::vector<std::pair<docid_t, docid_t>>& docidRange) const override;
+    bool ProcessDoc(docid_t docId, OperationLogProcessor* processor) const override;
     size_t GetItemSize() { return _itemSize; }
     OperationItem GetOperationItem(size_t itemIdx) { return _items[itemIdx]; }
     const char* GetPkHashPointer() const override { return (char*)(&_pkHash); }
@@ -93,42 +96,58 @@ bool UpdateFieldOperation<T>::Process(const PrimaryKeyIndexReader* pkIndexReader
 {
     assert(processor != nullptr);
     assert(pkIndexReader != nullptr);
+    docid_t docId = LookupDocId(pkIndexReader, docIdRanges);
+    if (docId == INVALID_DOCID) {
+        return true;
+    }
+    return ProcessDoc(docId, processor);
+}
+
+template <typename T>
+docid_t UpdateFieldOperation<T>::LookupDocId(const PrimaryKeyIndexReader* pkIndexReader,
+                                             const std::vector<std::pair<docid_t, docid_t>>& docIdRanges) const
+{
     for (const auto& docIdRange : docIdRanges) {
         docid_t docId = pkIndexReader->LookupWithDocRange(_pkHash, docIdRange, /*executor*/ nullptr);
-        if (docId == INVALID_DOCID) {
+        if (docId != INVALID_DOCID) {
+            return docId;
+        }
+    }
+    return INVALID_DOCID;
+}
+
+template <typename T>
+bool UpdateFieldOperation<T>::ProcessDoc(docid_t docId, OperationLogProcessor* processor) const
+{
+    bool isAfterSeparator = false;
+    for (uint32_t i = 0; i < _itemSize; i++) {
+        const auto& item = _items[i];
+        fieldid_t fieldId = item.first;
+        if (fieldId == INVALID_FIELDID) {
+            isAfterSeparator = true;
             continue;
         }
-        bool isAfterSeparator = false;
-        for (uint32_t i = 0; i < _itemSize; i++) {
-            const auto& item = _items[i];
-            fieldid_t fieldId = item.first;
-            if (fieldId == INVALID_FIELDID) {
-                isAfterSeparator = true;
+        if (!isAfterSeparator) {
+            // attribute
+            const std::string& fieldName = _operationFieldInfo->GetFieldName(fieldId);
+            if (unlikely(fieldName.empty())) {
                 continue;
             }
-            if (!isAfterSeparator) {
-                // attribute
-                const std::string& fieldName = _operationFieldInfo->GetFieldName(fieldId);
-                if (unlikely(fieldName.empty())) {
-                    continue;
-                }
-                const autil::StringView& value = item.second;
-                bool ret = processor->UpdateFieldValue(docId, fieldName, value, value.empty());
-                if (!ret) {
-                    AUTIL_INTERVAL_LOG2(2, ERROR, "process update field op for doc [%d] failed", docId);
-                }
-            } else {
-                // inverted index
-                autil::DataBuffer buffer((char*)item.second.data(), item.second.size());
-                document::ModifiedTokens modifiedTokens;
-                modifiedTokens.Deserialize(buffer);
-                auto status = processor->UpdateFieldTokens(docId, modifiedTokens);
-                if (not status.IsOK()) {
-                    AUTIL_LOG(WARN, "process update field op for doc [%d] failed", docId);
-                }
+            const autil::StringView& value = item.second;
+            bool ret = processor->UpdateFieldValue(docId, fieldName, value, value.empty());
+            if (!ret) {
+                AUTIL_INTERVAL_LOG2(2, ERROR, "process update field op for doc [%d] failed", docId);
+            }
+        } else {
+            // inverted index
+            autil::DataBuffer buffer((char*)item.second.data(), item.second.size());
+            document::ModifiedTokens modifiedTokens;
+            modifiedTokens.Deserialize(buffer);
+            auto status = processor->UpdateFieldTokens(docId, modifiedTokens);
+            if (not status.IsOK()) {
+                AUTIL_LOG(WARN, "process update field op for doc [%d] failed", docId);
             }
         }
-        return true;
     }
     return true;
 }
@@ -216,11 +235,12 @@ OperationBase* UpdateFieldOperation<T>::Clone(autil::mem_pool::Pool* pool)
 
     UpdateFieldOperation* clonedOperation =
         IE_POOL_COMPATIBLE_NEW_CLASS(pool, UpdateFieldOperation, GetTimestamp(), _hashId);
-    clonedOperation->Init(GetPkHash(), clonedItems, _itemSize, GetSegmentId());
     if (!clonedOperation) {
         AUTIL_LOG(ERROR, "allocate memory fail!");
         return NULL;
     }
+    clonedOperation->Init(GetPkHash(), clonedItems, _itemSize, GetSegmentId());
+    clonedOperation->SetOperationFieldInfo(_operationFieldInfo);
     return clonedOperation;
 }
 
@@ -73,6 +73,26 @@ public:
         }
     }
 
+    // data blocks are read through file system, keys are filtered by bloom filter and looked up one by one
+    indexlib::index::ErrorCode BatchLookup(const Key* hashKeys, size_t count, docid_t* docids) noexcept
+    {
+        indexlib::file_system::ReadOption readOption;
+        for (size_t i = 0; i < count; ++i) {
+            docids[i] = INVALID_DOCID;
+            if (_bloomFilter && !_bloomFilter->Contains(hashKeys[i])) {
+                continue;
+            }
+            auto ret = _blockArrayReader.Find(hashKeys[i], readOption, &docids[i]);
+            if (!ret.Ok()) {
+                return ret.GetErrorCode();
+            }
+            if (!ret.Value()) {
+                docids[i] = INVALID_DOCID;
+            }
+        }
+        return indexlib::index::ErrorCode::OK;
+    }
+
     size_t EvaluateCurrentMemUsed() const override
     {
         size_t bloomFilterSize = 0;
@@ -35,6 +35,11 @@ public:
     {
         return _pkHashTable.Find(hashKey);
     }
+    indexlib::index::ErrorCode BatchLookup(const Key* hashKeys, size_t count, docid_t* docids) noexcept
+    {
+        _pkHashTable.BatchFind(hashKeys, count, docids);
+        return indexlib::index::ErrorCode::OK;
+    }
 
 private:
     void* _data;
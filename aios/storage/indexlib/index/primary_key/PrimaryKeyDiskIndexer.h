@@ -190,6 +190,27 @@ public:
         }
     }
 
+    // docids[i] is local docid of hashKeys[i], INVALID_DOCID if not found
+    indexlib::index::ErrorCode BatchLookup(const Key* hashKeys, size_t count, docid_t* docids) const noexcept
+    {
+        switch (_pkIndexType) {
+        case pk_hash_table: {
+            return _hashTablePrimaryKeyDiskIndexer->BatchLookup(hashKeys, count, docids);
+        }
+        case pk_sort_array: {
+            return _sortArrayPrimaryKeyDiskIndexer->BatchLookup(hashKeys, count, docids);
+        }
+        case pk_block_array: {
+            return _blockArrayPrimaryKeyDiskIndexer->BatchLookup(hashKeys, count, docids);
+        }
+        default: {
+            AUTIL_LOG(ERROR, "unsupport pk index type!");
+            std::fill(docids, docids + count, INVALID_DOCID);
+            return indexlib::index::ErrorCode::OK;
+        }
+        }
+    }
+
     static size_t CalculateLoadSize(const std::shared_ptr<indexlibv2::index::PrimaryKeyIndexConfig>& indexConfig,
                                     const std::shared_ptr<indexlib::file_system::IDirectory>& dir,
                                     const std::string& fileName)
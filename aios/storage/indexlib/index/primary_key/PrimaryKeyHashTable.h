@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 
@@ -105,6 +106,41 @@ public:
         return INVALID_DOCID;
     }
 
+    // probe keys in groups, buckets and chain heads of a group are prefetched before walking the chains,
+    // so that cache misses of different keys overlap
+    void BatchFind(const Key* keys, size_t count, docid_t* docids) const
+    {
+        indexlib::util::KeyHash<Key> hashFun;
+        uint64_t bucketIdxs[BATCH_FIND_GROUP_SIZE];
+        for (size_t begin = 0; begin < count; begin += BATCH_FIND_GROUP_SIZE) {
+            size_t groupSize = std::min(count - begin, BATCH_FIND_GROUP_SIZE);
+            for (size_t i = 0; i < groupSize; ++i) {
+                bucketIdxs[i] = hashFun(keys[begin + i]) % _bucketCount;
+                __builtin_prefetch(&_bucketPtr[bucketIdxs[i]], 0, 1);
+            }
+            for (size_t i = 0; i < groupSize; ++i) {
+                docid_t next = _bucketPtr[bucketIdxs[i]];
+                if (next != INVALID_DOCID) {
+                    __builtin_prefetch(&_pkPairPtr[next], 0, 1);
+                }
+                docids[begin + i] = next;
+            }
+            for (size_t i = 0; i < groupSize; ++i) {
+                const Key& key = keys[begin + i];
+                docid_t next = docids[begin + i];
+                docids[begin + i] = INVALID_DOCID;
+                while (next != INVALID_DOCID) {
+                    const PKPairTyped& pkPair = _pkPairPtr[next];
+                    if (likely(pkPair.key == key)) {
+                        docids[begin + i] = next;
+                        break;
+                    }
+                    next = pkPair.docid;
+                }
+            }
+        }
+    }
+
 public:
     static bool SeekToPkPair(const indexlib::file_system::FileReaderPtr& fileReader, uint64_t& pkCount)
     {
@@ -153,6 +189,7 @@ private:
     }
 
 private:
+    static constexpr size_t BATCH_FIND_GROUP_SIZE = 16;
     static docid_t NON_EXIST_DOCID;
     static PKPairTyped INVALID_PK_PAIR;
     static double BUCKET_COUNT_FACTOR;
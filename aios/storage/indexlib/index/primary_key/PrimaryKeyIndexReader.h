@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "autil/ConstString.h"
 #include "autil/MultiValueType.h"
@@ -67,6 +68,16 @@ public:
     virtual docid_t LookupWithPKHash(const autil::uint128_t& pkHash,
                                      future_lite::Executor* executor = nullptr) const = 0;
     virtual bool LookupWithPKHash(const autil::uint128_t& pkHash, segmentid_t specifySegment, docid_t* docid) const = 0;
+    // result[i] is docid of pkHashes[i], INVALID_DOCID if not found or deleted
+    virtual std::vector<docid_t> BatchLookupWithPKHash(const std::vector<autil::uint128_t>& pkHashes) const
+    {
+        std::vector<docid_t> docids;
+        docids.reserve(pkHashes.size());
+        for (const auto& pkHash : pkHashes) {
+            docids.push_back(LookupWithPKHash(pkHash));
+        }
+        return docids;
+    }
 
     virtual std::shared_ptr<indexlibv2::index::AttributeReader> GetPKAttributeReader() const = 0;
 
@@ -109,6 +109,7 @@ public:
     docid_t LookupWithHintValues(const autil::uint128_t& pkHash, int32_t hintValues) const override;
     docid_t LookupWithPKHash(const autil::uint128_t& pkHash, future_lite::Executor* executor) const override;
     bool LookupWithPKHash(const autil::uint128_t& pkHash, segmentid_t specifySegment, docid_t* docid) const override;
+    std::vector<docid_t> BatchLookupWithPKHash(const std::vector<autil::uint128_t>& pkHashes) const override;
     docid_t LookupWithDocRange(const autil::uint128_t& pkHash, std::pair<docid_t, docid_t> docRange,
                                future_lite::Executor* executor) const override;
     bool LookupAll(const std::string& pkStr, std::vector<std::pair<docid_t, bool>>& docidPairVec) const override;
@@ -121,6 +122,8 @@ public:
     docid_t Lookup(const Key& key, future_lite::Executor* executor = nullptr) const __ALWAYS_INLINE;
     docid_t Lookup(const Key& key, docid_t& lastDocId) const;
     docid_t Lookup(const std::string& pkStr, docid_t& lastDocId) const;
+    // resolve keys segment by segment, each segment is probed once with all unresolved keys
+    std::vector<docid_t> BatchLookup(const std::vector<Key>& hashKeys) const;
 
 public:
     static std::string Identifier()
@@ -710,6 +713,82 @@ inline docid_t PrimaryKeyReader<Key, DerivedType>::LookupWithDocRange(const auti
     }
 }
 
+template <typename Key, typename DerivedType>
+std::vector<docid_t>
+PrimaryKeyReader<Key, DerivedType>::BatchLookupWithPKHash(const std::vector<autil::uint128_t>& pkHashes) const
+{
+    std::vector<Key> hashKeys;
+    hashKeys.reserve(pkHashes.size());
+    for (const auto& pkHash : pkHashes) {
+        if constexpr (std::is_same_v<Key, autil::uint128_t>) {
+            hashKeys.push_back(pkHash);
+        } else {
+            assert((std::is_same_v<Key, uint64_t>));
+            hashKeys.push_back(pkHash.value[1]);
+        }
+    }
+    return BatchLookup(hashKeys);
+}
+
+template <typename Key, typename DerivedType>
+std::vector<docid_t> PrimaryKeyReader<Key, DerivedType>::BatchLookup(const std::vector<Key>& hashKeys) const
+{
+    std::vector<docid_t> docIds(hashKeys.size(), INVALID_DOCID);
+    // positions of keys not resolved yet
+    std::vector<size_t> pendings;
+    pendings.reserve(hashKeys.size());
+    for (size_t i = 0; i < hashKeys.size(); ++i) {
+        if (_needLookupReverse) {
+            docid_t docId = LookupInMemorySegment(hashKeys[i]);
+            if (IsDocIdValid(docId)) {
+                docIds[i] = docId;
+                continue;
+            }
+        }
+        pendings.push_back(i);
+    }
+
+    std::vector<Key> pendingKeys;
+    std::vector<docid_t> localDocIds;
+    for (const auto& readerInfo : _segmentReaderList) {
+        if (pendings.empty()) {
+            break;
+        }
+        pendingKeys.resize(pendings.size());
+        localDocIds.resize(pendings.size());
+        for (size_t i = 0; i < pendings.size(); ++i) {
+            pendingKeys[i] = hashKeys[pendings[i]];
+        }
+        auto ec = readerInfo._segmentPair.second->BatchLookup(pendingKeys.data(), pendingKeys.size(),
+                                                              localDocIds.data());
+        indexlib::index::ThrowIfError(ec);
+        docid_t baseDocid = readerInfo._segmentPair.first;
+        size_t leftCount = 0;
+        for (size_t i = 0; i < pendings.size(); ++i) {
+            if (localDocIds[i] != INVALID_DOCID) {
+                docid_t gDocId = baseDocid + localDocIds[i];
+                // for inc cover rt, rt doc deleted use inc doc
+                if (IsDocIdValid(gDocId)) {
+                    docIds[pendings[i]] = gDocId;
+                    continue;
+                }
+            }
+            pendings[leftCount++] = pendings[i];
+        }
+        pendings.resize(leftCount);
+    }
+
+    if (!_needLookupReverse) {
+        for (size_t pos : pendings) {
+            docid_t docId = LookupInMemorySegment(hashKeys[pos]);
+            if (IsDocIdValid(docId)) {
+                docIds[pos] = docId;
+            }
+        }
+    }
+    return docIds;
+}
+
 template <typename Key, typename DerivedType>
 bool PrimaryKeyReader<Key, DerivedType>::LookupAll(const std::string& pkStr,
                                                    std::vector<std::pair<docid_t, bool>>& docidPairVec) const
@@ -47,6 +47,50 @@ public:
         return INVALID_DOCID;
     }
 
+    // interleaved binary search of a group of keys, probes of next step are prefetched for all keys of the group
+    indexlib::index::ErrorCode BatchLookup(const Key* hashKeys, size_t count, docid_t* docids) noexcept
+    {
+        size_t keyIdxs[BATCH_LOOKUP_GROUP_SIZE];
+        PKPairTyped* bases[BATCH_LOOKUP_GROUP_SIZE];
+        PKPairTyped* begin = (PKPairTyped*)_data;
+        PKPairTyped* end = begin + _itemCount;
+        size_t cursor = 0;
+        while (cursor < count) {
+            size_t groupSize = 0;
+            for (; cursor < count && groupSize < BATCH_LOOKUP_GROUP_SIZE; ++cursor) {
+                docids[cursor] = INVALID_DOCID;
+                if (_bloomFilter && !_bloomFilter->Contains(hashKeys[cursor])) {
+                    continue;
+                }
+                keyIdxs[groupSize] = cursor;
+                bases[groupSize] = begin;
+                ++groupSize;
+            }
+            if (groupSize == 0 || _itemCount == 0) {
+                continue;
+            }
+            size_t n = _itemCount;
+            while (n > 1) {
+                size_t half = n / 2;
+                for (size_t i = 0; i < groupSize; ++i) {
+                    bases[i] = (bases[i][half].key < hashKeys[keyIdxs[i]]) ? bases[i] + half : bases[i];
+                }
+                n -= half;
+                for (size_t i = 0; i < groupSize; ++i) {
+                    __builtin_prefetch(bases[i] + n / 2, 0, 1);
+                }
+            }
+            for (size_t i = 0; i < groupSize; ++i) {
+                const Key& hashKey = hashKeys[keyIdxs[i]];
+                PKPairTyped* iter = bases[i] + (bases[i]->key < hashKey ? 1 : 0);
+                if (iter != end && iter->key == hashKey) {
+                    docids[keyIdxs[i]] = iter->docid;
+                }
+            }
+        }
+        return indexlib::index::ErrorCode::OK;
+    }
+
     size_t EvaluateCurrentMemUsed() const override
     {
         size_t bloomFilterSize = 0;
@@ -56,6 +100,9 @@ public:
         return PrimaryKeyDiskIndexerTyped<Key>::EvaluateCurrentMemUsed() + bloomFilterSize;
     }
 
+private:
+    static constexpr size_t BATCH_LOOKUP_GROUP_SIZE = 16;
+
 private:
     uint32_t _itemCount;
     void* _data;
@@ -15,6 +15,7 @@
  */
 #include "indexlib/index/summary/LocalDiskSummaryDiskIndexer.h"
 
+#include "autil/TimeUtility.h"
 #include "autil/mem_pool/Pool.h"
 #include "indexlib/config/GroupDataParameter.h"
 #include "indexlib/document/normal/SearchSummaryDocument.h"
@@ -151,7 +152,7 @@ LocalDiskSummaryDiskIndexer::GetDocument(docid_t localDocId,
 future_lite::coro::Lazy<std::vector<indexlib::index::ErrorCode>>
 LocalDiskSummaryDiskIndexer::GetDocument(const std::vector<docid_t>& docIds, autil::mem_pool::Pool* sessionPool,
                                          indexlib::file_system::ReadOption readOption,
-                                         const SearchSummaryDocVec* docs) noexcept
+                                         const SearchSummaryDocVec* docs, SummaryFetchStat* stat) noexcept
 {
     std::vector<indexlib::index::ErrorCode> ec(docIds.size(), indexlib::index::ErrorCode::OK);
     if (!_summaryGroupConfig->NeedStoreSummary()) {
@@ -160,7 +161,9 @@ LocalDiskSummaryDiskIndexer::GetDocument(const std::vector<docid_t>& docIds, aut
     assert(docs);
     assert(docIds.size() == docs->size());
     std::vector<autil::StringView> datas;
-    auto ret = co_await _dataReader->GetValue(docIds, sessionPool, readOption, &datas);
+    VarLenDataReadStat readStat;
+    auto ret = co_await _dataReader->GetValue(docIds, sessionPool, readOption, &datas, stat ? &readStat : nullptr);
+    int64_t deserializeBeginTime = stat ? autil::TimeUtility::currentTimeInMicroSeconds() : 0;
 
     assert(ret.size() == docIds.size());
     for (size_t i = 0; i < ret.size(); ++i) {
@@ -178,6 +181,12 @@ LocalDiskSummaryDiskIndexer::GetDocument(const std::vector<docid_t>& docIds, aut
             continue;
         }
     }
+    if (stat) {
+        stat->offsetLatency += readStat.offsetLatency;
+        stat->dataLatency += readStat.dataLatency;
+        stat->dataIOCount += readStat.dataIOCount;
+        stat->deserializeLatency += autil::TimeUtility::currentTimeInMicroSeconds() - deserializeBeginTime;
+    }
     co_return ec;
 }
 
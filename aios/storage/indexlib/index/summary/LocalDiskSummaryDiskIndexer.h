@@ -44,6 +44,22 @@ class SummaryGroupConfig;
 namespace indexlibv2::index {
 class VarLenDataReader;
 
+// per phase latency (us) of batch summary fetch, latencies of concurrent segments are summed up
+struct SummaryFetchStat {
+    int64_t offsetLatency = 0;
+    int64_t dataLatency = 0;
+    int64_t deserializeLatency = 0;
+    size_t dataIOCount = 0;
+
+    void Merge(const SummaryFetchStat& other)
+    {
+        offsetLatency += other.offsetLatency;
+        dataLatency += other.dataLatency;
+        deserializeLatency += other.deserializeLatency;
+        dataIOCount += other.dataIOCount;
+    }
+};
+
 class LocalDiskSummaryDiskIndexer : private autil::NoCopyable
 {
 public:
@@ -69,7 +85,8 @@ public:
     future_lite::coro::Lazy<indexlib::index::ErrorCodeVec> GetDocument(const std::vector<docid_t>& docIds,
                                                                        autil::mem_pool::Pool* sessionPool,
                                                                        indexlib::file_system::ReadOption readOption,
-                                                                       const SearchSummaryDocVec* docs) noexcept;
+                                                                       const SearchSummaryDocVec* docs,
+                                                                       SummaryFetchStat* stat = nullptr) noexcept;
 
 private:
     static std::pair<Status, std::shared_ptr<indexlib::file_system::IDirectory>>
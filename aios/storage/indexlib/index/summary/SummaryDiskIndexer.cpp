@@ -136,7 +136,7 @@ std::pair<Status, bool> SummaryDiskIndexer::GetDocument(docid_t docId, const Sum
 future_lite::coro::Lazy<indexlib::index::ErrorCodeVec>
 SummaryDiskIndexer::GetDocument(const std::vector<docid_t>& docIds, const SummaryGroupIdVec& groupVec,
                                 autil::mem_pool::Pool* sessionPool, indexlib::file_system::ReadOption option,
-                                const SearchSummaryDocVec* docs) const noexcept
+                                const SearchSummaryDocVec* docs, SummaryFetchStat* stat) const noexcept
 {
     std::vector<indexlib::index::ErrorCode> ec;
     for (size_t i = 0; i < groupVec.size(); ++i) {
@@ -148,10 +148,17 @@ SummaryDiskIndexer::GetDocument(const std::vector<docid_t>& docIds, const Summar
     }
 
     std::vector<future_lite::coro::Lazy<std::vector<indexlib::index::ErrorCode>>> tasks;
+    std::vector<SummaryFetchStat> groupStats(groupVec.size());
     for (size_t i = 0; i < groupVec.size(); ++i) {
-        tasks.push_back(_summaryGroups[groupVec[i]]->GetDocument(docIds, sessionPool, option, docs));
+        SummaryFetchStat* groupStat = stat ? &groupStats[i] : nullptr;
+        tasks.push_back(_summaryGroups[groupVec[i]]->GetDocument(docIds, sessionPool, option, docs, groupStat));
     }
     auto taskResults = co_await future_lite::coro::collectAll(std::move(tasks));
+    if (stat) {
+        for (const auto& groupStat : groupStats) {
+            stat->Merge(groupStat);
+        }
+    }
     for (size_t i = 0; i < docIds.size(); ++i) {
         ec.push_back(indexlib::index::ErrorCode::OK);
     }
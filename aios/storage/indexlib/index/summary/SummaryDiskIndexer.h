@@ -87,7 +87,8 @@ public:
                                                                        const SummaryGroupIdVec& groupVec,
                                                                        autil::mem_pool::Pool* sessionPool,
                                                                        indexlib::file_system::ReadOption option,
-                                                                       const SearchSummaryDocVec* docs) const noexcept;
+                                                                       const SearchSummaryDocVec* docs,
+                                                                       SummaryFetchStat* stat = nullptr) const noexcept;
 
 private:
     std::vector<std::shared_ptr<LocalDiskSummaryDiskIndexer>> _summaryGroups;
@@ -15,12 +15,14 @@
  */
 #include "indexlib/index/summary/SummaryIndexFactory.h"
 
+#include "indexlib/framework/MetricsManager.h"
 #include "indexlib/index/IndexerParameter.h"
 #include "indexlib/index/summary/Common.h"
 #include "indexlib/index/summary/SummaryDiskIndexer.h"
 #include "indexlib/index/summary/SummaryMemIndexer.h"
 #include "indexlib/index/summary/SummaryMerger.h"
 #include "indexlib/index/summary/SummaryReader.h"
+#include "indexlib/index/summary/SummaryReaderMetrics.h"
 #include "indexlib/index/summary/config/SummaryIndexConfig.h"
 
 namespace indexlibv2::index {
@@ -44,7 +46,14 @@ std::unique_ptr<IIndexReader>
 SummaryIndexFactory::CreateIndexReader(const std::shared_ptr<config::IIndexConfig>& indexConfig,
                                        const IndexerParameter& indexerParam) const
 {
-    return std::make_unique<SummaryReader>();
+    if (indexerParam.metricsManager == nullptr) {
+        return std::make_unique<SummaryReader>();
+    }
+    auto metrics = std::dynamic_pointer_cast<SummaryReaderMetrics>(indexerParam.metricsManager->CreateMetrics(
+        "__summary_reader_metrics_identifier", [&indexerParam]() -> std::shared_ptr<framework::IMetrics> {
+            return std::make_shared<SummaryReaderMetrics>(indexerParam.metricsManager->GetMetricsReporter());
+        }));
+    return std::make_unique<SummaryReader>(metrics);
 }
 
 std::unique_ptr<IIndexMerger>
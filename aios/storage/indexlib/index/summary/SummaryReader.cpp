@@ -15,6 +15,7 @@
  */
 #include "indexlib/index/summary/SummaryReader.h"
 
+#include "autil/TimeUtility.h"
 #include "indexlib/document/normal/SearchSummaryDocument.h"
 #include "indexlib/document/normal/SummaryGroupFormatter.h"
 #include "indexlib/index/attribute/AttributeIteratorBase.h"
@@ -306,8 +307,10 @@ SummaryReader::InnerGetDocumentAsync(const std::vector<docid_t>& docIds, const S
 future_lite::coro::Lazy<std::vector<future_lite::Try<indexlib::index::ErrorCodeVec>>>
 SummaryReader::GetBuiltSegmentTasks(const std::vector<docid_t>& docIds, const SummaryGroupIdVec& groupVec,
                                     autil::mem_pool::Pool* sessionPool, indexlib::file_system::ReadOption readOption,
-                                    const SummaryReader::SearchSummaryDocVec* docs) const noexcept
+                                    const SummaryReader::SearchSummaryDocVec* docs,
+                                    std::vector<SummaryFetchStat>* segmentStats) const noexcept
 {
+    // segments are fetched concurrently, each collects its own stat when required
     std::vector<future_lite::coro::Lazy<std::vector<indexlib::index::ErrorCode>>> segmentTasks;
 
     // get value from built segment async
@@ -331,7 +334,8 @@ SummaryReader::GetBuiltSegmentTasks(const std::vector<docid_t>& docIds, const Su
             segmentDocIds.push_back(std::move(currentSegmentDocId));
             segmentDocs.push_back(std::move(currentSegmentDocs));
             segmentTasks.push_back(_diskIndexers[i]->GetDocument(segmentDocIds[idx], groupVec, sessionPool, readOption,
-                                                                 &segmentDocs[idx]));
+                                                                 &segmentDocs[idx],
+                                                                 segmentStats ? &(*segmentStats)[i] : nullptr));
         }
     }
     co_return co_await future_lite::coro::collectAll(std::move(segmentTasks));
@@ -432,7 +436,21 @@ future_lite::coro::Lazy<indexlib::index::ErrorCodeVec> SummaryReader::GetDocumen
 
     std::vector<indexlib::index::ErrorCode> ret(docIds.size(), indexlib::index::ErrorCode::OK);
     // fill result for built segment
-    auto segmentResults = co_await GetBuiltSegmentTasks(docIds, groupVec, sessionPool, readOption, docs);
+    std::vector<SummaryFetchStat> segmentStats;
+    if (_metrics) {
+        segmentStats.resize(_segmentDocCount.size());
+    }
+    int64_t beginTime = autil::TimeUtility::currentTimeInMicroSeconds();
+    auto segmentResults = co_await GetBuiltSegmentTasks(docIds, groupVec, sessionPool, readOption, docs,
+                                                        _metrics ? &segmentStats : nullptr);
+    if (_metrics) {
+        SummaryFetchStat stat;
+        for (const auto& segmentStat : segmentStats) {
+            stat.Merge(segmentStat);
+        }
+        _metrics->ReportFetchMetrics(docIds.size(), autil::TimeUtility::currentTimeInMicroSeconds() - beginTime,
+                                     stat);
+    }
     size_t docIdx = 0;
     for (size_t i = 0; i < segmentResults.size(); ++i) {
         assert(!segmentResults[i].hasError());
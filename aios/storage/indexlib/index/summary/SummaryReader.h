@@ -23,6 +23,7 @@
 #include "indexlib/index/common/ErrorCode.h"
 #include "indexlib/index/primary_key/PrimaryKeyReader.h"
 #include "indexlib/index/summary/SummaryDiskIndexer.h"
+#include "indexlib/index/summary/SummaryReaderMetrics.h"
 
 namespace indexlib { namespace document {
 class SearchSummaryDocument;
@@ -42,6 +43,9 @@ class SummaryReader : public IIndexReader
 {
 public:
     SummaryReader() : _executor(nullptr) {};
+    explicit SummaryReader(const std::shared_ptr<SummaryReaderMetrics>& metrics) : _executor(nullptr), _metrics(metrics)
+    {
+    }
     virtual ~SummaryReader() = default;
 
     // indexer, segId, segStatus, docCount
@@ -123,7 +127,7 @@ private:
     future_lite::coro::Lazy<std::vector<future_lite::Try<indexlib::index::ErrorCodeVec>>>
     GetBuiltSegmentTasks(const std::vector<docid_t>& docIds, const SummaryGroupIdVec& groupVec,
                          autil::mem_pool::Pool* sessionPool, indexlib::file_system::ReadOption readOption,
-                         const SearchSummaryDocVec* docs) const noexcept;
+                         const SearchSummaryDocVec* docs, std::vector<SummaryFetchStat>* segmentStats) const noexcept;
     future_lite::coro::Lazy<indexlib::index::ErrorCodeVec>
     GetDocumentFromSummaryAsync(const std::vector<docid_t>& docIds, const SummaryGroupIdVec& groupVec,
                                 autil::mem_pool::Pool* sessionPool, indexlib::file_system::ReadOption readOption,
@@ -140,6 +144,7 @@ private:
     GroupAttributeReaderInfo _groupAttributeReaders;
     SummaryGroupIdVec _allGroupIds;
     future_lite::Executor* _executor;
+    std::shared_ptr<SummaryReaderMetrics> _metrics;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/summary/SummaryReaderMetrics.h"
+
+#include "indexlib/framework/MetricsWrapper.h"
+
+namespace indexlibv2::index {
+AUTIL_LOG_SETUP(indexlib.index, SummaryReaderMetrics);
+
+SummaryReaderMetrics::SummaryReaderMetrics(const std::shared_ptr<kmonitor::MetricsReporter>& metricsReporter)
+    : _metricsReporter(metricsReporter)
+{
+}
+
+SummaryReaderMetrics::~SummaryReaderMetrics() {}
+
+void SummaryReaderMetrics::RegisterMetrics()
+{
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchQps, "summary/fetchQps", kmonitor::QPS);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchDocCount, "summary/fetchDocCount",
+                                         kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchLatency, "summary/fetchLatency",
+                                         kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchOffsetLatency, "summary/fetchOffsetLatency",
+                                         kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchDataLatency, "summary/fetchDataLatency",
+                                         kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchDeserializeLatency,
+                                         "summary/fetchDeserializeLatency", kmonitor::GAUGE);
+    REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, summaryFetchIOCount, "summary/fetchIOCount",
+                                         kmonitor::GAUGE);
+}
+
+void SummaryReaderMetrics::ReportFetchMetrics(size_t docCount, int64_t fetchLatency, const SummaryFetchStat& stat)
+{
+    if (_summaryFetchQpsMetric) {
+        _summaryFetchQpsMetric->IncreaseQps();
+    }
+    if (_summaryFetchDocCountMetric) {
+        _summaryFetchDocCountMetric->Report(docCount);
+    }
+    if (_summaryFetchLatencyMetric) {
+        _summaryFetchLatencyMetric->Report(fetchLatency);
+    }
+    if (_summaryFetchOffsetLatencyMetric) {
+        _summaryFetchOffsetLatencyMetric->Report(stat.offsetLatency);
+    }
+    if (_summaryFetchDataLatencyMetric) {
+        _summaryFetchDataLatencyMetric->Report(stat.dataLatency);
+    }
+    if (_summaryFetchDeserializeLatencyMetric) {
+        _summaryFetchDeserializeLatencyMetric->Report(stat.deserializeLatency);
+    }
+    if (_summaryFetchIOCountMetric) {
+        _summaryFetchIOCountMetric->Report(stat.dataIOCount);
+    }
+}
+
+} // namespace indexlibv2::index
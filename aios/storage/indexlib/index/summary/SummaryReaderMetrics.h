@@ -0,0 +1,57 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <memory>
+
+#include "autil/Log.h"
+#include "indexlib/framework/IMetrics.h"
+#include "indexlib/index/summary/LocalDiskSummaryDiskIndexer.h"
+namespace indexlib { namespace util {
+class Metric;
+}} // namespace indexlib::util
+namespace kmonitor {
+class MetricsReporter;
+} // namespace kmonitor
+
+namespace indexlibv2::index {
+
+class SummaryReaderMetrics : public framework::IMetrics
+{
+public:
+    SummaryReaderMetrics(const std::shared_ptr<kmonitor::MetricsReporter>& metricsReporter);
+    ~SummaryReaderMetrics();
+
+public:
+    void ReportMetrics() override {}
+    void RegisterMetrics() override;
+    // reported once for each batch fetch from built segments
+    void ReportFetchMetrics(size_t docCount, int64_t fetchLatency, const SummaryFetchStat& stat);
+
+private:
+    std::shared_ptr<kmonitor::MetricsReporter> _metricsReporter;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchQpsMetric;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchDocCountMetric;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchLatencyMetric;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchOffsetLatencyMetric;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchDataLatencyMetric;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchDeserializeLatencyMetric;
+    std::shared_ptr<indexlib::util::Metric> _summaryFetchIOCountMetric;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlibv2::index
@@ -35,6 +35,9 @@ static constexpr const char* TASK_NAME = "task_name";
 static constexpr const char* DESIGNATE_FULL_MERGE_TASK_NAME = "full_merge";
 static constexpr const char* DESIGNATE_BATCH_MODE_MERGE_TASK_NAME = "bs_batch_mode_merge";
 static constexpr const char* BRANCH_ID = "_branch_id_";
+// estimated by merge strategy on segment merge plan, actual size is recorded in merged segment metrics
+static constexpr const char* MERGE_PLAN_ESTIMATE_BYTES_READ = "estimate_bytes_read";
+static constexpr const char* MERGE_PLAN_ESTIMATE_BYTES_WRITTEN = "estimate_bytes_written";
 
 static constexpr const char* MERGE_TASK_TYPE = "merge";
 static constexpr const char* ALTER_TABLE_TASK_TYPE = "alter_table";
@@ -111,6 +111,10 @@ CommonMergeDescriptionCreator::CreateMergeOperationDescriptions(const std::share
             opDesc.AddParameter(MergedSegmentMoveOperation::PARAM_TARGET_SEGMENT_INFO,
                                 autil::legacy::ToJsonString(segInfo));
             opDesc.AddParameter(MergedSegmentMoveOperation::PARAM_OP_TO_INDEX, autil::legacy::ToJsonString(opToIndex));
+            std::string estimateBytesWritten;
+            if (segMergePlan.GetParameter(MERGE_PLAN_ESTIMATE_BYTES_WRITTEN, estimateBytesWritten)) {
+                opDesc.AddParameter(MERGE_PLAN_ESTIMATE_BYTES_WRITTEN, estimateBytesWritten);
+            }
             opDesc.AddDepends(segmentMoveDependIds);
             operationDescs.push_back(opDesc);
             segmentOperationIds.push_back(operationId);
@@ -21,6 +21,7 @@
 #include "indexlib/config/TabletSchema.h"
 #include "indexlib/file_system/Directory.h"
 #include "indexlib/file_system/IDirectory.h"
+#include "indexlib/framework/MetricsManager.h"
 #include "indexlib/framework/SegmentMetrics.h"
 #include "indexlib/framework/TabletData.h"
 #include "indexlib/framework/Version.h"
@@ -30,6 +31,7 @@
 #include "indexlib/table/index_task/IndexTaskConstant.h"
 #include "indexlib/table/index_task/merger/MergePlan.h"
 #include "indexlib/table/index_task/merger/MergeUtil.h"
+#include "indexlib/util/metrics/KmonitorTagvNormalizer.h"
 
 using namespace std;
 
@@ -94,6 +96,27 @@ IndexMergeOperation::GetIndexConfig(const framework::IndexOperationDescription&
     return std::make_pair(Status::OK(), indexConfig);
 }
 
+void IndexMergeOperation::ReportMergeThroughput(const framework::IndexTaskContext& context) const
+{
+    auto stat = _indexMerger->GetMergeStatistics();
+    auto manager = context.GetMetricsManager();
+    if (stat.timeUsedInUs <= 0 || !manager) {
+        return;
+    }
+    auto metrics = std::dynamic_pointer_cast<framework::IndexOperationMetrics>(
+        manager->CreateMetrics("INDEX_OPERATION_METRICS", [&]() -> std::shared_ptr<framework::IMetrics> {
+            return std::make_shared<framework::IndexOperationMetrics>(manager->GetMetricsReporter());
+        }));
+    if (!metrics) {
+        return;
+    }
+    kmonitor::MetricsTags tags;
+    tags.AddTag("opId", std::to_string(GetOpId()));
+    tags.AddTag("opName", indexlib::util::KmonitorTagvNormalizer::GetInstance()->Normalize(GetDebugString()));
+    double timeUsedInSecond = stat.timeUsedInUs / 1000000.0;
+    metrics->ReportIndexMergeThroughput(tags, stat.itemCount / timeUsedInSecond, stat.bytesWritten / timeUsedInSecond);
+}
+
 std::string IndexMergeOperation::GetDebugString() const
 {
     return "IndexMergeOp." + _indexConfig->GetIndexType() + "." + _indexConfig->GetIndexName();
@@ -106,6 +129,7 @@ Status IndexMergeOperation::Execute(const framework::IndexTaskContext& context)
 
     auto resourceManager = context.GetResourceManager();
     RETURN_IF_STATUS_ERROR(_indexMerger->Merge(segmentMergeInfos, resourceManager), "index merge failed");
+    ReportMergeThroughput(context);
     if (_desc.UseOpFenceDir()) {
         return StoreMergedSegmentMetrics(segmentMergeInfos, context);
     }
@@ -57,6 +57,7 @@ protected:
                         const std::vector<std::string>& mergeIndexDirs);
     Status GetSegmentMergePlan(const framework::IndexTaskContext& context, SegmentMergePlan& segMergePlan,
                                framework::Version& targetVersion);
+    void ReportMergeThroughput(const framework::IndexTaskContext& context) const;
 
 protected:
     framework::IndexOperationDescription _desc;
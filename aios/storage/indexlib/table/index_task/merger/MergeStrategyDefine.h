@@ -32,6 +32,7 @@ public:
     static constexpr char OPTIMIZE_MERGE_STRATEGY_NAME[] = "optimize";
     static constexpr char SHARD_BASED_MERGE_STRATEGY_NAME[] = "shard_based";
     static constexpr char BALANCE_TREE_MERGE_STRATEGY_NAME[] = "balance_tree";
+    static constexpr char TIERED_MERGE_STRATEGY_NAME[] = "tiered";
     static constexpr char SPECIFIC_SEGMENTS_MERGE_STRATEGY_NAME[] = "specific_segments";
     static constexpr char LEVELED_COMPACTION_MERGE_STRATEGY_NAME[] = "leveled_compaction";
 
@@ -318,10 +318,31 @@ Status MergedSegmentMoveOperation::Execute(const framework::IndexTaskContext& co
     if (segmentMetrics.GetKeyCount(keyCount)) {
         targetSegmentInfo.docCount = keyCount;
     }
+    RETURN_IF_STATUS_ERROR(RecordBytesWritten(segDirName, targetSegmentDirectory, &segmentMetrics),
+                           "record bytes written of segment [%s] failed", segDirName.c_str());
 
     return StoreSegmentInfos(targetSegmentInfo, segmentMetrics, counterMapContent, targetSegmentDirectory);
 }
 
+// Index dirs of target segment are complete here, so its size is what the merge actually wrote. Merge strategy
+// only estimates bytes written when planning, the actual size is kept in segment metrics for later accounting.
+Status MergedSegmentMoveOperation::RecordBytesWritten(
+    const std::string& segDirName, const std::shared_ptr<indexlib::file_system::IDirectory>& targetSegmentDirectory,
+    indexlib::framework::SegmentMetrics* segmentMetrics) const
+{
+    auto [status, bytesWritten] = targetSegmentDirectory->GetDirectorySize("").StatusWith();
+    RETURN_IF_STATUS_ERROR(status, "get size of segment dir [%s] failed", segDirName.c_str());
+    segmentMetrics->Set<size_t>(MERGE_STATISTICS_GROUP, MERGE_STATISTICS_BYTES_WRITTEN, bytesWritten);
+    std::string estimateBytesWritten;
+    if (_desc.GetParameter(MERGE_PLAN_ESTIMATE_BYTES_WRITTEN, estimateBytesWritten)) {
+        AUTIL_LOG(INFO, "merged segment [%s] bytes written [%lu], estimate bytes written of merge plan [%s]",
+                  segDirName.c_str(), bytesWritten, estimateBytesWritten.c_str());
+    } else {
+        AUTIL_LOG(INFO, "merged segment [%s] bytes written [%lu]", segDirName.c_str(), bytesWritten);
+    }
+    return Status::OK();
+}
+
 Status MergedSegmentMoveOperation::StoreSegmentInfos(
     const framework::SegmentInfo& targetSegmentInfo, const indexlib::framework::SegmentMetrics& segmentMetrics,
     const std::string& counterMap, const std::shared_ptr<indexlib::file_system::IDirectory>& mergerDirectory)
@@ -40,6 +40,9 @@ public:
     static constexpr char PARAM_TARGET_SEGMENT_INFO[] = "segment_info";
     static constexpr char PARAM_OP_TO_INDEX_DIR[] = "op_to_index_dir";
     static constexpr char PARAM_OP_TO_INDEX[] = "op_to_index";
+    // segment metrics group of merged segment, bytes written is the actual segment size after merge
+    static constexpr char MERGE_STATISTICS_GROUP[] = "__@__merge_statistics";
+    static constexpr char MERGE_STATISTICS_BYTES_WRITTEN[] = "bytes_written";
 
 public:
     MergedSegmentMoveOperation(const framework::IndexOperationDescription& desc);
@@ -51,6 +54,9 @@ private:
     Status StoreSegmentInfos(const framework::SegmentInfo& targetSegmentInfo,
                              const indexlib::framework::SegmentMetrics& segmentMetrics, const std::string& counterMap,
                              const std::shared_ptr<indexlib::file_system::IDirectory>& mergerDirectory);
+    Status RecordBytesWritten(const std::string& segDirName,
+                              const std::shared_ptr<indexlib::file_system::IDirectory>& targetSegmentDirectory,
+                              indexlib::framework::SegmentMetrics* segmentMetrics) const;
     Status MoveIndexDir(const framework::IndexTaskContext& context, framework::IndexOperationId opId,
                         const std::string& segDirName, const std::string& indexPath);
     Status MergeSegmentMetrics(const std::vector<indexlib::framework::SegmentMetrics>& segMetricsVec,
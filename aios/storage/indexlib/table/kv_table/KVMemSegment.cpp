@@ -23,9 +23,11 @@ namespace indexlibv2::table {
 AUTIL_LOG_SETUP(indexlib.table, KVMemSegment);
 
 KVMemSegment::KVMemSegment(const config::TabletOptions* options, const std::shared_ptr<config::TabletSchema>& schema,
-                           const framework::SegmentMeta& segmentMeta, bool enableMemoryReclaim)
+                           const framework::SegmentMeta& segmentMeta, bool enableMemoryReclaim,
+                           uint32_t buildingShardCount)
     : plain::PlainMemSegment(options, schema, segmentMeta)
     , _enableMemoryReclaim(enableMemoryReclaim)
+    , _buildingShardCount(buildingShardCount)
 {
 }
 
@@ -68,6 +70,10 @@ void KVMemSegment::PrepareIndexerParameter(const framework::BuildResource& resou
         indexerParam.indexMemoryReclaimer = nullptr;
         AUTIL_LOG(INFO, "disable kv tablet memory reclaim");
     }
+    if (_buildingShardCount > 1 && indexerParam.indexMemoryReclaimer != nullptr) {
+        AUTIL_LOG(INFO, "kv memory reclaim not work with [%u] building shards", _buildingShardCount);
+    }
+    indexerParam.buildingShardCount = _buildingShardCount;
 }
 
 } // namespace indexlibv2::table
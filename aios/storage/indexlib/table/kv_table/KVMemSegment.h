@@ -25,7 +25,8 @@ class KVMemSegment : public plain::PlainMemSegment
 {
 public:
     KVMemSegment(const config::TabletOptions* options, const std::shared_ptr<config::TabletSchema>& schema,
-                 const framework::SegmentMeta& segmentMeta, bool enableMemoryReclaim);
+                 const framework::SegmentMeta& segmentMeta, bool enableMemoryReclaim,
+                 uint32_t buildingShardCount = 1);
     ~KVMemSegment() {}
 
 protected:
@@ -38,6 +39,7 @@ protected:
 private:
     bool _hasCheckPKValueIndex = false;
     bool _enableMemoryReclaim = false;
+    uint32_t _buildingShardCount = 1;
     AUTIL_LOG_DECLARE();
 };
 
@@ -53,6 +53,123 @@ Status KVReaderImpl::DoOpen(const std::shared_ptr<indexlibv2::config::KVIndexCon
     return LoadSegmentReader(kvIndexConfig, tabletData);
 }
 
+FL_LAZY(void)
+KVReaderImpl::InnerMultiGet(const index::KVReadOptions* readOptions, const std::vector<index::keytype_t>& sortedKeys,
+                            std::vector<index::KVResultStatus>& statuses,
+                            std::vector<autil::StringView>& values) const noexcept
+{
+    auto metricsCollector = readOptions->metricsCollector;
+    ResetCounter(metricsCollector);
+    if (_diskShardReaders.empty() && _memoryShardReaders.empty()) {
+        FL_CORETURN;
+    }
+    // keys in each shard stay ascending
+    size_t shardCount = _memoryShardReaders.empty() ? _diskShardReaders.size() : _memoryShardReaders.size();
+    std::vector<std::vector<size_t>> shardPendings(shardCount);
+    for (size_t i = 0; i < sortedKeys.size(); ++i) {
+        shardPendings[GetShardId(sortedKeys[i])].push_back(i);
+    }
+    std::vector<uint64_t> valueTs(sortedKeys.size(), 0);
+    if (!_memoryShardReaders.empty()) {
+        for (size_t shardId = 0; shardId < shardCount; ++shardId) {
+            FL_COAWAIT MultiGetFromSegments(_memoryShardReaders[shardId], sortedKeys, shardPendings[shardId],
+                                            statuses, values, valueTs, readOptions);
+        }
+    }
+    if (_kvReportMetrics && metricsCollector) {
+        metricsCollector->BeginSSTableQuery();
+    }
+    if (!_diskShardReaders.empty()) {
+        for (size_t shardId = 0; shardId < shardCount; ++shardId) {
+            FL_COAWAIT MultiGetFromSegments(_diskShardReaders[shardId], sortedKeys, shardPendings[shardId], statuses,
+                                            values, valueTs, readOptions);
+        }
+    }
+
+    if (_hasTTL) {
+        uint64_t minimumTsInSecond = 0;
+        uint64_t currentTimeInSecond = autil::TimeUtility::us2sec(readOptions->timestamp);
+        if (currentTimeInSecond > _ttl) {
+            minimumTsInSecond = currentTimeInSecond - _ttl;
+        }
+        for (size_t i = 0; i < statuses.size(); ++i) {
+            if (statuses[i] == index::KVResultStatus::FOUND && valueTs[i] < minimumTsInSecond) {
+                statuses[i] = index::KVResultStatus::NOT_FOUND;
+            }
+        }
+    }
+    if (_kvReportMetrics && metricsCollector) {
+        metricsCollector->EndQuery();
+    }
+}
+
+FL_LAZY(void)
+KVReaderImpl::MultiGetFromSegments(
+    const std::vector<std::pair<std::shared_ptr<index::IKVSegmentReader>, std::shared_ptr<framework::Locator>>>&
+        segmentReaders,
+    const std::vector<index::keytype_t>& sortedKeys, std::vector<size_t>& pending,
+    std::vector<index::KVResultStatus>& statuses, std::vector<autil::StringView>& values,
+    std::vector<uint64_t>& valueTs, const index::KVReadOptions* readOptions) const noexcept
+{
+    auto pool = readOptions->pool;
+    auto metricsCollector = readOptions->metricsCollector;
+    auto timeoutTerminator = readOptions->timeoutTerminator.get();
+    std::vector<index::keytype_t> keys;
+    std::vector<indexlib::util::Status> segStatuses;
+    std::vector<autil::StringView> segValues;
+    std::vector<uint64_t> segTs;
+    for (const auto& segmentReader : segmentReaders) {
+        if (pending.empty()) {
+            break;
+        }
+        if (timeoutTerminator && timeoutTerminator->checkRestrictTimeout()) {
+            for (auto idx : pending) {
+                statuses[idx] = index::KVResultStatus::TIMEOUT;
+            }
+            pending.clear();
+            break;
+        }
+        size_t count = pending.size();
+        keys.resize(count);
+        for (size_t j = 0; j < count; ++j) {
+            keys[j] = sortedKeys[pending[j]];
+        }
+        segStatuses.assign(count, indexlib::util::NOT_FOUND);
+        segValues.assign(count, autil::StringView());
+        segTs.assign(count, 0);
+        try {
+            FL_COAWAIT segmentReader.first->BatchGet(keys.data(), count, segStatuses.data(), segValues.data(),
+                                                     segTs.data(), pool, metricsCollector, timeoutTerminator,
+                                                     readOptions->maxConcurrency, readOptions->yield);
+        } catch (const std::exception& e) {
+            AUTIL_LOG(ERROR, "should not throw exception, [%s]", e.what());
+            segStatuses.assign(count, indexlib::util::FAIL);
+        } catch (...) {
+            AUTIL_LOG(ERROR, "should not throw exception");
+            segStatuses.assign(count, indexlib::util::FAIL);
+        }
+
+        size_t remain = 0;
+        for (size_t j = 0; j < count; ++j) {
+            auto idx = pending[j];
+            if (segStatuses[j] == indexlib::util::NOT_FOUND) {
+                pending[remain++] = idx;
+                continue;
+            }
+            if (segStatuses[j] == indexlib::util::OK || segStatuses[j] == indexlib::util::DELETED) {
+                if (_kvReportMetrics && metricsCollector) {
+                    metricsCollector->IncResultCount();
+                }
+            }
+            // fail, delete, found
+            statuses[idx] = index::TranslateStatus(segStatuses[j]);
+            values[idx] = segValues[j];
+            valueTs[idx] = segTs[j];
+        }
+        pending.resize(remain);
+    }
+}
+
 Status KVReaderImpl::LoadSegmentReader(const std::shared_ptr<indexlibv2::config::KVIndexConfig>& kvIndexConfig,
                                        const framework::TabletData* tabletData) noexcept
 {
@@ -57,6 +57,20 @@ protected:
     InnerGet(const index::KVReadOptions* readOptions, index::keytype_t key, autil::StringView& value,
              index::KVMetricsCollector* metricsCollector = NULL) const noexcept override;
 
+    FL_LAZY(void)
+    InnerMultiGet(const index::KVReadOptions* readOptions, const std::vector<index::keytype_t>& sortedKeys,
+                  std::vector<index::KVResultStatus>& statuses,
+                  std::vector<autil::StringView>& values) const noexcept override;
+
+    // batch lookup pending keys (index of sortedKeys) newest segment first, pending keeps keys not found
+    FL_LAZY(void)
+    MultiGetFromSegments(
+        const std::vector<std::pair<std::shared_ptr<index::IKVSegmentReader>, std::shared_ptr<framework::Locator>>>&
+            segmentReaders,
+        const std::vector<index::keytype_t>& sortedKeys, std::vector<size_t>& pending,
+        std::vector<index::KVResultStatus>& statuses, std::vector<autil::StringView>& values,
+        std::vector<uint64_t>& valueTs, const index::KVReadOptions* readOptions) const noexcept;
+
     virtual FL_LAZY(index::KVResultStatus)
         DoGet(const index::KVReadOptions* readOptions, index::keytype_t key, autil::StringView& value,
               uint64_t& valueTs, index::KVMetricsCollector* metricsCollector = NULL) const noexcept;
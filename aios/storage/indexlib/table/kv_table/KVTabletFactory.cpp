@@ -125,10 +125,12 @@ std::unique_ptr<framework::MemSegment> KVTabletFactory::CreateMemSegment(const S
     }
 
     bool enableMemoryReclaim = _options->IsMemoryReclaimEnabled();
-    auto segmentCreator = [enableMemoryReclaim](const config::TabletOptions* tableOptions,
-                                                const std::shared_ptr<config::TabletSchema>& schema,
-                                                const framework::SegmentMeta& segmentMeta) {
-        return std::make_shared<KVMemSegment>(tableOptions, schema, segmentMeta, enableMemoryReclaim);
+    uint32_t buildingShardCount = _options->GetBuildingShardCount();
+    auto segmentCreator = [enableMemoryReclaim, buildingShardCount](const config::TabletOptions* tableOptions,
+                                                                    const std::shared_ptr<config::TabletSchema>& schema,
+                                                                    const framework::SegmentMeta& segmentMeta) {
+        return std::make_shared<KVMemSegment>(tableOptions, schema, segmentMeta, enableMemoryReclaim,
+                                              buildingShardCount);
     };
     uint32_t suggestLevelNum = _options->GetLevelNum();
 
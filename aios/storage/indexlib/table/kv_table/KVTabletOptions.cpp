@@ -66,4 +66,17 @@ bool KVTabletOptions::IsMemoryReclaimEnabled() const
     return ret;
 }
 
+uint32_t KVTabletOptions::GetBuildingShardCount() const
+{
+    if (!_tabletOptions->IsOnline()) {
+        return 1;
+    }
+    std::string path = "online_index_config.build_config.kv_building_shard_count";
+    uint32_t shardCount = 1;
+    if (!_tabletOptions->GetFromRawJson(path, &shardCount) || shardCount == 0) {
+        return 1;
+    }
+    return shardCount;
+}
+
 } // namespace indexlibv2::table
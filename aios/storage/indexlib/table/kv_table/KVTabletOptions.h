@@ -32,6 +32,7 @@ public:
     uint32_t GetShardNum() const;
     uint32_t GetLevelNum() const;
     bool IsMemoryReclaimEnabled() const;
+    uint32_t GetBuildingShardCount() const;
 
 private:
     std::shared_ptr<config::TabletOptions> _tabletOptions;
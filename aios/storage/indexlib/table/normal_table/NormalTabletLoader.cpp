@@ -17,6 +17,7 @@
 
 #include <any>
 
+#include "autil/EnvUtil.h"
 #include "indexlib/config/TabletSchema.h"
 #include "indexlib/document/document_rewriter/DocumentInfoToAttributeRewriter.h"
 #include "indexlib/file_system/Directory.h"
@@ -49,6 +50,19 @@ NormalTabletLoader::NormalTabletLoader(const std::string& fenceName, bool reopen
     , _reopenDataConsistent(reopenDataConsistent)
     , _loadIndexForCheck(loadIndexForCheck)
 {
+    _parallelRedoThreadCount = autil::EnvUtil::getEnv("INDEXLIB_PARALLEL_REDO_THREAD_COUNT", (size_t)0);
+}
+
+std::vector<docid_t> NormalTabletLoader::GetSegmentBaseDocids(const framework::TabletData& tabletData)
+{
+    std::vector<docid_t> segmentBaseDocids;
+    docid_t baseDocId = 0;
+    auto slice = tabletData.CreateSlice();
+    for (const auto& segment : slice) {
+        segmentBaseDocids.push_back(baseDocId);
+        baseDocId += segment->GetSegmentInfo()->docCount;
+    }
+    return segmentBaseDocids;
 }
 
 using RedoParam =
@@ -384,6 +398,10 @@ Status NormalTabletLoader::PatchAndRedo(const framework::Version& newOnDiskVersi
 
         indexlib::index::OperationLogReplayer::RedoParams redoParams = {
             pkReader.get(), modifier.get(), redoStrategy.get(), _memoryQuotaController.get()};
+        if (_parallelRedoThreadCount > 1) {
+            redoParams.parallelRedoThreadCount = _parallelRedoThreadCount;
+            redoParams.partitionBaseDocids = GetSegmentBaseDocids(newTabletData);
+        }
         framework::Locator redoLocator;
         if (diffDiskSegmentIds.find(segmentId) == diffDiskSegmentIds.end() &&
             (segmentId & framework::Segment::PRIVATE_SEGMENT_ID_MASK)) {
@@ -440,6 +458,10 @@ NormalTabletLoader::FinalLoad(const framework::TabletData& currentTabletData)
                                 "init redo strategy failed");
         indexlib::index::OperationLogReplayer::RedoParams redoParams = {
             pkReader.get(), modifier.get(), redoStrategy.get(), _memoryQuotaController.get()};
+        if (_parallelRedoThreadCount > 1) {
+            redoParams.parallelRedoThreadCount = _parallelRedoThreadCount;
+            redoParams.partitionBaseDocids = GetSegmentBaseDocids(*tabletData);
+        }
         auto [redoStatus, cursor] =
             opReplayer->RedoOperationsFromCursor(redoParams, *_opCursor, _newVersion.GetLocator());
         RETURN2_IF_STATUS_ERROR(redoStatus, nullptr, "redo failed");
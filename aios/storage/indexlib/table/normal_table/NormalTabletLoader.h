@@ -79,10 +79,13 @@ private:
                                 const framework::TabletData& newTabletData);
     std::pair<Status, bool> IsRtFullyFasterThanInc(const framework::TabletData& lastTabletData,
                                                    const framework::Version& newOnDiskVersion);
+    // used as partitions of parallel redo, modifiers keep per segment states
+    static std::vector<docid_t> GetSegmentBaseDocids(const framework::TabletData& tabletData);
 
 private:
     bool _reopenDataConsistent = false;
     bool _loadIndexForCheck = false;
+    size_t _parallelRedoThreadCount = 0;
     std::vector<segmentid_t> _targetRedoSegments;
     std::set<segmentid_t> _segmentIdsOnPreload;
     std::shared_ptr<indexlib::index::OperationCursor> _opCursor;
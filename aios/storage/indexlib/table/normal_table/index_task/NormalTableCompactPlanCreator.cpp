@@ -45,6 +45,7 @@
 #include "indexlib/table/normal_table/index_task/merger/CombinedMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/OptimizeMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/PriorityQueueMergeStrategy.h"
+#include "indexlib/table/normal_table/index_task/merger/TieredMergeStrategy.h"
 
 using namespace std;
 
@@ -162,6 +163,10 @@ NormalTableCompactPlanCreator::CreateCompactStrategy(const std::string& mergeStr
         auto strategy = std::make_unique<BalanceTreeMergeStrategy>();
         return {NORMAL_TABLE_MERGE_TYPE, std::make_unique<CombinedMergeStrategy>(std::move(strategy))};
     }
+    if (mergeStrategyName == MergeStrategyDefine::TIERED_MERGE_STRATEGY_NAME) {
+        auto strategy = std::make_unique<TieredMergeStrategy>();
+        return {NORMAL_TABLE_MERGE_TYPE, std::make_unique<CombinedMergeStrategy>(std::move(strategy))};
+    }
     if (mergeStrategyName == MergeStrategyDefine::SPECIFIC_SEGMENTS_MERGE_STRATEGY_NAME) {
         return {NORMAL_TABLE_MERGE_TYPE, std::make_unique<SpecificSegmentsMergeStrategy>()};
     }
@@ -90,7 +90,8 @@ Status AndIndexReclaimer::Reclaim(index::DeletionMapPatchWriter* docDeleter)
         }
         size_t reclaimDocCount = 0;
         if (postingExecutors.size() == _param.GetReclaimOprands().size()) {
-            auto andOp = std::make_shared<indexlib::index::AndPostingExecutor>(postingExecutors);
+            auto andOp = std::make_shared<indexlib::index::AndPostingExecutor>(postingExecutors,
+                                                                               /*enableBlockMode=*/true);
             docid_t docId = andOp->Seek(0);
             while (docId != INVALID_DOCID && docId != indexlib::END_DOCID) {
                 assert(docId >= baseDocId);
@@ -100,6 +101,8 @@ Status AndIndexReclaimer::Reclaim(index::DeletionMapPatchWriter* docDeleter)
                 reclaimDocCount++;
                 docId = andOp->Seek(docId + 1);
             }
+            AUTIL_LOG(INFO, "reclaim_operator[AND] examined %ld docs, matched %ld docs for segment [%d]",
+                      andOp->GetExaminedDocCount(), andOp->GetMatchedDocCount(), segmentId);
         }
         totalReclaimDoc += reclaimDocCount;
         AUTIL_LOG(INFO, "reclaim_operator[AND] matches %zu docs for segment [%d] by condition [%s]", reclaimDocCount,
@@ -19,6 +19,7 @@
 #include "indexlib/table/normal_table/Common.h"
 #include "indexlib/table/normal_table/index_task/merger/BalanceTreeMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/PriorityQueueMergeStrategy.h"
+#include "indexlib/table/normal_table/index_task/merger/TieredMergeStrategy.h"
 
 namespace indexlibv2 { namespace table {
 AUTIL_LOG_SETUP(indexlib.table, CombinedMergeStrategy);
@@ -37,6 +38,10 @@ CombinedMergeStrategy::GetMergedSegmentMergePlan(const framework::IndexTaskConte
         auto strategy = dynamic_cast<PriorityQueueMergeStrategy*>(_mergedSegmentStrategy.get());
         assert(strategy != nullptr);
         std::tie(st, mergePlan) = strategy->DoCreateMergePlan(context);
+    } else if (strategyName == MergeStrategyDefine::TIERED_MERGE_STRATEGY_NAME) {
+        auto strategy = dynamic_cast<TieredMergeStrategy*>(_mergedSegmentStrategy.get());
+        assert(strategy != nullptr);
+        std::tie(st, mergePlan) = strategy->DoCreateMergePlan(context);
     } else {
         AUTIL_LOG(ERROR, "un-supported merge strategy [%s] for merged segment", strategyName.c_str());
         assert(false);
@@ -0,0 +1,339 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/table/normal_table/index_task/merger/TieredMergeStrategy.h"
+
+#include <algorithm>
+
+#include "autil/StringTokenizer.h"
+#include "autil/StringUtil.h"
+#include "autil/TimeUtility.h"
+#include "indexlib/config/MergeConfig.h"
+#include "indexlib/config/OfflineConfig.h"
+#include "indexlib/config/TabletOptions.h"
+#include "indexlib/file_system/IDirectory.h"
+#include "indexlib/framework/LevelInfo.h"
+#include "indexlib/table/index_task/IndexTaskConstant.h"
+#include "indexlib/table/normal_table/index_task/merger/NormalTableMergeStrategyUtil.h"
+
+namespace indexlibv2::table {
+
+namespace {
+using indexlibv2::framework::Segment;
+using indexlibv2::framework::TabletData;
+} // namespace
+
+AUTIL_LOG_SETUP(indexlib.table, TieredMergeStrategy);
+
+std::pair<Status, TieredMergeParams>
+TieredMergeStrategy::ExtractParams(const config::MergeStrategyParameter& param) const
+{
+    TieredMergeParams params;
+    std::string mergeParam = param.GetLegacyString();
+    autil::StringUtil::trim(mergeParam);
+    if (mergeParam.empty()) {
+        AUTIL_LOG(INFO, "no specified merge param");
+        return {Status::OK(), params};
+    }
+
+    autil::StringTokenizer st(mergeParam, ";",
+                              autil::StringTokenizer::TOKEN_TRIM | autil::StringTokenizer::TOKEN_IGNORE_EMPTY);
+    for (size_t i = 0; i < st.getNumTokens(); i++) {
+        autil::StringTokenizer kvStr(st[i], "=",
+                                     autil::StringTokenizer::TOKEN_TRIM | autil::StringTokenizer::TOKEN_IGNORE_EMPTY);
+        if (kvStr.getNumTokens() != 2) {
+            auto status = Status::InvalidArgs("invalid parameter [%s] for merge strategy", mergeParam.c_str());
+            AUTIL_LOG(ERROR, "%s", status.ToString().c_str());
+            return {status, params};
+        }
+        bool ret = true;
+        if (kvStr[0] == "base-segment-size-mb") {
+            uint64_t baseSegmentSizeInMB = 0;
+            ret = autil::StringUtil::strToUInt64(kvStr[1].c_str(), baseSegmentSizeInMB) && baseSegmentSizeInMB > 0;
+            params.baseSegmentSize = baseSegmentSizeInMB * 1024 * 1024;
+        } else if (kvStr[0] == "size-ratio") {
+            ret = autil::StringUtil::strToUInt32(kvStr[1].c_str(), params.sizeRatio) && params.sizeRatio >= 2;
+        } else if (kvStr[0] == "max-segments-per-tier") {
+            ret = autil::StringUtil::strToUInt32(kvStr[1].c_str(), params.maxSegmentsPerTier) &&
+                  params.maxSegmentsPerTier >= 2;
+        } else if (kvStr[0] == "conflict-delete-percent") {
+            ret = autil::StringUtil::strToUInt32(kvStr[1].c_str(), params.conflictDelPercent) &&
+                  params.conflictDelPercent <= 100;
+        } else if (kvStr[0] == "max-segment-size-mb") {
+            uint64_t maxSegmentSizeInMB = 0;
+            ret = autil::StringUtil::strToUInt64(kvStr[1].c_str(), maxSegmentSizeInMB) && maxSegmentSizeInMB > 0;
+            params.maxSegmentSize = maxSegmentSizeInMB * 1024 * 1024;
+        } else if (kvStr[0] == "max-segment-age-second") {
+            ret = autil::StringUtil::strToUInt64(kvStr[1].c_str(), params.maxSegmentAgeSecond);
+        } else {
+            AUTIL_LOG(INFO, "Skipping parameter not intended for tiered merge strategy: [%s]:[%s]",
+                      kvStr[0].c_str(), kvStr[1].c_str());
+        }
+        if (!ret) {
+            auto status = Status::InvalidArgs("invalid parameter [%s] for merge strategy", mergeParam.c_str());
+            AUTIL_LOG(ERROR, "%s", status.ToString().c_str());
+            return {status, params};
+        }
+    }
+    AUTIL_LOG(INFO, "tiered merge params: %s", params.DebugString().c_str());
+    return {Status::OK(), params};
+}
+
+std::pair<Status, std::shared_ptr<MergePlan>>
+TieredMergeStrategy::CreateMergePlan(const framework::IndexTaskContext* context)
+{
+    auto [status, mergePlan] = DoCreateMergePlan(context);
+    RETURN2_IF_STATUS_ERROR(status, nullptr, "Create merge plan failed");
+    RETURN2_IF_STATUS_ERROR(MergeStrategy::FillMergePlanTargetInfo(context, mergePlan), mergePlan,
+                            "fill merge plan target info failed");
+    AUTIL_LOG(INFO, "Create merge plan %s", autil::legacy::ToJsonString(mergePlan, true).c_str());
+    return {Status::OK(), mergePlan};
+}
+
+Status TieredMergeStrategy::CheckParam(const framework::IndexTaskContext* context)
+{
+    auto tabletData = context->GetTabletData();
+    const auto& version = tabletData->GetOnDiskVersion();
+    auto levelInfo = version.GetSegmentDescriptions()->GetLevelInfo();
+    if (levelInfo != nullptr && levelInfo->GetTopology() != framework::topo_sequence) {
+        AUTIL_LOG(ERROR, "[%s] is not supported, only support sequence topology",
+                  framework::LevelMeta::TopologyToStr(levelInfo->GetTopology()).c_str());
+        return Status::InvalidArgs();
+    }
+    auto mergeConfig = context->GetTabletOptions()->GetOfflineConfig().GetMergeConfig();
+    assert(mergeConfig.GetMergeStrategyStr() == GetName() or
+           mergeConfig.GetMergeStrategyStr() == MergeStrategyDefine::COMBINED_MERGE_STRATEGY_NAME);
+    auto [st, params] = ExtractParams(mergeConfig.GetMergeStrategyParameter());
+    if (!st.IsOK()) {
+        return st;
+    }
+    _params = std::move(params);
+    return Status::OK();
+}
+
+std::pair<Status, std::shared_ptr<MergePlan>>
+TieredMergeStrategy::DoCreateMergePlan(const framework::IndexTaskContext* context)
+{
+    const auto& version = context->GetTabletData()->GetOnDiskVersion();
+    if (version.GetSegmentCount() == 0) {
+        AUTIL_LOG(INFO, "empty version, no need create merge plan");
+        return std::make_pair(Status::OK(), std::make_shared<MergePlan>(MERGE_PLAN, MERGE_PLAN));
+    }
+    auto st = CheckParam(context);
+    if (!st.IsOK()) {
+        AUTIL_LOG(ERROR, "invalid params.");
+        return {st, nullptr};
+    }
+    auto [collectStatus, segmentMergeInfos] = CollectSegmentMergeInfos(context->GetTabletData());
+    RETURN2_IF_STATUS_ERROR(collectStatus, nullptr, "collect segment merge infos failed");
+
+    auto mergePlan = std::make_shared<MergePlan>(/*name=*/MERGE_PLAN, /*type=*/MERGE_PLAN);
+    uint64_t totalBytesRead = 0;
+    uint64_t totalBytesWritten = 0;
+    auto selectedSegments =
+        SelectMergeSegments(_params, segmentMergeInfos, autil::TimeUtility::currentTimeInMicroSeconds());
+    for (const auto& inPlanSegments : selectedSegments) {
+        SegmentMergePlan segmentMergePlan;
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+        for (const auto& segmentMergeInfo : inPlanSegments) {
+            segmentMergePlan.AddSrcSegment(segmentMergeInfo.segmentId);
+            bytesRead += segmentMergeInfo.segmentSize;
+            bytesWritten += GetValidSize(segmentMergeInfo);
+        }
+        segmentMergePlan.AddParameter(MERGE_PLAN_ESTIMATE_BYTES_READ, autil::StringUtil::toString(bytesRead));
+        segmentMergePlan.AddParameter(MERGE_PLAN_ESTIMATE_BYTES_WRITTEN, autil::StringUtil::toString(bytesWritten));
+        totalBytesRead += bytesRead;
+        totalBytesWritten += bytesWritten;
+        AUTIL_LOG(INFO, "Merge plan generated [%s] by Tiered, estimate bytes read [%lu], estimate bytes written [%lu]",
+                  segmentMergePlan.ToString().c_str(), bytesRead, bytesWritten);
+        mergePlan->AddMergePlan(segmentMergePlan);
+    }
+
+    uint64_t totalSegmentSize = 0;
+    for (const auto& segmentMergeInfo : segmentMergeInfos) {
+        totalSegmentSize += segmentMergeInfo.segmentSize;
+    }
+    AUTIL_LOG(INFO,
+              "tiered merge selects [%lu] plans from [%lu] segments, estimate bytes read [%lu], estimate bytes "
+              "written [%lu], estimate bytes written to total segment size ratio [%.3f]",
+              selectedSegments.size(), segmentMergeInfos.size(), totalBytesRead, totalBytesWritten,
+              totalSegmentSize > 0 ? double(totalBytesWritten) / totalSegmentSize : 0.0);
+    return {Status::OK(), mergePlan};
+}
+
+std::pair<Status, std::vector<TieredMergeStrategy::SegmentMergeInfo>>
+TieredMergeStrategy::CollectSegmentMergeInfos(const std::shared_ptr<framework::TabletData>& tabletData) const
+{
+    std::vector<TieredMergeStrategy::SegmentMergeInfo> segmentMergeInfos;
+    auto slice = tabletData->CreateSlice(Segment::SegmentStatus::ST_BUILT);
+    for (auto iter = slice.begin(); iter != slice.end(); iter++) {
+        auto segment = *iter;
+        auto segmentInfo = segment->GetSegmentInfo();
+        if (!segmentInfo->mergedSegment) {
+            continue;
+        }
+        auto [status, deleteDocCount] = NormalTableMergeStrategyUtil::GetDeleteDocCount(segment.get());
+        RETURN2_IF_STATUS_ERROR(status, segmentMergeInfos, "get delete doc count failed, segment [%d]",
+                                segment->GetSegmentId());
+        auto ret = segment->GetSegmentDirectory()->GetIDirectory()->GetDirectorySize(/*path=*/"");
+        RETURN2_IF_STATUS_ERROR(ret.Status(), segmentMergeInfos, "get directory size fail, dir[%s]",
+                                segment->GetSegmentDirectory()->GetLogicalPath().c_str());
+        segmentMergeInfos.push_back({segment->GetSegmentId(), segmentInfo->docCount,
+                                     static_cast<uint64_t>(deleteDocCount), static_cast<uint64_t>(ret.result),
+                                     segmentInfo->timestamp});
+    }
+    return {Status::OK(), segmentMergeInfos};
+}
+
+std::vector<std::vector<TieredMergeStrategy::SegmentMergeInfo>>
+TieredMergeStrategy::SelectMergeSegments(const TieredMergeParams& params,
+                                         const std::vector<SegmentMergeInfo>& segmentMergeInfos,
+                                         int64_t currentTimestamp)
+{
+    std::vector<std::vector<SegmentMergeInfo>> mergeSegments;
+    std::vector<std::vector<SegmentMergeInfo>> tiers;
+    // segments not merged with others in its tier but need rewrite for deleted docs
+    std::vector<SegmentMergeInfo> rewriteSegments;
+    auto tryRewrite = [&](const SegmentMergeInfo& segmentMergeInfo) {
+        if (LargerThanDelPercent(params, segmentMergeInfo)) {
+            rewriteSegments.push_back(segmentMergeInfo);
+        }
+    };
+
+    for (const auto& segmentMergeInfo : segmentMergeInfos) {
+        uint64_t validSize = GetValidSize(segmentMergeInfo);
+        if (validSize > params.maxSegmentSize) {
+            tryRewrite(segmentMergeInfo);
+            continue;
+        }
+        int32_t tier = GetTier(params, validSize);
+        if (tiers.size() < (size_t)(tier + 1)) {
+            tiers.resize(tier + 1);
+        }
+        tiers[tier].push_back(segmentMergeInfo);
+    }
+
+    uint64_t maxAgeInUs = params.maxSegmentAgeSecond * 1000 * 1000;
+    for (auto& segments : tiers) {
+        bool isFull = segments.size() >= params.maxSegmentsPerTier;
+        bool isAged = false;
+        if (maxAgeInUs > 0 && segments.size() >= 2) {
+            for (const auto& segmentMergeInfo : segments) {
+                if (segmentMergeInfo.timestamp > 0 &&
+                    currentTimestamp - segmentMergeInfo.timestamp >= (int64_t)maxAgeInUs) {
+                    isAged = true;
+                    break;
+                }
+            }
+        }
+        if (!isFull && !isAged) {
+            for (const auto& segmentMergeInfo : segments) {
+                tryRewrite(segmentMergeInfo);
+            }
+            continue;
+        }
+        std::stable_sort(segments.begin(), segments.end(),
+                         [&params, currentTimestamp](const SegmentMergeInfo& left, const SegmentMergeInfo& right) {
+                             double leftPriority = GetMergePriority(params, left, currentTimestamp);
+                             double rightPriority = GetMergePriority(params, right, currentTimestamp);
+                             if (leftPriority != rightPriority) {
+                                 return leftPriority > rightPriority;
+                             }
+                             return GetValidSize(left) < GetValidSize(right);
+                         });
+        std::vector<SegmentMergeInfo> inPlanSegments;
+        uint64_t inPlanSize = 0;
+        for (const auto& segmentMergeInfo : segments) {
+            uint64_t validSize = GetValidSize(segmentMergeInfo);
+            if (inPlanSegments.size() >= params.maxSegmentsPerTier || inPlanSize + validSize > params.maxSegmentSize) {
+                tryRewrite(segmentMergeInfo);
+                continue;
+            }
+            inPlanSegments.push_back(segmentMergeInfo);
+            inPlanSize += validSize;
+        }
+        if (inPlanSegments.size() > 1) {
+            mergeSegments.push_back(std::move(inPlanSegments));
+        } else if (inPlanSegments.size() == 1) {
+            tryRewrite(inPlanSegments[0]);
+        }
+    }
+    for (const auto& segmentMergeInfo : rewriteSegments) {
+        mergeSegments.push_back({segmentMergeInfo});
+    }
+    return mergeSegments;
+}
+
+uint64_t TieredMergeStrategy::GetValidSize(const SegmentMergeInfo& segmentMergeInfo)
+{
+    if (segmentMergeInfo.docCount == 0) {
+        return segmentMergeInfo.segmentSize;
+    }
+    if (segmentMergeInfo.deletedDocCount >= segmentMergeInfo.docCount) {
+        return 0;
+    }
+    return segmentMergeInfo.segmentSize * double(segmentMergeInfo.docCount - segmentMergeInfo.deletedDocCount) /
+           segmentMergeInfo.docCount;
+}
+
+int32_t TieredMergeStrategy::GetTier(const TieredMergeParams& params, uint64_t validSize)
+{
+    int32_t tier = 0;
+    uint64_t tierMaxSize = params.baseSegmentSize;
+    while (validSize > tierMaxSize) {
+        tier++;
+        if (tierMaxSize > std::numeric_limits<uint64_t>::max() / params.sizeRatio) {
+            break;
+        }
+        tierMaxSize *= params.sizeRatio;
+    }
+    return tier;
+}
+
+bool TieredMergeStrategy::LargerThanDelPercent(const TieredMergeParams& params,
+                                               const SegmentMergeInfo& segmentMergeInfo)
+{
+    if (0 == segmentMergeInfo.docCount) {
+        return false;
+    }
+    uint32_t curPercent = double(segmentMergeInfo.deletedDocCount) / segmentMergeInfo.docCount * 100;
+    return curPercent > params.conflictDelPercent;
+}
+
+double TieredMergeStrategy::GetMergePriority(const TieredMergeParams& params,
+                                             const SegmentMergeInfo& segmentMergeInfo, int64_t currentTimestamp)
+{
+    // delete ratio and age ratio both in [0, 1], segments with more deleted docs or older data merge first
+    double priority = 0;
+    if (segmentMergeInfo.docCount > 0) {
+        priority += double(segmentMergeInfo.deletedDocCount) / segmentMergeInfo.docCount;
+    }
+    if (params.maxSegmentAgeSecond > 0 && segmentMergeInfo.timestamp > 0) {
+        double age =
+            double(currentTimestamp - segmentMergeInfo.timestamp) / (params.maxSegmentAgeSecond * 1000 * 1000);
+        priority += std::max(0.0, std::min(1.0, age));
+    }
+    return priority;
+}
+
+std::pair<Status, TieredMergeParams> TieredMergeStrategy::TEST_ExtractParams(const std::string& paramStr)
+{
+    config::MergeStrategyParameter param;
+    param.SetLegacyString(paramStr);
+    return ExtractParams(param);
+}
+
+} // namespace indexlibv2::table
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "autil/Log.h"
+#include "indexlib/config/MergeStrategyParameter.h"
+#include "indexlib/framework/Segment.h"
+#include "indexlib/framework/TabletData.h"
+#include "indexlib/framework/index_task/IndexTaskContext.h"
+#include "indexlib/table/index_task/merger/MergePlan.h"
+#include "indexlib/table/index_task/merger/MergeStrategy.h"
+#include "indexlib/table/index_task/merger/MergeStrategyDefine.h"
+
+namespace indexlibv2::table {
+
+struct TieredMergeParams {
+    static constexpr uint64_t DEFAULT_BASE_SEGMENT_SIZE = 64 * 1024 * 1024;
+    static constexpr uint32_t DEFAULT_SIZE_RATIO = 10;
+    static constexpr uint32_t DEFAULT_MAX_SEGMENTS_PER_TIER = 10;
+    static constexpr uint32_t DEFAULT_CONFLICT_DEL_PERCENT = 30;
+    static constexpr uint64_t DEFAULT_MAX_SEGMENT_SIZE = std::numeric_limits<uint64_t>::max();
+    static constexpr uint64_t DEFAULT_MAX_SEGMENT_AGE_SECOND = 0;
+
+    // valid size upper bound of tier 0, tier i holds segments up to baseSegmentSize * sizeRatio^i
+    uint64_t baseSegmentSize = DEFAULT_BASE_SEGMENT_SIZE;
+    uint32_t sizeRatio = DEFAULT_SIZE_RATIO;
+    // a tier is merged when it holds this many segments
+    uint32_t maxSegmentsPerTier = DEFAULT_MAX_SEGMENTS_PER_TIER;
+    // segment with more deleted docs is rewritten alone even if its tier is not full
+    uint32_t conflictDelPercent = DEFAULT_CONFLICT_DEL_PERCENT;
+    // merged segment valid size limit, larger segments only take part in delete rewrite
+    uint64_t maxSegmentSize = DEFAULT_MAX_SEGMENT_SIZE;
+    // tier with at least two segments is merged when its oldest segment is older than this, 0 disables it
+    uint64_t maxSegmentAgeSecond = DEFAULT_MAX_SEGMENT_AGE_SECOND;
+    std::string DebugString() const
+    {
+        std::stringstream ss;
+        ss << "baseSegmentSize[" << baseSegmentSize << "],"
+           << "sizeRatio[" << sizeRatio << "],"
+           << "maxSegmentsPerTier[" << maxSegmentsPerTier << "],"
+           << "conflictDelPercent[" << conflictDelPercent << "],"
+           << "maxSegmentSize[" << maxSegmentSize << "],"
+           << "maxSegmentAgeSecond[" << maxSegmentAgeSecond << "]";
+        return ss.str();
+    }
+};
+
+// Size ratio (tiered) merge strategy for merged segments. Segments are put into tiers by valid size, a tier is
+// merged when it holds maxSegmentsPerTier segments or its oldest segment is too old, segments with high delete
+// ratio are merged first. Each segment merge plan records estimated bytes read and written, bytes written is
+// estimated from delete ratio. Actual size of each merged segment is recorded in its segment metrics after the
+// merge, write amplification is the sum of actual bytes written across merge rounds divided by the bytes ingested
+// over the same period.
+class TieredMergeStrategy : public MergeStrategy
+{
+public:
+    TieredMergeStrategy() = default;
+    ~TieredMergeStrategy() = default;
+
+    struct SegmentMergeInfo {
+        segmentid_t segmentId = INVALID_SEGMENTID;
+        uint64_t docCount = 0;
+        uint64_t deletedDocCount = 0;
+        uint64_t segmentSize = 0;
+        int64_t timestamp = 0; // us
+        SegmentMergeInfo(segmentid_t id, uint64_t docCnt, uint64_t delDocCnt, uint64_t size, int64_t ts)
+            : segmentId(id)
+            , docCount(docCnt)
+            , deletedDocCount(delDocCnt)
+            , segmentSize(size)
+            , timestamp(ts)
+        {
+        }
+        SegmentMergeInfo() = default;
+    };
+
+public:
+    std::string GetName() const override { return MergeStrategyDefine::TIERED_MERGE_STRATEGY_NAME; }
+    std::pair<Status, std::shared_ptr<MergePlan>> DoCreateMergePlan(const framework::IndexTaskContext* context);
+    std::pair<Status, std::shared_ptr<MergePlan>> CreateMergePlan(const framework::IndexTaskContext* context) override;
+
+public:
+    // pure selection over segment infos, used by DoCreateMergePlan and by offline replay of segment size history
+    static std::vector<std::vector<SegmentMergeInfo>>
+    SelectMergeSegments(const TieredMergeParams& params, const std::vector<SegmentMergeInfo>& segmentMergeInfos,
+                        int64_t currentTimestamp);
+    static uint64_t GetValidSize(const SegmentMergeInfo& segmentMergeInfo);
+
+private:
+    std::pair<Status, TieredMergeParams> ExtractParams(const config::MergeStrategyParameter& param) const;
+    Status CheckParam(const framework::IndexTaskContext* context);
+    std::pair<Status, std::vector<SegmentMergeInfo>>
+    CollectSegmentMergeInfos(const std::shared_ptr<framework::TabletData>& tabletData) const;
+
+    static int32_t GetTier(const TieredMergeParams& params, uint64_t validSize);
+    static bool LargerThanDelPercent(const TieredMergeParams& params, const SegmentMergeInfo& segmentMergeInfo);
+    static double GetMergePriority(const TieredMergeParams& params, const SegmentMergeInfo& segmentMergeInfo,
+                                   int64_t currentTimestamp);
+
+private:
+    std::pair<Status, TieredMergeParams> TEST_ExtractParams(const std::string& paramStr);
+
+private:
+    TieredMergeParams _params;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlibv2::table
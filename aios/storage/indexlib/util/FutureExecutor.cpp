@@ -42,8 +42,18 @@ future_lite::Executor* FutureExecutor::CreateExecutor(int threadNum, int maxAio)
                       .SetExecutorName("async_io_thread_pool_" + std::to_string(idx++))
                       .SetThreadNum(threadNum)
                       .Set<uint32_t>("max_aio", maxAio);
-    auto executor = future_lite::ExecutorCreator::Create(/*type*/ "async_io", params);
-    AUTIL_LOG(INFO, "pool created[%p], threadNum[%d], max_aio [%d]", executor.get(), threadNum, maxAio);
+    // INDEXLIB_ASYNC_IO_ENGINE=io_uring serves async io by io_uring instead of posix aio
+    std::string type = "async_io";
+    if (autil::EnvUtil::getEnv("INDEXLIB_ASYNC_IO_ENGINE", std::string("aio")) == "io_uring") {
+        if (future_lite::ExecutorCreator::HasExecutor("async_io_uring")) {
+            type = "async_io_uring";
+        } else {
+            AUTIL_LOG(WARN, "executor [async_io_uring] not linked, use [async_io]");
+        }
+    }
+    auto executor = future_lite::ExecutorCreator::Create(type, params);
+    AUTIL_LOG(INFO, "pool created[%p], type[%s], threadNum[%d], max_aio [%d]", executor.get(), type.c_str(),
+              threadNum, maxAio);
     return executor.release();
 }
 void FutureExecutor::DestroyExecutor(future_lite::Executor* executor)
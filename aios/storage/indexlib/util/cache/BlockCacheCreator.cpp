@@ -32,6 +32,7 @@ BlockCache* BlockCacheCreator::Create(const BlockCacheOption& option)
     unique_ptr<BlockCache> blockCache;
     switch (GetCacheTypeFromStr(option.cacheType)) {
     case LRU:
+    case TINY_LFU:
         blockCache.reset(new MemoryBlockCache());
         break;
 #ifndef AIOS_OPEN_SOURCE
@@ -39,6 +39,16 @@ struct BlockCacheOption {
         return option;
     }
 
+    static BlockCacheOption TinyLFU(size_t memorySize, size_t blockSize, size_t ioBatchSize)
+    {
+        BlockCacheOption option;
+        option.memorySize = memorySize;
+        option.blockSize = blockSize;
+        option.ioBatchSize = ioBatchSize;
+        option.cacheType = "tiny_lfu";
+        return option;
+    }
+
     // all size are B
     static BlockCacheOption DADI(size_t memorySize, size_t diskSize, size_t blockSize, size_t ioBatchSize)
     {
@@ -22,7 +22,8 @@ namespace indexlib { namespace util {
 enum CacheType {
     UNKNOWN,
     LRU,  // use lru policy
-    DADI, // use dadi cache
+    DADI,     // use dadi cache
+    TINY_LFU, // use w-tinylfu admission policy, scan resistant
 };
 
 static CacheType GetCacheTypeFromStr(const std::string& cacheTypeStr)
@@ -31,6 +32,8 @@ static CacheType GetCacheTypeFromStr(const std::string& cacheTypeStr)
         return LRU;
     } else if (cacheTypeStr == "dadi") {
         return DADI;
+    } else if (cacheTypeStr == "tiny_lfu") {
+        return TINY_LFU;
     } else {
         return UNKNOWN;
     }
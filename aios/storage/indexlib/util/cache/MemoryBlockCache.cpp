@@ -16,6 +16,7 @@
 #include "indexlib/util/cache/MemoryBlockCache.h"
 
 #include "autil/MemUtil.h"         // for memory debug
+#include "autil/StringUtil.h"
 #include "autil/cache/lru_cache.h" // for TEST_GetRefCount
 #include "indexlib/util/cache/BlockAllocator.h"
 #include "indexlib/util/cache/CacheType.h"
@@ -61,6 +62,24 @@ bool MemoryBlockCache::DoInit(const BlockCacheOption& cacheOption)
         AUTIL_LOG(ERROR, "unknown cache type [%s]", cacheOption.cacheType.c_str());
         return false;
     }
+    if (cacheType == TINY_LFU) {
+        double windowRatio = 0.0;
+        double protectedRatio = 0.0;
+        if (!ExtractTinyLFUParam(cacheOption, windowRatio, protectedRatio)) {
+            return false;
+        }
+        _cache = NewTinyLFUCache(_memorySize, shardBitsNum, false, windowRatio, protectedRatio, _blockSize,
+                                 GetBlockAllocator());
+        if (!_cache) {
+            AUTIL_LOG(ERROR,
+                      "create new tiny lfu cache fail, memorySize [%lu], shardBitsNum [%d], windowRatio [%f], "
+                      "protectedRatio [%f]",
+                      _memorySize, shardBitsNum, windowRatio, protectedRatio);
+            return false;
+        }
+        _tinyLFUCache = std::dynamic_pointer_cast<TinyLFUCache>(_cache);
+        return true;
+    }
     assert(cacheType == LRU);
     _cache = NewLRUCache(_memorySize, shardBitsNum, false, lruHighPriorityRatio, GetBlockAllocator());
     if (!_cache) {
@@ -71,6 +90,72 @@ bool MemoryBlockCache::DoInit(const BlockCacheOption& cacheOption)
     return true;
 }
 
+bool MemoryBlockCache::ExtractTinyLFUParam(const BlockCacheOption& cacheOption, double& windowRatio,
+                                           double& protectedRatio) const
+{
+    string windowRatioStr = GetValueFromKeyValueMap(cacheOption.cacheParams, "tiny_lfu_window_ratio", string("0.01"));
+    if (!autil::StringUtil::fromString(windowRatioStr, windowRatio) || windowRatio < 0.0 || windowRatio > 1.0) {
+        AUTIL_LOG(ERROR,
+                  "parse block cache param failed,  tiny_lfu_window_ratio [%s] should be float between [0.0, 1.0]",
+                  windowRatioStr.c_str());
+        return false;
+    }
+    string protectedRatioStr =
+        GetValueFromKeyValueMap(cacheOption.cacheParams, "tiny_lfu_protected_ratio", string("0.8"));
+    if (!autil::StringUtil::fromString(protectedRatioStr, protectedRatio) || protectedRatio < 0.0 ||
+        protectedRatio > 1.0) {
+        AUTIL_LOG(ERROR,
+                  "parse block cache param failed,  tiny_lfu_protected_ratio [%s] should be float between [0.0, 1.0]",
+                  protectedRatioStr.c_str());
+        return false;
+    }
+    return true;
+}
+
+void MemoryBlockCache::RegisterMetrics(const util::MetricProviderPtr& metricProvider, const std::string& prefix,
+                                       const kmonitor::MetricsTags& metricsTags)
+{
+    BlockCache::RegisterMetrics(metricProvider, prefix, metricsTags);
+    if (!_tinyLFUCache) {
+        return;
+    }
+    _metricsTags = metricsTags;
+    IE_INIT_METRIC_GROUP(metricProvider, BlockCacheWindowHitRatio, prefix + "/BlockCacheWindowHitRatio",
+                         kmonitor::GAUGE, "%");
+    IE_INIT_METRIC_GROUP(metricProvider, BlockCacheProbationHitRatio, prefix + "/BlockCacheProbationHitRatio",
+                         kmonitor::GAUGE, "%");
+    IE_INIT_METRIC_GROUP(metricProvider, BlockCacheProtectedHitRatio, prefix + "/BlockCacheProtectedHitRatio",
+                         kmonitor::GAUGE, "%");
+    IE_INIT_METRIC_GROUP(metricProvider, BlockCacheAdmitQps, prefix + "/BlockCacheAdmitQps", kmonitor::QPS, "count");
+    IE_INIT_METRIC_GROUP(metricProvider, BlockCacheRejectQps, prefix + "/BlockCacheRejectQps", kmonitor::QPS,
+                         "count");
+}
+
+void MemoryBlockCache::ReportMetrics()
+{
+    BlockCache::ReportMetrics();
+    if (!_tinyLFUCache) {
+        return;
+    }
+    auto stat = _tinyLFUCache->GetStatistics();
+    uint64_t windowHit = stat.window_hit_count - _lastStatistics.window_hit_count;
+    uint64_t probationHit = stat.probation_hit_count - _lastStatistics.probation_hit_count;
+    uint64_t protectedHit = stat.protected_hit_count - _lastStatistics.protected_hit_count;
+    uint64_t access = windowHit + probationHit + protectedHit + stat.miss_count - _lastStatistics.miss_count;
+    if (access > 0) {
+        IE_REPORT_METRIC_WITH_TAGS(BlockCacheWindowHitRatio, &_metricsTags, 100.0 * windowHit / access);
+        IE_REPORT_METRIC_WITH_TAGS(BlockCacheProbationHitRatio, &_metricsTags, 100.0 * probationHit / access);
+        IE_REPORT_METRIC_WITH_TAGS(BlockCacheProtectedHitRatio, &_metricsTags, 100.0 * protectedHit / access);
+    }
+    if (mBlockCacheAdmitQpsMetric) {
+        mBlockCacheAdmitQpsMetric->IncreaseQps(stat.admit_count - _lastStatistics.admit_count, &_metricsTags);
+    }
+    if (mBlockCacheRejectQpsMetric) {
+        mBlockCacheRejectQpsMetric->IncreaseQps(stat.reject_count - _lastStatistics.reject_count, &_metricsTags);
+    }
+    _lastStatistics = stat;
+}
+
 bool MemoryBlockCache::Put(Block* block, CacheBase::Handle** handle, autil::CacheBase::Priority priority) noexcept
 {
     if (_memorySize == 0) {
@@ -126,7 +211,7 @@ uint32_t MemoryBlockCache::TEST_GetRefCount(CacheBase::Handle* handle)
     if (_memorySize == 0) {
         return 0;
     }
-    if (strcmp(_cache->Name(), "LRUCache") == 0) {
+    if (strcmp(_cache->Name(), "LRUCache") == 0 || strcmp(_cache->Name(), "TinyLFUCache") == 0) {
         return reinterpret_cast<LRUHandle*>(handle)->refs;
     }
     assert(false);
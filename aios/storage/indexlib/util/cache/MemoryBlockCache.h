@@ -18,6 +18,7 @@
 #include <memory>
 
 #include "autil/Log.h"
+#include "autil/cache/tiny_lfu_cache.h"
 #include "indexlib/util/cache/BlockCache.h"
 
 namespace indexlib { namespace util {
@@ -53,12 +54,29 @@ public:
     uint32_t GetBlockCount() const override { return _cache ? (_cache->GetUsage() / _blockSize) : 0; }
     uint32_t GetMaxBlockCount() const override { return _cache ? (_cache->GetCapacity() / _blockSize) : 0; }
 
+    void RegisterMetrics(const util::MetricProviderPtr& metricProvider, const std::string& prefix,
+                         const kmonitor::MetricsTags& metricsTags) override;
+    void ReportMetrics() override;
+
     const char* TEST_GetCacheName() const override { return _cache ? _cache->Name() : "unknown"; }
     std::shared_ptr<autil::CacheBase> TEST_GetCache() const { return _cache; }
     uint32_t TEST_GetRefCount(autil::CacheBase::Handle* handle) override;
 
+private:
+    bool ExtractTinyLFUParam(const BlockCacheOption& cacheOption, double& windowRatio, double& protectedRatio) const;
+
 private:
     std::shared_ptr<autil::CacheBase> _cache;
+    // hit ratio of each region, only for tiny_lfu cache
+    std::shared_ptr<autil::TinyLFUCache> _tinyLFUCache;
+    autil::TinyLFUCacheShard::Statistics _lastStatistics;
+    kmonitor::MetricsTags _metricsTags;
+
+    IE_DECLARE_METRIC(BlockCacheWindowHitRatio);
+    IE_DECLARE_METRIC(BlockCacheProbationHitRatio);
+    IE_DECLARE_METRIC(BlockCacheProtectedHitRatio);
+    IE_DECLARE_METRIC(BlockCacheAdmitQps);
+    IE_DECLARE_METRIC(BlockCacheRejectQps);
 
 private:
     AUTIL_LOG_DECLARE();
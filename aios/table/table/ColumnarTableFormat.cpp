@@ -0,0 +1,336 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "table/ColumnarTableFormat.h"
+
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#include "autil/DataBuffer.h"
+#include "autil/legacy/exception.h"
+#include "autil/mem_pool/Pool.h"
+#include "table/Table.h"
+#include "table/ValueTypeSwitch.h"
+
+using namespace std;
+using namespace matchdoc;
+using namespace autil;
+
+namespace table {
+AUTIL_LOG_SETUP(table, ColumnarTableFormat);
+
+namespace {
+
+template <typename T>
+void writeFixedColumn(const Table &table, Column *column, DataBuffer &blockBuffer) {
+    auto columnData = column->getColumnData<T>();
+    size_t rowCount = table.getRowCount();
+    char *data = (char *)blockBuffer.writeNoCopy(rowCount * sizeof(T));
+    for (size_t i = 0; i < rowCount; i++) {
+        T value = columnData->get(i);
+        memcpy(data + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+template <typename T>
+void readFixedColumn(const StringView &block, size_t rowCount, Column *column) {
+    if (block.size() != rowCount * sizeof(T)) {
+        AUTIL_LEGACY_THROW(DataBufferCorruptedException, "fixed column block size not match");
+    }
+    auto columnData = column->getColumnData<T>();
+    const char *data = block.data();
+    for (size_t i = 0; i < rowCount; i++) {
+        T value;
+        memcpy(&value, data + i * sizeof(T), sizeof(T));
+        columnData->set(i, value);
+    }
+}
+
+// each value is written as DataBuffer does: varint length, encoded buffer
+template <typename T>
+void writeVarColumn(const Table &table, Column *column, DataBuffer &blockBuffer) {
+    auto columnData = column->getColumnData<T>();
+    size_t rowCount = table.getRowCount();
+    for (size_t i = 0; i < rowCount; i++) {
+        blockBuffer.write(columnData->get(i));
+    }
+}
+
+// return false if dictionary does not make block smaller
+template <typename T>
+bool writeDictColumn(const Table &table, Column *column, DataBuffer &blockBuffer) {
+    size_t rowCount = table.getRowCount();
+    DataBuffer plainBuffer(DataBuffer::DEFAUTL_DATA_BUFFER_SIZE, blockBuffer.getPool());
+    writeVarColumn<T>(table, column, plainBuffer);
+    DataBuffer entryBuffer((void *)plainBuffer.getData(), plainBuffer.getDataLen());
+    unordered_map<StringView, uint32_t> dict;
+    vector<StringView> entries;
+    vector<uint32_t> codes;
+    codes.reserve(rowCount);
+    for (size_t i = 0; i < rowCount; i++) {
+        const char *begin = (const char *)entryBuffer.getData();
+        uint32_t len = 0;
+        entryBuffer.read(len);
+        entryBuffer.readNoCopy(len);
+        StringView entry(begin, entryBuffer.getData() - begin);
+        auto iter = dict.find(entry);
+        if (iter == dict.end()) {
+            iter = dict.emplace(entry, entries.size()).first;
+            entries.push_back(entry);
+            if (entries.size() * 2 > rowCount) {
+                return false;
+            }
+        }
+        codes.push_back(iter->second);
+    }
+    blockBuffer.write(uint32_t(entries.size()));
+    for (const auto &entry : entries) {
+        blockBuffer.writeBytes(entry.data(), entry.size());
+    }
+    blockBuffer.writeBytes(codes.data(), codes.size() * sizeof(uint32_t));
+    return true;
+}
+
+template <typename T>
+T readVarValue(DataBuffer &blockBuffer) {
+    uint32_t len = 0;
+    blockBuffer.read(len);
+    T value;
+    value.init(len > 0 ? blockBuffer.readNoCopy(len) : nullptr);
+    return value;
+}
+
+template <typename T>
+void readVarColumn(DataBuffer &blockBuffer, size_t rowCount, Column *column) {
+    auto columnData = column->getColumnData<T>();
+    for (size_t i = 0; i < rowCount; i++) {
+        columnData->set(i, readVarValue<T>(blockBuffer));
+    }
+}
+
+template <typename T>
+void readDictColumn(DataBuffer &blockBuffer, size_t rowCount, Column *column) {
+    uint32_t dictSize = 0;
+    blockBuffer.read(dictSize);
+    vector<T> entries;
+    entries.reserve(dictSize);
+    for (uint32_t i = 0; i < dictSize; i++) {
+        entries.push_back(readVarValue<T>(blockBuffer));
+    }
+    const char *codes = (const char *)blockBuffer.readNoCopy(rowCount * sizeof(uint32_t));
+    auto columnData = column->getColumnData<T>();
+    for (size_t i = 0; i < rowCount; i++) {
+        uint32_t code;
+        memcpy(&code, codes + i * sizeof(uint32_t), sizeof(code));
+        if (code >= dictSize) {
+            AUTIL_LEGACY_THROW(DataBufferCorruptedException, "dict code out of range");
+        }
+        columnData->set(i, entries[code]);
+    }
+}
+
+} // namespace
+
+bool ColumnarTableFormat::support(const Table &table) {
+    // rows without any column block can not be checked by receiver
+    if (table.getColumnCount() == 0) {
+        return false;
+    }
+    for (size_t col = 0; col < table.getColumnCount(); col++) {
+        ValueType vt = table.getColumnType(col);
+        if (vt.isStdType() || !vt.isBuiltInType() || vt.getBuiltinType() == bt_unknown) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ColumnarTableFormat::serialize(const Table &table, DataBuffer &dataBuffer,
+                                    CompressType type)
+{
+    size_t rowCount = table.getRowCount();
+    size_t columnCount = table.getColumnCount();
+    dataBuffer.write(uint32_t(rowCount));
+    dataBuffer.write(uint32_t(columnCount));
+    for (size_t col = 0; col < columnCount; col++) {
+        dataBuffer.write(table.getColumnName(col));
+        dataBuffer.write(table.getColumnType(col).getType());
+    }
+    for (size_t col = 0; col < columnCount; col++) {
+        Column *column = table.getColumn(col);
+        ValueType vt = table.getColumnType(col);
+        DataBuffer blockBuffer(DataBuffer::DEFAUTL_DATA_BUFFER_SIZE, dataBuffer.getPool());
+        uint8_t encoding = ENCODING_PLAIN;
+        auto fixedFunc = [&](auto a) {
+            typedef typename decltype(a)::value_type T;
+            writeFixedColumn<T>(table, column, blockBuffer);
+            return true;
+        };
+        auto multiFunc = [&](auto a) {
+            typedef typename decltype(a)::value_type T;
+            writeVarColumn<T>(table, column, blockBuffer);
+            return true;
+        };
+        auto stringFunc = [&]() {
+            if (writeDictColumn<MultiChar>(table, column, blockBuffer)) {
+                encoding = ENCODING_DICT;
+            } else {
+                blockBuffer.clear();
+                writeVarColumn<MultiChar>(table, column, blockBuffer);
+            }
+            return true;
+        };
+        auto multiStringFunc = [&]() {
+            if (writeDictColumn<MultiString>(table, column, blockBuffer)) {
+                encoding = ENCODING_DICT;
+            } else {
+                blockBuffer.clear();
+                writeVarColumn<MultiString>(table, column, blockBuffer);
+            }
+            return true;
+        };
+        ValueTypeSwitch::switchType(vt, fixedFunc, multiFunc, stringFunc, multiStringFunc);
+        writeBlock(dataBuffer, encoding, blockBuffer, type);
+    }
+}
+
+void ColumnarTableFormat::deserialize(DataBuffer &dataBuffer, CompressType type, Table &table) {
+    uint32_t rowCount = 0;
+    uint32_t columnCount = 0;
+    dataBuffer.read(rowCount);
+    dataBuffer.read(columnCount);
+    // counts come from wire, check them before any allocation depends on them
+    if (columnCount == 0 ? rowCount != 0
+                         : (size_t)dataBuffer.getDataLen() / MIN_COLUMN_BYTES < columnCount) {
+        AUTIL_LEGACY_THROW(DataBufferCorruptedException, "column count not match buffer");
+    }
+    vector<Column *> columns;
+    columns.reserve(columnCount);
+    for (uint32_t col = 0; col < columnCount; col++) {
+        string name;
+        uint32_t valueType = 0;
+        dataBuffer.read(name);
+        dataBuffer.read(valueType);
+        ValueType vt;
+        vt.setType(valueType);
+        Column *column = table.declareColumn(name, vt, false);
+        if (!column) {
+            AUTIL_LEGACY_THROW(DataBufferCorruptedException, "declare column failed: " + name);
+        }
+        columns.push_back(column);
+    }
+    table.endGroup();
+
+    // every row takes at least one byte of its block, or one uint32 code of
+    // dict block, so row count is bounded by blocks actually received
+    vector<StringView> blocks(columnCount);
+    vector<uint8_t> encodings(columnCount, (uint8_t)ENCODING_PLAIN);
+    vector<string> decompressBuffers(columnCount);
+    for (uint32_t col = 0; col < columnCount; col++) {
+        blocks[col] = readBlock(dataBuffer, type, encodings[col], decompressBuffers[col]);
+        size_t minRowBytes = encodings[col] == ENCODING_DICT ? sizeof(uint32_t) : 1;
+        if (blocks[col].size() / minRowBytes < rowCount) {
+            AUTIL_LEGACY_THROW(DataBufferCorruptedException, "row count not match column block");
+        }
+    }
+    table.batchAllocateRow(rowCount);
+
+    auto *pool = table.getDataPool();
+    auto unexpectedFunc = [](auto a) { return false; };
+    for (uint32_t col = 0; col < columnCount; col++) {
+        Column *column = columns[col];
+        uint8_t encoding = encodings[col];
+        const StringView &block = blocks[col];
+        ValueType vt = column->getColumnSchema()->getType();
+        if (!vt.isMultiValue() && vt.getBuiltinType() != bt_string) {
+            auto fixedFunc = [&](auto a) {
+                typedef typename decltype(a)::value_type T;
+                readFixedColumn<T>(block, rowCount, column);
+                return true;
+            };
+            ValueTypeSwitch::switchType(vt, fixedFunc, unexpectedFunc);
+            continue;
+        }
+        // values of column refer to this copy, it lives as long as table pool
+        char *blockData = (char *)pool->allocate(block.size());
+        memcpy(blockData, block.data(), block.size());
+        DataBuffer blockBuffer(blockData, block.size(), pool);
+        auto varFunc = [&](auto a) {
+            typedef typename decltype(a)::value_type T;
+            if (encoding == ENCODING_DICT) {
+                readDictColumn<T>(blockBuffer, rowCount, column);
+            } else {
+                readVarColumn<T>(blockBuffer, rowCount, column);
+            }
+            return true;
+        };
+        auto stringFunc = [&]() {
+            return varFunc(ValueTypeSwitch::CppTypeTag<MultiChar>());
+        };
+        auto multiStringFunc = [&]() {
+            return varFunc(ValueTypeSwitch::CppTypeTag<MultiString>());
+        };
+        ValueTypeSwitch::switchType(vt, unexpectedFunc, varFunc, stringFunc, multiStringFunc);
+    }
+}
+
+void ColumnarTableFormat::writeBlock(DataBuffer &dataBuffer, uint8_t encoding,
+                                     const DataBuffer &blockBuffer, CompressType type)
+{
+    uint32_t rawLen = blockBuffer.getDataLen();
+    if (type != CompressType::NO_COMPRESS && type != CompressType::INVALID_COMPRESS_TYPE
+        && rawLen >= COMPRESS_MIN_BLOCK_SIZE)
+    {
+        string compressed;
+        StringView input(blockBuffer.getData(), rawLen);
+        if (CompressionUtil::compress(input, type, compressed, dataBuffer.getPool())
+            && compressed.size() < rawLen)
+        {
+            dataBuffer.write(uint8_t(encoding | ENCODING_COMPRESSED_FLAG));
+            dataBuffer.write(rawLen);
+            dataBuffer.write(uint32_t(compressed.size()));
+            dataBuffer.writeBytes(compressed.data(), compressed.size());
+            return;
+        }
+    }
+    dataBuffer.write(encoding);
+    dataBuffer.write(rawLen);
+    dataBuffer.writeBytes(blockBuffer.getData(), rawLen);
+}
+
+StringView ColumnarTableFormat::readBlock(DataBuffer &dataBuffer, CompressType type,
+                                          uint8_t &encoding, string &decompressBuffer)
+{
+    uint32_t rawLen = 0;
+    dataBuffer.read(encoding);
+    dataBuffer.read(rawLen);
+    if (!(encoding & ENCODING_COMPRESSED_FLAG)) {
+        return StringView((const char *)dataBuffer.readNoCopy(rawLen), rawLen);
+    }
+    encoding &= ~ENCODING_COMPRESSED_FLAG;
+    uint32_t storedLen = 0;
+    dataBuffer.read(storedLen);
+    StringView stored((const char *)dataBuffer.readNoCopy(storedLen), storedLen);
+    decompressBuffer.clear();
+    if (!CompressionUtil::decompress(stored, type, decompressBuffer, dataBuffer.getPool())
+        || decompressBuffer.size() != rawLen)
+    {
+        AUTIL_LEGACY_THROW(DataBufferCorruptedException, "decompress column block failed");
+    }
+    return StringView(decompressBuffer.data(), decompressBuffer.size());
+}
+
+}
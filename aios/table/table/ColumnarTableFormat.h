@@ -0,0 +1,73 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "autil/CompressionUtil.h"
+#include "autil/Log.h"
+#include "autil/StringView.h"
+
+namespace autil {
+class DataBuffer;
+}  // namespace autil
+
+namespace table {
+
+class Table;
+
+// Column-at-a-time wire format of Table, used when TableSerializeInfo.version
+// is TableSerializeInfo::VERSION_COLUMNAR.
+//   meta:  rowCount, columnCount, (name, valueType) * columnCount
+//   block: encoding, rawLen, [storedLen], bytes, one block per column
+// Single value numbers are packed contiguously; multi values and strings
+// keep DataBuffer encoding of each value. String columns with many
+// duplicates are dictionary encoded. Block is compressed by itself when
+// compress type is set and it is large enough.
+class ColumnarTableFormat
+{
+public:
+    static const uint8_t ENCODING_PLAIN = 0;
+    static const uint8_t ENCODING_DICT = 1;
+    static const uint8_t ENCODING_COMPRESSED_FLAG = 0x80;
+    static const uint32_t COMPRESS_MIN_BLOCK_SIZE = 1024;
+    // name length, value type, block encoding and length, at least one byte each
+    static const uint32_t MIN_COLUMN_BYTES = 4;
+
+public:
+    // false if table has no column or any column is not builtin type, sub
+    // docs are not checked
+    static bool support(const Table &table);
+    static void serialize(const Table &table, autil::DataBuffer &dataBuffer,
+                          autil::CompressType type);
+    // columns are declared on empty table, var length values refer to one
+    // pool buffer per column instead of one allocation per value
+    static void deserialize(autil::DataBuffer &dataBuffer, autil::CompressType type,
+                            Table &table);
+
+private:
+    static void writeBlock(autil::DataBuffer &dataBuffer, uint8_t encoding,
+                           const autil::DataBuffer &blockBuffer, autil::CompressType type);
+    // returned data is valid until dataBuffer or decompressBuffer changes
+    static autil::StringView readBlock(autil::DataBuffer &dataBuffer, autil::CompressType type,
+                                       uint8_t &encoding, std::string &decompressBuffer);
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+}
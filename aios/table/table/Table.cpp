@@ -19,6 +19,7 @@
 #include "autil/ConstString.h"
 #include "matchdoc/Reference.h"
 #include "matchdoc/VectorDocStorage.h"
+#include "table/ColumnarTableFormat.h"
 #include "table/ValueTypeSwitch.h"
 
 // TODO(xinfei.sxf) move to common define file
@@ -427,6 +428,7 @@ void Table::serialize(autil::DataBuffer &dataBuffer, autil::CompressType type) c
     if (needCompress) {
         _serializeInfo.compress = (uint32_t)type;
     }
+    _serializeInfo.version = TableSerializeInfo::VERSION_ROW;
     dataBuffer.write(_serializeInfo);
     _allocator->setSortRefFlag(false);
     if (!needCompress) {
@@ -444,6 +446,22 @@ void Table::serialize(autil::DataBuffer &dataBuffer, autil::CompressType type) c
     }
 }
 
+void Table::serializeColumnar(autil::DataBuffer &dataBuffer, autil::CompressType type) const {
+    if (_allocator->hasSubDocAllocator() || !ColumnarTableFormat::support(*this)) {
+        serialize(dataBuffer, type);
+        return;
+    }
+    bool needCompress = type != autil::CompressType::INVALID_COMPRESS_TYPE &&
+                        type != autil::CompressType::NO_COMPRESS &&
+                        (uint32_t)type < TableSerializeInfo::MAX_COMPRESS_VALUE;
+    TableSerializeInfo serializeInfo = _serializeInfo;
+    serializeInfo.version = TableSerializeInfo::VERSION_COLUMNAR;
+    serializeInfo.compress = needCompress ? (uint32_t)type : 0;
+    dataBuffer.write(serializeInfo);
+    ColumnarTableFormat::serialize(*this, dataBuffer,
+                                   needCompress ? type : autil::CompressType::NO_COMPRESS);
+}
+
 void Table::deserialize(autil::DataBuffer &dataBuffer) {
     dataBuffer.read(_serializeInfo);
     _allocator->setSortRefFlag(false);
@@ -452,6 +470,11 @@ void Table::deserialize(autil::DataBuffer &dataBuffer) {
     if ((autil::CompressType)_serializeInfo.compress < autil::CompressType::MAX) {
         type = (autil::CompressType)_serializeInfo.compress;
     }
+    if (_serializeInfo.version == TableSerializeInfo::VERSION_COLUMNAR) {
+        // columns are declared by format itself, no init
+        ColumnarTableFormat::deserialize(dataBuffer, type, *this);
+        return;
+    }
 
     bool needDecompress = type != autil::CompressType::NO_COMPRESS &&
                           type != autil::CompressType::INVALID_COMPRESS_TYPE;
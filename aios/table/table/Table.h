@@ -64,6 +64,8 @@ struct TableSerializeInfo {
     void deserialize(autil::DataBuffer &dataBuffer);
 
     static constexpr uint32_t MAX_COMPRESS_VALUE = 31; // 4 bits
+    static constexpr uint32_t VERSION_ROW = 0;
+    static constexpr uint32_t VERSION_COLUMNAR = 1;
 };
 
 class Table
@@ -182,6 +184,9 @@ public:
 public:
     void serialize(autil::DataBuffer &dataBuffer,
                    autil::CompressType type = autil::CompressType::NO_COMPRESS) const;
+    // fall back to row format if table has sub docs or non builtin columns
+    void serializeColumnar(autil::DataBuffer &dataBuffer,
+                           autil::CompressType type = autil::CompressType::NO_COMPRESS) const;
     void deserialize(autil::DataBuffer &dataBuffer);
     void serializeToString(std::string &data, autil::mem_pool::Pool *pool,
                            autil::CompressType type = autil::CompressType::NO_COMPRESS) const;
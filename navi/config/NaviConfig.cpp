@@ -42,6 +42,7 @@ ConcurrencyConfig::ConcurrencyConfig()
     , maxThreadNum(DEFAULT_THREAD_NUMBER)
     , queueSize(DEFAULT_QUEUE_SIZE)
     , processingSize(DEFAULT_PROCESSING_SIZE)
+    , workStealing(false)
 {}
 
 ConcurrencyConfig::ConcurrencyConfig(int threadNum_, size_t queueSize_, size_t processingSize_)
@@ -50,6 +51,7 @@ ConcurrencyConfig::ConcurrencyConfig(int threadNum_, size_t queueSize_, size_t p
     , maxThreadNum(DEFAULT_THREAD_NUMBER)
     , queueSize(queueSize_)
     , processingSize(processingSize_)
+    , workStealing(false)
 {}
 
 void ConcurrencyConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) {
@@ -58,6 +60,7 @@ void ConcurrencyConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) {
     json.Jsonize("max_thread_num", maxThreadNum, maxThreadNum);
     json.Jsonize("queue_size", queueSize, queueSize);
     json.Jsonize("processing_size", processingSize, processingSize);
+    json.Jsonize("work_stealing", workStealing, workStealing);
 }
 
 EngineConfig::EngineConfig()
@@ -54,6 +54,7 @@ public:
     size_t maxThreadNum;
     size_t queueSize;
     size_t processingSize;
+    bool workStealing;
 };
 
 class EngineConfig : public autil::legacy::Jsonizable {
@@ -25,6 +25,10 @@ thread_local int32_t INLINE_DEPTH_TLS = INVALID_INLINE_DEPTH;
 thread_local size_t current_thread_id = 0;
 thread_local size_t current_thread_counter = 0;
 thread_local size_t current_thread_wait_counter = 0;
+// worker identity for work stealing schedule
+thread_local NaviThreadPool *current_thread_pool = nullptr;
+thread_local int32_t current_worker_index = -1;
+thread_local uint32_t current_steal_seed = 0;
 
 NaviThreadPool::NaviThreadPool()
     : _run(false)
@@ -34,8 +38,10 @@ NaviThreadPool::NaviThreadPool()
     , _minThreadNum(DEFAULT_THREAD_NUMBER)
     , _maxThreadNum(DEFAULT_THREAD_NUMBER)
     , _activeThreadNum(DEFAULT_THREAD_NUMBER)
+    , _workStealing(false)
     , _threads(nullptr)
 {
+    atomic_set(&_localQueueSize, 0);
     atomic_set(&_workerCount, 0);
     atomic_set(&_runningThread, 0);
     atomic_set(&_processingCount, 0);
@@ -80,6 +86,16 @@ void NaviThreadPool::clear() {
         NAVI_KERNEL_LOG(ERROR, "drop item [%p]", item);
         item->destroy();
     }
+    if (!_threads) {
+        return;
+    }
+    for (size_t i = 0; i < _threadNum; i++) {
+        while (_threads[i].localQueue.popFront(&item)) {
+            atomic_dec(&_localQueueSize);
+            NAVI_KERNEL_LOG(ERROR, "drop item [%p]", item);
+            item->destroy();
+        }
+    }
 }
 
 int32_t NaviThreadPool::getIdleTid() {
@@ -171,7 +187,7 @@ void NaviThreadPool::waitQueueEmpty() {
             autil::ScopedLock lock(cond);
             cond.signal();
         }
-        if (0ul == _scheduleQueue.Size() &&
+        if (0ul == getQueueSize() &&
             atomic_read(&_workerCount) == 0)
         {
             break;
@@ -181,7 +197,7 @@ void NaviThreadPool::waitQueueEmpty() {
                  INFO,
                  "thread pool not empty, scheduleQueue size [%lu], workerCount "
                  "[%lld]",
-                 _scheduleQueue.Size(), atomic_read(&_workerCount));
+                 getQueueSize(), atomic_read(&_workerCount));
         }
         usleep(sleepTime);
         sleepTime += 1000;
@@ -230,6 +246,7 @@ bool NaviThreadPool::createThreads(const ConcurrencyConfig &config,
         _threadNum = (size_t)_configThreadNum;
     }
     _activeThreadNum = _threadNum;
+    _workStealing = config.workStealing;
     _threads = new NaviThread[_threadNum];
     for (size_t i = 0; i < _threadNum; i++) {
         auto thread = autil::Thread::createThread(
@@ -251,9 +268,10 @@ bool NaviThreadPool::createThreads(const ConcurrencyConfig &config,
     _backgroundThread = bgThread;
     NAVI_KERNEL_LOG(INFO,
                     "create threads success, autoScale[%d], config[%d],"
-                    "threadNum[%lu], minThreadNum[%lu], maxThreadNum[%lu]",
+                    "threadNum[%lu], minThreadNum[%lu], maxThreadNum[%lu], "
+                    "workStealing[%d]",
                     _autoScale, _configThreadNum,
-                    _threadNum, _minThreadNum, _maxThreadNum);
+                    _threadNum, _minThreadNum, _maxThreadNum, _workStealing);
     return true;
 }
 
@@ -357,11 +375,30 @@ void NaviThreadPool::push(NaviThreadPoolItemBase *item) {
     if (tid >= 0) {
         item->setSignalTid(_threads[tid].tid, getQueueSize());
     }
+    auto localIndex = getLocalWorkerIndex();
+    if (localIndex >= 0) {
+        // activated by a kernel running on this worker, keep it local and
+        // only wake up idle thread to steal
+        NAVI_KERNEL_LOG(SCHEDULE3, "push local WorkItem [%p], worker [%d], tid [%d]", item, localIndex, tid);
+        _threads[localIndex].localQueue.pushBack(item);
+        atomic_inc(&_localQueueSize);
+        if (tid >= 0) {
+            signal(tid);
+        }
+        return;
+    }
     NAVI_KERNEL_LOG(SCHEDULE3, "push WorkItem [%p], tid [%d], queueSize [%lu]", item, tid, getQueueSize());
     _scheduleQueue.Push(item);
     signal(tid);
 }
 
+int32_t NaviThreadPool::getLocalWorkerIndex() const {
+    if (!_workStealing || current_thread_pool != this) {
+        return -1;
+    }
+    return current_worker_index;
+}
+
 int64_t NaviThreadPool::getIdleThreadCount() const {
     int64_t active = _activeThreadNum;
     int64_t idle = active - atomic_read(&_processingCount);
@@ -373,7 +410,7 @@ int64_t NaviThreadPool::getRunningThreadCount() const {
 }
 
 size_t NaviThreadPool::getQueueSize() const {
-    return _scheduleQueue.Size();
+    return _scheduleQueue.Size() + atomic_read(&_localQueueSize);
 }
 
 NaviThreadPoolItemBase *NaviThreadPool::pop() {
@@ -385,6 +422,46 @@ NaviThreadPoolItemBase *NaviThreadPool::pop() {
     }
 }
 
+NaviThreadPoolItemBase *NaviThreadPool::pop(int32_t tid) {
+    if (!_workStealing) {
+        return pop();
+    }
+    NaviThreadPoolItemBase *item = nullptr;
+    if (_threads[tid].localQueue.popBack(&item)) {
+        atomic_dec(&_localQueueSize);
+        return item;
+    }
+    item = pop();
+    if (item) {
+        return item;
+    }
+    return steal(tid);
+}
+
+NaviThreadPoolItemBase *NaviThreadPool::steal(int32_t tid) {
+    if (0 == atomic_read(&_localQueueSize)) {
+        return nullptr;
+    }
+    // xorshift, start from a random victim to spread thieves
+    current_steal_seed ^= current_steal_seed << 13;
+    current_steal_seed ^= current_steal_seed >> 17;
+    current_steal_seed ^= current_steal_seed << 5;
+    size_t begin = current_steal_seed % _threadNum;
+    NaviThreadPoolItemBase *item = nullptr;
+    for (size_t i = 0; i < _threadNum; i++) {
+        size_t victim = (begin + i) % _threadNum;
+        if ((int32_t)victim == tid) {
+            continue;
+        }
+        if (_threads[victim].localQueue.popFront(&item)) {
+            atomic_dec(&_localQueueSize);
+            NAVI_KERNEL_LOG(SCHEDULE3, "thread [%d] steal [%p] from [%lu]", tid, item, victim);
+            return item;
+        }
+    }
+    return nullptr;
+}
+
 std::vector<pid_t> NaviThreadPool::getPidVec() const {
     std::vector<pid_t> vec;
     while ((int64_t)_threadNum != atomic_read(&_runningThread)) {
@@ -399,11 +476,14 @@ std::vector<pid_t> NaviThreadPool::getPidVec() const {
 void NaviThreadPool::workLoop(int32_t tid) {
     current_thread_id = (long)syscall(SYS_gettid);
     _threads[tid].tid = current_thread_id;
+    current_thread_pool = this;
+    current_worker_index = tid;
+    current_steal_seed = (uint32_t)current_thread_id | 1u;
     NAVI_MEMORY_BARRIER();
     atomic_inc(&_runningThread);
     NaviLoggerScope scope(_logger);
     while (_run) {
-        auto item = pop();
+        auto item = pop(tid);
         NAVI_KERNEL_LOG(SCHEDULE3, "thread pop [%d] [%p] queueSize [%lu]", tid, item, getQueueSize());
         if (item) {
             atomic_inc(&_processingCount);
@@ -438,6 +518,8 @@ void NaviThreadPool::workLoop(int32_t tid) {
         }
     }
     atomic_dec(&_runningThread);
+    current_thread_pool = nullptr;
+    current_worker_index = -1;
     INLINE_DEPTH_TLS = INVALID_INLINE_DEPTH;
 }
 
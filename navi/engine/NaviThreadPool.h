@@ -17,6 +17,7 @@
 
 #include "navi/common.h"
 #include "navi/config/NaviConfig.h"
+#include "navi/engine/NaviWorkDeque.h"
 #include "navi/engine/ScheduleInfo.h"
 #include "navi/util/CommonUtil.h"
 #include <arpc/common/LockFreeQueue.h>
@@ -36,6 +37,8 @@ enum ThreadStat {
     TS_WAKEUP,
 };
 
+class NaviThreadPoolItemBase;
+
 struct NaviThread {
     NaviThread()
         : tid(-1)
@@ -46,6 +49,8 @@ struct NaviThread {
     autil::ThreadPtr thread;
     autil::ThreadCond cond;
     volatile ThreadStat stat;
+    // work stealing mode only
+    NaviWorkDeque<NaviThreadPoolItemBase *> localQueue;
 } __attribute__((aligned(64)));
 
 class NaviThreadPoolItemBase
@@ -107,6 +112,9 @@ public:
     int64_t getRunningThreadCount() const;
     size_t getQueueSize() const;
     std::vector<pid_t> getPidVec() const;
+    bool isWorkStealing() const {
+        return _workStealing;
+    }
 private:
     bool createThreads(const ConcurrencyConfig &config, const std::string &name);
     void initThreadNumRange(const ConcurrencyConfig &config);
@@ -116,6 +124,9 @@ private:
     void checkTimeout();
     void workLoop(int32_t tid);
     NaviThreadPoolItemBase *pop();
+    NaviThreadPoolItemBase *pop(int32_t tid);
+    NaviThreadPoolItemBase *steal(int32_t tid);
+    int32_t getLocalWorkerIndex() const;
     int32_t getIdleTid();
     void signal(int32_t tid);
     bool wait(int32_t tid);
@@ -135,6 +146,8 @@ private:
     size_t _minThreadNum;
     size_t _maxThreadNum;
     size_t _activeThreadNum;
+    bool _workStealing;
+    atomic64_t _localQueueSize;
     NaviThread *_threads;
     autil::ThreadPtr _backgroundThread;
     autil::ThreadCond _backgroundCond;
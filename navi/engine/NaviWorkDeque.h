@@ -0,0 +1,83 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <autil/Lock.h>
+
+namespace navi {
+
+// per worker deque for work stealing schedule, owner pushes and pops at
+// back (LIFO, cache hot), thieves steal from front (FIFO, oldest item)
+template <typename T>
+class NaviWorkDeque
+{
+public:
+    NaviWorkDeque()
+        : _size(0)
+    {
+    }
+    ~NaviWorkDeque() {
+    }
+private:
+    NaviWorkDeque(const NaviWorkDeque &);
+    NaviWorkDeque &operator=(const NaviWorkDeque &);
+public:
+    void pushBack(T item) {
+        autil::ScopedSpinLock scope(_lock);
+        _items.push_back(item);
+        _size.store(_items.size(), std::memory_order_relaxed);
+    }
+    bool popBack(T *item) {
+        if (empty()) {
+            return false;
+        }
+        autil::ScopedSpinLock scope(_lock);
+        if (_items.empty()) {
+            return false;
+        }
+        *item = _items.back();
+        _items.pop_back();
+        _size.store(_items.size(), std::memory_order_relaxed);
+        return true;
+    }
+    bool popFront(T *item) {
+        if (empty()) {
+            return false;
+        }
+        autil::ScopedSpinLock scope(_lock);
+        if (_items.empty()) {
+            return false;
+        }
+        *item = _items.front();
+        _items.pop_front();
+        _size.store(_items.size(), std::memory_order_relaxed);
+        return true;
+    }
+    size_t size() const {
+        return _size.load(std::memory_order_relaxed);
+    }
+    bool empty() const {
+        return 0 == size();
+    }
+private:
+    autil::SpinLock _lock;
+    std::deque<T> _items;
+    std::atomic<size_t> _size;
+} __attribute__((aligned(64)));
+
+}